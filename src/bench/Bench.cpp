@@ -0,0 +1,175 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "3rdparty/json.hpp"
+#include "bench/Bench.h"
+#include "util/Misc.h"
+#include "util/Stats.h"
+#include "util/log/Log.h"
+
+using bench::Bench;
+
+// _____________________________________________________________________________
+Bench::Bench(size_t reps, const std::string& filter)
+    : _reps(std::max<size_t>(1, reps)), _filter(filter) {}
+
+// _____________________________________________________________________________
+bool Bench::selected(const std::string& name) const {
+  return name.find(_filter) != std::string::npos;
+}
+
+// _____________________________________________________________________________
+void Bench::run(const std::string& name, const util::json::Dict& params,
+                const std::function<void()>& f) {
+  run(name, params, []() {}, f);
+}
+
+// _____________________________________________________________________________
+void Bench::run(const std::string& name, const util::json::Dict& params,
+                const std::function<void()>& setup,
+                const std::function<void()>& f) {
+  if (!selected(name)) return;
+
+  util::json::Dict res = params;
+  res["name"] = name;
+
+  std::vector<double> times;
+
+  util::stats::reset();
+
+  // the phases of the benchmarked code reset the peak of the process, too
+  util::stats::PeakRss peakRss;
+
+  try {
+    for (size_t i = 0; i < _reps; i++) {
+      setup();
+      T_START(rep);
+      f();
+      times.push_back(T_STOP(rep));
+    }
+  } catch (const std::exception& e) {
+    LOGTO(WARN, std::cerr) << name << " failed: " << e.what();
+    res["error"] = std::string(e.what());
+    _results.push_back(res);
+    return;
+  }
+
+  std::sort(times.begin(), times.end());
+
+  res["reps"] = _reps;
+  res["min_ms"] = times.front();
+  res["max_ms"] = times.back();
+  res["median_ms"] = times.size() % 2
+                         ? times[times.size() / 2]
+                         : (times[times.size() / 2 - 1] +
+                            times[times.size() / 2]) / 2;
+  res["mean_ms"] =
+      std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+
+  res["peak_rss"] = peakRss.get();
+
+  if (util::stats::ENABLED) {
+    // the sum of the peaks of the accounted subsystems, deterministic other
+    // than the peak resident set size
+    size_t memPeak = 0;
+    util::json::Dict memPeaks;
+    for (size_t i = 0; i < util::stats::NUM_MEMS; i++) {
+      auto m = static_cast<util::stats::Mem>(i);
+      if (!util::stats::memPeak(m)) continue;
+      memPeaks[util::stats::memName(m)] = util::stats::memPeak(m);
+      memPeak += util::stats::memPeak(m);
+    }
+
+    res["mem_peak_bytes"] = memPeak;
+    res["mem_peaks"] = memPeaks;
+  }
+
+  LOGTO(INFO, std::cerr) << name << ": " << res["median_ms"].f << " ms";
+
+  _results.push_back(res);
+}
+
+// _____________________________________________________________________________
+size_t Bench::memRegressions(const std::string& baselinePath,
+                             double maxRegress, double maxRssRegress) const {
+  std::ifstream f(baselinePath);
+  if (!f.good()) {
+    throw std::runtime_error("Could not read baseline " + baselinePath);
+  }
+
+  nlohmann::json j;
+  try {
+    f >> j;
+  } catch (const std::exception&) {
+    throw std::runtime_error("Could not parse baseline " + baselinePath);
+  }
+
+  std::map<std::string, nlohmann::json> base;
+  for (const auto& r : j["results"]) {
+    if (r.count("name")) base[r["name"].get<std::string>()] = r;
+  }
+
+  size_t ret = 0;
+  for (const auto& r : _results) {
+    auto it = base.find(r.dict.at("name").str);
+    if (it == base.end()) continue;
+
+    // the peak resident set size, written with and without --mem-stats
+    auto rss = r.dict.find("peak_rss");
+    if (rss != r.dict.end() && it->second.count("peak_rss")) {
+      size_t old = it->second["peak_rss"].get<size_t>();
+      if (old > 0 && rss->second.ui > old * (1 + maxRssRegress / 100)) {
+        LOGTO(WARN, std::cerr)
+            << it->first << ": peak_rss grew from " << old << " to "
+            << rss->second.ui << " bytes";
+        ret++;
+      }
+    }
+
+    auto cur = r.dict.find("mem_peak_bytes");
+    if (cur == r.dict.end()) continue;
+
+    if (!it->second.count("mem_peak_bytes")) {
+      LOGTO(WARN, std::cerr) << it->first
+                             << ": no memory peaks in the baseline, it was "
+                                "written without --mem-stats";
+      continue;
+    }
+
+    std::vector<std::pair<std::string, size_t>> peaks = {
+        {"mem_peak_bytes", cur->second.ui}};
+    for (const auto& kv : r.dict.at("mem_peaks").dict) {
+      peaks.push_back({kv.first, kv.second.ui});
+    }
+
+    for (const auto& p : peaks) {
+      size_t old = 0;
+      if (p.first == "mem_peak_bytes") {
+        old = it->second[p.first].get<size_t>();
+      } else if (it->second.count("mem_peaks") &&
+                 it->second["mem_peaks"].count(p.first)) {
+        old = it->second["mem_peaks"][p.first].get<size_t>();
+      }
+
+      if (old > 0 && p.second > old * (1 + maxRegress / 100)) {
+        LOGTO(WARN, std::cerr)
+            << it->first << ": " << p.first << " grew from " << old
+            << " to " << p.second << " bytes";
+        ret++;
+      }
+    }
+  }
+
+  return ret;
+}
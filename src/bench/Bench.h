@@ -0,0 +1,51 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef BENCH_BENCH_H_
+#define BENCH_BENCH_H_
+
+#include <functional>
+#include <string>
+#include "util/json/Writer.h"
+
+namespace bench {
+
+// runs benchmarks and collects their timings and memory peaks
+class Bench {
+ public:
+  // each benchmark is run reps times, benchmarks whose name does not
+  // contain filter are skipped
+  Bench(size_t reps, const std::string& filter);
+
+  // whether the benchmark name is selected by the filter
+  bool selected(const std::string& name) const;
+
+  // time f, after running the untimed setup before each repetition. params
+  // are written to the results. If setup or f throw, the error is recorded
+  // instead of the timings.
+  void run(const std::string& name, const util::json::Dict& params,
+           const std::function<void()>& setup, const std::function<void()>& f);
+  void run(const std::string& name, const util::json::Dict& params,
+           const std::function<void()>& f);
+
+  const util::json::Array& getResults() const { return _results; }
+
+  // compare the accounted memory peaks of the results (their sum and the
+  // peaks of the single subsystems) against those of a previous output of
+  // the benchmarks, returns the number of peaks that grew by more than
+  // maxRegress percent. The peak resident set size is reset for every
+  // benchmark, but still depends on the allocator, so it is gated by its own
+  // maxRssRegress. Throws std::runtime_error if the baseline cannot be read.
+  size_t memRegressions(const std::string& baselinePath, double maxRegress,
+                        double maxRssRegress) const;
+
+ private:
+  size_t _reps;
+  std::string _filter;
+  util::json::Array _results;
+};
+
+}  // namespace bench
+
+#endif  // BENCH_BENCH_H_
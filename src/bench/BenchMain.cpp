@@ -0,0 +1,350 @@
+// Copyright 2016
+// University of Freiburg - Chair of Algorithms and Datastructures
+// Author: Patrick Brosi
+
+#include <getopt.h>
+#include <stdio.h>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bench/Bench.h"
+#include "bench/Generators.h"
+#include "bench/_config.h"
+#include "bench/config/BenchConfig.h"
+#include "bench/config/ConfigReader.h"
+#include "loom/Loom.h"
+#include "loom/config/ConfigReader.h"
+#include "loom/optim/OptGraph.h"
+#include "loom/optim/OptGraphScorer.h"
+#include "octi/Octi.h"
+#include "octi/config/ConfigReader.h"
+#include "shared/linegraph/LineGraph.h"
+#include "shared/rendergraph/RenderGraph.h"
+#include "topo/config/TopoConfig.h"
+#include "topo/mapconstructor/MapConstructor.h"
+#include "transitmap/TransitMap.h"
+#include "transitmap/config/ConfigReader.h"
+#include "util/geo/Grid.h"
+#include "util/graph/DirGraph.h"
+#include "util/graph/Dijkstra.h"
+#include "util/graph/EDijkstra.h"
+#include "util/Stats.h"
+#include "util/json/Writer.h"
+#include "util/log/Log.h"
+
+using bench::Bench;
+using bench::Network;
+using shared::linegraph::LineGraph;
+using shared::rendergraph::RenderGraph;
+using util::graph::Dijkstra;
+using util::graph::DirGraph;
+using util::graph::EDijkstra;
+using util::graph::Edge;
+using util::graph::Node;
+
+typedef DirGraph<size_t, double> BGraph;
+typedef Node<size_t, double> BNode;
+typedef Edge<size_t, double> BEdge;
+
+struct DCostFunc : public Dijkstra::CostFunc<size_t, double, double> {
+  double operator()(const BNode* from, const BEdge* e, const BNode* to) const {
+    UNUSED(from);
+    UNUSED(to);
+    return e->pl();
+  }
+  double inf() const { return std::numeric_limits<double>::infinity(); }
+};
+
+struct ECostFunc : public EDijkstra::CostFunc<size_t, double, double> {
+  double operator()(const BEdge* from, const BNode* n, const BEdge* to) const {
+    UNUSED(from);
+    // do not count the start edge
+    return n ? to->pl() : 0;
+  }
+  double inf() const { return std::numeric_limits<double>::infinity(); }
+};
+
+// _____________________________________________________________________________
+template <typename Reader, typename Config>
+void readCfg(std::vector<std::string> args, Config* cfg) {
+  args.insert(args.begin(), "loomBench");
+  std::vector<char*> argv;
+  for (auto& a : args) argv.push_back(&a[0]);
+  argv.push_back(0);
+  optind = 0;
+  Reader().read(cfg, args.size(), &argv[0]);
+}
+
+// _____________________________________________________________________________
+template <typename G>
+void read(G* g, const std::string& json, double smooth) {
+  std::stringstream ss(json);
+  g->readFromJson(&ss, smooth);
+}
+
+// _____________________________________________________________________________
+void benchGraph(Bench* b, const Network& net, const util::json::Dict& params,
+                size_t seed) {
+  BGraph g;
+  std::vector<BNode*> nds;
+  std::vector<BEdge*> edgs;
+  for (size_t i = 0; i < net.nds.size(); i++) nds.push_back(g.addNd(i));
+  for (const auto& e : net.edgs) {
+    double d = util::geo::dist(net.nds[e.first], net.nds[e.second]);
+    edgs.push_back(g.addEdg(nds[e.first], nds[e.second], d));
+    edgs.push_back(g.addEdg(nds[e.second], nds[e.first], d));
+  }
+
+  std::mt19937 rng(seed);
+  std::vector<std::pair<size_t, size_t>> ndQs, edgQs;
+  for (size_t i = 0; i < 200; i++) {
+    ndQs.push_back({rng() % nds.size(), rng() % nds.size()});
+    edgQs.push_back({rng() % edgs.size(), rng() % edgs.size()});
+  }
+
+  b->run("dijkstra/" + net.name, params, [&]() {
+    for (const auto& q : ndQs) {
+      Dijkstra::shortestPath(nds[q.first], nds[q.second], DCostFunc());
+    }
+  });
+
+  b->run("edijkstra/" + net.name, params, [&]() {
+    for (const auto& q : edgQs) {
+      EDijkstra::shortestPath(edgs[q.first], edgs[q.second], ECostFunc());
+    }
+  });
+
+  // grid of the network edges, queried around random stations
+  util::geo::DBox box;
+  for (const auto& p : net.nds) box = util::geo::extendBox(p, box);
+
+  util::geo::Grid<size_t, util::geo::Line, double> grid(500, 500, box);
+  for (size_t i = 0; i < net.edgs.size(); i++) {
+    grid.add({net.nds[net.edgs[i].first], net.nds[net.edgs[i].second]}, i);
+  }
+
+  b->run("grid/" + net.name, params, [&]() {
+    for (size_t i = 0; i < 10; i++) {
+      for (const auto& q : ndQs) {
+        std::set<size_t> res;
+        const auto& p = net.nds[q.first];
+        grid.get(util::geo::DBox({p.getX() - 1000, p.getY() - 1000},
+                                 {p.getX() + 1000, p.getY() + 1000}),
+                 &res);
+      }
+    }
+  });
+}
+
+// _____________________________________________________________________________
+void benchLoom(Bench* b, const Network& net, const util::json::Dict& params,
+               bool exhaust) {
+  std::string json = net.toJson();
+
+  loom::config::Config cfg;
+  readCfg<loom::config::ConfigReader>({}, &cfg);
+
+  // same penalties as loom::run
+  RenderGraph rg(5, 5);
+  read(&rg, json, 3);
+  double maxCrossPen =
+      rg.maxDeg() * std::max(cfg.crossPenMultiSameSeg,
+                             std::max(cfg.crossPenMultiDiffSeg,
+                                      std::max(cfg.stationCrossWeightSameSeg,
+                                               cfg.stationCrossWeightDiffSeg)));
+  double maxSepPen = rg.maxDeg() * std::max(cfg.separationPenWeight,
+                                            cfg.stationSeparationWeight);
+  shared::rendergraph::Penalties pens{maxCrossPen,
+                                      maxSepPen,
+                                      cfg.crossPenMultiSameSeg,
+                                      cfg.crossPenMultiDiffSeg,
+                                      cfg.separationPenWeight,
+                                      cfg.stationCrossWeightSameSeg,
+                                      cfg.stationCrossWeightDiffSeg,
+                                      cfg.stationSeparationWeight,
+                                      true,
+                                      true};
+
+  loom::optim::OptGraphScorer scorer(pens);
+  loom::optim::OptGraph og(&scorer);
+  og.build(&rg);
+
+  // score the input ordering of the optimization graph
+  loom::optim::OptOrderCfg ordering;
+  for (auto n : og.getNds()) {
+    for (auto e : n->getAdjList()) {
+      if (e->getFrom() != n) continue;
+      for (const auto& lo : e->pl().getLines()) ordering[e].push_back(lo.line);
+    }
+  }
+
+  b->run("scorer/" + net.name, params, [&]() {
+    for (size_t i = 0; i < 100; i++) scorer.getTotalScore(&og, ordering);
+  });
+
+  for (const std::string m :
+       {"null", "greedy", "greedy-lookahead", "hillc", "hillc-random", "anneal",
+        "anneal-random", "exhaust", "comb", "ilp", "ilp-naive"}) {
+    std::string name = "loom/" + m + "/" + net.name;
+    if (!b->selected(name)) continue;
+
+    // the exhaustive search easily runs for minutes, even on small networks
+    if (m == "exhaust" && !exhaust) continue;
+
+    cfg.optimMethod = m;
+    std::unique_ptr<RenderGraph> g;
+
+    b->run(name, params,
+           [&]() {
+             g.reset(new RenderGraph(5, 5));
+             read(g.get(), json, 3);
+           },
+           [&]() {
+             util::json::Dict stats;
+             loom::run(&cfg, g.get(), &stats);
+           });
+  }
+}
+
+// _____________________________________________________________________________
+void benchOcti(Bench* b, const Network& net, const util::json::Dict& params) {
+  std::string json = net.toJson();
+
+  for (const std::string m : {"heur", "ilp-build"}) {
+    std::string name = "octi/" + m + "/" + net.name;
+    if (!b->selected(name)) continue;
+
+    octi::config::Config cfg;
+    if (m == "heur") {
+      readCfg<octi::config::ConfigReader>({}, &cfg);
+    } else {
+      // only build the ILP, without solving it
+      readCfg<octi::config::ConfigReader>({"-m", "ilp"}, &cfg);
+      cfg.ilpNoSolve = true;
+    }
+
+    std::unique_ptr<LineGraph> tg;
+
+    b->run(name, params,
+           [&]() {
+             tg.reset(new LineGraph());
+             read(tg.get(), json, 0);
+           },
+           [&]() {
+             LineGraph res;
+             octi::basegraph::BaseGraph* gg = 0;
+             util::json::Dict stats;
+             auto prep = octi::prepare(&cfg, tg.get());
+             octi::draw(&cfg, prep, tg.get(), &res, &gg, &stats);
+             delete gg;
+           });
+  }
+}
+
+// _____________________________________________________________________________
+void benchTopo(Bench* b, const Network& net, const util::json::Dict& params) {
+  std::string json = net.toUnmergedJson();
+  topo::config::TopoConfig cfg;
+  std::unique_ptr<LineGraph> tg;
+
+  b->run("topo/collapse/" + net.name, params,
+         [&]() {
+           tg.reset(new LineGraph());
+           read(tg.get(), json, 0);
+         },
+         [&]() {
+           topo::MapConstructor mc(&cfg, tg.get());
+           mc.collapseShrdSegs(cfg.maxAggrDistance);
+         });
+}
+
+// _____________________________________________________________________________
+void benchTransitmap(Bench* b, const Network& net,
+                     const util::json::Dict& params) {
+  std::string json = net.toJson();
+  transitmapper::config::Config cfg;
+  readCfg<transitmapper::config::ConfigReader>({}, &cfg);
+  std::unique_ptr<RenderGraph> g;
+
+  b->run("transitmap/svg/" + net.name, params,
+         [&]() {
+           g.reset(new RenderGraph(cfg.lineWidth, cfg.lineSpacing));
+           read(g.get(), json, cfg.inputSmoothing);
+         },
+         [&]() {
+           std::stringstream ss;
+           transitmapper::run(&cfg, g.get(), &ss);
+         });
+}
+
+// _____________________________________________________________________________
+int main(int argc, char** argv) {
+  // disable output buffering for standard output
+  setbuf(stdout, NULL);
+
+  bench::config::BenchConfig cfg;
+
+  // read config
+  bench::config::ConfigReader cr;
+  cr.read(&cfg, argc, argv);
+
+  // the memory accounting slows down the timed runs
+  if (cfg.memStats) util::stats::enable();
+
+  size_t s = cfg.scale;
+
+  std::vector<Network> nets = {bench::gridCity(6 * s, 10 * s, cfg.seed),
+                               bench::radialMetro(8, 6 * s, 12, cfg.seed),
+                               bench::trunkCorridor(20 * s, 12, cfg.seed),
+                               bench::randomPlanar(64 * s * s, 10 * s,
+                                                   cfg.seed)};
+
+  Bench b(cfg.reps, cfg.filter);
+
+  for (const auto& net : nets) {
+    LineGraph lg;
+    read(&lg, net.toJson(), 0);
+
+    util::json::Dict params{{"network", net.name},
+                            {"nodes", lg.numNds()},
+                            {"edges", lg.numEdgs()},
+                            {"lines", lg.numLines()},
+                            {"max_deg", lg.maxDeg()}};
+
+    benchGraph(&b, net, params, cfg.seed);
+    benchLoom(&b, net, params,
+              cfg.filter.find("exhaust") != std::string::npos);
+    benchOcti(&b, net, params);
+    benchTopo(&b, net, params);
+    benchTransitmap(&b, net, params);
+  }
+
+  util::json::Writer wr(&std::cout, 3, true);
+  wr.val(util::json::Dict{{"version", VERSION_FULL},
+                          {"reps", cfg.reps},
+                          {"scale", cfg.scale},
+                          {"seed", cfg.seed},
+                          {"results", b.getResults()}});
+  wr.closeAll();
+  std::cout << std::endl;
+
+  if (!cfg.memBaseline.empty()) {
+    try {
+      size_t n = b.memRegressions(cfg.memBaseline, cfg.maxMemRegress,
+                                  cfg.maxRssRegress);
+      if (n) {
+        LOG(ERROR) << n << " memory peaks grew by more than "
+                   << cfg.maxMemRegress << "% (resident set size: "
+                   << cfg.maxRssRegress << "%) over " << cfg.memBaseline;
+        return 1;
+      }
+    } catch (const std::runtime_error& e) {
+      LOG(ERROR) << e.what();
+      return 1;
+    }
+  }
+
+  return (0);
+}
@@ -0,0 +1,395 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <sstream>
+#include "bench/Generators.h"
+#include "util/json/Writer.h"
+
+using bench::Network;
+using util::geo::DPoint;
+
+namespace {
+
+// std::mt19937 is fully specified, unlike the standard distributions, so
+// the networks are the same on every platform
+class Rand {
+ public:
+  explicit Rand(size_t seed) : _rng(seed) {}
+
+  // uniform in [0, n)
+  size_t idx(size_t n) { return _rng() % n; }
+
+  // uniform in [-d, d]
+  double jitter(double d) { return (_rng() / 4294967295.0 * 2 - 1) * d; }
+
+  bool coin(double p) { return _rng() / 4294967295.0 < p; }
+
+ private:
+  std::mt19937 _rng;
+};
+
+// _____________________________________________________________________________
+std::string color(size_t i) {
+  static const char* COLORS[] = {"e6194b", "3cb44b", "ffe119", "4363d8",
+                                 "f58231", "911eb4", "46f0f0", "f032e6",
+                                 "bcf60c", "fabebe", "008080", "e6beff",
+                                 "9a6324", "800000", "aaffc3", "808000",
+                                 "ffd8b1", "000075", "808080", "000000"};
+  return COLORS[i % 20];
+}
+
+// _____________________________________________________________________________
+void writeNd(util::json::Writer* wr, const std::string& id, size_t stat,
+             const DPoint& p) {
+  wr->obj();
+  wr->keyVal("type", "Feature");
+  wr->key("geometry");
+  wr->obj();
+  wr->keyVal("type", "Point");
+  wr->key("coordinates");
+  wr->arr();
+  wr->val(p.getX());
+  wr->val(p.getY());
+  wr->close();
+  wr->close();
+  wr->key("properties");
+  wr->obj();
+  wr->keyVal("id", id);
+  wr->keyVal("station_id", "s" + std::to_string(stat));
+  wr->keyVal("station_label", "Stop " + std::to_string(stat));
+  wr->close();
+  wr->close();
+}
+
+// _____________________________________________________________________________
+void writeEdg(util::json::Writer* wr, const std::string& from,
+              const std::string& to, const DPoint& a, const DPoint& b,
+              const std::set<size_t>& lines) {
+  wr->obj();
+  wr->keyVal("type", "Feature");
+  wr->key("geometry");
+  wr->obj();
+  wr->keyVal("type", "LineString");
+  wr->key("coordinates");
+  wr->arr();
+  for (const auto& p : {a, b}) {
+    wr->arr();
+    wr->val(p.getX());
+    wr->val(p.getY());
+    wr->close();
+  }
+  wr->close();
+  wr->close();
+  wr->key("properties");
+  wr->obj();
+  wr->keyVal("from", from);
+  wr->keyVal("to", to);
+  wr->key("lines");
+  wr->arr();
+  for (size_t l : lines) {
+    wr->obj();
+    wr->keyVal("id", "L" + std::to_string(l));
+    wr->keyVal("label", std::to_string(l + 1));
+    wr->keyVal("color", color(l));
+    wr->close();
+  }
+  wr->close();
+  wr->close();
+  wr->close();
+}
+
+// _____________________________________________________________________________
+std::pair<size_t, size_t> key(size_t a, size_t b) {
+  return {std::min(a, b), std::max(a, b)};
+}
+
+// _____________________________________________________________________________
+std::vector<size_t> bfs(const Network& net, size_t from, size_t to) {
+  std::vector<std::vector<size_t>> adj(net.nds.size());
+  for (const auto& e : net.edgs) {
+    adj[e.first].push_back(e.second);
+    adj[e.second].push_back(e.first);
+  }
+
+  std::vector<size_t> pred(net.nds.size(), net.nds.size());
+  std::queue<size_t> q;
+  pred[from] = from;
+  q.push(from);
+
+  while (!q.empty() && pred[to] == net.nds.size()) {
+    size_t cur = q.front();
+    q.pop();
+    for (size_t n : adj[cur]) {
+      if (pred[n] != net.nds.size()) continue;
+      pred[n] = cur;
+      q.push(n);
+    }
+  }
+
+  std::vector<size_t> ret;
+  if (pred[to] == net.nds.size()) return ret;
+  for (size_t cur = to; cur != from; cur = pred[cur]) ret.push_back(cur);
+  ret.push_back(from);
+  std::reverse(ret.begin(), ret.end());
+  return ret;
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+std::string Network::toJson() const {
+  std::map<std::pair<size_t, size_t>, std::set<size_t>> edgLines;
+  for (size_t l = 0; l < lines.size(); l++) {
+    for (size_t i = 1; i < lines[l].size(); i++) {
+      edgLines[key(lines[l][i - 1], lines[l][i])].insert(l);
+    }
+  }
+
+  std::stringstream ss;
+  util::json::Writer wr(&ss, 3, false);
+  wr.obj();
+  wr.keyVal("type", "FeatureCollection");
+  wr.key("features");
+  wr.arr();
+
+  // only stations on lines are written
+  std::vector<bool> used(nds.size(), false);
+  for (const auto& e : edgLines) used[e.first.first] = used[e.first.second] = 1;
+
+  for (size_t i = 0; i < nds.size(); i++) {
+    if (used[i]) writeNd(&wr, "n" + std::to_string(i), i, nds[i]);
+  }
+
+  for (const auto& e : edgLines) {
+    writeEdg(&wr, "n" + std::to_string(e.first.first),
+             "n" + std::to_string(e.first.second), nds[e.first.first],
+             nds[e.first.second], e.second);
+  }
+
+  wr.closeAll();
+  return ss.str();
+}
+
+// _____________________________________________________________________________
+std::string Network::toUnmergedJson() const {
+  std::stringstream ss;
+  util::json::Writer wr(&ss, 3, false);
+  wr.obj();
+  wr.keyVal("type", "FeatureCollection");
+  wr.key("features");
+  wr.arr();
+
+  for (size_t l = 0; l < lines.size(); l++) {
+    // displace each line by a few meters, like separately mapped tracks
+    DPoint off(((l % 7) - 3.0) * 4, (((l * 3) % 7) - 3.0) * 4);
+    auto id = [&](size_t i) {
+      return "l" + std::to_string(l) + "n" + std::to_string(lines[l][i]);
+    };
+    auto pos = [&](size_t i) {
+      return DPoint(nds[lines[l][i]].getX() + off.getX(),
+                    nds[lines[l][i]].getY() + off.getY());
+    };
+
+    for (size_t i = 0; i < lines[l].size(); i++) {
+      writeNd(&wr, id(i), lines[l][i], pos(i));
+    }
+
+    for (size_t i = 1; i < lines[l].size(); i++) {
+      writeEdg(&wr, id(i - 1), id(i), pos(i - 1), pos(i), {l});
+    }
+  }
+
+  wr.closeAll();
+  return ss.str();
+}
+
+// _____________________________________________________________________________
+Network bench::gridCity(size_t n, size_t numLines, size_t seed) {
+  Rand rand(seed);
+  Network net;
+  net.name = "grid";
+
+  for (size_t y = 0; y < n; y++) {
+    for (size_t x = 0; x < n; x++) {
+      net.nds.push_back(
+          DPoint(x * 500.0 + rand.jitter(60), y * 500.0 + rand.jitter(60)));
+      if (x) net.edgs.push_back({y * n + x - 1, y * n + x});
+      if (y) net.edgs.push_back({(y - 1) * n + x, y * n + x});
+    }
+  }
+
+  auto nd = [&](size_t a, size_t b, bool transp) {
+    return transp ? a * n + b : b * n + a;
+  };
+
+  for (size_t l = 0; l < numLines; l++) {
+    // even lines cross from west to east, odd lines from south to north
+    bool transp = l % 2;
+    size_t b = rand.idx(n);
+    size_t target = rand.idx(n);
+
+    std::vector<size_t> path;
+    for (size_t a = 0; a < n; a++) {
+      path.push_back(nd(a, b, transp));
+      // only move towards the target, so the path never revisits a station
+      while (b != target && (rand.coin(0.4) || a == n - 1)) {
+        b = b < target ? b + 1 : b - 1;
+        path.push_back(nd(a, b, transp));
+      }
+    }
+    net.lines.push_back(path);
+  }
+
+  return net;
+}
+
+// _____________________________________________________________________________
+Network bench::radialMetro(size_t arms, size_t armLen, size_t numLines,
+                           size_t seed) {
+  Rand rand(seed);
+  Network net;
+  net.name = "radial";
+
+  net.nds.push_back(DPoint(0, 0));
+
+  auto nd = [&](size_t arm, size_t k) {
+    return k ? 1 + arm * armLen + k - 1 : 0;
+  };
+
+  for (size_t a = 0; a < arms; a++) {
+    double ang = 2 * M_PI * a / arms;
+    for (size_t k = 1; k <= armLen; k++) {
+      double a2 = ang + rand.jitter(0.05);
+      net.nds.push_back(DPoint(cos(a2) * k * 600, sin(a2) * k * 600));
+      net.edgs.push_back({nd(a, k - 1), nd(a, k)});
+    }
+  }
+
+  // the ring connects all arms half way out
+  size_t ring = std::max<size_t>(1, armLen / 2);
+  for (size_t a = 0; a < arms; a++) {
+    net.edgs.push_back({nd(a, ring), nd((a + 1) % arms, ring)});
+  }
+
+  for (size_t l = 0; l < numLines; l++) {
+    size_t a = l % arms;
+    size_t b = (a + 1 + rand.idx(arms - 1)) % arms;
+    size_t endA = armLen - rand.idx(armLen / 3 + 1);
+    size_t endB = armLen - rand.idx(armLen / 3 + 1);
+
+    std::vector<size_t> path;
+
+    if (l == numLines - 1) {
+      // the ring line
+      for (size_t i = 0; i < arms; i++) path.push_back(nd(i, ring));
+    } else if (l % 4 == 3) {
+      // tangential lines use the ring to get to the next arm
+      for (size_t k = endA; k >= ring; k--) path.push_back(nd(a, k));
+      for (size_t k = ring; k <= endB; k++) path.push_back(nd((a + 1) % arms, k));
+    } else {
+      for (size_t k = endA; k > 0; k--) path.push_back(nd(a, k));
+      for (size_t k = 0; k <= endB; k++) path.push_back(nd(b, k));
+    }
+
+    net.lines.push_back(path);
+  }
+
+  return net;
+}
+
+// _____________________________________________________________________________
+Network bench::trunkCorridor(size_t len, size_t numLines, size_t seed) {
+  Rand rand(seed);
+  Network net;
+  net.name = "trunk";
+
+  for (size_t i = 0; i < len; i++) {
+    net.nds.push_back(
+        DPoint(i * 500.0, 300 * sin(i * 500.0 / 3000) + rand.jitter(30)));
+    if (i) net.edgs.push_back({i - 1, i});
+  }
+
+  DPoint west = net.nds.front();
+  DPoint east = net.nds.back();
+
+  for (size_t l = 0; l < numLines; l++) {
+    // the branches fan out at both ends of the trunk
+    double spread = (l + 0.5) / numLines - 0.5;
+    double angW = M_PI + spread * M_PI / 2;
+    double angE = -spread * M_PI / 2;
+
+    std::vector<size_t> path;
+
+    for (size_t k = 3; k > 0; k--) {
+      net.nds.push_back(DPoint(west.getX() + cos(angW) * k * 600,
+                               west.getY() + sin(angW) * k * 600));
+      if (k < 3) net.edgs.push_back({net.nds.size() - 2, net.nds.size() - 1});
+      path.push_back(net.nds.size() - 1);
+    }
+    net.edgs.push_back({path.back(), 0});
+
+    // every third line ends somewhere on the trunk
+    size_t end = l % 3 == 2 ? len / 2 + rand.idx(len / 2) : len - 1;
+    for (size_t i = 0; i <= end; i++) path.push_back(i);
+
+    if (end == len - 1) {
+      for (size_t k = 1; k <= 3; k++) {
+        net.nds.push_back(DPoint(east.getX() + cos(angE) * k * 600,
+                                 east.getY() + sin(angE) * k * 600));
+        net.edgs.push_back({path.back(), net.nds.size() - 1});
+        path.push_back(net.nds.size() - 1);
+      }
+    }
+
+    net.lines.push_back(path);
+  }
+
+  return net;
+}
+
+// _____________________________________________________________________________
+Network bench::randomPlanar(size_t n, size_t numLines, size_t seed) {
+  Rand rand(seed);
+  Network net;
+  net.name = "random";
+
+  size_t side = std::max<size_t>(2, ceil(sqrt(n)));
+
+  for (size_t y = 0; y < side; y++) {
+    for (size_t x = 0; x < side; x++) {
+      // small enough a jitter to keep the grid edges from crossing
+      net.nds.push_back(
+          DPoint(x * 500.0 + rand.jitter(100), y * 500.0 + rand.jitter(100)));
+      if (x && rand.coin(0.75)) net.edgs.push_back({y * side + x - 1, y * side + x});
+      if (y && rand.coin(0.75))
+        net.edgs.push_back({(y - 1) * side + x, y * side + x});
+
+      // at most one diagonal per cell
+      if (x && y && rand.coin(0.25)) {
+        if (rand.coin(0.5)) {
+          net.edgs.push_back({(y - 1) * side + x - 1, y * side + x});
+        } else {
+          net.edgs.push_back({(y - 1) * side + x, y * side + x - 1});
+        }
+      }
+    }
+  }
+
+  for (size_t l = 0; l < numLines; l++) {
+    std::vector<size_t> path;
+    // prefer long lines, but give up after a few tries
+    for (size_t i = 0; i < 20 && path.size() < side / 2 + 2; i++) {
+      path = bfs(net, rand.idx(net.nds.size()), rand.idx(net.nds.size()));
+    }
+    if (path.size() > 1) net.lines.push_back(path);
+  }
+
+  return net;
+}
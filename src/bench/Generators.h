@@ -0,0 +1,51 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef BENCH_GENERATORS_H_
+#define BENCH_GENERATORS_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "util/geo/Geo.h"
+
+namespace bench {
+
+// a synthetic transit network, lines are given as paths of node indices.
+// Coordinates are in web mercator meters, like the output of gtfs2graph.
+struct Network {
+  std::string name;
+  std::vector<util::geo::DPoint> nds;
+  std::vector<std::pair<size_t, size_t>> edgs;
+  std::vector<std::vector<size_t>> lines;
+
+  // the network as a line graph in GeoJSON, one edge per network edge
+  std::string toJson() const;
+
+  // the network as it comes out of gtfs2graph, before topo: each line
+  // has its own, slightly displaced edges, stations are shared by their ID
+  std::string toUnmergedJson() const;
+};
+
+// all generators are deterministic for a given seed
+
+// n x n stations in a jittered grid, with lines crossing the city from one
+// side to the opposite one
+Network gridCity(size_t n, size_t numLines, size_t seed);
+
+// arms running out of a center station, connected by a ring line. Each line
+// runs from the end of one arm through the center to the end of another.
+Network radialMetro(size_t arms, size_t armLen, size_t numLines, size_t seed);
+
+// a long corridor shared by all lines, with short branches at both ends
+Network trunkCorridor(size_t len, size_t numLines, size_t seed);
+
+// a planar network of about n stations, made of a jittered grid with random
+// edges removed and random cell diagonals added. Lines are shortest paths
+// between random stations.
+Network randomPlanar(size_t n, size_t numLines, size_t seed);
+
+}  // namespace bench
+
+#endif  // BENCH_GENERATORS_H_
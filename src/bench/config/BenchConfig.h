@@ -0,0 +1,45 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef BENCH_CONFIG_BENCHCONFIG_H_
+#define BENCH_CONFIG_BENCHCONFIG_H_
+
+#include <string>
+
+namespace bench {
+namespace config {
+
+struct BenchConfig {
+  // repetitions of each benchmark
+  size_t reps = 5;
+
+  // linear scale factor of the synthetic networks
+  size_t scale = 1;
+
+  // seed of the network generators and of the random queries
+  size_t seed = 1;
+
+  // only run benchmarks whose name contains this
+  std::string filter;
+
+  // record the memory peaks of the accounted subsystems, implied by
+  // memBaseline. Off by default, the accounting adds to the timings.
+  bool memStats = false;
+
+  // a previous output of the benchmarks to compare the memory peaks against
+  std::string memBaseline;
+
+  // the growth of a memory peak over the baseline, in percent, above which
+  // the benchmarks fail
+  double maxMemRegress = 10;
+
+  // the same for the peak resident set size, looser because it also depends
+  // on the allocator
+  double maxRssRegress = 25;
+};
+
+}  // namespace config
+}  // namespace bench
+
+#endif  // BENCH_CONFIG_BENCHCONFIG_H_
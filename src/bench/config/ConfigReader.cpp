@@ -0,0 +1,143 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <getopt.h>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "bench/_config.h"
+#include "bench/config/ConfigReader.h"
+#include "util/log/Log.h"
+
+using bench::config::ConfigReader;
+
+static const char* YEAR = &__DATE__[7];
+static const char* COPY =
+    "University of Freiburg - Chair of Algorithms and Data Structures";
+static const char* AUTHORS = "Patrick Brosi <brosi@informatik.uni-freiburg.de>";
+
+// _____________________________________________________________________________
+ConfigReader::ConfigReader() {}
+
+// _____________________________________________________________________________
+void ConfigReader::help(const char* bin) const {
+  std::cout << std::setfill(' ') << std::left << "loomBench (part of LOOM) "
+            << VERSION_FULL << "\n(built " << __DATE__ << " " << __TIME__ << ")"
+            << "\n\n(C) " << YEAR << " " << COPY << "\n"
+            << "Authors: " << AUTHORS << "\n\n"
+            << "Usage: " << bin << " > results.json\n\n"
+            << "Allowed options:\n\n"
+            << "General:\n"
+            << std::setw(35) << "  -v [ --version ]"
+            << "print version\n"
+            << std::setw(35) << "  -h [ --help ]"
+            << "show this help message\n"
+            << std::setw(35) << "  -r [ --reps ] arg (=5)"
+            << "repetitions of each benchmark\n"
+            << std::setw(35) << "  --scale arg (=1)"
+            << "linear scale factor of the synthetic networks\n"
+            << std::setw(35) << "  --seed arg (=1)"
+            << "seed of the network generators\n"
+            << std::setw(35) << "  --filter arg"
+            << "only run benchmarks whose name contains arg, the\n"
+            << std::setw(35) << " "
+            << "exhaustive loom search only runs if it contains\n"
+            << std::setw(35) << " "
+            << "'exhaust'\n"
+            << std::setw(35) << "  --mem-stats"
+            << "record the memory peaks of the subsystems, for use\n"
+            << std::setw(35) << " "
+            << "as a --mem-baseline\n"
+            << std::setw(35) << "  --mem-baseline arg"
+            << "compare memory peaks against this previous output\n"
+            << std::setw(35) << " "
+            << "and fail on regressions, implies --mem-stats\n"
+            << std::setw(35) << "  --max-mem-regress arg (=10)"
+            << "allowed growth of a memory peak in percent\n"
+            << std::setw(35) << "  --max-rss-regress arg (=25)"
+            << "allowed growth of the peak resident set size in\n"
+            << std::setw(35) << " "
+            << "percent\n";
+}
+
+// _____________________________________________________________________________
+void ConfigReader::read(BenchConfig* cfg, int argc, char** argv) const {
+  struct option ops[] = {{"version", no_argument, 0, 'v'},
+                         {"help", no_argument, 0, 'h'},
+                         {"reps", required_argument, 0, 'r'},
+                         {"scale", required_argument, 0, 1},
+                         {"seed", required_argument, 0, 2},
+                         {"filter", required_argument, 0, 3},
+                         {"mem-baseline", required_argument, 0, 4},
+                         {"max-mem-regress", required_argument, 0, 5},
+                         {"mem-stats", no_argument, 0, 6},
+                         {"max-rss-regress", required_argument, 0, 7},
+                         {0, 0, 0, 0}};
+
+  char c;
+  while ((c = getopt_long(argc, argv, ":hvr:", ops, 0)) != -1) {
+    switch (c) {
+      case 'h':
+        help(argv[0]);
+        exit(0);
+      case 'v':
+        std::cout << "loomBench - (LOOM " << VERSION_FULL << ")" << std::endl;
+        exit(0);
+      case 'r':
+        cfg->reps = atoi(optarg);
+        break;
+      case 1:
+        cfg->scale = atoi(optarg);
+        break;
+      case 2:
+        cfg->seed = atoi(optarg);
+        break;
+      case 3:
+        cfg->filter = optarg;
+        break;
+      case 4:
+        cfg->memBaseline = optarg;
+        break;
+      case 5:
+        cfg->maxMemRegress = atof(optarg);
+        break;
+      case 6:
+        cfg->memStats = true;
+        break;
+      case 7:
+        cfg->maxRssRegress = atof(optarg);
+        break;
+      case ':':
+        std::cerr << argv[optind - 1];
+        std::cerr << " requires an argument" << std::endl;
+        exit(1);
+      case '?':
+        std::cerr << argv[optind - 1];
+        std::cerr << " option unknown" << std::endl;
+        exit(1);
+        break;
+      default:
+        std::cerr << "Error while parsing arguments" << std::endl;
+        exit(1);
+        break;
+    }
+  }
+
+  if (!cfg->memBaseline.empty()) cfg->memStats = true;
+
+  if (cfg->reps < 1) {
+    LOG(ERROR) << "At least 1 repetition is required";
+    exit(1);
+  }
+
+  if (cfg->scale < 1) {
+    LOG(ERROR) << "Scale must be at least 1";
+    exit(1);
+  }
+
+  if (cfg->maxMemRegress < 0 || cfg->maxRssRegress < 0) {
+    LOG(ERROR) << "Allowed memory regression must not be negative";
+    exit(1);
+  }
+}
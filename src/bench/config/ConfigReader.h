@@ -0,0 +1,24 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef BENCH_CONFIG_CONFIGREADER_H_
+#define BENCH_CONFIG_CONFIGREADER_H_
+
+#include <vector>
+#include "bench/config/BenchConfig.h"
+
+namespace bench {
+namespace config {
+
+class ConfigReader {
+ public:
+  ConfigReader();
+  void read(BenchConfig* targetConfig, int argc, char** argv) const;
+
+ public:
+  void help(const char* bin) const;
+};
+}  // namespace config
+}  // namespace bench
+#endif  // BENCH_CONFIG_CONFIGREADER_H_
@@ -0,0 +1,292 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <cstring>
+#include <stdexcept>
+#include "dot/Lexer.h"
+#include "util/String.h"
+
+using dot::parser::Interner;
+using dot::parser::Lexer;
+using dot::parser::Slice;
+using dot::parser::SliceEq;
+using dot::parser::SliceHash;
+using dot::parser::Stmt;
+
+namespace {
+// _____________________________________________________________________________
+inline bool isIDChar(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_' || c == '.';
+}
+
+// _____________________________________________________________________________
+inline bool isWs(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' ||
+         c == '\v';
+}
+}  // namespace
+
+// _____________________________________________________________________________
+size_t SliceHash::operator()(const Slice& s) const {
+  // FNV-1a
+  size_t h = 14695981039346656037ULL;
+  for (size_t i = 0; i < s.n; i++) {
+    h ^= static_cast<unsigned char>(s.s[i]);
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// _____________________________________________________________________________
+bool SliceEq::operator()(const Slice& a, const Slice& b) const {
+  return a.n == b.n && memcmp(a.s, b.s, a.n) == 0;
+}
+
+// _____________________________________________________________________________
+size_t Interner::get(const Slice& s) {
+  auto i = _ids.find(s);
+  if (i != _ids.end()) return i->second;
+  _ids[s] = _strs.size();
+  _strs.push_back(s);
+  return _strs.size() - 1;
+}
+
+// _____________________________________________________________________________
+const Slice* Stmt::get(size_t k) const {
+  for (size_t i = attrs.size(); i > 0; i--) {
+    if (attrs[i - 1].first == k) return &attrs[i - 1].second;
+  }
+  return 0;
+}
+
+// _____________________________________________________________________________
+Lexer::Lexer(const char* data, size_t len)
+    : _data(data), _p(data), _end(data + len), _type(GRAPH), _level(0) {}
+
+// _____________________________________________________________________________
+size_t Lexer::key(const char* k) { return _keys.get(Slice(k, strlen(k))); }
+
+// _____________________________________________________________________________
+void Lexer::err(const std::string& msg) const {
+  throw std::runtime_error(msg + " at byte " + util::toString(pos()));
+}
+
+// _____________________________________________________________________________
+void Lexer::skipWs() {
+  while (_p < _end) {
+    if (isWs(*_p)) {
+      _p++;
+    } else if (*_p == '#' ||
+               (*_p == '/' && _p + 1 < _end && _p[1] == '/')) {
+      while (_p < _end && *_p != '\n') _p++;
+    } else if (*_p == '/' && _p + 1 < _end && _p[1] == '*') {
+      _p += 2;
+      while (_p + 1 < _end && !(_p[0] == '*' && _p[1] == '/')) _p++;
+      if (_p + 1 >= _end) err("Unterminated comment");
+      _p += 2;
+    } else {
+      return;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+bool Lexer::kw(const Slice& s, const char* w) const {
+  size_t i = 0;
+  for (; i < s.n && w[i]; i++) {
+    if ((s.s[i] | 0x20) != w[i]) return false;
+  }
+  return i == s.n && !w[i];
+}
+
+// _____________________________________________________________________________
+Slice Lexer::readId(bool* quoted) {
+  *quoted = false;
+  if (_p == _end) err("Unexpected end of input");
+
+  const char* start = _p;
+
+  if (*_p == '"') {
+    *quoted = true;
+    start = ++_p;
+    while (_p < _end && *_p != '"') {
+      if (*_p == '\\') _p++;
+      _p++;
+    }
+    if (_p >= _end) err("Unterminated string");
+    return Slice(start, _p++ - start);
+  }
+
+  if (*_p == '<') {
+    *quoted = true;
+    size_t depth = 1;
+    start = ++_p;
+    for (; _p < _end; _p++) {
+      if (*_p == '<') depth++;
+      if (*_p == '>' && --depth == 0) break;
+    }
+    if (_p >= _end) err("Unterminated HTML string");
+    return Slice(start, _p++ - start);
+  }
+
+  if (*_p == '-') _p++;
+
+  while (_p < _end && isIDChar(*_p)) _p++;
+  if (_p == start || (_p == start + 1 && *start == '-')) err("Expected ID");
+
+  return Slice(start, _p - start);
+}
+
+// _____________________________________________________________________________
+void Lexer::header() {
+  bool quoted;
+  skipWs();
+  Slice w = readId(&quoted);
+
+  bool strict = false;
+  if (!quoted && kw(w, "strict")) {
+    strict = true;
+    skipWs();
+    w = readId(&quoted);
+  }
+
+  if (!quoted && kw(w, "graph")) {
+    _type = strict ? STRICT_GRAPH : GRAPH;
+  } else if (!quoted && kw(w, "digraph")) {
+    _type = strict ? STRICT_DIGRAPH : DIGRAPH;
+  } else {
+    err("Expected keywords 'strict', 'graph' or 'digraph'");
+  }
+
+  skipWs();
+  if (_p < _end && *_p != '{') {
+    readId(&quoted);
+    skipWs();
+  }
+
+  if (_p == _end || *_p != '{') err("Expected opening {");
+  _p++;
+  _level = 1;
+}
+
+// _____________________________________________________________________________
+void Lexer::attrList(Stmt* s) {
+  bool quoted;
+  while (_p < _end && *_p == '[') {
+    _p++;
+    while (true) {
+      skipWs();
+      if (_p == _end) err("Unexpected end of input");
+      if (*_p == ']') break;
+      if (*_p == ',' || *_p == ';') {
+        _p++;
+        continue;
+      }
+
+      size_t k = _keys.get(readId(&quoted));
+      skipWs();
+      if (_p == _end || *_p != '=') err("Expected '='");
+      _p++;
+      skipWs();
+      s->attrs.push_back({k, readId(&quoted)});
+    }
+    _p++;
+    skipWs();
+  }
+}
+
+// _____________________________________________________________________________
+bool Lexer::next(Stmt* s) {
+  s->ids.clear();
+  s->attrs.clear();
+  s->type = EMPTY;
+
+  if (_level == 0) {
+    if (_p != _data) return false;
+    header();
+  }
+
+  bool quoted;
+
+  while (true) {
+    skipWs();
+    if (_p == _end) err("Unexpected end of input");
+
+    s->graphType = _type;
+    s->level = _level;
+
+    if (*_p == ';') {
+      _p++;
+      continue;
+    }
+
+    if (*_p == '{') {
+      _p++;
+      _level++;
+      continue;
+    }
+
+    if (*_p == '}') {
+      _p++;
+      if (--_level == 0) return false;
+      continue;
+    }
+
+    Slice id = readId(&quoted);
+    skipWs();
+
+    if (!quoted && kw(id, "subgraph")) {
+      if (_p < _end && *_p != '{') {
+        readId(&quoted);
+        skipWs();
+      }
+      if (_p == _end || *_p != '{') err("Expected opening {");
+      continue;
+    }
+
+    s->ids.push_back(_ids.get(id));
+
+    if (!quoted && kw(id, "graph")) {
+      s->type = ATTR_GRAPH;
+    } else if (!quoted && kw(id, "node")) {
+      s->type = ATTR_NODE;
+    } else if (!quoted && kw(id, "edge")) {
+      s->type = ATTR_EDGE;
+    } else if (_p < _end && *_p == '=') {
+      _p++;
+      skipWs();
+      s->ids.push_back(_ids.get(readId(&quoted)));
+      s->type = ATTR;
+      return true;
+    } else {
+      s->type = NODE;
+
+      while (_p + 1 < _end && *_p == '-' && (_p[1] == '-' || _p[1] == '>')) {
+        bool directed = _p[1] == '>';
+        if (directed && (_type == STRICT_GRAPH || _type == GRAPH)) {
+          err("No directed edges allowed in undirected graph");
+        }
+        if (!directed && (_type == STRICT_DIGRAPH || _type == DIGRAPH)) {
+          err("No undirected edges allowed in directed graph");
+        }
+        _p += 2;
+        skipWs();
+        if (_p < _end && *_p == '{') {
+          err("Subgraphs in edge statements not yet supported");
+        }
+        Slice to = readId(&quoted);
+        if (!quoted && kw(to, "subgraph")) {
+          err("Subgraphs in edge statements not yet supported");
+        }
+        s->ids.push_back(_ids.get(to));
+        s->type = EDGE;
+        skipWs();
+      }
+    }
+
+    attrList(s);
+    return true;
+  }
+}
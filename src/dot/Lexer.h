@@ -0,0 +1,112 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef DOT_LEXER_H_
+#define DOT_LEXER_H_
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "dot/Parser.h"
+
+namespace dot {
+namespace parser {
+
+// a range of the lexed memory block, quoted strings are given without their
+// quotes and with escape sequences left as they are
+struct Slice {
+  Slice() : s(0), n(0) {}
+  Slice(const char* s, size_t n) : s(s), n(n) {}
+  const char* s;
+  size_t n;
+
+  std::string str() const { return std::string(s, n); }
+};
+
+struct SliceHash {
+  size_t operator()(const Slice& s) const;
+};
+
+struct SliceEq {
+  bool operator()(const Slice& a, const Slice& b) const;
+};
+
+// maps slices to dense ids, the slices are not copied
+class Interner {
+ public:
+  size_t get(const Slice& s);
+  const Slice& str(size_t id) const { return _strs[id]; }
+  size_t size() const { return _strs.size(); }
+
+ private:
+  std::unordered_map<Slice, size_t, SliceHash, SliceEq> _ids;
+  std::vector<Slice> _strs;
+};
+
+// a single statement, with interned ids and attribute keys
+struct Stmt {
+  EntityType type;
+
+  // ids, interned by Lexer::id()
+  std::vector<size_t> ids;
+
+  // attribute keys, interned by Lexer::key(), and their values
+  std::vector<std::pair<size_t, Slice>> attrs;
+
+  GraphType graphType;
+  size_t level;
+
+  // value of the attribute with key k, or 0. If the key was given more than
+  // once, the last value is returned.
+  const Slice* get(size_t k) const;
+};
+
+// zero-copy DOT lexer over a memory block which returns one statement at a
+// time. Accepts the same language as the Parser, plus comments, HTML strings
+// and negative numerals as IDs. Throws std::runtime_error on syntax errors.
+class Lexer {
+ public:
+  Lexer(const char* data, size_t len);
+
+  // read the next statement into s, returns false after the closing brace of
+  // the graph
+  bool next(Stmt* s);
+
+  // interned id of attribute key k, which must outlive the lexer
+  size_t key(const char* k);
+
+  // interned node IDs
+  const Slice& id(size_t i) const { return _ids.str(i); }
+  size_t numIds() const { return _ids.size(); }
+
+  // interned attribute keys
+  const Slice& attrKey(size_t i) const { return _keys.str(i); }
+
+  // current byte offset in the block
+  size_t pos() const { return _p - _data; }
+
+ private:
+  const char* _data;
+  const char* _p;
+  const char* _end;
+
+  GraphType _type;
+  size_t _level;
+
+  Interner _ids;
+  Interner _keys;
+
+  void header();
+  void skipWs();
+  Slice readId(bool* quoted);
+  bool kw(const Slice& s, const char* w) const;
+  void attrList(Stmt* s);
+  void err(const std::string& msg) const;
+};
+
+}  // namespace parser
+}  // namespace dot
+
+#endif  // DOT_LEXER_H_
@@ -27,6 +27,9 @@ int main(int argc, char** argv) {
   // disable output buffering for standard output
   setbuf(stdout, NULL);
 
+  // write log messages to stderr from a background thread
+  util::AsyncLog::start(&std::cerr);
+
   // initialize randomness
   srand(time(NULL) + rand());
 
@@ -57,8 +57,8 @@ void Builder::consume(const Feed& f, BuildGraph* g) {
     addStop(prev.getStop(), g, &ngrid);
     ++st;
 
-    if (i % 100 == 0)
-      LOGTO(DEBUG, std::cerr) << "@ trip " << i << "/" << f.getTrips().size();
+    LOGTO_EVERY(DEBUG, std::cerr, 1000)
+        << "@ trip " << i << "/" << f.getTrips().size();
 
     for (; st != t->second->getStopTimes().end(); ++st) {
       const auto& cur = *st;
@@ -0,0 +1,23 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef LOOM_LOOM_H_
+#define LOOM_LOOM_H_
+
+#include "loom/config/LoomConfig.h"
+#include "shared/rendergraph/RenderGraph.h"
+#include "util/json/Writer.h"
+
+namespace loom {
+
+// optimize the line orderings of g in place. If cfg->outputStats is set, the
+// optimization statistics are written to jsonStats. Throws
+// std::runtime_error for an unknown optimization method or if the optimizer
+// fails (for example if no ILP solver is available).
+void run(const config::Config* cfg, shared::rendergraph::RenderGraph* g,
+         util::json::Dict* jsonStats);
+
+}  // namespace loom
+
+#endif  // LOOM_LOOM_H_
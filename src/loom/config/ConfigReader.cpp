@@ -4,12 +4,14 @@
 
 #include <float.h>
 #include <getopt.h>
+#include <unistd.h>
 #include <exception>
 #include <iostream>
 #include <string>
 #include "loom/_config.h"
 #include "loom/config/ConfigReader.h"
 #include "loom/config/LoomConfig.h"
+#include "util/json/Writer.h"
 #include "util/log/Log.h"
 
 using loom::config::ConfigReader;
@@ -64,8 +66,22 @@ void ConfigReader::help(const char* bin) const {
             << "Misc:\n"
             << std::setw(41) << "  -D [ --from-dot ]"
             << "input is in dot format\n"
+            << std::setw(41) << "  --in-format arg (=geojson)"
+            << "Input format, either geojson or bin\n"
+            << std::setw(41) << "  --input arg"
+            << "Read input from this file instead of stdin\n"
+            << std::setw(41) << "  --out-format arg (=geojson)"
+            << "Output format, either geojson or bin\n"
+            << std::setw(41) << "  --out-precision arg (=10)"
+            << "Decimals of GeoJSON coordinates, -1 for shortest exact\n"
             << std::setw(41) << "  --output-stats"
             << "Print stats to output\n"
+            << std::setw(41) << "  --trace-file arg"
+            << "Write a Chrome trace of the run to this file\n"
+            << std::setw(41) << "  --time-budget arg (=-1)"
+            << "Wall-clock budget in seconds, -1 for none\n"
+            << std::setw(41) << "  --seed arg (=0)"
+            << "Seed for randomized optimization methods\n"
             << std::setw(41) << "  --ilp-solver arg (=gurobi)"
             << "Preferred ILP solver, either glpk, cbc, or gurobi.\n"
             << std::setw(41) << " "
@@ -104,6 +120,13 @@ void ConfigReader::read(Config* cfg, int argc, char** argv) const {
       {"optim-runs", required_argument, 0, 13},
       {"dbg-output-path", required_argument, 0, 14},
       {"output-optgraph", required_argument, 0, 15},
+      {"seed", required_argument, 0, 16},
+      {"in-format", required_argument, 0, 17},
+      {"out-format", required_argument, 0, 18},
+      {"out-precision", required_argument, 0, 19},
+      {"input", required_argument, 0, 20},
+      {"trace-file", required_argument, 0, 21},
+      {"time-budget", required_argument, 0, 22},
       {0, 0, 0, 0}};
 
   char c;
@@ -163,6 +186,28 @@ void ConfigReader::read(Config* cfg, int argc, char** argv) const {
       case 15:
         cfg->outOptGraph = true;
         break;
+      case 16:
+        cfg->seed = atoi(optarg);
+        break;
+      case 17:
+        cfg->inFormat = optarg;
+        break;
+      case 18:
+        cfg->outFormat = optarg;
+        break;
+      case 19:
+        cfg->outPrecision = atoi(optarg) < 0 ? util::json::PREC_SHORTEST
+                                               : atoi(optarg);
+        break;
+      case 20:
+        cfg->inputFile = optarg;
+        break;
+      case 21:
+        cfg->traceFile = optarg;
+        break;
+      case 22:
+        cfg->deadline = util::Deadline(atof(optarg));
+        break;
       case 'D':
         cfg->fromDot = true;
         break;
@@ -181,4 +226,21 @@ void ConfigReader::read(Config* cfg, int argc, char** argv) const {
         break;
     }
   }
+
+  if (cfg->inFormat != "geojson" && cfg->inFormat != "bin") {
+    LOG(ERROR) << "Unknown input format " << cfg->inFormat
+               << ", must be one of {geojson, bin}";
+    exit(1);
+  }
+
+  if (!cfg->inputFile.empty() && access(cfg->inputFile.c_str(), R_OK) != 0) {
+    LOG(ERROR) << "Cannot read input file " << cfg->inputFile;
+    exit(1);
+  }
+
+  if (cfg->outFormat != "geojson" && cfg->outFormat != "bin") {
+    LOG(ERROR) << "Unknown output format " << cfg->outFormat
+               << ", must be one of {geojson, bin}";
+    exit(1);
+  }
 }
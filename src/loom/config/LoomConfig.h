@@ -6,6 +6,7 @@
 #define LOOM_CONFIG_LOOMCONFIG_H_
 
 #include <string>
+#include "util/Deadline.h"
 
 namespace loom {
 namespace config {
@@ -20,6 +21,9 @@ struct Config {
 
   size_t optimRuns = 1;
 
+  // seed for the randomized optimizers
+  unsigned int seed = 0;
+
   bool outOptGraph = false;
 
   bool outputStats = false;
@@ -28,6 +32,23 @@ struct Config {
   bool untangleGraph = true;
   bool fromDot = false;
 
+  // read the input from this file instead of stdin
+  std::string inputFile;
+
+  // write a Chrome trace-event file of the instrumented phases here
+  std::string traceFile;
+
+  // wall-clock budget of the run, see --time-budget
+  util::Deadline deadline;
+
+  // either geojson or bin
+  std::string inFormat = "geojson";
+  std::string outFormat = "geojson";
+
+  // decimals of GeoJSON output coordinates, util::json::PREC_SHORTEST for
+  // the shortest exact representation
+  size_t outPrecision = 10;
+
   int ilpTimeLimit = -1;
   int ilpNumThreads = 0;
 
@@ -19,7 +19,7 @@ using loom::optim::CombOptimizer;
 using shared::rendergraph::HierarOrderCfg;
 
 // _____________________________________________________________________________
-double CombOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
+double CombOptimizer::optimizeComp(OptGraph* og, const OptNodeSet& g,
                                 HierarOrderCfg* hc, size_t depth,
                                 OptResStats& stats) const {
   size_t maxC = maxCard(g);
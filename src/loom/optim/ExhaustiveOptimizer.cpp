@@ -6,21 +6,22 @@
 #include <unordered_map>
 #include "loom/optim/ExhaustiveOptimizer.h"
 #include "shared/linegraph/Line.h"
+#include "util/Stats.h"
 #include "util/log/Log.h"
 
 using namespace loom;
 using namespace optim;
 using loom::optim::ExhaustiveOptimizer;
 using shared::linegraph::Line;
+using shared::linegraph::LineIdCmp;
 using shared::rendergraph::HierarOrderCfg;
 
 // _____________________________________________________________________________
 double ExhaustiveOptimizer::optimizeComp(OptGraph* og,
-                                         const std::set<OptNode*>& g,
+                                         const OptNodeSet& g,
                                          HierarOrderCfg* hc, size_t depth,
                                          OptResStats& stats) const {
   UNUSED(og);
-  UNUSED(stats);
   LOGTO(DEBUG, std::cerr) << prefix(depth)
                           << "(ExhaustiveOptimizer) Optimizing component with "
                           << g.size() << " nodes.";
@@ -53,11 +54,15 @@ double ExhaustiveOptimizer::optimizeComp(OptGraph* og,
   bestScore = curScore;
   best = cur;
 
+  util::stats::MemTrack orderMem(util::stats::MEM_ORDER_CFG);
+  STATS_MEM(orderMem, 3 * memUsage(cur));
+
   double solSp = solutionSpaceSize(g);
 
   // don't try if it is pointless, assuming we can make 100.000
-  // iterations per second
-  if ((solSp / 50000) > (60 * 60 * 6)) {
+  // iterations per second. Under a time budget, search until it is used up
+  // and take the best ordering found so far.
+  if (!_cfg->deadline.limited() && (solSp / 50000) > (60 * 60 * 6)) {
     std::stringstream ss;
     ss << "Exhaustive search would take too long (over "
        << ((solSp / 50000) / (60 * 60))
@@ -89,7 +94,8 @@ double ExhaustiveOptimizer::optimizeComp(OptGraph* og,
     }
 
     for (size_t i = 0; i < edges.size(); i++) {
-      if (std::next_permutation(cur[edges[i]].begin(), cur[edges[i]].end())) {
+      if (std::next_permutation(cur[edges[i]].begin(), cur[edges[i]].end(),
+                                LineIdCmp())) {
         break;
       } else if (i == edges.size() - 1) {
         running = false;
@@ -98,6 +104,13 @@ double ExhaustiveOptimizer::optimizeComp(OptGraph* og,
 
     if (!running) break;
 
+    if (_cfg->deadline.expired()) {
+      LOGTO(DEBUG, std::cerr) << prefix(depth) << "Time budget used up after "
+                              << iters << "/" << solSp << " iterations.";
+      stats.timedOut = true;
+      break;
+    }
+
     if (_optScorer.optimizeSep())
       curScore = _optScorer.getTotalScore(g, cur);
     else
@@ -110,8 +123,14 @@ double ExhaustiveOptimizer::optimizeComp(OptGraph* og,
     itTime += T_STOP(iter);
   }
 
-  LOGTO(DEBUG, std::cerr) << prefix(depth) << "Found optimal score "
-                          << bestScore << " after " << iters << " iterations!";
+  if (running) {
+    LOGTO(DEBUG, std::cerr) << prefix(depth) << "Best score so far is "
+                            << bestScore;
+  } else {
+    LOGTO(DEBUG, std::cerr) << prefix(depth) << "Found optimal score "
+                            << bestScore << " after " << iters
+                            << " iterations!";
+  }
 
   writeHierarch(&best, hc);
 
@@ -119,13 +138,13 @@ double ExhaustiveOptimizer::optimizeComp(OptGraph* og,
 }
 
 // _____________________________________________________________________________
-void ExhaustiveOptimizer::initialConfig(const std::set<OptNode*>& g,
+void ExhaustiveOptimizer::initialConfig(const OptNodeSet& g,
                                         OptOrderCfg* cfg) const {
   initialConfig(g, cfg, false);
 }
 
 // _____________________________________________________________________________
-void ExhaustiveOptimizer::initialConfig(const std::set<OptNode*>& g,
+void ExhaustiveOptimizer::initialConfig(const OptNodeSet& g,
                                         OptOrderCfg* cfg, bool sorted) const {
   for (OptNode* n : g) {
     for (OptEdge* e : n->getAdjList()) {
@@ -138,9 +157,9 @@ void ExhaustiveOptimizer::initialConfig(const std::set<OptNode*>& g,
       }
 
       if (sorted) {
-        std::sort((*cfg)[e].begin(), (*cfg)[e].end());
+        std::sort((*cfg)[e].begin(), (*cfg)[e].end(), LineIdCmp());
       } else {
-        std::random_shuffle((*cfg)[e].begin(), (*cfg)[e].end());
+        std::shuffle((*cfg)[e].begin(), (*cfg)[e].end(), _rng);
       }
     }
   }
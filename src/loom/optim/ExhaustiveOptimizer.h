@@ -21,14 +21,14 @@ class ExhaustiveOptimizer : public Optimizer {
                       const shared::rendergraph::Penalties& pens)
       : Optimizer(cfg, pens), _optScorer(pens){};
 
-  virtual double optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
+  virtual double optimizeComp(OptGraph* og, const OptNodeSet& g,
                            shared::rendergraph::HierarOrderCfg* c,
                            size_t depth, OptResStats& stats) const;
 
  protected:
   OptGraphScorer _optScorer;
-  void initialConfig(const std::set<OptNode*>& g, OptOrderCfg* cfg) const;
-  void initialConfig(const std::set<OptNode*>& g, OptOrderCfg* cfg,
+  void initialConfig(const OptNodeSet& g, OptOrderCfg* cfg) const;
+  void initialConfig(const OptNodeSet& g, OptOrderCfg* cfg,
                      bool sorted) const;
   void writeHierarch(OptOrderCfg* cfg,
                      shared::rendergraph::HierarOrderCfg* c) const;
@@ -16,7 +16,7 @@ using shared::linegraph::Line;
 using shared::rendergraph::HierarOrderCfg;
 
 // _____________________________________________________________________________
-double GreedyOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
+double GreedyOptimizer::optimizeComp(OptGraph* og, const OptNodeSet& g,
                                   HierarOrderCfg* hc, size_t depth,
                                   OptResStats& stats) const {
   UNUSED(og);
@@ -35,7 +35,7 @@ double GreedyOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
 }
 
 // _____________________________________________________________________________
-void GreedyOptimizer::getFlatConfig(const std::set<OptNode*>& g,
+void GreedyOptimizer::getFlatConfig(const OptNodeSet& g,
                                    OptOrderCfg* cfg) const {
   const OptEdge* e = 0;
   SettledEdgs settled;
@@ -90,7 +90,7 @@ void GreedyOptimizer::getFlatConfig(const std::set<OptNode*>& g,
 }
 
 // _____________________________________________________________________________
-const OptEdge* GreedyOptimizer::getNextEdge(const std::set<OptNode*>& g,
+const OptEdge* GreedyOptimizer::getNextEdge(const OptNodeSet& g,
                                             SettledEdgs* settled) const {
   if (settled->size() == 0) return getInitialEdge(g);
 
@@ -109,7 +109,7 @@ const OptEdge* GreedyOptimizer::getNextEdge(const std::set<OptNode*>& g,
 
 // _____________________________________________________________________________
 const OptEdge* GreedyOptimizer::getInitialEdge(
-    const std::set<OptNode*>& g) const {
+    const OptNodeSet& g) const {
   const OptEdge* ret = 0;
 
   for (auto n : g) {
@@ -42,19 +42,19 @@ class GreedyOptimizer : public ExhaustiveOptimizer {
                   const shared::rendergraph::Penalties& pens, bool lookAhead)
       : ExhaustiveOptimizer(cfg, pens), _lookAhead(lookAhead){};
 
-  virtual double optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
+  virtual double optimizeComp(OptGraph* og, const OptNodeSet& g,
                            shared::rendergraph::HierarOrderCfg* c,
                            size_t depth, OptResStats& stats) const;
 
-  void getFlatConfig(const std::set<OptNode*>& g,
+  void getFlatConfig(const OptNodeSet& g,
                      OptOrderCfg* cfg) const;
 
  private:
   bool _lookAhead;
 
-  const OptEdge* getNextEdge(const std::set<OptNode*>& g,
+  const OptEdge* getNextEdge(const OptNodeSet& g,
                              SettledEdgs* settled) const;
-  const OptEdge* getInitialEdge(const std::set<OptNode*>& g) const;
+  const OptEdge* getInitialEdge(const OptNodeSet& g) const;
 
   std::pair<bool, double> guess(const shared::linegraph::Line* a,
                                 const shared::linegraph::Line* b,
@@ -16,10 +16,9 @@ using shared::linegraph::Line;
 using shared::rendergraph::HierarOrderCfg;
 
 // _____________________________________________________________________________
-double HillClimbOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
+double HillClimbOptimizer::optimizeComp(OptGraph* og, const OptNodeSet& g,
                                      HierarOrderCfg* hc, size_t depth,
                                      OptResStats& stats) const {
-  UNUSED(stats);
   UNUSED(depth);
   T_START(1);
   OptOrderCfg cur;
@@ -77,6 +76,13 @@ double HillClimbOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>&
     if (bestEdge == 0) break;
 
     cur[bestEdge] = bestOrder;
+
+    // every step is an improvement, so the current ordering is the best one
+    // found so far
+    if (_cfg->deadline.expired()) {
+      stats.timedOut = true;
+      break;
+    }
   }
 
   writeHierarch(&cur, hc);
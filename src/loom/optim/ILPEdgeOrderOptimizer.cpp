@@ -17,7 +17,7 @@ using shared::rendergraph::HierarOrderCfg;
 
 // _____________________________________________________________________________
 void ILPEdgeOrderOptimizer::getConfigurationFromSolution(
-    ILPSolver* lp, HierarOrderCfg* hc, const std::set<OptNode*>& g) const {
+    ILPSolver* lp, HierarOrderCfg* hc, const OptNodeSet& g) const {
   for (OptNode* n : g) {
     for (OptEdge* e : n->getAdjList()) {
       if (e->getFrom() != n) continue;
@@ -77,7 +77,7 @@ void ILPEdgeOrderOptimizer::getConfigurationFromSolution(
 
 // _____________________________________________________________________________
 ILPSolver* ILPEdgeOrderOptimizer::createProblem(
-    OptGraph* og, const std::set<OptNode*>& g) const {
+    OptGraph* og, const OptNodeSet& g) const {
   UNUSED(og);
   ILPSolver* lp = shared::optim::getSolver(_cfg->ilpSolver, shared::optim::MIN);
 
@@ -130,7 +130,7 @@ ILPSolver* ILPEdgeOrderOptimizer::createProblem(
 }
 
 // _____________________________________________________________________________
-void ILPEdgeOrderOptimizer::writeCrossingOracle(const std::set<OptNode*>& g,
+void ILPEdgeOrderOptimizer::writeCrossingOracle(const OptNodeSet& g,
                                                 ILPSolver* lp) const {
   // do everything iteratively, otherwise it would be unreadable
 
@@ -505,7 +505,7 @@ void ILPEdgeOrderOptimizer::writeCrossingOracle(const std::set<OptNode*>& g,
 
 // _____________________________________________________________________________
 void ILPEdgeOrderOptimizer::writeDiffSegConstraintsImpr(
-    const std::set<OptNode*>& g, ILPSolver* lp) const {
+    const OptNodeSet& g, ILPSolver* lp) const {
   // go into nodes and build crossing constraints for adjacent
   for (OptNode* node : g) {
     std::set<OptEdge*> processed;
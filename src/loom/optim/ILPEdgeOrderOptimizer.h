@@ -26,16 +26,16 @@ class ILPEdgeOrderOptimizer : public ILPOptimizer {
 
  private:
   virtual shared::optim::ILPSolver* createProblem(
-      OptGraph* og, const std::set<OptNode*>& g) const;
+      OptGraph* og, const OptNodeSet& g) const;
 
   virtual void getConfigurationFromSolution(
       shared::optim::ILPSolver* lp, shared::rendergraph::HierarOrderCfg* c,
-      const std::set<OptNode*>& g) const;
+      const OptNodeSet& g) const;
 
-  void writeCrossingOracle(const std::set<OptNode*>& g,
+  void writeCrossingOracle(const OptNodeSet& g,
                            shared::optim::ILPSolver* lp) const;
 
-  void writeDiffSegConstraintsImpr(const std::set<OptNode*>& g,
+  void writeDiffSegConstraintsImpr(const OptNodeSet& g,
                                    shared::optim::ILPSolver* lp) const;
 };
 }  // namespace optim
@@ -6,10 +6,12 @@
 #include <cstdio>
 #include <fstream>
 #include <thread>
+#include "loom/optim/GreedyOptimizer.h"
 #include "loom/optim/ILPOptimizer.h"
 #include "loom/optim/OptGraph.h"
 #include "shared/optim/ILPSolvProv.h"
 #include "shared/rendergraph/OrderCfg.h"
+#include "util/Stats.h"
 #include "util/String.h"
 #include "util/geo/Geo.h"
 #include "util/geo/output/GeoGraphJsonOutput.h"
@@ -22,7 +24,7 @@ using shared::optim::ILPSolver;
 using shared::rendergraph::HierarOrderCfg;
 
 // _____________________________________________________________________________
-double ILPOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
+double ILPOptimizer::optimizeComp(OptGraph* og, const OptNodeSet& g,
                                   HierarOrderCfg* hc, size_t depth,
                                   OptResStats& stats) const {
 
@@ -37,6 +39,9 @@ double ILPOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
   double buildT = T_STOP(build);
   LOGTO(DEBUG, std::cerr) << " .. done";
 
+  util::stats::MemTrack ilpMem(util::stats::MEM_ILP);
+  STATS_MEM(ilpMem, lp->memUsage());
+
   if (lp->getNumVars() > static_cast<int>(stats.maxNumColsPerComp))
     stats.maxNumColsPerComp = lp->getNumVars();
   if (lp->getNumConstrs() > static_cast<int>(stats.maxNumRowsPerComp))
@@ -46,7 +51,8 @@ double ILPOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
     lp->writeMps(_cfg->MPSOutputPath);
   }
 
-  if (_cfg->ilpTimeLimit >= 0) lp->setTimeLim(_cfg->ilpTimeLimit);
+  int timeLim = _cfg->deadline.clampTimeLim(_cfg->ilpTimeLimit);
+  if (timeLim >= 0) lp->setTimeLim(timeLim);
   if (_cfg->ilpNumThreads != 0) lp->setNumThreads(_cfg->ilpNumThreads);
 
   LOGTO(DEBUG, std::cerr) << "Solving ILP problem...";
@@ -61,6 +67,13 @@ double ILPOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
     LOG(WARN)
         << "No solution found for ILP problem (most likely because of a time "
            "limit)!";
+
+    if (_cfg->deadline.limited()) {
+      // under a time budget, rather take the greedy ordering than the input
+      stats.timedOut = true;
+      GreedyOptimizer greedy(_cfg, _scorer.getPens(), true);
+      greedy.optimizeComp(og, g, hc, depth + 1, stats);
+    }
   } else {
     LOGTO(INFO, std::cerr) << "(stats) ILP obj = " << lp->getObjVal();
     LOGTO(INFO, std::cerr) << "(stats) ILP build time = " << buildT << " ms";
@@ -94,7 +107,7 @@ int ILPOptimizer::getSeparationPenalty(const OptNode* n) const {
 
 // _____________________________________________________________________________
 void ILPOptimizer::getConfigurationFromSolution(
-    ILPSolver* lp, HierarOrderCfg* hc, const std::set<OptNode*>& g) const {
+    ILPSolver* lp, HierarOrderCfg* hc, const OptNodeSet& g) const {
   // build name index for faster lookup
 
   for (OptNode* n : g) {
@@ -135,7 +148,7 @@ void ILPOptimizer::getConfigurationFromSolution(
 
 // _____________________________________________________________________________
 ILPSolver* ILPOptimizer::createProblem(OptGraph* og,
-                                       const std::set<OptNode*>& g) const {
+                                       const OptNodeSet& g) const {
   ILPSolver* lp = shared::optim::getSolver(_cfg->ilpSolver, shared::optim::MIN);
 
   // for every segment s, we define |L(s)|^2 decision variables x_slp
@@ -184,7 +197,7 @@ ILPSolver* ILPOptimizer::createProblem(OptGraph* og,
 
 // _____________________________________________________________________________
 void ILPOptimizer::writeSameSegConstraints(OptGraph* og,
-                                           const std::set<OptNode*>& g,
+                                           const OptNodeSet& g,
                                            ILPSolver* lp) const {
   UNUSED(og);
   // go into nodes and build crossing constraints for adjacent
@@ -304,7 +317,7 @@ void ILPOptimizer::writeSameSegConstraints(OptGraph* og,
 
 // _____________________________________________________________________________
 void ILPOptimizer::writeDiffSegConstraints(OptGraph* og,
-                                           const std::set<OptNode*>& g,
+                                           const OptNodeSet& g,
                                            ILPSolver* lp) const {
   UNUSED(og);
   // go into nodes and build crossing constraints for adjacent
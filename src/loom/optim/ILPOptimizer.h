@@ -22,26 +22,26 @@ class ILPOptimizer : public Optimizer {
                const shared::rendergraph::Penalties& pens)
       : Optimizer(cfg, pens), _exhausOpt(cfg, pens) {};
 
-  virtual double optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
+  virtual double optimizeComp(OptGraph* og, const OptNodeSet& g,
                               shared::rendergraph::HierarOrderCfg* c,
                               size_t depth, OptResStats& stats) const;
 
  protected:
   const loom::optim::ExhaustiveOptimizer _exhausOpt;
   virtual shared::optim::ILPSolver* createProblem(
-      OptGraph* og, const std::set<OptNode*>& g) const;
+      OptGraph* og, const OptNodeSet& g) const;
 
   virtual void getConfigurationFromSolution(
       shared::optim::ILPSolver* lp, shared::rendergraph::HierarOrderCfg* c,
-      const std::set<OptNode*>& g) const;
+      const OptNodeSet& g) const;
 
   std::string getILPVarName(OptEdge* e, const shared::linegraph::Line* r,
                             size_t p) const;
 
-  void writeSameSegConstraints(OptGraph* og, const std::set<OptNode*>& g,
+  void writeSameSegConstraints(OptGraph* og, const OptNodeSet& g,
                                shared::optim::ILPSolver* lp) const;
 
-  void writeDiffSegConstraints(OptGraph* og, const std::set<OptNode*>& g,
+  void writeDiffSegConstraints(OptGraph* og, const OptNodeSet& g,
                                shared::optim::ILPSolver* lp) const;
 
   std::vector<PosComPair> getPositionCombinations(OptEdge* a, OptEdge* b) const;
@@ -10,7 +10,7 @@ using loom::optim::NullOptimizer;
 using shared::rendergraph::HierarOrderCfg;
 
 // _____________________________________________________________________________
-double NullOptimizer::optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
+double NullOptimizer::optimizeComp(OptGraph* og, const OptNodeSet& g,
                                 HierarOrderCfg* hc, size_t depth,
                                 OptResStats& stats) const {
   UNUSED(og);
@@ -24,6 +24,7 @@ using loom::optim::PartnerPath;
 using shared::linegraph::Line;
 using shared::linegraph::LineEdge;
 using shared::linegraph::LineGraph;
+using shared::linegraph::LineIdCmp;
 using shared::linegraph::LineNode;
 using shared::linegraph::LineOcc;
 using shared::rendergraph::RenderGraph;
@@ -77,7 +78,7 @@ size_t OptEdgePL::getCardinality() const { return getLines().size(); }
 
 // _____________________________________________________________________________
 const OptLO* OptEdgePL::getLineOcc(const Line* l) const {
-  if (lines.size() && lines.back().line > l) return 0;
+  if (lines.size() && LineIdCmp()(l, lines.back().line)) return 0;
   if (lines.size() > 0 && lines[0].line == l) return &lines[0];
   if (lines.size() > 1 && lines[1].line == l) return &lines[1];
   if (lines.size() > 2 && lines[2].line == l) return &lines[2];
@@ -352,7 +353,7 @@ std::vector<PartnerPath> OptGraph::getPartnerLines() const {
 }
 
 // _____________________________________________________________________________
-PartnerPath OptGraph::pathFromComp(const std::set<OptNode*>& comp) const {
+PartnerPath OptGraph::pathFromComp(const OptNodeSet& comp) const {
   std::vector<OptNode*> nPath;
   nPath.push_back(*comp.begin());
   PartnerPath pp;
@@ -703,6 +704,12 @@ size_t OptGraph::getMaxCardinality() const {
 // _____________________________________________________________________________
 const util::geo::Line<double>* OptEdgePL::getGeom() { return 0; }
 
+// _____________________________________________________________________________
+std::string OptEdgePL::dirId(const LineNode* dir) {
+  if (!dir) return "";
+  return util::toString(dir->getId());
+}
+
 // _____________________________________________________________________________
 util::json::Dict OptEdgePL::getAttrs() {
   util::json::Dict ret;
@@ -711,11 +718,11 @@ util::json::Dict OptEdgePL::getAttrs() {
   for (const auto& r : getLines()) {
     if (r.relatives.size() > 1)
       lines += r.line->label() + "(x" + util::toString(r.relatives.size()) +
-               ")" + "[" + r.line->color() + ", -> " + util::toString(r.dir) +
+               ")" + "[" + r.line->color() + ", -> " + dirId(r.dir) +
                "], ";
     else
       lines += r.line->label() + "[" + r.line->color() + ", -> " +
-               util::toString(r.dir) + "], ";
+               dirId(r.dir) + "], ";
   }
 
   ret["lines"] = lines;
@@ -731,11 +738,11 @@ std::string OptEdgePL::toStr() const {
   for (const auto& r : getLines()) {
     if (r.relatives.size() > 1)
       lines += r.line->label() + "(x" + util::toString(r.relatives.size()) +
-               ")" + "[" + r.line->color() + ", -> " + util::toString(r.dir) +
+               ")" + "[" + r.line->color() + ", -> " + dirId(r.dir) +
                "], ";
     else
       lines += r.line->label() + "[" + r.line->color() + ", -> " +
-               util::toString(r.dir) + "], ";
+               dirId(r.dir) + "], ";
   }
 
   return "[" + lines + "]";
@@ -747,7 +754,7 @@ const util::geo::Point<double>* OptNodePL::getGeom() { return &p; }
 // _____________________________________________________________________________
 util::json::Dict OptNodePL::getAttrs() {
   util::json::Dict ret;
-  ret["orig_node"] = util::toString(node);
+  ret["orig_node"] = node ? util::toString(node->getId()) : "";
   if (!node) {
     ret["stat_name"] = "<dummy>";
   } else {
@@ -759,7 +766,7 @@ util::json::Dict OptNodePL::getAttrs() {
   }
   std::string edges;
   for (auto e : circOrdering) {
-    edges += util::toString(e) + ",";
+    edges += util::toString(e->getId()) + ",";
   }
 
   ret["edge_order"] = edges;
@@ -2378,3 +2385,15 @@ bool OptGraph::terminatesAt(const OptEdge* eA, const OptNode* nd) {
   }
   return true;
 }
+
+// _____________________________________________________________________________
+size_t loom::optim::memUsage(const OptOrderCfg& cfg) {
+  // a map node holds 3 pointers and the color besides the key and the value
+  const size_t mapNd = 4 * sizeof(void*) + sizeof(OptOrderCfg::value_type);
+
+  size_t ret = 0;
+  for (const auto& e : cfg) {
+    ret += mapNd + e.second.capacity() * sizeof(const Line*);
+  }
+  return ret;
+}
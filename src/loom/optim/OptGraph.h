@@ -25,10 +25,18 @@ class OptGraphScorer;
 typedef util::graph::Node<OptNodePL, OptEdgePL> OptNode;
 typedef util::graph::Edge<OptNodePL, OptEdgePL> OptEdge;
 
+// node and edge containers are ordered by id, not by address, to make the
+// optimization deterministic
+typedef std::set<OptNode*, util::graph::IdCmp<OptNode>> OptNodeSet;
+
 typedef std::map<const loom::optim::OptEdge*,
-                 std::vector<const shared::linegraph::Line*>>
+                 std::vector<const shared::linegraph::Line*>,
+                 util::graph::IdCmp<loom::optim::OptEdge>>
     OptOrderCfg;
 
+// estimated bytes used by an ordering configuration
+size_t memUsage(const OptOrderCfg& cfg);
+
 struct OptLO {
   OptLO() : line(0), dir(0) {}
   OptLO(const shared::linegraph::Line* r,
@@ -42,12 +50,20 @@ struct OptLO {
   std::vector<const shared::linegraph::Line*> relatives;
 
   bool operator==(const shared::linegraph::Line* b) const { return b == line; }
-  bool operator<(const shared::linegraph::Line* b) const { return b < line; }
-  bool operator>(const shared::linegraph::Line* b) const { return b > line; }
+  bool operator<(const shared::linegraph::Line* b) const {
+    return shared::linegraph::LineIdCmp()(b, line);
+  }
+  bool operator>(const shared::linegraph::Line* b) const {
+    return shared::linegraph::LineIdCmp()(line, b);
+  }
 
   bool operator==(const OptLO& b) const { return b.line == line; }
-  bool operator<(const OptLO& b) const { return b.line < line; }
-  bool operator>(const OptLO& b) const { return b.line > line; }
+  bool operator<(const OptLO& b) const {
+    return shared::linegraph::LineIdCmp()(b.line, line);
+  }
+  bool operator>(const OptLO& b) const {
+    return shared::linegraph::LineIdCmp()(line, b.line);
+  }
 
   bool operator==(const shared::linegraph::LineOcc& b) const {
     return b.line == line;
@@ -108,6 +124,9 @@ struct OptEdgePL {
 
   const util::geo::Line<double>* getGeom();
   util::json::Dict getAttrs();
+
+ private:
+  static std::string dirId(const shared::linegraph::LineNode* dir);
 };
 
 struct OptNodePL {
@@ -151,7 +170,7 @@ class OptGraph : public util::graph::UndirGraph<OptNodePL, OptEdgePL> {
   void partnerLines();
 
   std::vector<PartnerPath> getPartnerLines() const;
-  PartnerPath pathFromComp(const std::set<OptNode*>& comp) const;
+  PartnerPath pathFromComp(const OptNodeSet& comp) const;
 
   static shared::linegraph::LineEdge* getAdjEdg(const OptEdge* e,
                                                 const OptNode* n);
@@ -8,6 +8,7 @@
 #include "loom/optim/Optimizer.h"
 #include "shared/linegraph/Line.h"
 #include "shared/rendergraph/Penalties.h"
+#include "util/Stats.h"
 
 using loom::optim::OptGraphScorer;
 using shared::linegraph::Line;
@@ -17,12 +18,21 @@ using shared::linegraph::LineNode;
 // _____________________________________________________________________________
 std::pair<size_t, size_t> OptGraphScorer::getNumCrossings(
     const OptGraph* g, const OptOrderCfg& c) const {
-  return getNumCrossings(g->getNds(), c);
+  size_t sameSegCrossings = 0;
+  size_t diffSegCrossings = 0;
+
+  for (auto n : g->getNds()) {
+    auto crossings = getNumCrossings(n, c);
+    sameSegCrossings += crossings.first;
+    diffSegCrossings += crossings.second;
+  }
+
+  return {sameSegCrossings, diffSegCrossings};
 }
 
 // _____________________________________________________________________________
 std::pair<size_t, size_t> OptGraphScorer::getNumCrossings(
-    const std::set<OptNode*>& g, const OptOrderCfg& c) const {
+    const OptNodeSet& g, const OptOrderCfg& c) const {
   size_t sameSegCrossings = 0;
   size_t diffSegCrossings = 0;
 
@@ -38,11 +48,17 @@ std::pair<size_t, size_t> OptGraphScorer::getNumCrossings(
 // _____________________________________________________________________________
 size_t OptGraphScorer::getNumSeparations(const OptGraph* g,
                                          const OptOrderCfg& c) const {
-  return getNumSeparations(g->getNds(), c);
+  double ret = 0;
+
+  for (auto n : g->getNds()) {
+    ret += getNumSeparations(n, c);
+  }
+
+  return ret;
 }
 
 // _____________________________________________________________________________
-size_t OptGraphScorer::getNumSeparations(const std::set<OptNode*>& g,
+size_t OptGraphScorer::getNumSeparations(const OptNodeSet& g,
                                          const OptOrderCfg& c) const {
   double ret = 0;
 
@@ -56,23 +72,41 @@ size_t OptGraphScorer::getNumSeparations(const std::set<OptNode*>& g,
 // _____________________________________________________________________________
 double OptGraphScorer::getSeparationScore(const OptGraph* g,
                                           const OptOrderCfg& c) const {
-  return getSeparationScore(g->getNds(), c);
+  double ret = 0;
+
+  for (auto n : g->getNds()) {
+    ret += getSeparationScore(n, c);
+  }
+
+  return ret;
 }
 
 // _____________________________________________________________________________
 double OptGraphScorer::getCrossingScore(const OptGraph* g,
                                         const OptOrderCfg& c) const {
-  return getCrossingScore(g->getNds(), c);
+  double ret = 0;
+
+  for (auto n : g->getNds()) {
+    ret += getCrossingScore(n, c);
+  }
+
+  return ret;
 }
 
 // _____________________________________________________________________________
 double OptGraphScorer::getTotalScore(const OptGraph* g,
                                      const OptOrderCfg& c) const {
-  return getTotalScore(g->getNds(), c);
+  double ret = 0;
+
+  for (auto n : g->getNds()) {
+    ret += getTotalScore(n, c);
+  }
+
+  return ret;
 }
 
 // _____________________________________________________________________________
-double OptGraphScorer::getTotalScore(const std::set<OptNode*>& g,
+double OptGraphScorer::getTotalScore(const OptNodeSet& g,
                                      const OptOrderCfg& c) const {
   double ret = 0;
 
@@ -100,7 +134,7 @@ double OptGraphScorer::getTotalScore(OptNode* n, const OptOrderCfg& c) const {
 }
 
 // _____________________________________________________________________________
-double OptGraphScorer::getSeparationScore(const std::set<OptNode*>& g,
+double OptGraphScorer::getSeparationScore(const OptNodeSet& g,
                                           const OptOrderCfg& c) const {
   double ret = 0;
 
@@ -112,7 +146,7 @@ double OptGraphScorer::getSeparationScore(const std::set<OptNode*>& g,
 }
 
 // _____________________________________________________________________________
-double OptGraphScorer::getCrossingScore(const std::set<OptNode*>& g,
+double OptGraphScorer::getCrossingScore(const OptNodeSet& g,
                                         const OptOrderCfg& c) const {
   double ret = 0;
 
@@ -155,6 +189,8 @@ std::pair<size_t, size_t> OptGraphScorer::getNumCrossings(
 // _____________________________________________________________________________
 std::pair<std::pair<size_t, size_t>, size_t> OptGraphScorer::getNumCrossSeps(
     OptNode* n, const OptOrderCfg& c) const {
+  STATS_COUNT(SCORER_CALLS, 1);
+
   std::pair<std::pair<size_t, size_t>, size_t> ret = {{0, 0}, 0};
   for (auto ea : n->getAdjList()) {
     auto cur = getNumCrossSeps(n, ea, c);
@@ -16,12 +16,12 @@ class OptGraphScorer {
   OptGraphScorer(const shared::rendergraph::Penalties& pens) : _pens(pens) {}
 
   double getTotalScore(const OptGraph* g, const OptOrderCfg& c) const;
-  double getTotalScore(const std::set<OptNode*>& g, const OptOrderCfg& c) const;
+  double getTotalScore(const OptNodeSet& g, const OptOrderCfg& c) const;
   double getTotalScore(OptNode* n, const OptOrderCfg& c) const;
   double getTotalScore(OptEdge* n, const OptOrderCfg& c) const;
 
   double getCrossingScore(const OptGraph* g, const OptOrderCfg& c) const;
-  double getCrossingScore(const std::set<OptNode*>& g,
+  double getCrossingScore(const OptNodeSet& g,
                           const OptOrderCfg& c) const;
   double getCrossingScore(OptNode* n, const OptOrderCfg& c) const;
   double getCrossingScore(OptEdge* e, const OptOrderCfg& c) const;
@@ -30,7 +30,7 @@ class OptGraphScorer {
 
   double getSeparationScore(OptEdge* e, const OptOrderCfg& c) const;
 
-  double getSeparationScore(const std::set<OptNode*>& g,
+  double getSeparationScore(const OptNodeSet& g,
                             const OptOrderCfg& c) const;
   double getSeparationScore(OptNode* n, const OptOrderCfg& c) const;
 
@@ -53,11 +53,11 @@ class OptGraphScorer {
   std::pair<size_t, size_t> getNumCrossings(const OptGraph* g,
                                             const OptOrderCfg& c) const;
 
-  std::pair<size_t, size_t> getNumCrossings(const std::set<OptNode*>& g,
+  std::pair<size_t, size_t> getNumCrossings(const OptNodeSet& g,
                                             const OptOrderCfg& c) const;
 
   size_t getNumSeparations(const OptGraph* g, const OptOrderCfg& c) const;
-  size_t getNumSeparations(const std::set<OptNode*>& g,
+  size_t getNumSeparations(const OptNodeSet& g,
                            const OptOrderCfg& c) const;
 
   bool optimizeSep() const;
@@ -9,6 +9,7 @@
 #include "loom/optim/OptGraphScorer.h"
 #include "loom/optim/Optimizer.h"
 #include "util/Misc.h"
+#include "util/Stats.h"
 #include "util/geo/output/GeoGraphJsonOutput.h"
 #include "util/graph/Algorithm.h"
 #include "util/log/Log.h"
@@ -38,9 +39,20 @@ using util::geo::DPoint;
 OptResStats Optimizer::optimize(RenderGraph* rg) const {
   // create optim graph
   OptGraph g(&_scorer);
-  g.build(rg);
+  {
+    STATS_TIMER("loom/optgraph-build");
+    g.build(rg);
+  }
+
+  util::stats::MemTrack rgMem(util::stats::MEM_GRAPH);
+  util::stats::MemTrack rgGeomMem(util::stats::MEM_GEOM);
+  util::stats::MemTrack optGraphMem(util::stats::MEM_GRAPH);
+  STATS_MEM(rgMem, rg->memUsage());
+  STATS_MEM(rgGeomMem, rg->geomMemUsage());
+  STATS_MEM(optGraphMem, g.memUsage());
 
   OptResStats optResStats;
+  optResStats.timedOut = false;
 
   optResStats.numNodesOrig = rg->numNds();
   optResStats.numStationsOrig = rg->numNds(false);
@@ -48,7 +60,7 @@ OptResStats Optimizer::optimize(RenderGraph* rg) const {
   optResStats.numLinesOrig = rg->numLines();
   optResStats.maxDegOrig = rg->maxDeg();
 
-  size_t maxC = maxCard(g.getNds());
+  size_t maxC = maxCard(g);
 
   double solSp = 0;
   const auto& origComps = util::graph::Algorithm::connectedComponents(g);
@@ -107,12 +119,14 @@ OptResStats Optimizer::optimize(RenderGraph* rg) const {
     out.print(g, fstr);
   }
 
+  STATS_MEM(optGraphMem, g.memUsage());
+
   // iterate over components and optimize all of them separately
   const auto& comps = util::graph::Algorithm::connectedComponents(g);
 
   optResStats.numNodes = g.getNumNodes();
   optResStats.numEdges = g.getNumEdges();
-  optResStats.maxLineCard = maxCard(g.getNds());
+  optResStats.maxLineCard = maxCard(g);
   optResStats.solutionSpaceSize = 0;
 
   size_t nonTrivialComponents = 0;
@@ -154,6 +168,13 @@ OptResStats Optimizer::optimize(RenderGraph* rg) const {
   OrderCfg bestCfg;
 
   for (size_t run = 0; run < runs; run++) {
+    // keep the runs done so far if the time budget is used up
+    if (run > 0 && _cfg->deadline.expired()) {
+      optResStats.timedOut = true;
+      runs = run;
+      break;
+    }
+
     OrderCfg c;
     HierarOrderCfg hc;
 
@@ -190,7 +211,12 @@ OptResStats Optimizer::optimize(RenderGraph* rg) const {
       // this is the implementation of the single edge pruning described in the
       // publication - simple skip such components
       // we also skip components with only single edges
-      if (maxC > 1 && nds.size() > 2) {
+      if (maxC > 1 && nds.size() > 2 && _cfg->deadline.expired()) {
+        // no time left, keep the input ordering of the remaining components
+        optResStats.timedOut = true;
+        t += nullOpt.optimizeComp(&g, nds, &hc, 0, optResStats);
+      } else if (maxC > 1 && nds.size() > 2) {
+        STATS_TIMER("loom/optimize-comp");
         t += optimizeComp(&g, nds, &hc, optResStats);
       } else {
         t += nullOpt.optimizeComp(&g, nds, &hc, 0, optResStats);
@@ -246,6 +272,11 @@ OptResStats Optimizer::optimize(RenderGraph* rg) const {
 
     auto optCfg = getOptOrderCfg(c, ndMap, &gg);
 
+    util::stats::MemTrack scoreGraphMem(util::stats::MEM_GRAPH);
+    util::stats::MemTrack orderMem(util::stats::MEM_ORDER_CFG);
+    STATS_MEM(scoreGraphMem, gg.memUsage());
+    STATS_MEM(orderMem, memUsage(optCfg));
+
     double score = _scorer.getCrossingScore(&gg, optCfg);
 
     if (_scorer.optimizeSep()) score += _scorer.getSeparationScore(&gg, optCfg);
@@ -323,7 +354,7 @@ std::vector<LinePair> Optimizer::getLinePairs(OptEdge* segment, bool unique) {
         continue;
       }
 
-      if (loA.line < loB.line) {
+      if (shared::linegraph::LineIdCmp()(loA.line, loB.line)) {
         ret.push_back(LinePair(loA, loB));
       } else {
         ret.push_back(LinePair(loB, loA));
@@ -444,7 +475,7 @@ std::vector<EdgePair> Optimizer::getEdgePartnerPairs(OptNode* node,
 }
 
 // _____________________________________________________________________________
-size_t Optimizer::maxCard(const std::set<OptNode*>& g) {
+size_t Optimizer::maxCard(const OptNodeSet& g) {
   size_t ret = 0;
   for (const auto* n : g) {
     for (const auto* e : n->getAdjList()) {
@@ -457,7 +488,20 @@ size_t Optimizer::maxCard(const std::set<OptNode*>& g) {
 }
 
 // _____________________________________________________________________________
-double Optimizer::numEdges(const std::set<OptNode*>& g) {
+size_t Optimizer::maxCard(const OptGraph& g) {
+  size_t ret = 0;
+  for (const auto* n : g.getNds()) {
+    for (const auto* e : n->getAdjList()) {
+      if (e->getFrom() != n) continue;
+      if (e->pl().getCardinality() > ret) ret = e->pl().getCardinality();
+    }
+  }
+
+  return ret;
+}
+
+// _____________________________________________________________________________
+double Optimizer::numEdges(const OptNodeSet& g) {
   double ret = 0;
   for (const auto* n : g) {
     for (const auto* e : n->getAdjList()) {
@@ -469,7 +513,7 @@ double Optimizer::numEdges(const std::set<OptNode*>& g) {
 }
 
 // _____________________________________________________________________________
-double Optimizer::solutionSpaceSize(const std::set<OptNode*>& g) {
+double Optimizer::solutionSpaceSize(const OptNodeSet& g) {
   double ret = 1;
   for (const auto* n : g) {
     for (const auto* e : n->getAdjList()) {
@@ -481,7 +525,7 @@ double Optimizer::solutionSpaceSize(const std::set<OptNode*>& g) {
 }
 
 // _____________________________________________________________________________
-double Optimizer::optimizeComp(OptGraph* g, const std::set<OptNode*>& cmp,
+double Optimizer::optimizeComp(OptGraph* g, const OptNodeSet& cmp,
                                HierarOrderCfg* c, OptResStats& stats) const {
   return optimizeComp(g, cmp, c, 0, stats);
 }
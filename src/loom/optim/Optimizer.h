@@ -2,6 +2,7 @@
 // Chair of Algorithms and Data Structures.
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
+#include <random>
 #include "loom/config/LoomConfig.h"
 #include "loom/optim/OptGraph.h"
 #include "loom/optim/OptGraphScorer.h"
@@ -30,19 +31,23 @@ struct OptResStats {
   size_t diffSegCrossings;
   size_t separations;
   double score;
+
+  // whether the time budget was used up before all components were
+  // optimized to the end
+  bool timedOut;
 };
 
 class Optimizer {
  public:
   Optimizer(const config::Config* cfg,
             const shared::rendergraph::Penalties& pens)
-      : _cfg(cfg), _scorer(pens){};
+      : _cfg(cfg), _scorer(pens), _rng(cfg->seed){};
 
   virtual OptResStats optimize(shared::rendergraph::RenderGraph* rg) const;
-  double optimizeComp(OptGraph* g, const std::set<OptNode*>& cmp,
+  double optimizeComp(OptGraph* g, const OptNodeSet& cmp,
                    shared::rendergraph::HierarOrderCfg* c,
                    OptResStats& stats) const;
-  virtual double optimizeComp(OptGraph* g, const std::set<OptNode*>& cmp,
+  virtual double optimizeComp(OptGraph* g, const OptNodeSet& cmp,
                            shared::rendergraph::HierarOrderCfg* c,
                            size_t depth, OptResStats& stats) const = 0;
 
@@ -66,14 +71,19 @@ class Optimizer {
 
   static std::vector<OptEdge*> getEdgePartners(OptNode* node, OptEdge* segmentA,
                                                const LinePair& linepair);
-  static size_t maxCard(const std::set<OptNode*>& g);
-  static double solutionSpaceSize(const std::set<OptNode*>& g);
-  static double numEdges(const std::set<OptNode*>& g);
+  static size_t maxCard(const OptNodeSet& g);
+  static size_t maxCard(const OptGraph& g);
+  static double solutionSpaceSize(const OptNodeSet& g);
+  static double numEdges(const OptNodeSet& g);
 
  protected:
   const config::Config* _cfg;
   const OptGraphScorer _scorer;
 
+  // seeded from cfg->seed, so runs with the same seed give the same output
+  // and concurrent runs do not share any random state
+  mutable std::mt19937 _rng;
+
   static std::string prefix(size_t depth);
 
  private:
@@ -3,9 +3,11 @@
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
 #include <algorithm>
+#include <cfloat>
 #include <unordered_map>
 #include "loom/optim/GreedyOptimizer.h"
 #include "loom/optim/SimulatedAnnealingOptimizer.h"
+#include "util/Stats.h"
 #include "util/log/Log.h"
 
 using namespace loom;
@@ -18,12 +20,11 @@ using shared::rendergraph::RenderGraph;
 
 // _____________________________________________________________________________
 double SimulatedAnnealingOptimizer::optimizeComp(OptGraph* og,
-                                              const std::set<OptNode*>& g,
+                                              const OptNodeSet& g,
                                               HierarOrderCfg* hc, size_t depth,
                                               OptResStats& stats) const {
   T_START(1);
   UNUSED(depth);
-  UNUSED(stats);
   OptOrderCfg cur;
 
   // fixed order list of optim graph edges
@@ -42,12 +43,22 @@ double SimulatedAnnealingOptimizer::optimizeComp(OptGraph* og,
     greedy.getFlatConfig(g, &cur);
   }
 
+  // best is at most as large as cur
+  util::stats::MemTrack orderMem(util::stats::MEM_ORDER_CFG);
+  STATS_MEM(orderMem, (1 + _cfg->deadline.limited()) * memUsage(cur));
+
   size_t iters = 0;
 
   size_t k = 0;
 
   size_t ABORT_AFTER_UNCH = 5;
 
+  // under a time budget, remember the best ordering seen, as we may be
+  // interrupted right after accepting a worse one
+  bool anytime = _cfg->deadline.limited();
+  OptOrderCfg best;
+  double bestScore = DBL_MAX;
+
   while (true) {
     iters++;
 
@@ -65,7 +76,7 @@ double SimulatedAnnealingOptimizer::optimizeComp(OptGraph* og,
 
           double s = getScore(og, edges[i], cur);
 
-          double r = rand() / (RAND_MAX + 1.0);
+          double r = std::uniform_real_distribution<double>(0, 1)(_rng);
           double e = exp(-(1.0 * (s - oldScore)) / temp);
 
           if (s < oldScore) {
@@ -87,6 +98,22 @@ double SimulatedAnnealingOptimizer::optimizeComp(OptGraph* og,
     }
 
     if (iters - k > ABORT_AFTER_UNCH) break;
+
+    if (anytime) {
+      double score = _optScorer.optimizeSep()
+                         ? _optScorer.getTotalScore(g, cur)
+                         : _optScorer.getCrossingScore(g, cur);
+      if (score < bestScore) {
+        bestScore = score;
+        best = cur;
+      }
+
+      if (_cfg->deadline.expired()) {
+        stats.timedOut = true;
+        cur = best;
+        break;
+      }
+    }
   }
 
   writeHierarch(&cur, hc);
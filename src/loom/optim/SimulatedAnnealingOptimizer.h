@@ -24,7 +24,7 @@ class SimulatedAnnealingOptimizer : public HillClimbOptimizer {
                               bool randomStart)
       : HillClimbOptimizer(cfg, pens, randomStart){};
 
-  virtual double optimizeComp(OptGraph* og, const std::set<OptNode*>& g,
+  virtual double optimizeComp(OptGraph* og, const OptNodeSet& g,
                            shared::rendergraph::HierarOrderCfg* c,
                            size_t depth, OptResStats& stats) const;
 };
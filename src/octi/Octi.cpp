@@ -0,0 +1,456 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "3rdparty/json.hpp"
+#include "octi/Octi.h"
+#include "octi/Octilinearizer.h"
+#include "octi/combgraph/CombGraph.h"
+#include "shared/linegraph/BinOutput.h"
+#include "util/Misc.h"
+#include "util/Stats.h"
+#include "util/geo/Geo.h"
+#include "util/log/Log.h"
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_num_procs() 1
+#endif
+
+using octi::Octilinearizer;
+using octi::basegraph::BaseGraph;
+using octi::combgraph::CombGraph;
+using octi::combgraph::CombNode;
+using octi::combgraph::Drawing;
+using octi::combgraph::Score;
+using shared::linegraph::LineGraph;
+using util::geo::DPolygon;
+using util::geo::dist;
+
+namespace {
+
+// _____________________________________________________________________________
+double avgStatDist(const LineGraph& g) {
+  double avg = 0;
+  size_t i = 0;
+  for (const auto nd : g.getNds()) {
+    if (nd->getDeg() == 0) continue;
+    i++;
+    double loc = 0;
+    for (const auto edg : nd->getAdjList()) {
+      loc += dist(*nd->pl().getGeom(), *edg->getOtherNd(nd)->pl().getGeom());
+    }
+    avg += loc / nd->getAdjList().size();
+  }
+  avg /= i++;
+  return avg;
+}
+
+// _____________________________________________________________________________
+const CombNode* getCenterNd(const CombGraph* cg) {
+  const CombNode* ret = 0;
+  for (auto nd : cg->getNds()) {
+    if (!ret || LineGraph::getLDeg(nd->pl().getParent()) >
+                    LineGraph::getLDeg(ret->pl().getParent())) {
+      ret = nd;
+    }
+  }
+
+  return ret;
+}
+
+// _____________________________________________________________________________
+util::geo::DBox drawBox(const octi::config::Config* cfg, const octi::Prep& prep,
+                        const CombGraph& cg) {
+  auto box = util::geo::pad(prep.box, prep.gridSize + 1);
+
+  if (cfg->baseGraphType == octi::basegraph::BaseGraphType::ORTHORADIAL ||
+      cfg->baseGraphType == octi::basegraph::BaseGraphType::PSEUDOORTHORADIAL) {
+    auto centerNd = getCenterNd(&cg);
+
+    LOGTO(DEBUG, std::cerr) << "Orthoradial center node is "
+                            << centerNd->pl().getParent()->pl().toString();
+
+    auto cgCtr = *centerNd->pl().getGeom();
+    auto newBox = util::geo::DBox();
+
+    newBox = extendBox(box, newBox);
+    newBox = extendBox(rotate(convexHull(box), 180, cgCtr), newBox);
+    box = newBox;
+  }
+
+  return box;
+}
+
+// _____________________________________________________________________________
+std::vector<DPolygon> readObstacleFile(const std::string& p) {
+  std::vector<DPolygon> ret;
+  std::ifstream s;
+  s.open(p);
+  nlohmann::json j;
+  s >> j;
+
+  if (j["type"] == "FeatureCollection") {
+    for (auto feature : j["features"]) {
+      auto geom = feature["geometry"];
+      if (geom["type"] == "Polygon") {
+        std::vector<std::vector<double>> coords = geom["coordinates"][0];
+        util::geo::Line<double> l;
+        for (auto coord : coords) {
+          l.push_back({coord[0], coord[1]});
+        }
+        ret.push_back(l);
+      }
+    }
+  }
+
+  return ret;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void octi::run(config::Config* cfg, LineGraph* tg, LineGraph* res,
+               BaseGraph** gg, util::json::Dict* stats) {
+  if (cfg->obstaclePath.size()) {
+    LOGTO(DEBUG, std::cerr) << "Reading obstacle file...";
+    cfg->obstacles = readObstacleFile(cfg->obstaclePath);
+    LOGTO(DEBUG, std::cerr) << "Done. (" << cfg->obstacles.size() << " obst.)";
+  }
+
+  Prep prep = prepare(cfg, tg);
+
+  try {
+    draw(cfg, prep, tg, res, gg, stats);
+  } catch (const NoEmbeddingFoundExc& exc) {
+    delete *gg;
+    *gg = 0;
+    throw std::runtime_error(exc.what());
+  } catch (...) {
+    delete *gg;
+    *gg = 0;
+    throw;
+  }
+}
+
+// _____________________________________________________________________________
+octi::Prep octi::prepare(const config::Config* cfg, LineGraph* tg) {
+  STATS_PHASE("octi/prepare");
+  LOGTO(DEBUG, std::cerr) << "Planarizing graph...";
+  T_START(planarize);
+  tg->topologizeIsects();
+  LOGTO(DEBUG, std::cerr) << "Done. (" << T_STOP(planarize) << "ms)";
+
+  Prep prep;
+
+  prep.avgDist = avgStatDist(*tg);
+  LOGTO(DEBUG, std::cerr) << "Average adj. node distance is " << prep.avgDist;
+
+  Octilinearizer oct(cfg->baseGraphType);
+
+  if (util::trim(cfg->gridSize).back() == '%') {
+    double perc = atof(cfg->gridSize.c_str()) / 100;
+    prep.gridSize = prep.avgDist * perc;
+    LOGTO(DEBUG, std::cerr)
+        << "Grid size " << prep.gridSize << " (" << perc * 100 << "%)";
+  } else {
+    prep.gridSize = atof(cfg->gridSize.c_str());
+    LOGTO(DEBUG, std::cerr) << "Grid size " << prep.gridSize;
+  }
+
+  // contract degree 2 nodes without any significance (no station, no exception,
+  // no change in lines
+  tg->contractStrayNds();
+
+  // heuristic: contract all edges shorter than half the grid size
+  tg->contractEdges(prep.gridSize / 2);
+
+  prep.box = tg->getBBox();
+
+  // split nodes that have a larger degree than the max degree of the grid graph
+  // to allow drawing
+  tg->splitNodes(oct.maxNodeDeg());
+
+  return prep;
+}
+
+// _____________________________________________________________________________
+void octi::draw(const config::Config* cfg, const Prep& prep, LineGraph* tg,
+                LineGraph* res, BaseGraph** gg, util::json::Dict* stats) {
+  CombGraph cg(tg, cfg->deg2Heur);
+
+  util::stats::MemTrack graphMem(util::stats::MEM_GRAPH);
+  util::stats::MemTrack geomMem(util::stats::MEM_GEOM);
+  util::stats::MemTrack gridMem(util::stats::MEM_GRID);
+  STATS_MEM(graphMem, tg->memUsage() + cg.memUsage());
+  STATS_MEM(geomMem, tg->geomMemUsage());
+  STATS_MEM(gridMem, tg->gridMemUsage());
+
+  draw(cfg, prep, *tg, cg, res, gg, stats);
+}
+
+namespace {
+// _____________________________________________________________________________
+void drawOn(const octi::config::Config* cfg, const octi::Prep& prep,
+            const LineGraph& tg, const CombGraph& cg,
+            const std::vector<BaseGraph*>* ggs, LineGraph* res, BaseGraph** gg,
+            util::json::Dict* stats) {
+  STATS_PHASE("octi/draw");
+  Octilinearizer oct(cfg->baseGraphType);
+
+  double avgDist = prep.avgDist;
+  auto box = drawBox(cfg, prep, cg);
+
+  Drawing d;
+  Score sc;
+  octi::ilp::ILPStats ilpstats;
+  double time = 0;
+
+  if (ggs) {
+    if (cfg->optMode != "heur") {
+      throw std::runtime_error("Prebuilt base graphs need the heur method");
+    }
+
+    T_START(octi);
+#pragma omp parallel for
+    for (size_t i = 0; i < ggs->size(); i++) (*ggs)[i]->reset(cfg->pens);
+
+    sc = oct.draw(cg, *ggs, res, &d, cfg->maxGrDist, cfg->orderMethod,
+                  cfg->restrLocSearch, cfg->enfGeoPen, cfg->obstacles,
+                  cfg->heurLocSearchIters, cfg->abortAfter, cfg->deadline);
+    *gg = (*ggs)[0];
+    time = T_STOP(octi);
+    LOGTO(DEBUG, std::cerr) << "Schematized using heur approach in " << time
+                            << " ms, score " << sc.full;
+  } else if (cfg->optMode == "ilp") {
+    T_START(octi);
+    sc = oct.drawILP(cg, box, res, gg, &d, cfg->pens, prep.gridSize,
+                     cfg->borderRad, cfg->maxGrDist, cfg->orderMethod,
+                     cfg->ilpNoSolve, cfg->enfGeoPen, cfg->hananIters,
+                     cfg->ilpTimeLimit, cfg->ilpCacheDir,
+                     cfg->ilpCacheThreshold, cfg->ilpNumThreads, &ilpstats,
+                     cfg->ilpSolver, cfg->ilpPath, cfg->deadline);
+    time = T_STOP(octi);
+    LOGTO(DEBUG, std::cerr)
+        << "Schematized using ILP in " << time << " ms, score " << sc.full;
+  } else if ((cfg->optMode == "heur")) {
+    T_START(octi);
+    sc = oct.draw(cg, box, res, gg, &d, cfg->pens, prep.gridSize,
+                  cfg->borderRad, cfg->maxGrDist, cfg->orderMethod,
+                  cfg->restrLocSearch, cfg->enfGeoPen, cfg->hananIters,
+                  cfg->obstacles, cfg->heurLocSearchIters, cfg->abortAfter,
+                  cfg->deadline);
+    time = T_STOP(octi);
+    LOGTO(DEBUG, std::cerr) << "Schematized using heur approach in " << time
+                            << " ms, score " << sc.full;
+  }
+
+  util::json::Dict jsonScore;
+
+  if (cfg->writeStats) {
+    size_t maxRss = util::getPeakRSS();
+    size_t numEdgs = 0;
+    size_t numEdgsComb = 0;
+    size_t numEdgsTg = 0;
+    for (auto nd : (*gg)->getNds()) {
+      numEdgs += nd->getDeg();
+    }
+    for (auto nd : cg.getNds()) {
+      numEdgsComb += nd->getDeg();
+    }
+    for (auto nd : tg.getNds()) {
+      numEdgsTg += nd->getDeg();
+    }
+
+    // translate score to JSON
+    jsonScore = util::json::Dict{
+        {"scores",
+         util::json::Dict{{"total-score", sc.full},
+                          {"topo-violations", util::json::Int(sc.violations)},
+                          {"density-score", sc.dense},
+                          {"bend-score", sc.bend},
+                          {"hop-score", sc.hop},
+                          {"move-score", sc.move}}},
+        {"pens",
+         util::json::Dict{
+             {"density-pen", cfg->pens.densityPen},
+             {"diag-pen", cfg->pens.diagonalPen},
+             {"hori-pen", cfg->pens.horizontalPen},
+             {"vert-pen", cfg->pens.verticalPen},
+             {"180-turn-pen", cfg->pens.p_0},
+             {"135-turn-pen", cfg->pens.p_135},
+             {"90-turn-pen", cfg->pens.p_90},
+             {"45-turn-pen", cfg->pens.p_45},
+         }},
+        {"gridgraph-size", util::json::Dict{{"nodes", (*gg)->getNds().size()},
+                                            {"edges", numEdgs / 2}}},
+        {"combgraph-size", util::json::Dict{{"nodes", cg.getNds().size()},
+                                            {"edges", numEdgsComb / 2}}},
+        {"input-graph-size", util::json::Dict{{"nodes", tg.getNds().size()},
+                                              {"edges", numEdgsTg / 2},
+                                              {"max-deg", tg.maxDeg()}}},
+        {"input-graph-avg-node-dist",
+         avgDist * webMercDistFactor(box.getLowerLeft())},
+        {"area", dist(box.getLowerRight(), box.getLowerLeft()) *
+                     webMercDistFactor(box.getLowerRight()) *
+                     dist(box.getLowerRight(), box.getUpperRight()) *
+                     webMercDistFactor(box.getLowerRight())},
+        {"misc", util::json::Dict{{"method", cfg->optMode},
+                                  {"deg2heur", cfg->deg2Heur},
+                                  {"max-grid-dist", cfg->maxGrDist}}},
+        {"time-ms", time},
+        {"iterations", sc.iters},
+        {"procs", omp_get_num_procs()},
+        {"peak-memory", util::readableSize(maxRss)},
+        {"peak-memory-bytes", maxRss},
+        {"timestamp", util::json::Int(std::time(0))}};
+
+    if (cfg->optMode == "ilp") {
+      jsonScore["ilp"] = util::json::Dict{
+          {"size",
+           util::json::Dict{{"rows", ilpstats.rows}, {"cols", ilpstats.cols}}},
+          {"solve-time", ilpstats.time},
+          {"optimal", util::json::Bool{ilpstats.optimal}}};
+    }
+
+    *stats = util::json::Dict{{"statistics", jsonScore}};
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void octi::draw(const config::Config* cfg, const Prep& prep,
+                const LineGraph& tg, const CombGraph& cg, LineGraph* res,
+                BaseGraph** gg, util::json::Dict* stats) {
+  drawOn(cfg, prep, tg, cg, 0, res, gg, stats);
+}
+
+// _____________________________________________________________________________
+std::vector<BaseGraph*> octi::baseGraphs(const config::Config* cfg,
+                                         const Prep& prep,
+                                         const CombGraph& cg) {
+  Octilinearizer oct(cfg->baseGraphType);
+  return oct.newBaseGraphs(cg, drawBox(cfg, prep, cg), cfg->pens,
+                           prep.gridSize, cfg->borderRad, cfg->hananIters);
+}
+
+// _____________________________________________________________________________
+void octi::draw(const config::Config* cfg, const Prep& prep,
+                const LineGraph& tg, const CombGraph& cg,
+                const std::vector<BaseGraph*>& ggs, LineGraph* res,
+                BaseGraph** gg, util::json::Dict* stats) {
+  drawOn(cfg, prep, tg, cg, &ggs, res, gg, stats);
+}
+
+
+// _____________________________________________________________________________
+void octi::sweep(std::vector<config::Config>* cfgs, const LineGraph& tg,
+                 std::vector<util::json::Dict>* stats) {
+  STATS_PHASE("octi/sweep");
+
+  // the prepared graph, shared by all sets with the same grid size and base
+  // graph, and its combination graphs with and without deg 2 contraction
+  struct Prepared {
+    size_t first;
+    Prep prep;
+    LineGraph tg;
+    std::unique_ptr<CombGraph> cg[2];
+  };
+
+  std::map<std::string, std::vector<DPolygon>> obstacles;
+  std::map<std::pair<std::string, int>, size_t> groupIds;
+  std::vector<std::unique_ptr<Prepared>> groups;
+  std::vector<size_t> group(cfgs->size());
+
+  for (size_t i = 0; i < cfgs->size(); i++) {
+    auto& cfg = (*cfgs)[i];
+    cfg.writeStats = true;
+
+    if (cfg.obstaclePath.size()) {
+      if (!obstacles.count(cfg.obstaclePath)) {
+        obstacles[cfg.obstaclePath] = readObstacleFile(cfg.obstaclePath);
+      }
+      cfg.obstacles = obstacles[cfg.obstaclePath];
+    }
+
+    auto key = std::make_pair(util::trim(cfg.gridSize),
+                              static_cast<int>(cfg.baseGraphType));
+    auto it = groupIds.find(key);
+    if (it == groupIds.end()) {
+      it = groupIds.insert({key, groups.size()}).first;
+      groups.emplace_back(new Prepared());
+      groups.back()->first = i;
+    }
+    group[i] = it->second;
+  }
+
+  LOGTO(DEBUG, std::cerr) << "Preparing " << groups.size() << " graphs for "
+                          << cfgs->size() << " parameter sets...";
+
+  std::stringstream snap;
+  shared::linegraph::BinOutput().print(tg, snap);
+  const std::string snapStr = snap.str();
+
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < groups.size(); i++) {
+    Prepared* p = groups[i].get();
+    std::stringstream s(snapStr);
+    p->tg.readFromBin(&s, 0);
+    p->prep = prepare(&(*cfgs)[p->first], &p->tg);
+  }
+
+  // build the combination graphs sequentially, they are cheap
+  for (size_t i = 0; i < cfgs->size(); i++) {
+    Prepared* p = groups[group[i]].get();
+    bool deg2Heur = (*cfgs)[i].deg2Heur;
+    if (!p->cg[deg2Heur]) {
+      p->cg[deg2Heur].reset(new CombGraph(&p->tg, deg2Heur));
+    }
+  }
+
+  util::stats::MemTrack graphMem(util::stats::MEM_GRAPH);
+  util::stats::MemTrack geomMem(util::stats::MEM_GEOM);
+  util::stats::MemTrack gridMem(util::stats::MEM_GRID);
+  if (util::stats::ENABLED) {
+    size_t graphB = 0, geomB = 0, gridB = 0;
+    for (const auto& p : groups) {
+      graphB += p->tg.memUsage();
+      geomB += p->tg.geomMemUsage();
+      gridB += p->tg.gridMemUsage();
+      for (const auto& cg : p->cg) graphB += cg ? cg->memUsage() : 0;
+    }
+    STATS_MEM(graphMem, graphB);
+    STATS_MEM(geomMem, geomB);
+    STATS_MEM(gridMem, gridB);
+  }
+
+  stats->clear();
+  stats->resize(cfgs->size());
+
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < cfgs->size(); i++) {
+    const auto& cfg = (*cfgs)[i];
+    const Prepared* p = groups[group[i]].get();
+
+    LineGraph res;
+    BaseGraph* gg = 0;
+
+    try {
+      draw(&cfg, p->prep, p->tg, *p->cg[cfg.deg2Heur], &res, &gg,
+           &(*stats)[i]);
+    } catch (const std::exception& exc) {
+      // an exception must not leave the parallel loop, for example if no ILP
+      // solver was found
+      (*stats)[i] = util::json::Dict{{"error", exc.what()}};
+    }
+
+    delete gg;
+  }
+}
@@ -0,0 +1,82 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef OCTI_OCTI_H_
+#define OCTI_OCTI_H_
+
+#include <vector>
+#include "octi/basegraph/BaseGraph.h"
+#include "octi/combgraph/CombGraph.h"
+#include "octi/config/OctiConfig.h"
+#include "shared/linegraph/LineGraph.h"
+#include "util/json/Writer.h"
+
+namespace octi {
+
+// the input graph after planarization and contraction, see prepare()
+struct Prep {
+  double gridSize;
+  double avgDist;
+  util::geo::DBox box;
+};
+
+// planarize tg and contract it for the grid size given in cfg. The result
+// only depends on the grid size and the base graph type, not on the
+// penalties.
+Prep prepare(const config::Config* cfg, shared::linegraph::LineGraph* tg);
+
+// schematize a graph prepared by prepare() into res, gg is set to the base
+// graph used. Throws NoEmbeddingFoundExc if no drawing was found. If
+// cfg->writeStats is set, the score is written to stats.
+void draw(const config::Config* cfg, const Prep& prep,
+          shared::linegraph::LineGraph* tg, shared::linegraph::LineGraph* res,
+          basegraph::BaseGraph** gg, util::json::Dict* stats);
+
+// same as above, but for a combination graph cg built from the prepared graph
+// tg with cfg->deg2Heur. Neither is changed, so both may be shared by
+// concurrent drawings.
+void draw(const config::Config* cfg, const Prep& prep,
+          const shared::linegraph::LineGraph& tg,
+          const combgraph::CombGraph& cg, shared::linegraph::LineGraph* res,
+          basegraph::BaseGraph** gg, util::json::Dict* stats);
+
+// the base graphs for heuristic drawings of a prepared graph, see the draw()
+// below. They depend on the grid size, the base graph type, cfg->hananIters
+// and cg, which is only read here, but not on the penalties. The caller owns
+// them.
+std::vector<basegraph::BaseGraph*> baseGraphs(const config::Config* cfg,
+                                              const Prep& prep,
+                                              const combgraph::CombGraph& cg);
+
+// same as the draw() with cg above, but with the heuristic approach on base
+// graphs built by baseGraphs(), possibly for other penalties or used by earlier
+// drawings. They are reset to cfg->pens first and stay owned by the caller, gg
+// is set to the one holding the drawing.
+void draw(const config::Config* cfg, const Prep& prep,
+          const shared::linegraph::LineGraph& tg,
+          const combgraph::CombGraph& cg,
+          const std::vector<basegraph::BaseGraph*>& ggs,
+          shared::linegraph::LineGraph* res, basegraph::BaseGraph** gg,
+          util::json::Dict* stats);
+
+// schematize tg into res, tg is simplified in place. The base graph used for
+// the drawing is written to gg. If cfg->writeStats is set, the graph-level
+// statistics are written to stats. Throws std::runtime_error if no drawing
+// was found or the drawing failed, gg is then left empty.
+void run(config::Config* cfg, shared::linegraph::LineGraph* tg,
+         shared::linegraph::LineGraph* res, basegraph::BaseGraph** gg,
+         util::json::Dict* stats);
+
+// schematize a copy of tg for every configuration in cfgs, in parallel. Sets
+// with the same grid size and base graph share a single prepare() run, and
+// those which also agree on deg2Heur the combination graph. The statistics
+// of cfgs[i] are written to (*stats)[i], or an "error" if its drawing failed.
+// The obstacle files of the configurations are read here.
+void sweep(std::vector<config::Config>* cfgs,
+           const shared::linegraph::LineGraph& tg,
+           std::vector<util::json::Dict>* stats);
+
+}  // namespace octi
+
+#endif  // OCTI_OCTI_H_
@@ -19,6 +19,7 @@
 #include "octi/basegraph/PseudoOrthoRadialGraph.h"
 #include "octi/combgraph/Drawing.h"
 #include "util/Misc.h"
+#include "util/Stats.h"
 #include "util/geo/output/GeoGraphJsonOutput.h"
 #include "util/graph/BiDijkstra.h"
 #include "util/graph/Dijkstra.h"
@@ -43,6 +44,18 @@ using util::geo::Polygon;
 using util::graph::BiDijkstra;
 using util::graph::Dijkstra;
 
+namespace {
+// _____________________________________________________________________________
+size_t geoPensMemUsage(const GeoPensMap& pens) {
+  // map nodes are roughly 3 pointers, a color and the value
+  size_t ret = 0;
+  for (const auto& p : pens) {
+    ret += 4 * sizeof(void*) + sizeof(p) + p.second.capacity() * sizeof(double);
+  }
+  return ret;
+}
+}  // namespace
+
 // _____________________________________________________________________________
 Score Octilinearizer::drawILP(
     const CombGraph& cg, const util::geo::DBox& box, LineGraph* outTg,
@@ -51,7 +64,8 @@ Score Octilinearizer::drawILP(
     double enfGeoPen, size_t hananIters, int timeLim,
     const std::string& cacheDir, double cacheThreshold, int numThreads,
     octi::ilp::ILPStats* stats, const std::string& solverStr,
-    const std::string& path) {
+    const std::string& path, const util::Deadline& deadline) {
+  STATS_TIMER("octi/ilp");
   BaseGraph* gg;
   Drawing drawing;
 
@@ -67,9 +81,23 @@ Score Octilinearizer::drawILP(
     // important: always use restrLocSearch here!
     auto score = draw(cg, box, &tmpOutTg, &gg, &drawing, pensCpy, gridSize,
                       borderRad, maxGrDist, orderMethod, true, enfGeoPen,
-                      hananIters, {}, 100, std::numeric_limits<size_t>::max());
-    if (score.violations) throw NoEmbeddingFoundExc();
+                      hananIters, {}, 100, std::numeric_limits<size_t>::max(),
+                      deadline);
+    if (score.violations) {
+      delete gg;
+      throw NoEmbeddingFoundExc();
+    }
     LOGTO(DEBUG, std::cerr) << "Presolving finished.";
+
+    if (deadline.expired()) {
+      // no time left for the ILP, take the presolved drawing
+      LOGTO(DEBUG, std::cerr) << "Time budget used up, skipping ILP.";
+      *stats = {score.full, 0, 0, 0, false};
+      drawing.getLineGraph(outTg);
+      *retGg = gg;
+      *dOut = drawing;
+      return score;
+    }
   } catch (const NoEmbeddingFoundExc& exc) {
     LOGTO(DEBUG, std::cerr) << "Presolve was not successful.";
     gg = newBaseGraph(box, cg, gridSize, borderRad, hananIters, pensCpy);
@@ -102,9 +130,14 @@ Score Octilinearizer::drawILP(
 
   ilp::ILPGridOptimizer ilpoptim;
 
-  *stats =
-      ilpoptim.optimize(gg, cg, &drawing, maxGrDist, noSolve, geoPens, timeLim,
-                        cacheDir, cacheThreshold, numThreads, solverStr, path);
+  try {
+    *stats = ilpoptim.optimize(gg, cg, &drawing, maxGrDist, noSolve, geoPens,
+                               deadline.clampTimeLim(timeLim), cacheDir,
+                               cacheThreshold, numThreads, solverStr, path);
+  } catch (...) {
+    delete gg;
+    throw;
+  }
 
   drawing.getLineGraph(outTg);
   *retGg = gg;
@@ -124,7 +157,31 @@ Score Octilinearizer::draw(const CombGraph& cg, const DBox& box,
                            OrderMethod orderMethod, bool restrLocSearch,
                            double enfGeoPen, size_t hananIters,
                            const std::vector<Polygon<double>>& obstacles,
-                           size_t locSearchIters, size_t abortAfter) {
+                           size_t locSearchIters, size_t abortAfter,
+                           const util::Deadline& deadline) {
+  auto ggs = newBaseGraphs(cg, box, pens, gridSize, borderRad, hananIters);
+
+  Score ret;
+  try {
+    ret = draw(cg, ggs, outTg, dOut, maxGrDist, orderMethod, restrLocSearch,
+               enfGeoPen, obstacles, locSearchIters, abortAfter, deadline);
+  } catch (...) {
+    for (auto gg : ggs) delete gg;
+    throw;
+  }
+
+  *retGg = ggs[0];
+
+  // only the first grid graph is handed out
+  for (size_t i = 1; i < ggs.size(); i++) delete ggs[i];
+
+  return ret;
+}
+
+// _____________________________________________________________________________
+std::vector<BaseGraph*> Octilinearizer::newBaseGraphs(
+    const CombGraph& cg, const DBox& box, const Penalties& pens,
+    double gridSize, double borderRad, size_t hananIters) const {
   size_t jobs = 4;
   std::vector<BaseGraph*> ggs(jobs);
 
@@ -132,15 +189,37 @@ Score Octilinearizer::draw(const CombGraph& cg, const DBox& box,
   T_START(ggraph);
 #pragma omp parallel for
   for (size_t i = 0; i < jobs; i++) {
+    STATS_TIMER("octi/base-graph");
     ggs[i] = newBaseGraph(box, cg, gridSize, borderRad, hananIters, pens);
     ggs[i]->init();
   }
 
   LOGTO(DEBUG, std::cerr) << "Done. (" << T_STOP(ggraph) << "ms)";
 
+  return ggs;
+}
+
+// _____________________________________________________________________________
+Score Octilinearizer::draw(const CombGraph& cg,
+                           const std::vector<BaseGraph*>& ggs,
+                           LineGraph* outTg, Drawing* dOut, double maxGrDist,
+                           OrderMethod orderMethod, bool restrLocSearch,
+                           double enfGeoPen,
+                           const std::vector<Polygon<double>>& obstacles,
+                           size_t locSearchIters, size_t abortAfter,
+                           const util::Deadline& deadline) {
+  size_t jobs = ggs.size();
+
   LOGTO(DEBUG, std::cerr) << "Grid graph has " << ggs[0]->getNds().size()
                           << " nodes";
 
+  util::stats::MemTrack graphMem(util::stats::MEM_GRAPH);
+  util::stats::MemTrack gridMem(util::stats::MEM_GRID);
+  util::stats::MemTrack geoPensMem(util::stats::MEM_GEO_PENS);
+  util::stats::MemTrack drawingMem(util::stats::MEM_DRAWING);
+  STATS_MEM(graphMem, jobs * ggs[0]->memUsage());
+  STATS_MEM(gridMem, jobs * ggs[0]->gridMemUsage());
+
   size_t LOCAL_SEARCH_ITERS = locSearchIters;
   double CONVERGENCE_THRESHOLD = 0.05;
 
@@ -158,6 +237,7 @@ Score Octilinearizer::draw(const CombGraph& cg, const DBox& box,
     }
     LOGTO(DEBUG, std::cerr) << "Done. (" << T_STOP(geopens) << "ms)";
     geoPens = &enfGeoPens;
+    STATS_MEM(geoPensMem, geoPensMemUsage(enfGeoPens));
   }
 
   if (obstacles.size()) {
@@ -192,17 +272,22 @@ Score Octilinearizer::draw(const CombGraph& cg, const DBox& box,
 #pragma omp parallel for
   for (size_t btch = 0; btch < jobs; btch++) {
     for (OrderMethod meth : batches[btch]) {
+      double bestScoreSoFar = 0;
+
+#pragma omp critical
+      { bestScoreSoFar = drawing.score(); }
+
+      // once out of time, stop trying further orderings if we already have
+      // a drawing
+      if (bestScoreSoFar != INF && deadline.expired()) break;
+
       T_START(draw);
+      STATS_TIMER("octi/initial-drawing");
       Drawing drawingCp(ggs[btch]);
 
       // get a randomized ordering
       std::vector<CombEdge*> iterOrder = getOrdering(cg, meth);
 
-      double bestScoreSoFar = 0;
-
-#pragma omp critical
-      { bestScoreSoFar = drawing.score(); }
-
       auto status = draw(iterOrder, ggs[btch], &drawingCp, bestScoreSoFar,
                          maxGrDist, geoPens, abortAfter);
 
@@ -228,6 +313,9 @@ Score Octilinearizer::draw(const CombGraph& cg, const DBox& box,
 
   for (size_t i = 0; i < jobs; i++) drawing.applyToGrid(ggs[i]);
 
+  // the best drawing and a working copy per job
+  STATS_MEM(drawingMem, (1 + jobs) * drawing.memUsage());
+
   size_t iters = 0;
 
   LOGTO(DEBUG, std::cerr) << "Initial score: " << drawing.score() << " ("
@@ -246,12 +334,23 @@ Score Octilinearizer::draw(const CombGraph& cg, const DBox& box,
   }
 
   for (; iters < LOCAL_SEARCH_ITERS; iters++) {
+    if (deadline.expired()) {
+      LOGTO(DEBUG, std::cerr) << "Time budget used up after " << iters
+                              << " local search iterations.";
+      break;
+    }
+
     T_START(iter);
+    STATS_TIMER("octi/local-search-iter");
     std::vector<Drawing> bestFrIters(jobs);
 
 #pragma omp parallel for
     for (size_t btch = 0; btch < jobs; btch++) {
+      STATS_TIMER("octi/local-search-batch");
       for (auto a : batchesLoc[btch]) {
+        // the moves found so far are still valid, skip the remaining nodes
+        if (deadline.expired()) break;
+
         Drawing drawingCp = drawing;
 
         // use the batches grid graph
@@ -311,7 +410,7 @@ Score Octilinearizer::draw(const CombGraph& cg, const DBox& box,
       }
     }
 
-    size_t bestCore;
+    size_t bestCore = 0;
     double bestScore = std::numeric_limits<double>::infinity();
     for (size_t i = 0; i < jobs; i++) {
       if (bestFrIters[i].score() < bestScore) {
@@ -320,6 +419,9 @@ Score Octilinearizer::draw(const CombGraph& cg, const DBox& box,
       }
     }
 
+    // the time budget was used up before any move was tried
+    if (bestScore == std::numeric_limits<double>::infinity()) break;
+
     double imp = (drawing.score() - bestFrIters[bestCore].score());
     LOGTO(DEBUG, std::cerr)
         << " ++ Iter " << iters << ", prev " << drawing.score() << ", next "
@@ -343,13 +445,13 @@ Score Octilinearizer::draw(const CombGraph& cg, const DBox& box,
                           << ", mv costs: " << fullScore.move
                           << ", dense costs: " << fullScore.dense;
 
-  *retGg = ggs[0];
   *dOut = drawing;
 
   // the drawing might still have another internal grid graph, make sure they
   // match (this is important for drawILP)
   dOut->setBaseGraph(ggs[0]);
   fullScore.iters = iters;
+
   return fullScore;
 }
 
@@ -14,6 +14,7 @@
 #include "octi/combgraph/Drawing.h"
 #include "octi/config/OctiConfig.h"
 #include "shared/linegraph/LineGraph.h"
+#include "util/Deadline.h"
 #include "util/graph/BiDijkstra.h"
 #include "util/graph/Dijkstra.h"
 
@@ -172,7 +173,23 @@ class Octilinearizer {
              config::OrderMethod orderMethod, bool restrLocSearch,
              double enfGeoCourse, size_t hananIters,
              const std::vector<util::geo::Polygon<double>>& obstacles,
-             size_t locsearchIters, size_t abortAfter);
+             size_t locsearchIters, size_t abortAfter,
+             const util::Deadline& deadline);
+
+  // the base graphs used by draw(), one per parallel job
+  std::vector<basegraph::BaseGraph*> newBaseGraphs(
+      const CombGraph& cg, const util::geo::DBox& box, const Penalties& pens,
+      double gridSize, double borderRad, size_t hananIters) const;
+
+  // same as above, but on base graphs built by newBaseGraphs(), which stay
+  // owned by the caller. The drawing is placed on the first of them.
+  Score draw(const CombGraph& cg,
+             const std::vector<basegraph::BaseGraph*>& ggs, LineGraph* out,
+             Drawing* d, double maxGrDist, config::OrderMethod orderMethod,
+             bool restrLocSearch, double enfGeoCourse,
+             const std::vector<util::geo::Polygon<double>>& obstacles,
+             size_t locsearchIters, size_t abortAfter,
+             const util::Deadline& deadline);
 
   Score drawILP(const CombGraph& cg, const util::geo::DBox& box, LineGraph* out,
                 basegraph::BaseGraph** gg, Drawing* d, const Penalties& pens,
@@ -181,7 +198,8 @@ class Octilinearizer {
                 double enfGeoPens, size_t hananIters, int timeLim,
                 const std::string& cacheDir, double cacheThreshold,
                 int numThreads, octi::ilp::ILPStats* stats,
-                const std::string& solverStr, const std::string& path);
+                const std::string& solverStr, const std::string& path,
+                const util::Deadline& deadline);
 
   size_t maxNodeDeg() const;
 
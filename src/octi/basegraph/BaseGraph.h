@@ -73,13 +73,17 @@ struct Penalties {
   double ndMovePen = 0.5;
 };
 
-class BaseGraph : public DirGraph<GridNodePL, GridEdgePL> {
+class BaseGraph
+    : public DirGraph<GridNodePL, GridEdgePL, util::graph::PoolAlloc> {
  public:
   BaseGraph(){};
 
   virtual void init() = 0;
   virtual double getCellSize() const = 0;
 
+  // approximate bytes held by the spatial index of the grid nodes
+  virtual size_t gridMemUsage() const = 0;
+
   virtual NodeCost nodeBendPen(GridNode* n, CombNode* origNode,
                                CombEdge* e) = 0;
   virtual NodeCost topoBlockPen(GridNode* n, CombNode* origNode,
@@ -124,6 +128,8 @@ class BaseGraph : public DirGraph<GridNodePL, GridEdgePL> {
 
   virtual GridEdge* getNEdg(const GridNode* a, const GridNode* b) const = 0;
   virtual void reset() = 0;
+  // reset to the state after init() under other penalties, without obstacles
+  virtual void reset(const Penalties& pens) = 0;
 
   virtual GridNode* getSettled(const CombNode* cnd) const = 0;
   virtual bool unused(const GridNode* gnd) const = 0;
@@ -34,6 +34,14 @@ GridGraph::GridGraph(const DBox& bbox, double cellSize, double spacer,
       _cellSize(cellSize),
       _spacer(spacer),
       _edgeCount(0) {
+  initPens();
+
+  // cut off illegal spacer values
+  if (spacer > cellSize / 2) _spacer = cellSize / 2;
+}
+
+// _____________________________________________________________________________
+void GridGraph::initPens() {
   assert(_c.p_0 <= _c.p_135);
   assert(_c.p_135 <= _c.p_90);
   assert(_c.p_90 <= _c.p_45);
@@ -41,9 +49,6 @@ GridGraph::GridGraph(const DBox& bbox, double cellSize, double spacer,
   _bendCosts[0] = _c.p_45 - _c.p_135;
   _bendCosts[1] = _c.p_45 - _c.p_135 + _c.p_90;
 
-  // cut off illegal spacer values
-  if (spacer > cellSize / 2) _spacer = cellSize / 2;
-
   _heurHopCost = _c.p_45 - _c.p_135;
 }
 
@@ -819,6 +824,43 @@ void GridGraph::reset() {
   reWriteObstCosts();
 }
 
+// _____________________________________________________________________________
+void GridGraph::reset(const Penalties& pens) {
+  _c = pens;
+  initPens();
+  _obstacles.clear();
+
+  for (auto n : getNds()) {
+    n->pl().setSettled(false);
+    for (auto e : n->getAdjListOut()) {
+      e->pl().open();
+      e->pl().unblock();
+    }
+
+    if (n->pl().getParent() != n) continue;
+
+    // rewrite the in-node bend costs, connections closed at the grid border
+    // stay closed
+    for (size_t i = 0; i < maxDeg(); i++) {
+      auto portA = n->pl().getPort(i);
+      if (!portA) continue;
+      for (size_t j = i + 1; j < maxDeg(); j++) {
+        auto portB = n->pl().getPort(j);
+        if (!portB) continue;
+        auto e = getEdg(portA, portB);
+        auto f = getEdg(portB, portA);
+
+        if (e->pl().rawCost() == INF) continue;
+
+        e->pl().setCost(getBendPen(i, j));
+        f->pl().setCost(getBendPen(i, j));
+      }
+    }
+  }
+
+  reset();
+}
+
 // _____________________________________________________________________________
 void GridGraph::reWriteObstCosts() {
   for (const auto& obst : _obstacles) writeObstacleCost(obst);
@@ -864,6 +906,9 @@ PolyLine<double> GridGraph::geomFromPath(
 // _____________________________________________________________________________
 double GridGraph::getCellSize() const { return _cellSize; }
 
+// _____________________________________________________________________________
+size_t GridGraph::gridMemUsage() const { return _grid.memUsage(); }
+
 // _____________________________________________________________________________
 size_t GridGraph::getGrNdDeg(const CombNode* nd, size_t x, size_t y) const {
   auto grNd = getNode(x, y);
@@ -37,6 +37,8 @@ class GridGraph : public BaseGraph {
 
   virtual double getCellSize() const;
 
+  virtual size_t gridMemUsage() const;
+
   virtual NodeCost nodeBendPen(GridNode* n, CombNode* origNd, CombEdge* e);
   virtual NodeCost topoBlockPen(GridNode* n, CombNode* origNode, CombEdge* e);
   virtual NodeCost spacingPen(GridNode* n, CombNode* origNode, CombEdge* e);
@@ -74,6 +76,7 @@ class GridGraph : public BaseGraph {
   virtual GridEdge* getNEdg(const GridNode* a, const GridNode* b) const;
   virtual void init();
   virtual void reset();
+  virtual void reset(const Penalties& pens);
 
   virtual GridNode* getSettled(const CombNode* cnd) const;
 
@@ -123,6 +126,9 @@ class GridGraph : public BaseGraph {
 
   const Grid<GridNode*, Point, double>& getGrid() const;
 
+  // derive the bend and heuristic costs from _c
+  virtual void initPens();
+
   virtual void writeInitialCosts();
   virtual void writeObstacleCost(const util::geo::Polygon<double>& obst);
   virtual void reWriteObstCosts();
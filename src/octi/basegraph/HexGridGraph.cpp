@@ -270,6 +270,15 @@ std::vector<double> HexGridGraph::getCosts() const {
   return ret;
  }
 
+// _____________________________________________________________________________
+void HexGridGraph::initPens() {
+  GridGraph::initPens();
+
+  _bendCosts[0] = _c.p_45 - _c.p_135;
+  _bendCosts[2] = _c.p_45;
+  _bendCosts[1] = _bendCosts[0] + _bendCosts[2];
+}
+
 // _____________________________________________________________________________
 double HexGridGraph::getBendPen(size_t i, size_t j) const {
   return _bendCosts[ang(i, j)];
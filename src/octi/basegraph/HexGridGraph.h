@@ -22,9 +22,7 @@ class HexGridGraph : public GridGraph {
     _h = _a * A;
     _grid = Grid<GridNode*, Point, double>(_a, _h, bbox, false);
 
-    _bendCosts[0] = _c.p_45 - _c.p_135;
-    _bendCosts[2] = _c.p_45;
-    _bendCosts[1] = _bendCosts[0] + _bendCosts[2];
+    initPens();
   }
 
   virtual void init();
@@ -35,6 +33,7 @@ class HexGridGraph : public GridGraph {
   virtual std::vector<double> getCosts() const;
 
  protected:
+  virtual void initPens();
   virtual void writeInitialCosts();
   virtual double getBendPen(size_t i, size_t j) const;
   virtual GridNode* writeNd(size_t x, size_t y);
@@ -82,6 +82,45 @@ size_t OctiGridGraph::ang(size_t i, size_t j) const {
   return ang;
 }
 
+// _____________________________________________________________________________
+void OctiGridGraph::initPens() {
+  GridGraph::initPens();
+
+  _bendCosts[0] = _c.p_45 - _c.p_135;
+  _bendCosts[3] = _c.p_45;
+  _bendCosts[2] = _c.p_45 - _c.p_135 + _c.p_90;
+  _bendCosts[1] = _bendCosts[0] + _bendCosts[3];
+
+  // prepare the octigrid A* heuristic
+  _heurXCost = _c.horizontalPen + _heurHopCost;
+  _heurYCost = _c.verticalPen + _heurHopCost;
+  _heurDiagCost = _c.diagonalPen + _heurHopCost;
+
+  if (_heurDiagCost < _heurXCost) {
+    // 1) two horizontal hops may be substituted by two diagonal hops
+    // 2) a horizontal hop may be subsituted by a diagonal + a vertical hop
+    // in both cases, _heurDiagCost is admissable
+    _heurXCost = _heurDiagCost;
+  }
+
+  if (_heurDiagCost < _heurYCost) {
+    // 1) two vertical hops may be substituted by two diagonal hops
+    // 2) a vertical hop may be subsituted by a diagonal + a horizontal hop
+    // in both cases, _heurDiagCost is admissable
+    _heurYCost = _heurDiagCost;
+  }
+
+  if (_heurDiagCost > _heurXCost + _heurYCost) {
+    // if the diagonal cost is greater than the horizontal plus the
+    // vertical, we can never save something by going diagonal
+    _heurDiagSave = 0;
+  } else {
+    // else, we save one x hop and one y hop at the cost of one
+    // diagonal hop
+    _heurDiagSave = _heurDiagCost - _heurXCost - _heurYCost;
+  }
+}
+
 // _____________________________________________________________________________
 double OctiGridGraph::getBendPen(size_t i, size_t j) const {
   return _bendCosts[ang(i, j)];
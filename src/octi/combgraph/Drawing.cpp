@@ -39,6 +39,23 @@ uint64_t Drawing::violations() const { return _violations; }
 // _____________________________________________________________________________
 void Drawing::setBaseGraph(const BaseGraph* gg) { _gg = gg; }
 
+// _____________________________________________________________________________
+size_t Drawing::memUsage() const {
+  // a map node holds 3 pointers and the color besides the key and the value
+  const size_t mapNd = 4 * sizeof(void*) + sizeof(void*);
+
+  size_t ret = _nds.size() * (mapNd + sizeof(size_t));
+  for (const auto& e : _edgs) {
+    ret += mapNd + sizeof(GrPath) +
+           e.second.capacity() * sizeof(std::pair<size_t, size_t>);
+  }
+
+  ret += (_ndReachCosts.size() + _ndBndCosts.size() + _edgCosts.size() +
+          _springCosts.size()) *
+         (mapNd + sizeof(double));
+  return ret + _vios.size() * (mapNd + sizeof(int));
+}
+
 // _____________________________________________________________________________
 Score Drawing::fullScore() const {
   Score ret{0, 0, 0, 0, 0, 0};
@@ -538,7 +555,8 @@ double Drawing::recalcBends(const CombNode* nd) {
 bool Drawing::drawn(const CombEdge* ce) const { return _edgs.count(ce); }
 
 // _____________________________________________________________________________
-const std::map<const CombEdge*, GrPath>& Drawing::getEdgPaths() const {
+const std::map<const CombEdge*, GrPath, util::graph::IdCmp<CombEdge>>&
+Drawing::getEdgPaths() const {
   return _edgs;
 }
 
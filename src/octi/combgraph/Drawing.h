@@ -78,6 +78,9 @@ class Drawing {
   double rawScore() const;
   uint64_t violations() const;
   Score fullScore() const;
+
+  // estimated bytes used by the drawing
+  size_t memUsage() const;
   void crumble();
 
   void draw(CombEdge* ce, const GrEdgList& ge, bool rev);
@@ -104,11 +107,13 @@ class Drawing {
 
   void setBaseGraph(const BaseGraph* gg);
 
-  const std::map<const CombEdge*, GrPath>& getEdgPaths() const;
+  const std::map<const CombEdge*, GrPath, util::graph::IdCmp<CombEdge>>&
+  getEdgPaths() const;
 
  private:
-  std::map<const CombNode*, size_t> _nds;
-  std::map<const CombEdge*, GrPath> _edgs;
+  // ordered by id, the line graph is extracted in this order
+  std::map<const CombNode*, size_t, util::graph::IdCmp<CombNode>> _nds;
+  std::map<const CombEdge*, GrPath, util::graph::IdCmp<CombEdge>> _edgs;
 
   std::map<const CombNode*, double> _ndReachCosts;
   std::map<const CombNode*, double> _ndBndCosts;
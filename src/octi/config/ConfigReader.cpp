@@ -5,11 +5,13 @@
 
 #include <float.h>
 #include <getopt.h>
+#include <unistd.h>
 #include <exception>
 #include <iostream>
 #include <string>
 #include "octi/_config.h"
 #include "octi/config/ConfigReader.h"
+#include "util/json/Writer.h"
 #include "util/log/Log.h"
 
 using octi::config::ConfigReader;
@@ -72,8 +74,24 @@ void ConfigReader::help(const char* bin) const {
             << "Will fall back if not available.\n"
             << std::setw(36) << "  --stats"
             << "write stats to output graph\n"
+            << std::setw(36) << "  --trace-file arg"
+            << "write a Chrome trace of the run to this file\n"
+            << std::setw(36) << "  --time-budget arg (=-1)"
+            << "wall-clock budget in seconds, -1 for none\n"
+            << std::setw(36) << "  --sweep arg"
+            << "run every parameter set in this file in\n"
+            << std::setw(36) << " "
+            << " parallel, write their stats as JSON lines\n"
             << std::setw(36) << "  -D [ --from-dot ]"
             << "input is in dot format\n"
+            << std::setw(36) << "  --in-format arg (=geojson)"
+            << "input format, either geojson or bin\n"
+            << std::setw(36) << "  --input arg"
+            << "read input from this file instead of stdin\n"
+            << std::setw(36) << "  --out-format arg (=geojson)"
+            << "output format, either geojson or bin\n"
+            << std::setw(36) << "  --out-precision arg (=10)"
+            << "decimals of GeoJSON coordinates, -1 for shortest exact\n"
             << std::setw(36) << "  --no-deg2-heur"
             << "don't contract degree 2 nodes\n"
             << std::setw(36) << "  --geo-pen arg (=0)"
@@ -143,6 +161,13 @@ void ConfigReader::read(Config* cfg, int argc, char** argv) const {
                          {"pen-45", required_argument, 0, 23},
                          {"nd-move-pen", required_argument, 0, 24},
                          {"abort-after", required_argument, 0, 'a'},
+                         {"in-format", required_argument, 0, 25},
+                         {"out-format", required_argument, 0, 26},
+                         {"out-precision", required_argument, 0, 27},
+                         {"input", required_argument, 0, 28},
+                         {"trace-file", required_argument, 0, 29},
+                         {"time-budget", required_argument, 0, 30},
+                         {"sweep", required_argument, 0, 31},
                          {0, 0, 0, 0}};
 
   char c;
@@ -231,6 +256,28 @@ void ConfigReader::read(Config* cfg, int argc, char** argv) const {
       case 24:
         cfg->pens.ndMovePen= atof(optarg);
         break;
+      case 25:
+        cfg->inFormat = optarg;
+        break;
+      case 26:
+        cfg->outFormat = optarg;
+        break;
+      case 27:
+        cfg->outPrecision = atoi(optarg) < 0 ? util::json::PREC_SHORTEST
+                                               : atoi(optarg);
+        break;
+      case 28:
+        cfg->inputFile = optarg;
+        break;
+      case 29:
+        cfg->traceFile = optarg;
+        break;
+      case 30:
+        cfg->deadline = util::Deadline(atof(optarg));
+        break;
+      case 31:
+        cfg->sweepFile = optarg;
+        break;
       case 'g':
         cfg->gridSize = optarg;
         break;
@@ -301,4 +348,26 @@ void ConfigReader::read(Config* cfg, int argc, char** argv) const {
     LOG(ERROR) << "Unknown base graph type " << baseGraphStr << std::endl;
     exit(0);
   }
+
+  if (cfg->inFormat != "geojson" && cfg->inFormat != "bin") {
+    LOG(ERROR) << "Unknown input format " << cfg->inFormat
+               << ", must be one of {geojson, bin}";
+    exit(1);
+  }
+
+  if (!cfg->inputFile.empty() && access(cfg->inputFile.c_str(), R_OK) != 0) {
+    LOG(ERROR) << "Cannot read input file " << cfg->inputFile;
+    exit(1);
+  }
+
+  if (!cfg->sweepFile.empty() && access(cfg->sweepFile.c_str(), R_OK) != 0) {
+    LOG(ERROR) << "Cannot read parameter set file " << cfg->sweepFile;
+    exit(1);
+  }
+
+  if (cfg->outFormat != "geojson" && cfg->outFormat != "bin") {
+    LOG(ERROR) << "Unknown output format " << cfg->outFormat
+               << ", must be one of {geojson, bin}";
+    exit(1);
+  }
 }
@@ -9,6 +9,7 @@
 #include "octi/basegraph/BaseGraph.h"
 #include "octi/basegraph/GridGraph.h"
 #include "util/geo/Geo.h"
+#include "util/Deadline.h"
 
 namespace octi {
 namespace config {
@@ -31,6 +32,27 @@ struct Config {
   std::string optMode = "heur";
   std::string ilpPath;
   bool fromDot = false;
+
+  // read the input from this file instead of stdin
+  std::string inputFile;
+
+  // write a Chrome trace-event file of the instrumented phases here
+  std::string traceFile;
+
+  // read parameter sets from this file and run them all, see --sweep
+  std::string sweepFile;
+
+  // wall-clock budget of the run, see --time-budget
+  util::Deadline deadline;
+
+  // either geojson or bin
+  std::string inFormat = "geojson";
+  std::string outFormat = "geojson";
+
+  // decimals of GeoJSON output coordinates, util::json::PREC_SHORTEST for
+  // the shortest exact representation
+  size_t outPrecision = 10;
+
   bool deg2Heur = true;
   bool restrLocSearch = false;
   double enfGeoPen = 0;
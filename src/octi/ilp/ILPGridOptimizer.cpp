@@ -6,6 +6,7 @@
 #include "octi/basegraph/BaseGraph.h"
 #include "octi/ilp/ILPGridOptimizer.h"
 #include "shared/optim/ILPSolvProv.h"
+#include "util/Stats.h"
 #include "util/geo/output/GeoGraphJsonOutput.h"
 #include "util/log/Log.h"
 
@@ -53,6 +54,9 @@ ILPStats ILPGridOptimizer::optimize(BaseGraph* gg, const CombGraph& cg,
   s.cols = lp->getNumVars();
   s.rows = lp->getNumConstrs();
 
+  util::stats::MemTrack ilpMem(util::stats::MEM_ILP);
+  STATS_MEM(ilpMem, lp->memUsage());
+
   lp->setStarter(sol);
 
   if (path.size()) {
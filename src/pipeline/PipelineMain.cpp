@@ -0,0 +1,302 @@
+// Copyright 2016
+// University of Freiburg - Chair of Algorithms and Datastructures
+// Author: Patrick Brosi
+
+#include <getopt.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "loom/Loom.h"
+#include "loom/config/ConfigReader.h"
+#include "octi/Octi.h"
+#include "octi/config/ConfigReader.h"
+#include "shared/linegraph/BinOutput.h"
+#include "shared/linegraph/JsonOutput.h"
+#include "shared/linegraph/LineGraph.h"
+#include "shared/rendergraph/RenderGraph.h"
+#include "topo/Topo.h"
+#include "topo/config/ConfigReader.h"
+#include "transitmap/TransitMap.h"
+#include "transitmap/config/ConfigReader.h"
+#include "util/Misc.h"
+#include "util/Stats.h"
+#include "util/geo/output/GeoGraphJsonOutput.h"
+#include "util/json/Writer.h"
+#include "util/log/Log.h"
+
+using shared::linegraph::LineGraph;
+using shared::rendergraph::RenderGraph;
+
+// a single tool stage, only the config of its tool is set
+struct Stage {
+  std::string name;
+  std::unique_ptr<topo::config::TopoConfig> topo;
+  std::unique_ptr<loom::config::Config> loom;
+  std::unique_ptr<octi::config::Config> octi;
+  std::unique_ptr<transitmapper::config::Config> transitmap;
+};
+
+// _____________________________________________________________________________
+void usage(const char* name) {
+  std::cerr << "Usage: " << name
+            << " <stage> [stage options] [:: <stage> [stage options]]...\n\n"
+            << "Runs the given stages on a single in-memory graph, reading the\n"
+            << "input of the first stage from stdin and writing the output of\n"
+            << "the last stage to stdout. The result is the same as piping\n"
+            << "the standalone tools. Stages are topo, loom, octi and\n"
+            << "transitmap, the latter must be the last stage. Use\n"
+            << "'<stage> --help' for the options of a stage. The time\n"
+            << "budgets of all stages count from the start of the pipeline."
+            << std::endl;
+}
+
+// _____________________________________________________________________________
+Stage readStage(std::vector<char*> args) {
+  Stage s;
+  s.name = args[0];
+
+  // the config readers all use getopt, reset it for each stage
+  optind = 0;
+
+  if (s.name == "topo") {
+    s.topo.reset(new topo::config::TopoConfig());
+    topo::config::ConfigReader().read(s.topo.get(), args.size(), &args[0]);
+  } else if (s.name == "loom") {
+    s.loom.reset(new loom::config::Config());
+    loom::config::ConfigReader().read(s.loom.get(), args.size(), &args[0]);
+  } else if (s.name == "octi") {
+    s.octi.reset(new octi::config::Config());
+    octi::config::ConfigReader().read(s.octi.get(), args.size(), &args[0]);
+  } else if (s.name == "transitmap") {
+    s.transitmap.reset(new transitmapper::config::Config());
+    transitmapper::config::ConfigReader().read(s.transitmap.get(), args.size(),
+                                               &args[0]);
+  } else {
+    LOG(ERROR) << "Unknown stage '" << s.name << "'";
+    exit(1);
+  }
+
+  return s;
+}
+
+// _____________________________________________________________________________
+bool writeStats(const Stage& s) {
+  if (s.topo) return s.topo->outputStats;
+  if (s.loom) return s.loom->outputStats;
+  if (s.octi) return s.octi->writeStats;
+  return s.transitmap->writeStats;
+}
+
+// _____________________________________________________________________________
+const std::string& traceFile(const Stage& s) {
+  if (s.topo) return s.topo->traceFile;
+  if (s.loom) return s.loom->traceFile;
+  if (s.octi) return s.octi->traceFile;
+  return s.transitmap->traceFile;
+}
+
+// _____________________________________________________________________________
+void readInput(LineGraph* g, LineGraph* prev, bool fromDot,
+               const std::string& inFormat, const std::string& inputFile,
+               double smooth) {
+  if (prev) {
+    g->readFromGraph(prev, smooth);
+  } else if (!inputFile.empty()) {
+    g->readFromFile(inputFile, fromDot ? "dot" : inFormat, smooth);
+  } else if (fromDot) {
+    g->readFromDot(&std::cin, smooth);
+  } else if (inFormat == "bin") {
+    g->readFromBin(&std::cin, smooth);
+  } else {
+    g->readFromJson(&std::cin, smooth);
+  }
+}
+
+// _____________________________________________________________________________
+void writeOutput(const LineGraph& g, const std::string& outFormat,
+                 size_t outPrecision, bool writeStats,
+                 const util::json::Dict& stats) {
+  shared::linegraph::JsonOutput out(outPrecision);
+  shared::linegraph::BinOutput binOut;
+
+  if (writeStats) {
+    if (outFormat == "bin") {
+      binOut.print(g, std::cout, stats);
+    } else {
+      out.print(g, std::cout, stats);
+    }
+  } else {
+    if (outFormat == "bin") {
+      binOut.print(g, std::cout);
+    } else {
+      out.print(g, std::cout);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+int main(int argc, char** argv) {
+  // disable output buffering for standard output
+  setbuf(stdout, NULL);
+
+  // write log messages to stderr from a background thread
+  util::AsyncLog::start(&std::cerr);
+
+  // initialize randomness
+  srand(time(NULL) + rand());
+
+  if (argc < 2) {
+    usage(argv[0]);
+    exit(1);
+  }
+
+  // parse all stage configs before doing any work
+  std::vector<Stage> stages;
+  std::vector<char*> args;
+  for (int i = 1; i <= argc; i++) {
+    if (i == argc || std::string(argv[i]) == "::") {
+      if (args.empty()) {
+        usage(argv[0]);
+        exit(1);
+      }
+      stages.push_back(readStage(args));
+      args.clear();
+    } else {
+      args.push_back(argv[i]);
+    }
+  }
+
+  for (size_t i = 0; i + 1 < stages.size(); i++) {
+    if (stages[i].transitmap) {
+      LOG(ERROR) << "transitmap must be the last stage.";
+      exit(1);
+    }
+    if (stages[i].octi && stages[i].octi->printMode == "gridgraph") {
+      LOG(ERROR) << "octi can only print the grid graph as the last stage.";
+      exit(1);
+    }
+  }
+
+  // instrumentation is process-wide, it covers all stages if any stage
+  // asks for it
+  for (const auto& s : stages) {
+    if (writeStats(s) || !traceFile(s).empty()) util::stats::enable();
+  }
+
+  // the graph handed from stage to stage
+  std::unique_ptr<LineGraph> g;
+
+  for (size_t i = 0; i < stages.size(); i++) {
+    Stage& s = stages[i];
+    bool last = i + 1 == stages.size();
+    util::json::Dict stats;
+
+    T_START(stage);
+
+    if (s.topo) {
+      std::unique_ptr<LineGraph> tg(new LineGraph());
+      readInput(tg.get(), g.get(), false, s.topo->inFormat,
+                s.topo->inputFile, 0);
+      topo::run(s.topo.get(), tg.get(), &stats);
+      g = std::move(tg);
+
+      if (last && s.topo->outputStats) {
+        stats["instrumentation"] = util::stats::toJson();
+      }
+
+      if (last) {
+        writeOutput(*g, s.topo->outFormat, s.topo->outPrecision,
+                    s.topo->outputStats, stats);
+      }
+    } else if (s.loom) {
+      std::unique_ptr<RenderGraph> rg(new RenderGraph(5, 5));
+      readInput(rg.get(), g.get(), s.loom->fromDot, s.loom->inFormat,
+                s.loom->inputFile, 3);
+      try {
+        loom::run(s.loom.get(), rg.get(), &stats);
+      } catch (const std::runtime_error& e) {
+        LOG(ERROR) << e.what();
+        return 1;
+      }
+      g = std::move(rg);
+
+      if (last && s.loom->outputStats) {
+        stats["instrumentation"] = util::stats::toJson();
+      }
+
+      if (last) {
+        writeOutput(*g, s.loom->outFormat, s.loom->outPrecision,
+                    s.loom->outputStats, stats);
+      }
+    } else if (s.octi) {
+      LineGraph tg;
+      std::unique_ptr<LineGraph> res(new LineGraph());
+      octi::basegraph::BaseGraph* ggPtr = 0;
+      readInput(&tg, g.get(), s.octi->fromDot, s.octi->inFormat,
+                s.octi->inputFile, 0);
+      try {
+        octi::run(s.octi.get(), &tg, res.get(), &ggPtr, &stats);
+      } catch (const std::runtime_error& e) {
+        LOG(ERROR) << e.what();
+        return 1;
+      }
+      // the grid graph is only needed for the output of this stage
+      std::unique_ptr<octi::basegraph::BaseGraph> gg(ggPtr);
+      g = std::move(res);
+
+      if (last && s.octi->writeStats) {
+        stats["instrumentation"] = util::stats::toJson();
+      }
+
+      if (last && s.octi->printMode == "gridgraph") {
+        util::geo::output::GeoGraphJsonOutput out;
+        if (s.octi->writeStats) {
+          out.print(*gg, std::cout, stats);
+        } else {
+          out.print(*gg, std::cout);
+        }
+      } else if (last) {
+        writeOutput(*g, s.octi->outFormat, s.octi->outPrecision,
+                    s.octi->writeStats, stats);
+      }
+    } else if (s.transitmap) {
+      std::unique_ptr<RenderGraph> rg(new RenderGraph(
+          s.transitmap->lineWidth, s.transitmap->lineSpacing));
+      readInput(rg.get(), g.get(), s.transitmap->fromDot,
+                s.transitmap->inFormat, s.transitmap->inputFile,
+                s.transitmap->inputSmoothing);
+      try {
+        transitmapper::run(s.transitmap.get(), rg.get(), &std::cout);
+      } catch (const std::runtime_error& e) {
+        LOG(ERROR) << e.what();
+        return 1;
+      }
+      g = std::move(rg);
+
+      if (s.transitmap->writeStats) {
+        util::json::Writer wr(&std::cerr, 3, true);
+        wr.val(util::stats::toJson());
+        wr.closeAll();
+        std::cerr << std::endl;
+      }
+    }
+
+    LOGTO(INFO, std::cerr) << "Stage " << i + 1 << " (" << s.name << ") took "
+                           << T_STOP(stage) << "ms, RSS "
+                           << util::readableSize(util::getCurrentRSS())
+                           << ", peak RSS "
+                           << util::readableSize(util::getPeakRSS());
+  }
+
+  for (const auto& s : stages) {
+    if (!traceFile(s).empty() && !util::stats::writeTrace(traceFile(s))) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <iterator>
+#include "server/BaseGraphPool.h"
+
+using server::BaseGraphPool;
+using server::BaseGraphs;
+
+// _____________________________________________________________________________
+BaseGraphPool::BaseGraphPool(size_t maxBytes)
+    : _maxBytes(maxBytes), _bytes(0), _hits(0), _misses(0) {}
+
+// _____________________________________________________________________________
+BaseGraphs BaseGraphPool::take(const std::string& key) {
+  std::unique_lock<std::mutex> lock(_mut);
+  for (auto i = _entries.begin(); i != _entries.end(); i++) {
+    if (i->key != key) continue;
+    _hits++;
+    BaseGraphs ret = std::move(i->ggs);
+    _bytes -= i->bytes;
+    _entries.erase(i);
+    return ret;
+  }
+
+  _misses++;
+  return BaseGraphs();
+}
+
+// _____________________________________________________________________________
+void BaseGraphPool::put(const std::string& key, BaseGraphs ggs) {
+  size_t bytes = 0;
+  for (const auto& gg : ggs) bytes += gg->memUsage() + gg->gridMemUsage();
+
+  // dropped sets are freed after the lock is released
+  std::list<Entry> dropped;
+
+  std::unique_lock<std::mutex> lock(_mut);
+  _entries.push_front({key, std::move(ggs), bytes});
+  _bytes += bytes;
+
+  while (_bytes > _maxBytes && !_entries.empty()) {
+    _bytes -= _entries.back().bytes;
+    dropped.splice(dropped.begin(), _entries, std::prev(_entries.end()));
+  }
+  lock.unlock();
+}
+
+// _____________________________________________________________________________
+size_t BaseGraphPool::size() const {
+  std::unique_lock<std::mutex> lock(_mut);
+  return _entries.size();
+}
+
+// _____________________________________________________________________________
+size_t BaseGraphPool::bytes() const {
+  std::unique_lock<std::mutex> lock(_mut);
+  return _bytes;
+}
+
+// _____________________________________________________________________________
+size_t BaseGraphPool::hits() const {
+  std::unique_lock<std::mutex> lock(_mut);
+  return _hits;
+}
+
+// _____________________________________________________________________________
+size_t BaseGraphPool::misses() const {
+  std::unique_lock<std::mutex> lock(_mut);
+  return _misses;
+}
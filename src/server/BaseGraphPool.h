@@ -0,0 +1,59 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef SERVER_BASEGRAPHPOOL_H_
+#define SERVER_BASEGRAPHPOOL_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "octi/basegraph/BaseGraph.h"
+
+namespace server {
+
+typedef std::vector<std::unique_ptr<octi::basegraph::BaseGraph>> BaseGraphs;
+
+// thread-safe pool of built octi base graphs, bounded by their total memory
+// usage. Other than the snapshots, base graphs are changed by a drawing, so a
+// set is taken out of the pool for a drawing and put back afterwards. Two
+// concurrent drawings thus never share a set, the second one builds its own.
+class BaseGraphPool {
+ public:
+  explicit BaseGraphPool(size_t maxBytes);
+
+  // take a set of base graphs for key out of the pool, empty if there is none
+  BaseGraphs take(const std::string& key);
+
+  // put a set of base graphs for key (back) into the pool, the least
+  // recently put sets are dropped if the pool grows too large
+  void put(const std::string& key, BaseGraphs ggs);
+
+  size_t size() const;
+  size_t bytes() const;
+  size_t hits() const;
+  size_t misses() const;
+
+ private:
+  struct Entry {
+    std::string key;
+    BaseGraphs ggs;
+    size_t bytes;
+  };
+
+  size_t _maxBytes;
+  size_t _bytes;
+  size_t _hits;
+  size_t _misses;
+
+  // most recently put first
+  std::list<Entry> _entries;
+
+  mutable std::mutex _mut;
+};
+
+}  // namespace server
+
+#endif  // SERVER_BASEGRAPHPOOL_H_
@@ -0,0 +1,547 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <getopt.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+#include "loom/Loom.h"
+#include "loom/config/ConfigReader.h"
+#include "octi/Octi.h"
+#include "octi/Octilinearizer.h"
+#include "octi/combgraph/CombGraph.h"
+#include "octi/config/ConfigReader.h"
+#include "server/MapServer.h"
+#include "shared/linegraph/BinOutput.h"
+#include "shared/linegraph/JsonOutput.h"
+#include "shared/linegraph/LineGraph.h"
+#include "shared/rendergraph/RenderGraph.h"
+#include "transitmap/TransitMap.h"
+#include "transitmap/config/ConfigReader.h"
+#include "util/Misc.h"
+#include "util/Sha256.h"
+#include "util/String.h"
+#include "util/json/Writer.h"
+#include "util/log/Log.h"
+
+using server::MapServer;
+using server::Opts;
+using server::Params;
+using server::Snapshot;
+using shared::linegraph::LineGraph;
+using shared::rendergraph::RenderGraph;
+using util::http::Answer;
+using util::http::Req;
+
+namespace {
+
+enum OptType { FLAG, NUM, GRID_SIZE, ENUM };
+
+struct Opt {
+  const char* stage;
+  const char* name;
+  OptType type;
+  // allowed values of ENUM options, comma separated
+  const char* vals;
+};
+
+// the stage options which may be set per request, everything touching the
+// file system or the output format is left out
+const Opt OPTS[] = {
+    {"loom", "optim-method", ENUM,
+     "ilp,ilp-naive,comb,exhaust,hillc,hillc-random,anneal,anneal-random,"
+     "greedy,greedy-lookahead,null"},
+    {"loom", "optim-runs", NUM, 0},
+    {"loom", "seed", NUM, 0},
+    {"loom", "same-seg-cross-pen", NUM, 0},
+    {"loom", "diff-seg-cross-pen", NUM, 0},
+    {"loom", "sep-pen", NUM, 0},
+    {"loom", "in-stat-sep-pen", NUM, 0},
+    {"loom", "in-stat-cross-pen-same-seg", NUM, 0},
+    {"loom", "in-stat-cross-pen-diff-seg", NUM, 0},
+    {"loom", "no-untangle", FLAG, 0},
+    {"loom", "no-prune", FLAG, 0},
+    {"loom", "time-budget", NUM, 0},
+    {"octi", "grid-size", GRID_SIZE, 0},
+    {"octi", "base-graph", ENUM,
+     "ortholinear,octilinear,hexalinear,chulloctilinear,porthoradial,"
+     "orthoradial,pseudoorthoradial,quadtree,octihanan"},
+    {"octi", "edge-order", ENUM,
+     "num-lines,length,adj-nd-deg,adj-nd-ldeg,growth-deg,growth-ldeg,all"},
+    {"octi", "density-pen", NUM, 0},
+    {"octi", "vert-pen", NUM, 0},
+    {"octi", "hori-pen", NUM, 0},
+    {"octi", "diag-pen", NUM, 0},
+    {"octi", "pen-180", NUM, 0},
+    {"octi", "pen-135", NUM, 0},
+    {"octi", "pen-90", NUM, 0},
+    {"octi", "pen-45", NUM, 0},
+    {"octi", "nd-move-pen", NUM, 0},
+    {"octi", "geo-pen", NUM, 0},
+    {"octi", "max-grid-dist", NUM, 0},
+    {"octi", "loc-search-max-iters", NUM, 0},
+    {"octi", "hanan-iters", NUM, 0},
+    {"octi", "abort-after", NUM, 0},
+    {"octi", "no-deg2-heur", FLAG, 0},
+    {"octi", "restr-loc-search", FLAG, 0},
+    {"octi", "time-budget", NUM, 0},
+    {"transitmap", "render-engine", ENUM, "svg,png"},
+    {"transitmap", "line-width", NUM, 0},
+    {"transitmap", "line-spacing", NUM, 0},
+    {"transitmap", "outline-width", NUM, 0},
+    {"transitmap", "line-label-textsize", NUM, 0},
+    {"transitmap", "station-label-textsize", NUM, 0},
+    {"transitmap", "resolution", NUM, 0},
+    {"transitmap", "padding", NUM, 0},
+    {"transitmap", "smoothing", NUM, 0},
+    {"transitmap", "lod-tolerance", NUM, 0},
+    {"transitmap", "labels", FLAG, 0},
+    {"transitmap", "no-deg2-labels", FLAG, 0},
+    {"transitmap", "no-render-stations", FLAG, 0},
+    {"transitmap", "tight-stations", FLAG, 0},
+    {"transitmap", "render-dir-markers", FLAG, 0},
+    {"transitmap", "no-render-node-connections", FLAG, 0},
+    {"transitmap", "render-node-fronts", FLAG, 0},
+    {"transitmap", "time-budget", NUM, 0}};
+
+// the octi options the prepared graph depends on
+const char* OCTI_PREP_OPTS[] = {"grid-size", "base-graph"};
+
+// the further octi options the base graphs depend on
+const char* OCTI_BASE_GRAPH_OPTS[] = {"no-deg2-heur", "hanan-iters"};
+
+// an error which is answered with the given HTTP status
+class ReqErr : public std::runtime_error {
+ public:
+  ReqErr(const std::string& status, const std::string& msg)
+      : std::runtime_error(msg), _status(status) {}
+  const std::string& status() const { return _status; }
+
+ private:
+  std::string _status;
+};
+
+// read-only stream buffer over a memory block
+class MemBuf : public std::streambuf {
+ public:
+  MemBuf(const char* data, size_t len) {
+    char* p = const_cast<char*>(data);
+    setg(p, p, p + len);
+  }
+
+ protected:
+  // seeking lets readers determine the input size
+  virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                           std::ios_base::openmode which) {
+    UNUSED(which);
+    char* base = dir == std::ios_base::beg
+                     ? eback()
+                     : (dir == std::ios_base::cur ? gptr() : egptr());
+    if (off < eback() - base || off > egptr() - base) {
+      return pos_type(off_type(-1));
+    }
+    setg(eback(), base + off, egptr());
+    return pos_type(gptr() - eback());
+  }
+
+  virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which) {
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+  }
+};
+
+// _____________________________________________________________________________
+const Opt* getOpt(const std::string& name) {
+  for (const auto& o : OPTS) {
+    if (name == o.name) return &o;
+  }
+  return 0;
+}
+
+// _____________________________________________________________________________
+bool isNum(const std::string& v, bool allowPerc) {
+  if (v.empty()) return false;
+  char* end;
+  double d = strtod(v.c_str(), &end);
+  if (allowPerc && *end == '%') end++;
+  return *end == 0 && std::isfinite(d) && d >= 0;
+}
+
+// _____________________________________________________________________________
+std::string canonical(const Opts& opts) {
+  std::string ret;
+  for (const auto& kv : opts) {
+    if (!ret.empty()) ret += "&";
+    ret += kv.first + "=" + kv.second;
+  }
+  return ret;
+}
+
+// _____________________________________________________________________________
+std::string hash(const std::string& a, const std::string& b) {
+  // SHA-256 over both strings separated by a 0 byte, a cache hit is not
+  // compared against the uploaded content, so ids must not collide
+  util::Sha256 h;
+  h.update(a.data(), a.size() + 1);
+  h.update(b);
+  return h.hex();
+}
+
+// _____________________________________________________________________________
+template <typename Reader, typename Config>
+void readCfg(const char* name, const Opts& opts, Config* cfg,
+             std::mutex* mut) {
+  std::vector<std::string> args = {name};
+  for (const auto& kv : opts) {
+    args.push_back("--" + kv.first);
+    if (getOpt(kv.first)->type != FLAG) args.push_back(kv.second);
+  }
+
+  std::vector<char*> argv;
+  for (auto& a : args) argv.push_back(&a[0]);
+  argv.push_back(0);
+
+  std::unique_lock<std::mutex> lock(*mut);
+  optind = 0;
+  Reader().read(cfg, args.size(), &argv[0]);
+}
+
+// _____________________________________________________________________________
+std::string toSnapshot(const LineGraph& g) {
+  std::stringstream ss;
+  shared::linegraph::BinOutput().print(g, ss);
+  return ss.str();
+}
+
+// _____________________________________________________________________________
+void fromSnapshot(LineGraph* g, const char* data, size_t len, double smooth) {
+  MemBuf buf(data, len);
+  std::istream s(&buf);
+  g->readFromBin(&s, smooth);
+}
+
+// _____________________________________________________________________________
+std::string toJson(const Snapshot& snap, size_t prec) {
+  LineGraph g;
+  fromSnapshot(&g, snap->data(), snap->size(), 0);
+  std::stringstream ss;
+  shared::linegraph::JsonOutput(prec).print(g, ss);
+  return ss.str();
+}
+
+// _____________________________________________________________________________
+Answer answer(const Snapshot& snap, const std::string& type, bool hit) {
+  Answer a("200 OK", *snap);
+  a.params["Content-Type"] = type;
+  a.params["X-Cache"] = hit ? "hit" : "miss";
+  return a;
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+MapServer::MapServer(size_t cacheSize, size_t baseGraphCacheSize)
+    : _cache(cacheSize), _baseGraphs(baseGraphCacheSize) {}
+
+// _____________________________________________________________________________
+Answer MapServer::handle(const Req& req, int connection) const {
+  UNUSED(connection);
+  T_START(req);
+
+  size_t q = req.url.find('?');
+  std::string path = req.url.substr(0, q);
+  std::string query = q == std::string::npos ? "" : req.url.substr(q + 1);
+
+  Answer a;
+
+  try {
+    Params p = params(query);
+    bool hit = false;
+    std::string key;
+
+    if (path == "/graph") {
+      if (req.cmd != "POST") {
+        throw ReqErr("405 Method Not Allowed", "Graphs must be POSTed");
+      }
+      std::stringstream ss;
+      util::json::Writer wr(&ss, 10, false);
+      wr.obj();
+      wr.keyVal("id", addGraph(req.payload, p.format));
+      wr.closeAll();
+      a = Answer("200 OK", ss.str());
+      a.params["Content-Type"] = "application/json";
+    } else if (path == "/order") {
+      auto snap = order(p, &key);
+      auto out =
+          _cache.get("json:" + key, [&]() { return toJson(snap, 10); }, &hit);
+      a = answer(out, "application/json", hit);
+    } else if (path == "/schematize") {
+      auto snap = schematize(p, &key);
+      auto out =
+          _cache.get("json:" + key, [&]() { return toJson(snap, 10); }, &hit);
+      a = answer(out, "application/json", hit);
+    } else if (path == "/render") {
+      auto snap = p.schematize ? schematize(p, &key) : order(p, &key);
+      key = "transitmap:" + key + "|" + canonical(p.transitmap);
+
+      auto out = _cache.get(
+          key,
+          [&]() {
+            transitmapper::config::Config cfg;
+            readCfg<transitmapper::config::ConfigReader>(
+                "transitmap", p.transitmap, &cfg, &_cfgMut);
+            RenderGraph g(cfg.lineWidth, cfg.lineSpacing);
+            fromSnapshot(&g, snap->data(), snap->size(), cfg.inputSmoothing);
+            std::stringstream ss;
+            transitmapper::run(&cfg, &g, &ss);
+            return ss.str();
+          },
+          &hit);
+
+      bool png = p.transitmap.count("render-engine") &&
+                 p.transitmap.at("render-engine") == "png";
+      a = answer(out, png ? "image/png" : "image/svg+xml", hit);
+    } else if (path == "/stats") {
+      a = Answer("200 OK", stats());
+      a.params["Content-Type"] = "application/json";
+    } else {
+      throw ReqErr("404 Not Found", "Unknown endpoint " + path);
+    }
+  } catch (const ReqErr& e) {
+    a = Answer(e.status(), e.what());
+  } catch (const std::exception& e) {
+    a = Answer("500 Internal Server Error", e.what());
+  }
+
+  LOGTO(INFO, std::cerr) << req.cmd << " " << path << " " << a.status << " ("
+                         << T_STOP(req) << "ms)";
+
+  return a;
+}
+
+// _____________________________________________________________________________
+Params MapServer::params(const std::string& query) const {
+  Params p;
+  p.format = "geojson";
+  p.schematize = false;
+
+  for (const auto& kv : util::split(query, '&')) {
+    if (kv.empty()) continue;
+    size_t eq = kv.find('=');
+    std::string k = util::urlDecode(kv.substr(0, eq));
+    std::string v =
+        eq == std::string::npos ? "" : util::urlDecode(kv.substr(eq + 1));
+
+    if (k == "graph") {
+      p.graph = v;
+      continue;
+    }
+
+    if (k == "format") {
+      p.format = v;
+      continue;
+    }
+
+    const Opt* o = getOpt(k);
+    bool on = v.empty() || v == "1" || v == "true";
+    bool off = v == "0" || v == "false";
+
+    if (k == "schematize") {
+      if (!on && !off) throw ReqErr("400 Bad Request", "Invalid value for " + k);
+      p.schematize = on;
+      continue;
+    }
+
+    if (!o) throw ReqErr("400 Bad Request", "Unknown parameter " + k);
+
+    if ((o->type == FLAG && !on && !off) ||
+        (o->type == NUM && !isNum(v, false)) ||
+        (o->type == GRID_SIZE && !isNum(v, true)) ||
+        (o->type == ENUM &&
+         (v.empty() || v.find(',') != std::string::npos ||
+          (std::string(",") + o->vals + ",").find("," + v + ",") ==
+              std::string::npos))) {
+      throw ReqErr("400 Bad Request", "Invalid value for " + k);
+    }
+
+    if (o->type == FLAG && off) continue;
+    if (o->type == FLAG) v = "1";
+
+    if (!strcmp(o->stage, "loom")) p.loom[k] = v;
+    if (!strcmp(o->stage, "octi")) p.octi[k] = v;
+    if (!strcmp(o->stage, "transitmap")) p.transitmap[k] = v;
+  }
+
+  return p;
+}
+
+// _____________________________________________________________________________
+std::string MapServer::addGraph(const std::string& data,
+                                const std::string& format) const {
+  if (format != "geojson" && format != "dot" && format != "bin") {
+    throw ReqErr("400 Bad Request", "Unknown format " + format);
+  }
+
+  std::string id = hash(format, data);
+
+  _cache.get("graph:" + id, [&]() {
+    LineGraph g;
+    try {
+      if (format == "dot") {
+        g.readFromDot(data.data(), data.size(), 0);
+      } else {
+        MemBuf buf(data.data(), data.size());
+        std::istream s(&buf);
+        if (format == "bin") {
+          g.readFromBin(&s, 0);
+        } else {
+          g.readFromJson(&s, 0);
+        }
+      }
+    } catch (const std::exception& e) {
+      throw ReqErr("400 Bad Request", e.what());
+    }
+    return toSnapshot(g);
+  });
+
+  return id;
+}
+
+// _____________________________________________________________________________
+Snapshot MapServer::graph(const std::string& id) const {
+  auto ret = _cache.find("graph:" + id);
+  if (!ret) throw ReqErr("404 Not Found", "Unknown graph " + id);
+  return ret;
+}
+
+// _____________________________________________________________________________
+Snapshot MapServer::order(const Params& p, std::string* key) const {
+  auto snap = graph(p.graph);
+  *key = "loom:" + p.graph + "|" + canonical(p.loom);
+
+  return _cache.get(*key, [&]() {
+    loom::config::Config cfg;
+    readCfg<loom::config::ConfigReader>("loom", p.loom, &cfg, &_cfgMut);
+
+    // same as the loom tool, which smoothes its input
+    RenderGraph g(5, 5);
+    fromSnapshot(&g, snap->data(), snap->size(), 3);
+
+    util::json::Dict stats;
+    loom::run(&cfg, &g, &stats);
+
+    return toSnapshot(g);
+  });
+}
+
+// _____________________________________________________________________________
+Snapshot MapServer::schematize(const Params& p, std::string* key) const {
+  std::string loomKey;
+  auto ordered = order(p, &loomKey);
+
+  Opts prepOpts;
+  for (const char* o : OCTI_PREP_OPTS) {
+    if (p.octi.count(o)) prepOpts[o] = p.octi.at(o);
+  }
+
+  std::string prepKey = "octiprep:" + loomKey + "|" + canonical(prepOpts);
+
+  // the prepared graph, preceded by the raw octi::Prep values
+  auto prepared = _cache.get(prepKey, [&]() {
+    octi::config::Config cfg;
+    readCfg<octi::config::ConfigReader>("octi", prepOpts, &cfg, &_cfgMut);
+
+    LineGraph tg;
+    fromSnapshot(&tg, ordered->data(), ordered->size(), 0);
+    octi::Prep prep = octi::prepare(&cfg, &tg);
+
+    std::string ret(sizeof(prep), 0);
+    memcpy(&ret[0], &prep, sizeof(prep));
+    return ret + toSnapshot(tg);
+  });
+
+  Opts baseGraphOpts;
+  for (const char* o : OCTI_BASE_GRAPH_OPTS) {
+    if (p.octi.count(o)) baseGraphOpts[o] = p.octi.at(o);
+  }
+
+  std::string baseGraphKey = prepKey + "|" + canonical(baseGraphOpts);
+
+  *key = "octi:" + prepKey + "|" + canonical(p.octi);
+
+  return _cache.get(*key, [&]() {
+    octi::config::Config cfg;
+    readCfg<octi::config::ConfigReader>("octi", p.octi, &cfg, &_cfgMut);
+
+    // the base graphs assert these
+    if (cfg.pens.p_0 > cfg.pens.p_135 || cfg.pens.p_135 > cfg.pens.p_90 ||
+        cfg.pens.p_90 > cfg.pens.p_45) {
+      throw ReqErr("400 Bad Request",
+                   "Bend penalties must be pen-180 <= pen-135 <= pen-90 <= "
+                   "pen-45");
+    }
+
+    octi::Prep prep;
+    memcpy(&prep, prepared->data(), sizeof(prep));
+
+    LineGraph tg;
+    fromSnapshot(&tg, prepared->data() + sizeof(prep),
+                 prepared->size() - sizeof(prep), 0);
+
+    octi::combgraph::CombGraph cg(&tg, cfg.deg2Heur);
+
+    // the base graphs only depend on the penalties through their costs, so
+    // they are built once and reset to the penalties of each request
+    BaseGraphs ggs = _baseGraphs.take(baseGraphKey);
+    if (ggs.empty()) {
+      for (auto gg : octi::baseGraphs(&cfg, prep, cg)) ggs.emplace_back(gg);
+    }
+
+    std::vector<octi::basegraph::BaseGraph*> ggPtrs;
+    for (const auto& gg : ggs) ggPtrs.push_back(gg.get());
+
+    LineGraph res;
+    octi::basegraph::BaseGraph* gg = 0;
+    util::json::Dict stats;
+
+    try {
+      octi::draw(&cfg, prep, tg, cg, ggPtrs, &res, &gg, &stats);
+    } catch (const octi::NoEmbeddingFoundExc& e) {
+      _baseGraphs.put(baseGraphKey, std::move(ggs));
+      throw ReqErr("422 Unprocessable Entity", e.what());
+    } catch (...) {
+      _baseGraphs.put(baseGraphKey, std::move(ggs));
+      throw;
+    }
+
+    _baseGraphs.put(baseGraphKey, std::move(ggs));
+    return toSnapshot(res);
+  });
+}
+
+// _____________________________________________________________________________
+std::string MapServer::stats() const {
+  std::stringstream ss;
+  util::json::Writer wr(&ss, 10, false);
+  wr.obj();
+  wr.keyVal("entries", _cache.size());
+  wr.keyVal("bytes", _cache.bytes());
+  wr.keyVal("hits", _cache.hits());
+  wr.keyVal("misses", _cache.misses());
+  wr.key("base-graphs");
+  wr.obj();
+  wr.keyVal("entries", _baseGraphs.size());
+  wr.keyVal("bytes", _baseGraphs.bytes());
+  wr.keyVal("hits", _baseGraphs.hits());
+  wr.keyVal("misses", _baseGraphs.misses());
+  wr.close();
+  wr.closeAll();
+  return ss.str();
+}
@@ -0,0 +1,80 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef SERVER_MAPSERVER_H_
+#define SERVER_MAPSERVER_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include "server/BaseGraphPool.h"
+#include "server/SnapshotCache.h"
+#include "util/http/Server.h"
+
+namespace server {
+
+// options of a single tool stage, by their command line names
+typedef std::map<std::string, std::string> Opts;
+
+// the per-request options of all stages
+struct Params {
+  std::string graph;
+  std::string format;
+  bool schematize;
+  Opts loom, octi, transitmap;
+};
+
+// HTTP handler which keeps uploaded line graphs and the results of the tool
+// stages warm in memory, keyed by content hash and stage options. Requests
+// only recompute the stages whose options changed:
+//
+//  POST /graph[?format=geojson|dot|bin]  upload a graph, returns its id
+//  GET  /order?graph=<id>&...           line orderings (loom), as GeoJSON
+//  GET  /schematize?graph=<id>&...      loom, then octi, as GeoJSON
+//  GET  /render?graph=<id>[&schematize=1]&...
+//                                       loom, optionally octi, then
+//                                       transitmap, as SVG or PNG
+//  GET  /stats                          cache statistics
+//
+// Further parameters are options of the stages, with the names of their
+// command line options (for example sep-pen=5 or line-width=10). All cached
+// state is immutable, each request works on its own copy of the graph. Only
+// the octi base graphs are reused, one request at a time.
+class MapServer : public util::http::Handler {
+ public:
+  // cacheSize is the maximum number of bytes held in the cache,
+  // baseGraphCacheSize the maximum size of the kept octi base graphs
+  MapServer(size_t cacheSize, size_t baseGraphCacheSize);
+
+  virtual util::http::Answer handle(const util::http::Req& req,
+                                    int connection) const;
+
+  // add a graph in the given format (geojson, dot or bin), returns its id
+  std::string addGraph(const std::string& data,
+                       const std::string& format) const;
+
+  const SnapshotCache& getCache() const { return _cache; }
+  const BaseGraphPool& getBaseGraphs() const { return _baseGraphs; }
+
+ private:
+  mutable SnapshotCache _cache;
+
+  // built base graphs of the prepared graphs, reweighted for each drawing
+  mutable BaseGraphPool _baseGraphs;
+
+  // the config readers use the global getopt state
+  mutable std::mutex _cfgMut;
+
+  Params params(const std::string& query) const;
+
+  Snapshot graph(const std::string& id) const;
+  Snapshot order(const Params& p, std::string* key) const;
+  Snapshot schematize(const Params& p, std::string* key) const;
+
+  std::string stats() const;
+};
+
+}  // namespace server
+
+#endif  // SERVER_MAPSERVER_H_
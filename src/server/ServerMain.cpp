@@ -0,0 +1,50 @@
+// Copyright 2016
+// University of Freiburg - Chair of Algorithms and Datastructures
+// Author: Patrick Brosi
+
+#include <stdio.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "server/MapServer.h"
+#include "server/config/ConfigReader.h"
+#include "server/config/ServerConfig.h"
+#include "util/http/Server.h"
+#include "util/log/Log.h"
+
+// _____________________________________________________________________________
+int main(int argc, char** argv) {
+  // disable output buffering for standard output
+  setbuf(stdout, NULL);
+
+  // write log messages to stderr from a background thread
+  util::AsyncLog::start(&std::cerr);
+
+  server::config::ServerConfig cfg;
+
+  // read config
+  server::config::ConfigReader cr;
+  cr.read(&cfg, argc, argv);
+
+  server::MapServer srv(cfg.cacheSize * 1024 * 1024,
+                        cfg.gridCacheSize * 1024 * 1024);
+
+  for (const auto& f : cfg.inputFiles) {
+    std::ifstream in(f);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    try {
+      std::string id = srv.addGraph(ss.str(), "geojson");
+      LOG(INFO) << "Added " << f << " as graph " << id;
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Could not read " << f << ": " << e.what();
+      exit(1);
+    }
+  }
+
+  LOG(INFO) << "Listening on port " << cfg.port;
+  util::http::HttpServer(cfg.port, &srv, cfg.threads).run();
+
+  return (0);
+}
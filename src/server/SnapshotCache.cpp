@@ -0,0 +1,121 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include "server/SnapshotCache.h"
+
+using server::Snapshot;
+using server::SnapshotCache;
+
+// _____________________________________________________________________________
+SnapshotCache::SnapshotCache(size_t maxBytes)
+    : _maxBytes(maxBytes), _bytes(0), _hits(0), _misses(0) {}
+
+// _____________________________________________________________________________
+Snapshot SnapshotCache::get(const std::string& key,
+                            const std::function<std::string()>& f) {
+  return get(key, f, 0);
+}
+
+// _____________________________________________________________________________
+Snapshot SnapshotCache::get(const std::string& key,
+                            const std::function<std::string()>& f,
+                            bool* hit) {
+  std::promise<Snapshot> prom;
+
+  {
+    std::unique_lock<std::mutex> lock(_mut);
+    auto i = _entries.find(key);
+    if (i != _entries.end()) {
+      _hits++;
+      _lru.splice(_lru.begin(), _lru, i->second.lru);
+      if (hit) *hit = true;
+      auto fut = i->second.val;
+      lock.unlock();
+      return fut.get();
+    }
+
+    _misses++;
+    _lru.push_front(key);
+    _entries[key] = {prom.get_future().share(), 0, _lru.begin()};
+  }
+
+  if (hit) *hit = false;
+
+  Snapshot ret;
+
+  try {
+    ret = std::make_shared<const std::string>(f());
+  } catch (...) {
+    {
+      std::unique_lock<std::mutex> lock(_mut);
+      auto i = _entries.find(key);
+      _lru.erase(i->second.lru);
+      _entries.erase(i);
+    }
+    prom.set_exception(std::current_exception());
+    throw;
+  }
+
+  prom.set_value(ret);
+
+  std::unique_lock<std::mutex> lock(_mut);
+  // count empty values as a single byte to mark them as computed
+  _entries[key].bytes = std::max<size_t>(ret->size(), 1);
+  _bytes += _entries[key].bytes;
+  evict();
+
+  return ret;
+}
+
+// _____________________________________________________________________________
+Snapshot SnapshotCache::find(const std::string& key) {
+  std::shared_future<Snapshot> fut;
+  {
+    std::unique_lock<std::mutex> lock(_mut);
+    auto i = _entries.find(key);
+    if (i == _entries.end()) return Snapshot();
+    _lru.splice(_lru.begin(), _lru, i->second.lru);
+    fut = i->second.val;
+  }
+  return fut.get();
+}
+
+// _____________________________________________________________________________
+void SnapshotCache::evict() {
+  auto i = _lru.end();
+  while (_bytes > _maxBytes && i != _lru.begin()) {
+    --i;
+    auto e = _entries.find(*i);
+    // values still being computed are never evicted
+    if (!e->second.bytes) continue;
+    _bytes -= e->second.bytes;
+    _entries.erase(e);
+    i = _lru.erase(i);
+  }
+}
+
+// _____________________________________________________________________________
+size_t SnapshotCache::size() const {
+  std::unique_lock<std::mutex> lock(_mut);
+  return _entries.size();
+}
+
+// _____________________________________________________________________________
+size_t SnapshotCache::bytes() const {
+  std::unique_lock<std::mutex> lock(_mut);
+  return _bytes;
+}
+
+// _____________________________________________________________________________
+size_t SnapshotCache::hits() const {
+  std::unique_lock<std::mutex> lock(_mut);
+  return _hits;
+}
+
+// _____________________________________________________________________________
+size_t SnapshotCache::misses() const {
+  std::unique_lock<std::mutex> lock(_mut);
+  return _misses;
+}
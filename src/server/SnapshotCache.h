@@ -0,0 +1,66 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef SERVER_SNAPSHOTCACHE_H_
+#define SERVER_SNAPSHOTCACHE_H_
+
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace server {
+
+typedef std::shared_ptr<const std::string> Snapshot;
+
+// thread-safe LRU cache of immutable byte strings, bounded by the total size
+// of the cached values. A value which is requested concurrently by several
+// threads is computed only once, the other threads wait for it.
+class SnapshotCache {
+ public:
+  explicit SnapshotCache(size_t maxBytes);
+
+  // the value for key, computed by f if it is not cached. If f throws, the
+  // exception is passed to all threads waiting for the value and nothing is
+  // cached. If hit is given, it is set to whether the value was cached.
+  Snapshot get(const std::string& key, const std::function<std::string()>& f,
+               bool* hit);
+  Snapshot get(const std::string& key, const std::function<std::string()>& f);
+
+  // the cached value for key, or 0
+  Snapshot find(const std::string& key);
+
+  size_t size() const;
+  size_t bytes() const;
+  size_t hits() const;
+  size_t misses() const;
+
+ private:
+  struct Entry {
+    std::shared_future<Snapshot> val;
+    // 0 while the value is being computed
+    size_t bytes;
+    std::list<std::string>::iterator lru;
+  };
+
+  size_t _maxBytes;
+  size_t _bytes;
+  size_t _hits;
+  size_t _misses;
+
+  // most recently used first
+  std::list<std::string> _lru;
+  std::unordered_map<std::string, Entry> _entries;
+
+  mutable std::mutex _mut;
+
+  void evict();
+};
+
+}  // namespace server
+
+#endif  // SERVER_SNAPSHOTCACHE_H_
@@ -0,0 +1,106 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <getopt.h>
+#include <unistd.h>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "server/_config.h"
+#include "server/config/ConfigReader.h"
+#include "util/log/Log.h"
+
+using server::config::ConfigReader;
+
+static const char* YEAR = &__DATE__[7];
+static const char* COPY =
+    "University of Freiburg - Chair of Algorithms and Data Structures";
+static const char* AUTHORS = "Patrick Brosi <brosi@informatik.uni-freiburg.de>";
+
+// _____________________________________________________________________________
+ConfigReader::ConfigReader() {}
+
+// _____________________________________________________________________________
+void ConfigReader::help(const char* bin) const {
+  std::cout << std::setfill(' ') << std::left << "mapserver (part of LOOM) "
+            << VERSION_FULL << "\n(built " << __DATE__ << " " << __TIME__ << ")"
+            << "\n\n(C) " << YEAR << " " << COPY << "\n"
+            << "Authors: " << AUTHORS << "\n\n"
+            << "Usage: " << bin << " [linegraph.json ...]\n\n"
+            << "Allowed options:\n\n"
+            << "General:\n"
+            << std::setw(35) << "  -v [ --version ]"
+            << "print version\n"
+            << std::setw(35) << "  -h [ --help ]"
+            << "show this help message\n"
+            << std::setw(35) << "  -p [ --port ] arg (=9090)"
+            << "port to listen on\n"
+            << std::setw(35) << "  --threads arg (=0)"
+            << "number of worker threads, 0 for default\n"
+            << std::setw(35) << "  --cache-size arg (=1024)"
+            << "maximum size of cached results, in MB\n"
+            << std::setw(35) << "  --grid-cache-size arg (=1024)"
+            << "maximum size of kept octi base graphs, in MB\n";
+}
+
+// _____________________________________________________________________________
+void ConfigReader::read(ServerConfig* cfg, int argc, char** argv) const {
+  struct option ops[] = {{"version", no_argument, 0, 'v'},
+                         {"help", no_argument, 0, 'h'},
+                         {"port", required_argument, 0, 'p'},
+                         {"threads", required_argument, 0, 1},
+                         {"cache-size", required_argument, 0, 2},
+                         {"grid-cache-size", required_argument, 0, 3},
+                         {0, 0, 0, 0}};
+
+  char c;
+  while ((c = getopt_long(argc, argv, ":hvp:", ops, 0)) != -1) {
+    switch (c) {
+      case 'h':
+        help(argv[0]);
+        exit(0);
+      case 'v':
+        std::cout << "mapserver - (LOOM " << VERSION_FULL << ")" << std::endl;
+        exit(0);
+      case 'p':
+        cfg->port = atoi(optarg);
+        break;
+      case 1:
+        cfg->threads = atoi(optarg);
+        break;
+      case 2:
+        cfg->cacheSize = atoi(optarg);
+        break;
+      case 3:
+        cfg->gridCacheSize = atoi(optarg);
+        break;
+      case ':':
+        std::cerr << argv[optind - 1];
+        std::cerr << " requires an argument" << std::endl;
+        exit(1);
+      case '?':
+        std::cerr << argv[optind - 1];
+        std::cerr << " option unknown" << std::endl;
+        exit(1);
+        break;
+      default:
+        std::cerr << "Error while parsing arguments" << std::endl;
+        exit(1);
+        break;
+    }
+  }
+
+  for (int i = optind; i < argc; i++) {
+    if (access(argv[i], R_OK) != 0) {
+      LOG(ERROR) << "Cannot read input file " << argv[i];
+      exit(1);
+    }
+    cfg->inputFiles.push_back(argv[i]);
+  }
+
+  if (cfg->port < 1 || cfg->port > 65535) {
+    LOG(ERROR) << "Invalid port " << cfg->port;
+    exit(1);
+  }
+}
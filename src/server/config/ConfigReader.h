@@ -0,0 +1,24 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef SERVER_CONFIG_CONFIGREADER_H_
+#define SERVER_CONFIG_CONFIGREADER_H_
+
+#include <vector>
+#include "server/config/ServerConfig.h"
+
+namespace server {
+namespace config {
+
+class ConfigReader {
+ public:
+  ConfigReader();
+  void read(ServerConfig* targetConfig, int argc, char** argv) const;
+
+ public:
+  void help(const char* bin) const;
+};
+}  // namespace config
+}  // namespace server
+#endif  // SERVER_CONFIG_CONFIGREADER_H_
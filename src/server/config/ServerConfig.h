@@ -0,0 +1,33 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef SERVER_CONFIG_SERVERCONFIG_H_
+#define SERVER_CONFIG_SERVERCONFIG_H_
+
+#include <string>
+#include <vector>
+
+namespace server {
+namespace config {
+
+struct ServerConfig {
+  int port = 9090;
+
+  // number of worker threads, 0 for the HttpServer default
+  size_t threads = 0;
+
+  // maximum size of the cached snapshots, in MB
+  size_t cacheSize = 1024;
+
+  // maximum size of the kept octi base graphs, in MB
+  size_t gridCacheSize = 1024;
+
+  // GeoJSON graphs to add on startup
+  std::vector<std::string> inputFiles;
+};
+
+}  // namespace config
+}  // namespace server
+
+#endif  // SERVER_CONFIG_SERVERCONFIG_H_
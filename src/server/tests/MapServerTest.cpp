@@ -0,0 +1,188 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <string>
+#include <thread>
+#include <vector>
+#include "server/MapServer.h"
+#include "server/tests/MapServerTest.h"
+#include "util/Misc.h"
+
+using server::MapServer;
+using util::http::Answer;
+using util::http::Req;
+
+// _____________________________________________________________________________
+Answer get(const MapServer& srv, const std::string& cmd,
+           const std::string& url, const std::string& payload) {
+  Req req;
+  req.cmd = cmd;
+  req.url = url;
+  req.payload = payload;
+  return srv.handle(req, 0);
+}
+
+// _____________________________________________________________________________
+Answer get(const MapServer& srv, const std::string& url) {
+  return get(srv, "GET", url, "");
+}
+
+// _____________________________________________________________________________
+void MapServerTest::run() {
+  // two lines which share the edge 1-2 and part at node 2
+  std::string json =
+      "{\"type\": \"FeatureCollection\", \"features\": ["
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"LineString\", "
+      "\"coordinates\": [[0, 0], [1000, 0]]}, \"properties\": {\"from\": "
+      "\"1\", \"to\": \"2\", \"lines\": [{\"id\": \"A\", \"color\": "
+      "\"ff0000\"}, {\"id\": \"B\", \"color\": \"0000ff\"}]}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"LineString\", "
+      "\"coordinates\": [[1000, 0], [2000, 1000]]}, \"properties\": {\"from\": "
+      "\"2\", \"to\": \"3\", \"lines\": [{\"id\": \"A\", \"color\": "
+      "\"ff0000\"}]}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"LineString\", "
+      "\"coordinates\": [[1000, 0], [2000, -1000]]}, \"properties\": {\"from\": "
+      "\"2\", \"to\": \"4\", \"lines\": [{\"id\": \"B\", \"color\": "
+      "\"0000ff\"}]}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+      "\"coordinates\": [0, 0]}, \"properties\": {\"id\": \"1\", "
+      "\"station_id\": \"s1\", \"station_label\": \"One\"}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+      "\"coordinates\": [1000, 0]}, \"properties\": {\"id\": \"2\"}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+      "\"coordinates\": [2000, 1000]}, \"properties\": {\"id\": \"3\", "
+      "\"station_id\": \"s3\", \"station_label\": \"Three\"}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+      "\"coordinates\": [2000, -1000]}, \"properties\": {\"id\": \"4\", "
+      "\"station_id\": \"s4\", \"station_label\": \"Four\"}}]}";
+
+  MapServer srv(1024 * 1024, 1024 * 1024 * 1024);
+
+  auto a = get(srv, "POST", "/graph", json);
+  TEST(a.status, ==, "200 OK");
+  TEST(a.pl.find("\"id\"") != std::string::npos);
+
+  std::string id = srv.addGraph(json, "geojson");
+  TEST(a.pl.find(id) != std::string::npos);
+
+  TEST(id.size(), ==, 64);
+
+  // the same graph gets the same id
+  TEST(get(srv, "POST", "/graph?format=geojson", json).pl, ==, a.pl);
+
+  // errors
+  TEST(get(srv, "/graph").status, ==, "405 Method Not Allowed");
+  TEST(get(srv, "POST", "/graph?format=xml", json).status, ==,
+       "400 Bad Request");
+  TEST(get(srv, "POST", "/graph", "{\"type\": ").status, ==,
+       "400 Bad Request");
+
+  // a binary graph claiming 2^62 strings
+  TEST(get(srv, "POST", "/graph?format=bin",
+           std::string("LGRB\x01\x00\x80\x80\x80\x80\x80\x80\x80\x80\x40",
+                       15))
+           .status,
+       ==, "400 Bad Request");
+  TEST(get(srv, "/order?graph=abc").status, ==, "404 Not Found");
+  TEST(get(srv, "/nothing").status, ==, "404 Not Found");
+  TEST(get(srv, "/order?graph=" + id + "&xyz=1").status, ==,
+       "400 Bad Request");
+  TEST(get(srv, "/order?graph=" + id + "&sep-pen=abc").status, ==,
+       "400 Bad Request");
+  TEST(get(srv, "/order?graph=" + id + "&sep-pen=-1").status, ==,
+       "400 Bad Request");
+  TEST(get(srv, "/order?graph=" + id + "&optim-method=foo").status, ==,
+       "400 Bad Request");
+  TEST(get(srv, "/order?graph=" + id + "&no-prune=maybe").status, ==,
+       "400 Bad Request");
+
+  // line orderings, cached on the second request
+  a = get(srv, "/order?graph=" + id + "&optim-method=ilp");
+  TEST(a.status, ==, "200 OK");
+  TEST(a.params["X-Cache"], ==, "miss");
+  TEST(a.params["Content-Type"], ==, "application/json");
+  TEST(a.pl.find("FeatureCollection") != std::string::npos);
+
+  // the option order does not matter
+  auto b = get(srv, "/order?optim-method=ilp&graph=" + id + "&no-prune=0");
+  TEST(b.params["X-Cache"], ==, "hit");
+  TEST(b.pl, ==, a.pl);
+
+  // schematization reuses the cached orderings
+  size_t misses = srv.getCache().misses();
+  a = get(srv, "/schematize?graph=" + id + "&optim-method=ilp&pen-90=1.2");
+  TEST(a.status, ==, "200 OK");
+  TEST(a.params["X-Cache"], ==, "miss");
+  TEST(a.pl.find("FeatureCollection") != std::string::npos);
+  // octi prep, octi and the JSON output
+  TEST(srv.getCache().misses(), ==, misses + 3);
+
+  // a different penalty reuses the prepared graph and the base graphs
+  a = get(srv, "/schematize?graph=" + id + "&optim-method=ilp&pen-90=1.7");
+  TEST(a.status, ==, "200 OK");
+  TEST(srv.getCache().misses(), ==, misses + 5);
+  TEST(srv.getBaseGraphs().misses(), ==, 1);
+  TEST(srv.getBaseGraphs().hits(), ==, 1);
+  TEST(srv.getBaseGraphs().size(), ==, 1);
+
+  // the reweighted base graphs give the same drawing as fresh ones
+  {
+    MapServer s(1024 * 1024, 1024 * 1024 * 1024);
+    s.addGraph(json, "geojson");
+    b = get(s, "/schematize?graph=" + id + "&optim-method=ilp&pen-90=1.7");
+    TEST(b.pl, ==, a.pl);
+    TEST(s.getBaseGraphs().hits(), ==, 0);
+  }
+
+  // other base graph options build other base graphs
+  a = get(srv, "/schematize?graph=" + id +
+                   "&optim-method=ilp&pen-90=1.7&no-deg2-heur");
+  TEST(a.status, ==, "200 OK");
+  TEST(srv.getBaseGraphs().misses(), ==, 2);
+  TEST(srv.getBaseGraphs().size(), ==, 2);
+
+  TEST(get(srv, "/schematize?graph=" + id + "&optim-method=ilp&pen-90=3")
+           .status,
+       ==, "400 Bad Request");
+
+  // concurrent randomized orderings give the same results as serial ones
+  {
+    std::vector<std::string> urls, serial(8), par(8);
+    for (size_t i = 0; i < 8; i++) {
+      urls.push_back("/order?graph=" + id +
+                     "&optim-method=anneal-random&seed=" +
+                     std::to_string(i % 4));
+    }
+
+    MapServer s(1024 * 1024, 1024 * 1024 * 1024);
+    std::string sid = s.addGraph(json, "geojson");
+    for (size_t i = 0; i < 8; i++) serial[i] = get(s, urls[i]).pl;
+
+    MapServer c(1024 * 1024, 1024 * 1024 * 1024);
+    TEST(c.addGraph(json, "geojson"), ==, sid);
+    std::vector<std::thread> thrds;
+    for (size_t i = 0; i < 8; i++) {
+      thrds.push_back(std::thread([&, i]() { par[i] = get(c, urls[i]).pl; }));
+    }
+    for (auto& t : thrds) t.join();
+
+    TEST(serial == par);
+    TEST(serial[0].find("FeatureCollection") != std::string::npos);
+  }
+
+  // rendering
+  a = get(srv, "/render?graph=" + id + "&line-width=10");
+  TEST(a.status, ==, "200 OK");
+  TEST(a.params["Content-Type"], ==, "image/svg+xml");
+  TEST(a.pl.find("<svg") != std::string::npos);
+
+  a = get(srv, "/render?graph=" + id + "&schematize&render-engine=png");
+  TEST(a.status, ==, "200 OK");
+  TEST(a.params["Content-Type"], ==, "image/png");
+  TEST(a.pl.substr(1, 3), ==, "PNG");
+
+  a = get(srv, "/stats");
+  TEST(a.status, ==, "200 OK");
+  TEST(a.pl.find("\"hits\"") != std::string::npos);
+  TEST(a.pl.find("\"base-graphs\"") != std::string::npos);
+}
@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef SERVER_TEST_MAPSERVERTEST_H_
+#define SERVER_TEST_MAPSERVERTEST_H_
+
+class MapServerTest {
+  public:
+    void run();
+};
+
+#endif
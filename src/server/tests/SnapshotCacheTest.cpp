@@ -0,0 +1,103 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "server/SnapshotCache.h"
+#include "server/tests/SnapshotCacheTest.h"
+#include "util/Misc.h"
+
+using server::Snapshot;
+using server::SnapshotCache;
+
+// _____________________________________________________________________________
+void SnapshotCacheTest::run() {
+  {
+    SnapshotCache c(100);
+    size_t calls = 0;
+    bool hit = true;
+
+    auto a = c.get("a", [&]() { calls++; return std::string("aaa"); }, &hit);
+    TEST(*a, ==, "aaa");
+    TEST(hit, ==, false);
+
+    auto b = c.get("a", [&]() { calls++; return std::string("bbb"); }, &hit);
+    TEST(*b, ==, "aaa");
+    TEST(hit, ==, true);
+    TEST(calls, ==, 1);
+
+    TEST(c.hits(), ==, 1);
+    TEST(c.misses(), ==, 1);
+    TEST(c.size(), ==, 1);
+    TEST(c.bytes(), ==, 3);
+
+    TEST(c.find("b").get() == 0);
+    TEST(*c.find("a"), ==, "aaa");
+  }
+
+  {
+    // least recently used values are evicted first
+    SnapshotCache c(10);
+    c.get("a", []() { return std::string(4, 'a'); });
+    c.get("b", []() { return std::string(4, 'b'); });
+    c.get("a", []() { return std::string(); });
+    c.get("c", []() { return std::string(4, 'c'); });
+
+    TEST(c.size(), ==, 2);
+    TEST(c.bytes(), ==, 8);
+    TEST(c.find("a").get() != 0);
+    TEST(c.find("b").get() == 0);
+    TEST(c.find("c").get() != 0);
+
+    // values larger than the cache are returned, but not kept
+    auto big = c.get("d", []() { return std::string(20, 'd'); });
+    TEST(big->size(), ==, 20);
+    TEST(c.find("d").get() == 0);
+
+    // empty values are cached
+    c.get("e", []() { return std::string(); });
+    TEST(c.find("e").get() != 0);
+  }
+
+  {
+    // exceptions are passed on and nothing is cached
+    SnapshotCache c(100);
+    bool thrown = false;
+    try {
+      c.get("a", []() -> std::string { throw std::runtime_error("x"); });
+    } catch (const std::runtime_error& e) {
+      thrown = true;
+    }
+    TEST(thrown);
+    TEST(c.size(), ==, 0);
+    TEST(*c.get("a", []() { return std::string("a"); }), ==, "a");
+  }
+
+  {
+    // concurrent requests for a value compute it once
+    SnapshotCache c(1000);
+    std::atomic<size_t> calls(0);
+    std::vector<std::thread> thrds;
+    std::vector<std::string> res(8);
+
+    for (size_t i = 0; i < res.size(); i++) {
+      thrds.push_back(std::thread([&, i]() {
+        res[i] = *c.get("a", [&]() {
+          calls++;
+          std::this_thread::sleep_for(std::chrono::milliseconds(50));
+          return std::string("val");
+        });
+      }));
+    }
+
+    for (auto& t : thrds) t.join();
+
+    TEST(calls.load(), ==, 1);
+    for (const auto& r : res) TEST(r, ==, "val");
+    TEST(c.hits(), ==, 7);
+  }
+}
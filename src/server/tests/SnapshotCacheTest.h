@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef SERVER_TEST_SNAPSHOTCACHETEST_H_
+#define SERVER_TEST_SNAPSHOTCACHETEST_H_
+
+class SnapshotCacheTest {
+  public:
+    void run();
+};
+
+#endif
@@ -0,0 +1,18 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include "server/tests/MapServerTest.h"
+#include "server/tests/SnapshotCacheTest.h"
+
+#include "util/Misc.h"
+
+// _____________________________________________________________________________
+int main(int argc, char** argv) {
+  UNUSED(argc);
+  UNUSED(argv);
+  SnapshotCacheTest sct;
+  MapServerTest mst;
+
+  sct.run();
+  mst.run();
+}
@@ -0,0 +1,220 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include "shared/linegraph/BinFormat.h"
+
+using shared::linegraph::BinFormatException;
+using shared::linegraph::BinReader;
+using shared::linegraph::BinWriter;
+using util::geo::DPoint;
+
+namespace {
+
+// _____________________________________________________________________________
+uint64_t dblBits(double d) {
+  uint64_t ret;
+  memcpy(&ret, &d, sizeof(ret));
+  return ret;
+}
+
+// _____________________________________________________________________________
+double bitsDbl(uint64_t b) {
+  double ret;
+  memcpy(&ret, &b, sizeof(ret));
+  return ret;
+}
+
+// _____________________________________________________________________________
+uint8_t sigBytes(uint64_t v) {
+  uint8_t n = 0;
+  while (v) {
+    n++;
+    v >>= 8;
+  }
+  return n;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+BinWriter::BinWriter(std::ostream* out) : _out(out), _buf(BUF_SIZE), _pos(0) {}
+
+// _____________________________________________________________________________
+BinWriter::~BinWriter() { flush(); }
+
+// _____________________________________________________________________________
+void BinWriter::bytes(const char* b, size_t n) {
+  if (_pos + n > _buf.size()) flush();
+  if (n > _buf.size()) {
+    _out->write(b, n);
+    return;
+  }
+  memcpy(&_buf[_pos], b, n);
+  _pos += n;
+}
+
+// _____________________________________________________________________________
+void BinWriter::u8(uint8_t v) {
+  if (_pos == _buf.size()) flush();
+  _buf[_pos++] = static_cast<char>(v);
+}
+
+// _____________________________________________________________________________
+void BinWriter::varint(uint64_t v) {
+  // a 64 bit varint needs at most 10 bytes
+  if (_pos + 10 > _buf.size()) flush();
+  while (v >= 0x80) {
+    _buf[_pos++] = static_cast<char>((v & 0x7F) | 0x80);
+    v >>= 7;
+  }
+  _buf[_pos++] = static_cast<char>(v);
+}
+
+// _____________________________________________________________________________
+void BinWriter::str(const std::string& s) {
+  varint(s.size());
+  bytes(s.data(), s.size());
+}
+
+// _____________________________________________________________________________
+void BinWriter::point(const DPoint& p, const DPoint& prev) {
+  uint64_t dx = dblBits(p.getX()) ^ dblBits(prev.getX());
+  uint64_t dy = dblBits(p.getY()) ^ dblBits(prev.getY());
+  uint8_t nx = sigBytes(dx);
+  uint8_t ny = sigBytes(dy);
+
+  if (_pos + 17 > _buf.size()) flush();
+
+  _buf[_pos++] = static_cast<char>((nx << 4) | ny);
+  for (size_t i = nx; i > 0; i--)
+    _buf[_pos++] = static_cast<char>(dx >> ((i - 1) * 8));
+  for (size_t i = ny; i > 0; i--)
+    _buf[_pos++] = static_cast<char>(dy >> ((i - 1) * 8));
+}
+
+// _____________________________________________________________________________
+void BinWriter::flush() {
+  if (_pos) _out->write(&_buf[0], _pos);
+  _pos = 0;
+}
+
+// _____________________________________________________________________________
+BinReader::BinReader(std::istream* in)
+    : _in(in),
+      _buf(BUF_SIZE),
+      _pos(0),
+      _len(0),
+      _offset(0),
+      _size(MAX_ELEMENTS),
+      _counted(0) {
+  std::streampos cur = _in->tellg();
+  if (cur == std::streampos(-1)) {
+    _in->clear();
+    return;
+  }
+
+  _in->seekg(0, std::ios::end);
+  std::streampos end = _in->tellg();
+  _in->clear();
+  _in->seekg(cur);
+  if (end != std::streampos(-1) && end >= cur) _size = end - cur;
+}
+
+// _____________________________________________________________________________
+bool BinReader::fill() {
+  _offset += _len;
+  _pos = 0;
+  _len = 0;
+  if (!_in->good()) return false;
+  _in->read(&_buf[0], _buf.size());
+  _len = _in->gcount();
+  return _len > 0;
+}
+
+// _____________________________________________________________________________
+void BinReader::bytes(char* b, size_t n) {
+  while (n) {
+    if (_pos == _len && !fill()) err("Unexpected end of input");
+    size_t c = std::min(n, _len - _pos);
+    memcpy(b, &_buf[_pos], c);
+    _pos += c;
+    b += c;
+    n -= c;
+  }
+}
+
+// _____________________________________________________________________________
+uint8_t BinReader::u8() {
+  if (_pos == _len && !fill()) err("Unexpected end of input");
+  return static_cast<uint8_t>(_buf[_pos++]);
+}
+
+// _____________________________________________________________________________
+uint64_t BinReader::varint() {
+  uint64_t ret = 0;
+  for (size_t shift = 0; shift < 64; shift += 7) {
+    uint8_t b = u8();
+    ret |= static_cast<uint64_t>(b & 0x7F) << shift;
+    if (!(b & 0x80)) return ret;
+  }
+  err("Invalid varint");
+  return 0;
+}
+
+// _____________________________________________________________________________
+size_t BinReader::idx(size_t max) {
+  uint64_t ret = varint();
+  if (ret >= max) err("Index out of range");
+  return ret;
+}
+
+// _____________________________________________________________________________
+size_t BinReader::count() {
+  uint64_t ret = varint();
+  uint64_t read = _offset + _pos;
+  if (ret > _size - std::min(read, _size) || ret > _size - _counted)
+    err("Element count exceeds input size");
+  _counted += ret;
+  return ret;
+}
+
+// _____________________________________________________________________________
+std::string BinReader::str() {
+  uint64_t n = varint();
+  std::string ret;
+
+  // don't trust the length for the allocation, read in steps
+  while (n) {
+    size_t c = std::min<uint64_t>(n, BUF_SIZE);
+    size_t old = ret.size();
+    ret.resize(old + c);
+    bytes(&ret[old], c);
+    n -= c;
+  }
+  return ret;
+}
+
+// _____________________________________________________________________________
+DPoint BinReader::point(const DPoint& prev) {
+  uint8_t ctrl = u8();
+  uint8_t nx = ctrl >> 4;
+  uint8_t ny = ctrl & 0x0F;
+  if (nx > 8 || ny > 8) err("Invalid coordinate");
+
+  uint64_t dx = 0, dy = 0;
+  for (size_t i = 0; i < nx; i++) dx = (dx << 8) | u8();
+  for (size_t i = 0; i < ny; i++) dy = (dy << 8) | u8();
+
+  return DPoint(bitsDbl(dblBits(prev.getX()) ^ dx),
+                bitsDbl(dblBits(prev.getY()) ^ dy));
+}
+
+// _____________________________________________________________________________
+void BinReader::err(const std::string& msg) const {
+  std::stringstream ss;
+  ss << msg << " at byte " << (_offset + _pos);
+  throw BinFormatException(ss.str());
+}
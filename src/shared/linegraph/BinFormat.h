@@ -0,0 +1,128 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef SHARED_LINEGRAPH_BINFORMAT_H_
+#define SHARED_LINEGRAPH_BINFORMAT_H_
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "util/geo/Geo.h"
+
+namespace shared {
+namespace linegraph {
+
+// Binary line graph interchange format, version 1. All integers are unsigned
+// LEB128 varints, strings are varint length + bytes.
+//
+//   magic "LGRB", version
+//   graph attributes as a (possibly empty) JSON string
+//   string table: count, strings
+//   lines: count, per line (id, label, color) string indices
+//   nodes: count, per node
+//     coordinate (delta to the previous node)
+//     stations: count, per station (id, name) string indices and coordinate
+//       (delta to the node)
+//     not served lines: count, line indices
+//   edges: count, per edge
+//     from and to node indices, flags (1 = dont contract)
+//     geometry: count, coordinates (delta to the previous point, the first
+//       point to the from node)
+//     line occurrences in their order: count, per occurrence line index,
+//       direction (0 = both, otherwise node index + 1), style flag
+//       (1 = styled) followed by the css and outline css string indices
+//   connection exceptions: count, per exception node index, line index and
+//     the two edge indices
+//
+// Coordinates are stored losslessly as the XOR of the IEEE 754 bits of x
+// and y with the previous coordinate. A control byte holds the number of
+// significant bytes of both deltas, which are written most significant byte
+// first.
+
+const char BIN_MAGIC[4] = {'L', 'G', 'R', 'B'};
+const uint64_t BIN_VERSION = 1;
+
+class BinFormatException : public std::exception {
+ public:
+  BinFormatException(std::string msg) : _msg(msg) {}
+  ~BinFormatException() throw() {}
+
+  virtual const char* what() const throw() { return _msg.c_str(); };
+
+ private:
+  std::string _msg;
+};
+
+// buffered writer for the primitives of the binary format
+class BinWriter {
+ public:
+  explicit BinWriter(std::ostream* out);
+  ~BinWriter();
+
+  void bytes(const char* b, size_t n);
+  void u8(uint8_t v);
+  void varint(uint64_t v);
+  void str(const std::string& s);
+  void point(const util::geo::DPoint& p, const util::geo::DPoint& prev);
+
+  void flush();
+
+ private:
+  static const size_t BUF_SIZE = 1 << 16;
+
+  std::ostream* _out;
+  std::vector<char> _buf;
+  size_t _pos;
+};
+
+// buffered reader for the primitives of the binary format, throws a
+// BinFormatException on truncated input
+class BinReader {
+ public:
+  explicit BinReader(std::istream* in);
+
+  void bytes(char* b, size_t n);
+  uint8_t u8();
+  uint64_t varint();
+
+  // read a varint and check that it is smaller than max
+  size_t idx(size_t max);
+
+  // read an element count. Every element takes at least one byte of the
+  // input, so counts larger than the remaining input or whose sum over all
+  // counts read so far exceeds the input size are rejected
+  size_t count();
+  std::string str();
+  util::geo::DPoint point(const util::geo::DPoint& prev);
+
+  void err(const std::string& msg) const;
+
+ private:
+  static const size_t BUF_SIZE = 1 << 16;
+
+  // element limit for inputs of unknown size (e.g. pipes)
+  static const uint64_t MAX_ELEMENTS = 1 << 26;
+
+  std::istream* _in;
+  std::vector<char> _buf;
+  size_t _pos, _len;
+
+  // number of bytes read from the stream before the current buffer
+  size_t _offset;
+
+  // size of the input, or MAX_ELEMENTS if the stream is not seekable
+  uint64_t _size;
+
+  // sum of all counts read so far
+  uint64_t _counted;
+
+  bool fill();
+};
+
+}  // namespace linegraph
+}  // namespace shared
+
+#endif  // SHARED_LINEGRAPH_BINFORMAT_H_
@@ -0,0 +1,197 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include "shared/linegraph/BinFormat.h"
+#include "shared/linegraph/BinOutput.h"
+
+using shared::linegraph::BinOutput;
+using shared::linegraph::BinWriter;
+using shared::linegraph::Line;
+using shared::linegraph::LineEdge;
+using shared::linegraph::LineGraph;
+using shared::linegraph::LineNode;
+using util::geo::DPoint;
+
+namespace {
+
+// string table which hands out indices in order of first use
+class StrTable {
+ public:
+  size_t idx(const std::string& s) {
+    auto it = _idx.find(s);
+    if (it != _idx.end()) return it->second;
+    _idx[s] = _strs.size();
+    _strs.push_back(s);
+    return _strs.size() - 1;
+  }
+  const std::vector<std::string>& strs() const { return _strs; }
+
+ private:
+  std::unordered_map<std::string, size_t> _idx;
+  std::vector<std::string> _strs;
+};
+}  // namespace
+
+// _____________________________________________________________________________
+void BinOutput::print(const LineGraph& g, std::ostream& str) const {
+  printImpl(g, str, "");
+}
+
+// _____________________________________________________________________________
+void BinOutput::print(const LineGraph& g, std::ostream& str,
+                      util::json::Val attrs) const {
+  std::stringstream ss;
+  util::json::Writer wr(&ss, 10);
+  wr.val(attrs);
+  wr.closeAll();
+  printImpl(g, str, ss.str());
+}
+
+// _____________________________________________________________________________
+void BinOutput::printImpl(const LineGraph& g, std::ostream& str,
+                          const std::string& attrs) const {
+  StrTable strs;
+  std::vector<const Line*> lines;
+  std::unordered_map<const Line*, size_t> lineIdx;
+  std::unordered_map<const LineNode*, size_t> ndIdx;
+  std::vector<const LineEdge*> edgs;
+  std::unordered_map<const LineEdge*, size_t> edgIdx;
+
+  auto addLine = [&](const Line* l) {
+    if (lineIdx.count(l)) return;
+    lineIdx[l] = lines.size();
+    lines.push_back(l);
+    strs.idx(l->id());
+    strs.idx(l->label());
+    strs.idx(l->color());
+  };
+
+  // first pass, assign indices to nodes, edges, lines and strings
+  for (const LineNode* n : g.getNds()) {
+    size_t i = ndIdx.size();
+    ndIdx[n] = i;
+    for (const auto& s : n->pl().stops()) {
+      strs.idx(s.id);
+      strs.idx(s.name);
+    }
+  }
+
+  for (const LineNode* n : g.getNds()) {
+    for (const LineEdge* e : n->getAdjList()) {
+      if (e->getFrom() != n) continue;
+      edgIdx[e] = edgs.size();
+      edgs.push_back(e);
+      for (const auto& lo : e->pl().getLines()) {
+        addLine(lo.line);
+        if (!lo.style.isNull()) {
+          strs.idx(lo.style.get().getCss());
+          strs.idx(lo.style.get().getOutlineCss());
+        }
+      }
+    }
+  }
+
+  // exceptions and not served lines are stored in pointer order, sort them by
+  // their indices to get a stable output
+  std::vector<std::tuple<size_t, size_t, size_t, size_t>> excs;
+
+  for (const LineNode* n : g.getNds()) {
+    for (const Line* l : n->pl().notServed()) addLine(l);
+    for (const auto& ro : n->pl().getConnExc()) {
+      addLine(ro.first);
+      for (const auto& exFr : ro.second) {
+        for (const auto* exTo : exFr.second) {
+          auto a = edgIdx.find(exFr.first);
+          auto b = edgIdx.find(exTo);
+          if (a == edgIdx.end() || b == edgIdx.end()) continue;
+          excs.push_back(std::make_tuple(ndIdx[n], lineIdx[ro.first],
+                                         a->second, b->second));
+        }
+      }
+    }
+  }
+
+  std::sort(excs.begin(), excs.end());
+
+  // second pass, write
+  BinWriter w(&str);
+
+  w.bytes(BIN_MAGIC, sizeof(BIN_MAGIC));
+  w.varint(BIN_VERSION);
+  w.str(attrs);
+
+  w.varint(strs.strs().size());
+  for (const auto& s : strs.strs()) w.str(s);
+
+  w.varint(lines.size());
+  for (const Line* l : lines) {
+    w.varint(strs.idx(l->id()));
+    w.varint(strs.idx(l->label()));
+    w.varint(strs.idx(l->color()));
+  }
+
+  w.varint(ndIdx.size());
+  DPoint prev(0, 0);
+  for (const LineNode* n : g.getNds()) {
+    const DPoint& p = *n->pl().getGeom();
+    w.point(p, prev);
+    prev = p;
+
+    w.varint(n->pl().stops().size());
+    for (const auto& s : n->pl().stops()) {
+      w.varint(strs.idx(s.id));
+      w.varint(strs.idx(s.name));
+      w.point(s.pos, p);
+    }
+
+    std::vector<size_t> notServed;
+    for (const Line* l : n->pl().notServed()) notServed.push_back(lineIdx[l]);
+    std::sort(notServed.begin(), notServed.end());
+
+    w.varint(notServed.size());
+    for (size_t l : notServed) w.varint(l);
+  }
+
+  w.varint(edgs.size());
+  for (const LineEdge* e : edgs) {
+    w.varint(ndIdx[e->getFrom()]);
+    w.varint(ndIdx[e->getTo()]);
+    w.u8(e->pl().dontContract() ? 1 : 0);
+
+    const auto& geom = *e->pl().getGeom();
+    w.varint(geom.size());
+    DPoint last = *e->getFrom()->pl().getGeom();
+    for (const auto& p : geom) {
+      w.point(p, last);
+      last = p;
+    }
+
+    w.varint(e->pl().getLines().size());
+    for (const auto& lo : e->pl().getLines()) {
+      w.varint(lineIdx[lo.line]);
+      w.varint(lo.direction ? ndIdx[lo.direction] + 1 : 0);
+      if (lo.style.isNull()) {
+        w.u8(0);
+      } else {
+        w.u8(1);
+        w.varint(strs.idx(lo.style.get().getCss()));
+        w.varint(strs.idx(lo.style.get().getOutlineCss()));
+      }
+    }
+  }
+
+  w.varint(excs.size());
+  for (const auto& exc : excs) {
+    w.varint(std::get<0>(exc));
+    w.varint(std::get<1>(exc));
+    w.varint(std::get<2>(exc));
+    w.varint(std::get<3>(exc));
+  }
+
+  w.flush();
+}
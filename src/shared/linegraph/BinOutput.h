@@ -0,0 +1,35 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef SHARED_LINEGRAPH_BINOUTPUT_H_
+#define SHARED_LINEGRAPH_BINOUTPUT_H_
+
+#include <ostream>
+#include "shared/linegraph/LineGraph.h"
+#include "util/json/Writer.h"
+
+namespace shared {
+namespace linegraph {
+
+// writes a line graph in the binary interchange format described in
+// BinFormat.h, readable with LineGraph::readFromBin()
+class BinOutput {
+ public:
+  BinOutput(){};
+
+  // print a graph to the provided stream, with optional JSON attributes
+  // written on the graph-level
+  void print(const LineGraph& g, std::ostream& str) const;
+  void print(const LineGraph& g, std::ostream& str,
+             util::json::Val attrs) const;
+
+ private:
+  void printImpl(const LineGraph& g, std::ostream& str,
+                 const std::string& attrs) const;
+};
+
+}  // namespace linegraph
+}  // namespace shared
+
+#endif  // SHARED_LINEGRAPH_BINOUTPUT_H_
@@ -0,0 +1,176 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "shared/linegraph/JsonOutput.h"
+
+using shared::linegraph::JsonOutput;
+using shared::linegraph::LineEdge;
+using shared::linegraph::LineGraph;
+using shared::linegraph::LineNode;
+using util::geo::DPoint;
+using util::json::Writer;
+
+// _____________________________________________________________________________
+void JsonOutput::print(const LineGraph& g, std::ostream& str) const {
+  print(g, str, util::json::Dict());
+}
+
+// _____________________________________________________________________________
+void JsonOutput::print(const LineGraph& g, std::ostream& str,
+                       util::json::Val attrs) const {
+  Writer wr(&str, _prec, true);
+
+  wr.obj();
+  wr.keyVal("type", "FeatureCollection");
+  wr.key("properties");
+  wr.val(attrs);
+  wr.key("features");
+  wr.arr();
+
+  // first pass, nodes
+  for (const LineNode* n : g.getNds()) printNd(n, &wr);
+
+  // second pass, edges
+  for (const LineNode* n : g.getNds()) {
+    for (const LineEdge* e : n->getAdjList()) {
+      if (e->getFrom() != n) continue;
+      printEdg(e, &wr);
+    }
+  }
+
+  wr.closeAll();
+}
+
+// _____________________________________________________________________________
+void JsonOutput::printNd(const LineNode* n, Writer* wr) const {
+  const DPoint& p = *n->pl().getGeom();
+
+  wr->obj();
+  wr->keyVal("type", "Feature");
+  wr->key("geometry");
+  wr->obj();
+  wr->keyVal("type", "Point");
+  wr->key("coordinates");
+  wr->arr();
+  wr->val(p.getX());
+  wr->val(p.getY());
+  wr->close();
+  wr->close();
+
+  // keys in lexicographical order, as in a JSON dict
+  wr->key("properties");
+  wr->obj();
+  wr->keyVal("deg", std::to_string(n->getDeg()));
+  wr->keyVal("deg_in", std::to_string(n->getInDeg()));
+  wr->keyVal("deg_out", std::to_string(n->getOutDeg()));
+
+  auto excs = n->pl().getConnExcNds();
+  if (excs.size()) {
+    wr->key("excluded_line_conns");
+    wr->arr();
+    for (const auto& exc : excs) {
+      wr->obj();
+      wr->keyVal("edge1_node", std::to_string(std::get<1>(exc)));
+      wr->keyVal("edge2_node", std::to_string(std::get<2>(exc)));
+      wr->keyVal("route", std::get<0>(exc));
+      wr->close();
+    }
+    wr->close();
+  }
+
+  wr->keyVal("id", std::to_string(n->getId()));
+
+  if (n->pl().notServed().size()) {
+    std::vector<std::string> notServed;
+    for (const auto& no : n->pl().notServed()) notServed.push_back(no->id());
+    std::sort(notServed.begin(), notServed.end());
+
+    wr->key("not_serving");
+    wr->arr();
+    for (const auto& no : notServed) wr->val(no);
+    wr->close();
+  }
+
+  if (n->pl().stops().size()) {
+    wr->keyVal("station_id", n->pl().stops().front().id);
+    wr->keyVal("station_label", n->pl().stops().front().name);
+  }
+
+  wr->close();
+  wr->close();
+}
+
+// _____________________________________________________________________________
+void JsonOutput::printEdg(const LineEdge* e, Writer* wr) const {
+  const auto& geom = *e->pl().getGeom();
+
+  wr->obj();
+  wr->keyVal("type", "Feature");
+  wr->key("geometry");
+  wr->obj();
+  wr->keyVal("type", "LineString");
+  wr->key("coordinates");
+  wr->arr();
+  if (geom.size()) {
+    for (const auto& p : geom) {
+      wr->arr();
+      wr->val(p.getX());
+      wr->val(p.getY());
+      wr->close();
+    }
+  } else {
+    // edges without a geometry are drawn as a straight line
+    for (const LineNode* n : {e->getFrom(), e->getTo()}) {
+      wr->arr();
+      wr->val(n->pl().getGeom()->getX());
+      wr->val(n->pl().getGeom()->getY());
+      wr->close();
+    }
+  }
+  wr->close();
+  wr->close();
+
+  // keys in lexicographical order, as in a JSON dict
+  wr->key("properties");
+  wr->obj();
+
+  std::string dbgLines;
+  for (size_t i = 0; i < e->pl().getLines().size(); i++) {
+    if (i) dbgLines += ",";
+    dbgLines += e->pl().getLines()[i].line->label();
+  }
+  wr->keyVal("dbg_lines", dbgLines);
+  wr->keyVal("from", std::to_string(e->getFrom()->getId()));
+  wr->keyVal("id", std::to_string(e->getId()));
+
+  wr->key("lines");
+  wr->arr();
+  for (const auto& lo : e->pl().getLines()) {
+    wr->obj();
+    wr->keyVal("color", lo.line->color());
+    if (lo.direction) {
+      wr->keyVal("direction", std::to_string(lo.direction->getId()));
+    }
+    wr->keyVal("id", lo.line->id());
+    wr->keyVal("label", lo.line->label());
+    if (!lo.style.isNull()) {
+      if (lo.style.get().getOutlineCss().size()) {
+        wr->keyVal("outline-style", lo.style.get().getOutlineCss());
+      }
+      if (lo.style.get().getCss().size()) {
+        wr->keyVal("style", lo.style.get().getCss());
+      }
+    }
+    wr->close();
+  }
+  wr->close();
+
+  wr->keyVal("to", std::to_string(e->getTo()->getId()));
+
+  wr->close();
+  wr->close();
+}
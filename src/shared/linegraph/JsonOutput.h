@@ -0,0 +1,42 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef SHARED_LINEGRAPH_JSONOUTPUT_H_
+#define SHARED_LINEGRAPH_JSONOUTPUT_H_
+
+#include <ostream>
+#include "shared/linegraph/LineGraph.h"
+#include "util/json/Writer.h"
+
+namespace shared {
+namespace linegraph {
+
+// writes a line graph as GeoJSON. The output is the same as that of
+// util::geo::output::GeoGraphJsonOutput, but the feature properties are
+// written directly from the payloads without building JSON dicts first.
+class JsonOutput {
+ public:
+  JsonOutput() : _prec(10){};
+
+  // coordinates are written with prec decimals, or in their shortest
+  // round-trip representation for util::json::PREC_SHORTEST
+  explicit JsonOutput(size_t prec) : _prec(prec){};
+
+  // print a graph to the provided stream, with optional JSON attributes
+  // written on the graph-level
+  void print(const LineGraph& g, std::ostream& str) const;
+  void print(const LineGraph& g, std::ostream& str,
+             util::json::Val attrs) const;
+
+ private:
+  size_t _prec;
+
+  void printNd(const LineNode* n, util::json::Writer* wr) const;
+  void printEdg(const LineEdge* e, util::json::Writer* wr) const;
+};
+
+}  // namespace linegraph
+}  // namespace shared
+
+#endif  // SHARED_LINEGRAPH_JSONOUTPUT_H_
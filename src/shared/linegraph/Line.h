@@ -24,6 +24,14 @@ class Line {
  private:
   std::string _id, _label, _color;
 };
+
+// orders lines by their id instead of their address, null lines first
+struct LineIdCmp {
+  bool operator()(const Line* a, const Line* b) const {
+    if (!a || !b) return a < b;
+    return a->id() < b->id();
+  }
+};
 }
 }
 
@@ -2,6 +2,7 @@
 // Chair of Algorithms and Data Structures.
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
+#include <algorithm>
 #include "shared/linegraph/Line.h"
 #include "shared/linegraph/LineEdgePL.h"
 #include "shared/linegraph/LineGraph.h"
@@ -10,6 +11,7 @@
 #include "util/String.h"
 #include "util/geo/PolyLine.h"
 
+using shared::linegraph::Line;
 using shared::linegraph::LineEdgePL;
 using shared::linegraph::LineNode;
 using shared::linegraph::LineOcc;
@@ -22,6 +24,13 @@ LineEdgePL::LineEdgePL() : _dontContract(false) {}
 LineEdgePL::LineEdgePL(const PolyLine<double>& p)
     : _dontContract(false), _p(p) {}
 
+// _____________________________________________________________________________
+LineEdgePL::LineEdgePL(const LineEdgePL& other, PolyLine<double> p)
+    : _lineToIdx(other._lineToIdx),
+      _lines(other._lines),
+      _dontContract(other._dontContract),
+      _p(std::move(p)) {}
+
 // _____________________________________________________________________________
 const util::geo::Line<double>* LineEdgePL::getGeom() const {
   return &_p.getLine();
@@ -36,10 +45,37 @@ const PolyLine<double>& LineEdgePL::getPolyline() const { return _p; }
 // _____________________________________________________________________________
 void LineEdgePL::setPolyline(const PolyLine<double>& p) { _p = p; }
 
+// _____________________________________________________________________________
+void LineEdgePL::setPolyline(PolyLine<double>&& p) { _p = std::move(p); }
+
+// _____________________________________________________________________________
+std::vector<std::pair<const Line*, size_t>>::iterator LineEdgePL::lineIdx(
+    const Line* r) {
+  auto it = std::lower_bound(
+      _lineToIdx.begin(), _lineToIdx.end(), r,
+      [](const std::pair<const Line*, size_t>& a, const Line* b) {
+        return a.first < b;
+      });
+  if (it != _lineToIdx.end() && it->first == r) return it;
+  return _lineToIdx.end();
+}
+
+// _____________________________________________________________________________
+std::vector<std::pair<const Line*, size_t>>::const_iterator LineEdgePL::lineIdx(
+    const Line* r) const {
+  auto it = std::lower_bound(
+      _lineToIdx.begin(), _lineToIdx.end(), r,
+      [](const std::pair<const Line*, size_t>& a, const Line* b) {
+        return a.first < b;
+      });
+  if (it != _lineToIdx.end() && it->first == r) return it;
+  return _lineToIdx.end();
+}
+
 // _____________________________________________________________________________
 void LineEdgePL::addLine(const Line* r, const LineNode* dir,
                          util::Nullable<shared::style::LineStyle> ls) {
-  auto f = _lineToIdx.find(r);
+  auto f = lineIdx(r);
   if (f != _lineToIdx.end()) {
     size_t prevIdx = f->second;
     const auto& prev = _lines[prevIdx];
@@ -55,10 +91,14 @@ void LineEdgePL::addLine(const Line* r, const LineNode* dir,
       return;
     }
   }
-  _lineToIdx[r] = _lines.size();
-  LineOcc occ(r, dir, ls);
-  _lines.push_back(occ);
-
+  _lineToIdx.insert(
+      std::upper_bound(
+          _lineToIdx.begin(), _lineToIdx.end(), r,
+          [](const Line* a, const std::pair<const Line*, size_t>& b) {
+            return a < b.first;
+          }),
+      {r, _lines.size()});
+  _lines.push_back(LineOcc(r, dir, ls));
 }
 
 // _____________________________________________________________________________
@@ -68,10 +108,11 @@ void LineEdgePL::addLine(const Line* r, const LineNode* dir) {
 
 // _____________________________________________________________________________
 void LineEdgePL::delLine(const Line* r) {
-  _lineToIdx[_lines.back().line] = _lineToIdx.find(r)->second;
-  _lines[_lineToIdx.find(r)->second] = _lines.back();
+  size_t idx = lineIdx(r)->second;
+  lineIdx(_lines.back().line)->second = idx;
+  _lines[idx] = _lines.back();
   _lines.resize(_lines.size() - 1);
-  _lineToIdx.erase(r);
+  _lineToIdx.erase(lineIdx(r));
 }
 
 // _____________________________________________________________________________
@@ -96,7 +137,7 @@ util::json::Dict LineEdgePL::getAttrs() const {
     }
 
     if (r.direction != 0) {
-      line["direction"] = util::toString(r.direction);
+      line["direction"] = util::toString(r.direction->getId());
       dbg_lines += (!arr.size() ? "" : ",") + r.line->label();
     } else {
       dbg_lines += (!arr.size() ? "" : ",") + r.line->label();
@@ -112,11 +153,13 @@ util::json::Dict LineEdgePL::getAttrs() const {
 }
 
 // _____________________________________________________________________________
-bool LineEdgePL::hasLine(const Line* l) const { return _lineToIdx.count(l); }
+bool LineEdgePL::hasLine(const Line* l) const {
+  return lineIdx(l) != _lineToIdx.end();
+}
 
 // _____________________________________________________________________________
 const LineOcc& LineEdgePL::lineOcc(const Line* l) const {
-  return _lines[_lineToIdx.find(l)->second];
+  return _lines[lineIdx(l)->second];
 }
 
 // _____________________________________________________________________________
@@ -124,7 +167,7 @@ const LineOcc& LineEdgePL::lineOccAtPos(size_t i) const { return _lines[i]; }
 
 // _____________________________________________________________________________
 void LineEdgePL::updateLineOcc(const LineOcc& occ) {
-  _lines[_lineToIdx.find(occ.line)->second] = occ;
+  _lines[lineIdx(occ.line)->second] = occ;
 }
 
 // _____________________________________________________________________________
@@ -132,14 +175,14 @@ void LineEdgePL::writePermutation(const std::vector<size_t> order) {
   std::vector<LineOcc> linesNew(_lines.size());
   for (size_t i = 0; i < order.size(); i++) {
     linesNew[i] = _lines[order[i]];
-    _lineToIdx[_lines[order[i]].line] = i;
+    lineIdx(_lines[order[i]].line)->second = i;
   }
-  _lines = linesNew;
+  _lines = std::move(linesNew);
 }
 
 // _____________________________________________________________________________
 size_t LineEdgePL::linePos(const Line* r) const {
-  auto it = _lineToIdx.find(r);
+  auto it = lineIdx(r);
   if (it == _lineToIdx.end()) return -1;
   return it->second;
 }
@@ -6,6 +6,8 @@
 #define SHARED_LINEGRAPH_LINEEDGEPL_H_
 
 #include <set>
+#include <utility>
+#include <vector>
 
 #include "shared/linegraph/Line.h"
 #include "shared/style/LineStyle.h"
@@ -38,7 +40,7 @@ struct LineOcc {
 };
 
 inline bool operator<(const LineOcc& x, const LineOcc& y) {
-  return x.line < y.line;
+  return LineIdCmp()(x.line, y.line);
 }
 
 class LineEdgePL : util::geograph::GeoEdgePL<double> {
@@ -46,6 +48,9 @@ class LineEdgePL : util::geograph::GeoEdgePL<double> {
   LineEdgePL();
   LineEdgePL(const PolyLine<double>& p);
 
+  // copy the lines of other, but use a new geometry
+  LineEdgePL(const LineEdgePL& other, PolyLine<double> p);
+
   void addLine(const Line* r, const Node<LineNodePL, LineEdgePL>* dir,
                util::Nullable<shared::style::LineStyle> ls);
   void addLine(const Line* r, const Node<LineNodePL, LineEdgePL>* dir);
@@ -68,18 +73,24 @@ class LineEdgePL : util::geograph::GeoEdgePL<double> {
 
   const PolyLine<double>& getPolyline() const;
   void setPolyline(const PolyLine<double>& p);
+  void setPolyline(PolyLine<double>&& p);
 
   void writePermutation(const std::vector<size_t> order);
 
   void setDontContract(bool dontContract) { _dontContract = dontContract; }
-  bool dontContract() { return _dontContract; }
+  bool dontContract() const { return _dontContract; }
 
  private:
-  std::map<const Line*, size_t> _lineToIdx;
+  // sorted by line, maps each line to its position in _lines
+  std::vector<std::pair<const Line*, size_t>> _lineToIdx;
   std::vector<LineOcc> _lines;
   bool _dontContract;
 
   PolyLine<double> _p;
+
+  std::vector<std::pair<const Line*, size_t>>::iterator lineIdx(const Line* r);
+  std::vector<std::pair<const Line*, size_t>>::const_iterator lineIdx(
+      const Line* r) const;
 };
 }  // namespace linegraph
 }  // namespace shared
@@ -2,17 +2,33 @@
 // Chair of Algorithms and Data Structures.
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "3rdparty/json.hpp"
-#include "dot/Parser.h"
+#include "dot/Lexer.h"
+#include "shared/linegraph/BinFormat.h"
 #include "shared/linegraph/LineEdgePL.h"
 #include "shared/linegraph/LineGraph.h"
 #include "shared/linegraph/LineNodePL.h"
 #include "shared/style/LineStyle.h"
+#include "util/MmapFile.h"
 #include "util/String.h"
 #include "util/graph/Edge.h"
 #include "util/graph/Node.h"
 #include "util/log/Log.h"
-
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_max_threads() 1
+#endif
+
+using shared::linegraph::BIN_MAGIC;
+using shared::linegraph::BIN_VERSION;
+using shared::linegraph::BinReader;
 using shared::linegraph::EdgeGrid;
 using shared::linegraph::EdgeOrdering;
 using shared::linegraph::ISect;
@@ -23,108 +39,123 @@ using shared::linegraph::LineNode;
 using shared::linegraph::LineOcc;
 using shared::linegraph::NodeGrid;
 using shared::linegraph::Partner;
+using shared::linegraph::Station;
 using util::geo::DPoint;
 using util::geo::Point;
 
+namespace {
+// approximate size of the chunks of a GeoJSON file decoded in parallel
+const size_t JSON_CHUNK = 1 << 20;
+
+// chunks decoded per thread before they are merged into the graph, to bound
+// the memory of decoded but not yet merged features
+const size_t JSON_CHUNKS_PER_THREAD = 4;
+
+// _____________________________________________________________________________
+inline bool isJsonWs(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+}  // namespace
+
 // _____________________________________________________________________________
 void LineGraph::readFromDot(std::istream* s, double smooth) {
+  std::string buf;
+  char tmp[1 << 16];
+  while (s->read(tmp, sizeof(tmp)) || s->gcount()) buf.append(tmp, s->gcount());
+  readFromDot(buf.data(), buf.size(), smooth);
+}
+
+// _____________________________________________________________________________
+void LineGraph::readFromDot(const char* data, size_t len, double smooth) {
   UNUSED(smooth);
   _bbox = util::geo::Box<double>();
 
-  dot::parser::Parser dp(s);
-  std::map<std::string, LineNode*> idMap;
+  dot::parser::Lexer lx(data, len);
+  dot::parser::Stmt ent;
+
+  const size_t kPos = lx.key("pos");
+  const size_t kStationId = lx.key("station_id");
+  const size_t kLabel = lx.key("label");
+  const size_t kId = lx.key("id");
+  const size_t kColor = lx.key("color");
+
+  // indexed by the interned node IDs of the lexer
+  std::vector<LineNode*> idMap;
 
   size_t eid = 0;
+  std::string tmp;
 
-  while (dp.has()) {
-    auto ent = dp.get();
+  while (lx.next(&ent)) {
+    if (idMap.size() < lx.numIds()) idMap.resize(lx.numIds(), 0);
 
-    if (ent.type == dot::parser::EMPTY) {
-      continue;
-    } else if (ent.type == dot::parser::NODE) {
+    if (ent.type == dot::parser::NODE) {
       // only use nodes with a position
-      if (ent.attrs.find("pos") == ent.attrs.end()) continue;
-      std::string coords = ent.attrs["pos"];
-      std::replace(coords.begin(), coords.end(), ',', ' ');
+      const auto* pos = ent.get(kPos);
+      if (!pos) continue;
 
-      std::stringstream ss;
-      ss << coords;
+      tmp.assign(pos->s, pos->n);
+      std::replace(tmp.begin(), tmp.end(), ',', ' ');
 
-      double x, y;
+      char* end;
+      double x = strtod(tmp.c_str(), &end);
+      double y = strtod(end, 0);
 
-      ss >> x;
-      ss >> y;
-
-      LineNode* n = 0;
-      if (idMap.find(ent.ids.front()) != idMap.end()) {
-        n = idMap[ent.ids.front()];
-      }
-
-      if (!n) {
-        n = addNd(util::geo::Point<double>(x, y));
-        idMap[ent.ids[0]] = n;
-      }
+      LineNode*& n = idMap[ent.ids.front()];
+      if (!n) n = addNd(util::geo::Point<double>(x, y));
 
       expandBBox(*n->pl().getGeom());
 
-      Station i("", "", *n->pl().getGeom());
-      if (ent.attrs.find("station_id") != ent.attrs.end() ||
-          ent.attrs.find("label") != ent.attrs.end()) {
-        if (ent.attrs.find("station_id") != ent.attrs.end())
-          i.id = ent.attrs["station_id"];
-        if (ent.attrs.find("label") != ent.attrs.end())
-          i.name = ent.attrs["label"];
+      const auto* stationId = ent.get(kStationId);
+      const auto* label = ent.get(kLabel);
+
+      if (stationId || label) {
+        Station i("", "", *n->pl().getGeom());
+        if (stationId) i.id = stationId->str();
+        if (label) i.name = label->str();
         n->pl().addStop(i);
       }
     } else if (ent.type == dot::parser::EDGE) {
       eid++;
-      std::string prevId = ent.ids.front();
-      if (idMap.find(prevId) == idMap.end())
-        idMap[prevId] = addNd(util::geo::Point<double>(0, 0));
 
-      for (size_t i = 1; i < ent.ids.size(); ++i) {
-        std::string curId = ent.ids[i];
+      const auto* id = ent.get(kId);
+      const auto* label = ent.get(kLabel);
+      const auto* color = ent.get(kColor);
 
-        if (idMap.find(curId) == idMap.end())
-          idMap[curId] = addNd(util::geo::Point<double>(0, 0));
-        auto e = getEdg(idMap[prevId], idMap[curId]);
+      if (id) {
+        tmp = id->str();
+      } else if (label) {
+        tmp = label->str();
+      } else if (color) {
+        tmp = color->str();
+      } else {
+        tmp = util::toString(eid);
+      }
 
-        if (!e) {
-          PolyLine<double> pl;
-          e = addEdg(idMap[curId], idMap[prevId], pl);
-        }
+      const Line* r = getLine(tmp);
+      if (!r) {
+        r = new Line(tmp, label ? label->str() : "", color ? color->str() : "");
+        addLine(r);
+      }
 
-        std::string id;
-        if (ent.attrs.find("id") != ent.attrs.end()) {
-          id = ent.attrs["id"];
-        } else if (ent.attrs.find("label") != ent.attrs.end()) {
-          id = ent.attrs["label"];
-        } else if (ent.attrs.find("color") != ent.attrs.end()) {
-          id = ent.attrs["color"];
-        } else {
-          id = util::toString(eid);
-        }
+      bool directed = ent.graphType == dot::parser::DIGRAPH ||
+                      ent.graphType == dot::parser::STRICT_DIGRAPH;
 
-        const Line* r = getLine(id);
-        if (!r) {
-          std::string label = ent.attrs.find("label") == ent.attrs.end()
-                                  ? ""
-                                  : ent.attrs["label"];
-          std::string color = ent.attrs.find("color") == ent.attrs.end()
-                                  ? ""
-                                  : ent.attrs["color"];
-          r = new Line(id, label, color);
-          addLine(r);
-        }
+      for (size_t i = 0; i < ent.ids.size(); ++i) {
+        if (!idMap[ent.ids[i]])
+          idMap[ent.ids[i]] = addNd(util::geo::Point<double>(0, 0));
+        if (i == 0) continue;
+
+        LineNode* prev = idMap[ent.ids[i - 1]];
+        LineNode* cur = idMap[ent.ids[i]];
 
-        LineNode* dir = 0;
+        auto e = getEdg(prev, cur);
 
-        if (ent.graphType == dot::parser::DIGRAPH ||
-            ent.graphType == dot::parser::STRICT_DIGRAPH) {
-          dir = idMap[curId];
+        if (!e) {
+          PolyLine<double> pl;
+          e = addEdg(cur, prev, pl);
         }
 
-        e->pl().addLine(r, dir);
+        e->pl().addLine(r, directed ? cur : 0);
       }
     }
   }
@@ -154,224 +185,734 @@ void LineGraph::readFromTopoJson(nlohmann::json::array_t objects,
   throw(std::runtime_error("TopoJSON input not yet implemented."));
 }
 
+// _____________________________________________________________________________
+struct LineGraph::JsonFeature {
+  struct JsonLine {
+    std::string id, label, color, direction, style, outlineStyle;
+    bool hasStyle = false, hasOutlineStyle = false;
+  };
+
+  std::string geomType;
+
+  // flat list of x, y coordinates
+  std::vector<double> coords;
+
+  std::string id, from, to, stationId, stationLabel;
+  bool hasStation = false;
+  bool dontContract = false;
+
+  std::vector<JsonLine> lines;
+
+  std::vector<std::string> notServing;
+
+  // line, edge 1 node, edge 2 node
+  std::vector<std::array<std::string, 3>> connExcs;
+};
+
 // _____________________________________________________________________________
 void LineGraph::readFromGeoJson(nlohmann::json::array_t features,
                                 double smooth) {
+  // feed the DOM through the streaming reader to share a single code path
+  std::stringstream ss;
+  ss << nlohmann::json(features);
+  util::json::Reader r(&ss);
+  r.next();
+  readFromGeoJson(&r, smooth);
+}
+
+// _____________________________________________________________________________
+void LineGraph::readFromGeoJson(util::json::Reader* r, double smooth) {
+  if (r->type() != util::json::Reader::ARR_START) {
+    r->skip();
+    return;
+  }
+
   _bbox = util::geo::Box<double>();
 
-  std::map<std::string, LineNode*> idMap;
+  JsonIdMap ids;
 
-  for (auto feature : features) {
-    auto props = feature["properties"];
-    auto geom = feature["geometry"];
-    if (geom["type"] == "Point") {
-      std::string id = props["id"].get<std::string>();
+  // edges referencing nodes which have not been read yet
+  std::vector<JsonFeature> pendingEdgs;
 
-      std::vector<double> coords = geom["coordinates"];
+  // line exceptions need the lines and edges, they are added at the end
+  std::vector<JsonFeature> pendingExcs;
 
-      LineNode* n = addNd(util::geo::DPoint(coords[0], coords[1]));
-      expandBBox(*n->pl().getGeom());
+  JsonFeature f;
+  while (r->next() != util::json::Reader::ARR_END) {
+    if (r->type() != util::json::Reader::OBJ_START) {
+      r->skip();
+      continue;
+    }
 
-      Station i("", "", *n->pl().getGeom());
-      if (!props["station_id"].is_null() || !props["station_label"].is_null()) {
-        if (!props["station_id"].is_null()) {
-          if (props["station_id"].type() == nlohmann::json::value_t::string) {
-            i.id = props["station_id"].get<std::string>();
-          } else {
-            i.id = props["station_id"].get<std::string>();
-          }
-        }
-        if (!props["station_label"].is_null()) i.name = props["station_label"];
-        n->pl().addStop(i);
+    f = JsonFeature();
+    parseJsonFeature(r, &f);
+    addJsonFeature(&f, &ids, &pendingEdgs, &pendingExcs, smooth);
+  }
+
+  addJsonPending(ids, pendingEdgs, pendingExcs, smooth);
+}
+
+// _____________________________________________________________________________
+void LineGraph::readJsonFeatures(util::json::Reader* r, const char* data,
+                                 size_t len, double smooth) {
+  if (r->type() != util::json::Reader::ARR_START) {
+    r->skip();
+    return;
+  }
+
+  _bbox = util::geo::Box<double>();
+
+  // chunk starts at boundaries between two features. A chunk is confirmed
+  // if the preceding one ends exactly at its start, otherwise (only on
+  // malformed input) it is decoded again from where the preceding one ended.
+  std::vector<size_t> starts =
+      util::json::arrayChunks(data, len, r->pos(), JSON_CHUNK);
+
+  struct Chunk {
+    std::vector<JsonFeature> feats;
+    size_t end = 0;
+    bool arrEnd = false;
+    bool failed = false;
+  };
+
+  JsonIdMap ids;
+  std::vector<JsonFeature> pendingEdgs;
+  std::vector<JsonFeature> pendingExcs;
+
+  size_t cur = starts.front();
+  bool arrEnd = false;
+  size_t round = JSON_CHUNKS_PER_THREAD * omp_get_max_threads();
+
+  for (size_t i = 0; i + 1 < starts.size() && !arrEnd; i += round) {
+    std::vector<Chunk> chunks(std::min(round, starts.size() - 1 - i));
+
+#pragma omp parallel for schedule(dynamic)
+    for (size_t j = 0; j < chunks.size(); j++) {
+      try {
+        chunks[j].end = parseJsonChunk(data, len, starts[i + j],
+                                       starts[i + j + 1], &chunks[j].feats,
+                                       &chunks[j].arrEnd);
+      } catch (const util::json::ReaderException& e) {
+        // a wrong guess, or an error which is reported below
+        chunks[j].failed = true;
+      }
+    }
+
+    // merge in document order
+    for (size_t j = 0; j < chunks.size() && !arrEnd; j++) {
+      if (chunks[j].failed || cur != starts[i + j]) {
+        chunks[j] = Chunk();
+        chunks[j].end = parseJsonChunk(data, len, cur, starts[i + j + 1],
+                                       &chunks[j].feats, &chunks[j].arrEnd);
+      }
+
+      for (auto& f : chunks[j].feats) {
+        addJsonFeature(&f, &ids, &pendingEdgs, &pendingExcs, smooth);
       }
 
-      idMap[id] = n;
+      cur = chunks[j].end;
+      arrEnd = chunks[j].arrEnd;
     }
   }
 
-  // second pass, edges
-  for (auto feature : features) {
-    auto props = feature["properties"];
-    auto geom = feature["geometry"];
-    if (geom["type"] == "LineString") {
-      if (props["lines"].is_null() || props["lines"].size() == 0) continue;
-      std::string from = props["from"].get<std::string>();
-      std::string to = props["to"].get<std::string>();
+  if (!arrEnd) {
+    std::vector<JsonFeature> rest;
+    cur = parseJsonChunk(data, len, cur, len, &rest, &arrEnd);
+    for (auto& f : rest) {
+      addJsonFeature(&f, &ids, &pendingEdgs, &pendingExcs, smooth);
+    }
+  }
 
-      std::vector<std::vector<double>> coords = geom["coordinates"];
+  // continue behind the features array
+  r->seek(cur);
+  r->next();
 
-      PolyLine<double> pl;
-      for (auto coord : coords) {
-        double x = coord[0], y = coord[1];
-        Point<double> p(x, y);
-        pl << p;
-        expandBBox(p);
-      }
+  addJsonPending(ids, pendingEdgs, pendingExcs, smooth);
+}
+
+// _____________________________________________________________________________
+size_t LineGraph::parseJsonChunk(const char* data, size_t len, size_t start,
+                                 size_t end, std::vector<JsonFeature>* feats,
+                                 bool* arrEnd) {
+  size_t p = start;
+  while (true) {
+    // separators are whitespace to the reader
+    while (p < len && (isJsonWs(data[p]) || data[p] == ',' || data[p] == ':'))
+      p++;
+
+    if (p == len) {
+      throw util::json::ReaderException("Unexpected end of input at byte " +
+                                        util::toString(len));
+    }
 
-      pl.applyChaikinSmooth(smooth);
+    if (data[p] == ']') {
+      *arrEnd = true;
+      return p;
+    }
+
+    if (p >= end) return p;
+
+    util::json::Reader r(data + p, len - p, p);
+    if (r.next() == util::json::Reader::OBJ_START) {
+      feats->push_back(JsonFeature());
+      parseJsonFeature(&r, &feats->back());
+    } else {
+      r.skip();
+    }
+    p += r.pos();
+  }
+}
+
+// _____________________________________________________________________________
+void LineGraph::addJsonFeature(JsonFeature* f, JsonIdMap* ids,
+                               std::vector<JsonFeature>* pendingEdgs,
+                               std::vector<JsonFeature>* pendingExcs,
+                               double smooth) {
+  if (f->geomType == "Point") {
+    addJsonNd(*f, ids);
+    if (f->notServing.size() || f->connExcs.size()) {
+      f->coords.clear();
+      pendingExcs->push_back(std::move(*f));
+    }
+  } else if (f->geomType == "LineString") {
+    if (!addJsonEdg(*f, *ids, smooth, false))
+      pendingEdgs->push_back(std::move(*f));
+  }
+}
+
+// _____________________________________________________________________________
+void LineGraph::addJsonPending(const JsonIdMap& ids,
+                               const std::vector<JsonFeature>& pendingEdgs,
+                               const std::vector<JsonFeature>& pendingExcs,
+                               double smooth) {
+  for (const auto& pf : pendingEdgs) addJsonEdg(pf, ids, smooth, true);
+  for (const auto& pf : pendingExcs) addJsonExcs(pf, ids);
 
-      LineNode* fromN = 0;
-      LineNode* toN = 0;
+  _bbox = util::geo::pad(_bbox, 100);
+
+  buildGrids();
+}
+
+// _____________________________________________________________________________
+void LineGraph::parseJsonFeature(util::json::Reader* r, JsonFeature* f) {
+  while (r->next() != util::json::Reader::OBJ_END) {
+    const std::string& key = r->str();
+    if (key == "geometry") {
+      if (r->next() == util::json::Reader::OBJ_START)
+        parseJsonGeom(r, f);
+      else
+        r->skip();
+    } else if (key == "properties") {
+      if (r->next() == util::json::Reader::OBJ_START)
+        parseJsonProps(r, f);
+      else
+        r->skip();
+    } else {
+      r->skipVal();
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void LineGraph::parseJsonGeom(util::json::Reader* r, JsonFeature* f) {
+  while (r->next() != util::json::Reader::OBJ_END) {
+    const std::string& key = r->str();
+    if (key == "type") {
+      f->geomType = r->strVal();
+    } else if (key == "coordinates") {
+      if (r->next() == util::json::Reader::ARR_START)
+        parseJsonCoords(r, &f->coords);
+      else
+        r->skip();
+    } else {
+      r->skipVal();
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void LineGraph::parseJsonCoords(util::json::Reader* r, std::vector<double>* c) {
+  // the innermost arrays are positions, only take their x and y
+  size_t dim = 0;
+  while (r->next() != util::json::Reader::ARR_END) {
+    if (r->type() == util::json::Reader::ARR_START) {
+      parseJsonCoords(r, c);
+    } else if (r->type() == util::json::Reader::NUMBER) {
+      if (dim++ < 2) c->push_back(r->num());
+    } else {
+      r->skip();
+    }
+  }
+}
 
-      if (from.size()) {
-        fromN = idMap[from];
-        if (!fromN) {
-          LOG(ERROR) << "Node \"" << from << "\" not found." << std::endl;
+// _____________________________________________________________________________
+void LineGraph::parseJsonProps(util::json::Reader* r, JsonFeature* f) {
+  while (r->next() != util::json::Reader::OBJ_END) {
+    const std::string& key = r->str();
+    if (key == "id") {
+      f->id = r->strVal();
+    } else if (key == "from") {
+      f->from = r->strVal();
+    } else if (key == "to") {
+      f->to = r->strVal();
+    } else if (key == "station_id") {
+      f->stationId = r->strVal();
+      if (r->type() != util::json::Reader::JSNULL) f->hasStation = true;
+    } else if (key == "station_label") {
+      f->stationLabel = r->strVal();
+      if (r->type() != util::json::Reader::JSNULL) f->hasStation = true;
+    } else if (key == "dontcontract") {
+      f->dontContract = r->numVal(0) != 0;
+    } else if (key == "lines") {
+      if (r->next() == util::json::Reader::ARR_START)
+        parseJsonLines(r, f);
+      else
+        r->skip();
+    } else if (key == "not_serving") {
+      if (r->next() != util::json::Reader::ARR_START) {
+        r->skip();
+        continue;
+      }
+      while (r->next() != util::json::Reader::ARR_END) {
+        if (r->type() == util::json::Reader::STRING)
+          f->notServing.push_back(r->str());
+        else
+          r->skip();
+      }
+    } else if (key == "excluded_line_conns") {
+      if (r->next() != util::json::Reader::ARR_START) {
+        r->skip();
+        continue;
+      }
+      while (r->next() != util::json::Reader::ARR_END) {
+        if (r->type() != util::json::Reader::OBJ_START) {
+          r->skip();
           continue;
         }
-      } else {
-        fromN = addNd(pl.getLine().front());
+        std::array<std::string, 3> exc;
+        while (r->next() != util::json::Reader::OBJ_END) {
+          const std::string& k = r->str();
+          if (k == "route")
+            exc[0] = r->strVal();
+          else if (k == "edge1_node")
+            exc[1] = r->strVal();
+          else if (k == "edge2_node")
+            exc[2] = r->strVal();
+          else
+            r->skipVal();
+        }
+        f->connExcs.push_back(exc);
       }
+    } else {
+      r->skipVal();
+    }
+  }
+}
 
-      if (to.size()) {
-        toN = idMap[to];
-        if (!fromN) {
-          LOG(ERROR) << "Node \"" << to << "\" not found." << std::endl;
-          continue;
-        }
+// _____________________________________________________________________________
+void LineGraph::parseJsonLines(util::json::Reader* r, JsonFeature* f) {
+  while (r->next() != util::json::Reader::ARR_END) {
+    if (r->type() != util::json::Reader::OBJ_START) {
+      r->skip();
+      continue;
+    }
+
+    JsonFeature::JsonLine l;
+    while (r->next() != util::json::Reader::OBJ_END) {
+      const std::string& key = r->str();
+      if (key == "id") {
+        l.id = r->strVal();
+      } else if (key == "label") {
+        l.label = r->strVal();
+      } else if (key == "color") {
+        l.color = r->strVal();
+      } else if (key == "direction") {
+        l.direction = r->strVal();
+      } else if (key == "style") {
+        l.style = r->strVal();
+        l.hasStyle = r->type() != util::json::Reader::JSNULL;
+      } else if (key == "outline-style") {
+        l.outlineStyle = r->strVal();
+        l.hasOutlineStyle = r->type() != util::json::Reader::JSNULL;
       } else {
-        fromN = addNd(pl.getLine().back());
+        r->skipVal();
       }
+    }
+    f->lines.push_back(l);
+  }
+}
 
-      LineEdge* e = addEdg(fromN, toN, pl);
+// _____________________________________________________________________________
+void LineGraph::addJsonNd(const JsonFeature& f, JsonIdMap* ids) {
+  if (f.coords.size() < 2) return;
 
-      if (props["dontcontract"].is_number() && props["dontcontract"].get<int>())
-        e->pl().setDontContract(true);
+  LineNode* n = addNd(util::geo::DPoint(f.coords[0], f.coords[1]));
+  expandBBox(*n->pl().getGeom());
 
-      for (auto line : props["lines"]) {
-        std::string id;
-        if (!line["id"].is_null()) {
-          id = line["id"].get<std::string>();
-        } else if (!line["label"].is_null()) {
-          id = line["label"].get<std::string>();
-        } else if (!line["color"].is_null()) {
-          id = line["color"].get<std::string>();
-        } else
-          continue;
+  if (f.hasStation) {
+    n->pl().addStop(Station(f.stationId, f.stationLabel, *n->pl().getGeom()));
+  }
 
-        const Line* l = getLine(id);
-        if (!l) {
-          std::string label = line["label"].is_null() ? "" : line["label"];
-          std::string color = line["color"];
-          l = new Line(id, label, color);
-          addLine(l);
-        }
+  if (f.id.size()) (*ids)[f.id] = n;
+}
 
-        LineNode* dir = 0;
+// _____________________________________________________________________________
+bool LineGraph::addJsonEdg(const JsonFeature& f, const JsonIdMap& ids,
+                           double smooth, bool force) {
+  if (f.lines.empty()) return true;
+  if (f.coords.size() < 4) return true;
+
+  // check whether all referenced nodes are already known
+  auto fromIt = ids.find(f.from);
+  auto toIt = ids.find(f.to);
+  bool known = (f.from.empty() || fromIt != ids.end()) &&
+               (f.to.empty() || toIt != ids.end());
+  for (const auto& l : f.lines) {
+    if (l.direction.size() && !ids.count(l.direction)) known = false;
+  }
 
-        if (!line["direction"].is_null()) {
-          dir = idMap[line["direction"].get<std::string>()];
-        }
+  if (!known && !force) return false;
 
-        if (!line["style"].is_null() || !line["outline-style"].is_null()) {
-          shared::style::LineStyle ls;
+  if (f.from.size() && fromIt == ids.end()) {
+    LOG(ERROR) << "Node \"" << f.from << "\" not found." << std::endl;
+    return true;
+  }
 
-          if (!line["style"].is_null()) ls.setCss(line["style"]);
-          if (!line["outline-style"].is_null())
-            ls.setOutlineCss(line["outline-style"]);
+  if (f.to.size() && toIt == ids.end()) {
+    LOG(ERROR) << "Node \"" << f.to << "\" not found." << std::endl;
+    return true;
+  }
 
-          e->pl().addLine(l, dir, ls);
-        } else {
-          e->pl().addLine(l, dir);
-        }
-      }
+  PolyLine<double> pl;
+  for (size_t i = 0; i + 1 < f.coords.size(); i += 2) {
+    Point<double> p(f.coords[i], f.coords[i + 1]);
+    pl << p;
+    expandBBox(p);
+  }
+
+  pl.applyChaikinSmooth(smooth);
+
+  LineNode* fromN = f.from.size() ? fromIt->second : addNd(pl.getLine().front());
+  LineNode* toN = f.to.size() ? toIt->second : addNd(pl.getLine().back());
+
+  LineEdge* e = addEdg(fromN, toN, pl);
+
+  if (f.dontContract) e->pl().setDontContract(true);
+
+  for (const auto& line : f.lines) {
+    std::string id;
+    if (line.id.size()) {
+      id = line.id;
+    } else if (line.label.size()) {
+      id = line.label;
+    } else if (line.color.size()) {
+      id = line.color;
+    } else {
+      continue;
+    }
+
+    const Line* l = getLine(id);
+    if (!l) {
+      l = new Line(id, line.label, line.color);
+      addLine(l);
+    }
+
+    LineNode* dir = 0;
+
+    if (line.direction.size()) {
+      auto dirIt = ids.find(line.direction);
+      if (dirIt != ids.end()) dir = dirIt->second;
+    }
+
+    if (line.hasStyle || line.hasOutlineStyle) {
+      shared::style::LineStyle ls;
+
+      if (line.hasStyle) ls.setCss(line.style);
+      if (line.hasOutlineStyle) ls.setOutlineCss(line.outlineStyle);
+
+      e->pl().addLine(l, dir, ls);
+    } else {
+      e->pl().addLine(l, dir);
     }
   }
 
-  // third pass, exceptions (TODO: do this in the first part, store in some
-  // data structure, add here!)
-  for (auto feature : features) {
-    auto props = feature["properties"];
-    auto geom = feature["geometry"];
-    if (geom["type"] == "Point") {
-      std::string id = props["id"].get<std::string>();
+  return true;
+}
 
-      if (!idMap.count(id)) continue;
-      LineNode* n = idMap[id];
+// _____________________________________________________________________________
+void LineGraph::addJsonExcs(const JsonFeature& f, const JsonIdMap& ids) {
+  auto nIt = ids.find(f.id);
+  if (nIt == ids.end()) return;
+  LineNode* n = nIt->second;
 
-      if (!props["not_serving"].is_null()) {
-        for (auto excl : props["not_serving"]) {
-          std::string lid = excl.get<std::string>();
+  for (const auto& lid : f.notServing) {
+    const Line* r = getLine(lid);
 
-          const Line* r = getLine(lid);
+    if (!r) {
+      LOG(WARN) << "line " << lid << " marked as not served in in node "
+                << f.id << ", but no such line exists.";
+      continue;
+    }
 
-          if (!r) {
-            LOG(WARN) << "line " << lid << " marked as not served in in node "
-                      << id << ", but no such line exists.";
-            continue;
-          }
+    n->pl().addLineNotServed(r);
+  }
 
-          n->pl().addLineNotServed(r);
-        }
+  for (const auto& excl : f.connExcs) {
+    const std::string& lid = excl[0];
+    const std::string& nid1 = excl[1];
+    const std::string& nid2 = excl[2];
+
+    const Line* r = getLine(lid);
+
+    if (!r) {
+      LOG(WARN) << "line connection exclude defined in node " << f.id
+                << " for line " << lid << ", but no such line exists.";
+      continue;
+    }
+
+    auto n1 = ids.find(nid1);
+    auto n2 = ids.find(nid2);
+
+    if (n1 == ids.end()) {
+      LOG(WARN) << "line connection exclude defined in node " << f.id
+                << " for edge from " << nid1 << ", but no such node exists.";
+      continue;
+    }
+
+    if (n2 == ids.end()) {
+      LOG(WARN) << "line connection exclude defined in node " << f.id
+                << " for edge from " << nid2 << ", but no such node exists.";
+      continue;
+    }
+
+    LineEdge* a = getEdg(n, n1->second);
+    LineEdge* b = getEdg(n, n2->second);
+
+    if (!a) {
+      LOG(WARN) << "line connection exclude defined in node " << f.id
+                << " for edge from " << nid1 << ", but no such edge exists.";
+      continue;
+    }
+
+    if (!b) {
+      LOG(WARN) << "line connection exclude defined in node " << f.id
+                << " for edge from " << nid2 << ", but no such edge exists.";
+      continue;
+    }
+
+    n->pl().addConnExc(r, a, b);
+  }
+}
+
+// _____________________________________________________________________________
+void LineGraph::readFromJson(std::istream* s, double smooth) {
+  util::json::Reader r(s);
+  readJsonDoc(&r, 0, 0, smooth);
+}
+
+// _____________________________________________________________________________
+void LineGraph::readJsonDoc(util::json::Reader* r, const char* data,
+                            size_t len, double smooth) {
+  if (r->next() != util::json::Reader::OBJ_START)
+    throw util::json::ReaderException("Expected a GeoJSON object.");
+
+  std::string type;
+
+  while (r->next() != util::json::Reader::OBJ_END) {
+    const std::string& key = r->str();
+    if (key == "type") {
+      type = r->strVal();
+      if (type == "Topology") readFromTopoJson({}, {}, smooth);
+    } else if (key == "features") {
+      r->next();
+      if (data) {
+        readJsonFeatures(r, data, len, smooth);
+      } else {
+        readFromGeoJson(r, smooth);
       }
+    } else {
+      r->skipVal();
+    }
+  }
+}
 
-      if (!props["excluded_line_conns"].is_null()) {
-        for (auto excl : props["excluded_line_conns"]) {
-          std::string lid = excl["route"].get<std::string>();
-          std::string nid1 = excl["edge1_node"].get<std::string>();
-          std::string nid2 = excl["edge2_node"].get<std::string>();
+// _____________________________________________________________________________
+void LineGraph::readFromFile(const std::string& path,
+                             const std::string& format, double smooth) {
+  if (format == "geojson") {
+    util::MmapFile f(path);
+    util::json::Reader r(f.data(), f.size(), 0);
+    readJsonDoc(&r, f.data(), f.size(), smooth);
+    return;
+  }
 
-          const Line* r = getLine(lid);
+  if (format == "dot") {
+    util::MmapFile f(path);
+    readFromDot(f.data(), f.size(), smooth);
+    return;
+  }
 
-          if (!r) {
-            LOG(WARN) << "line connection exclude defined in node " << id
-                      << " for line " << lid << ", but no such line exists.";
-            continue;
-          }
+  std::ifstream s(path, std::ios::binary);
+  if (!s.good()) throw std::runtime_error("Could not open " + path);
 
-          if (!idMap.count(nid1)) {
-            LOG(WARN) << "line connection exclude defined in node " << id
-                      << " for edge from " << nid1
-                      << ", but no such node exists.";
-            continue;
-          }
+  if (format == "bin") {
+    readFromBin(&s, smooth);
+  } else {
+    throw std::runtime_error("Unknown input format " + format);
+  }
+}
 
-          if (!idMap.count(nid2)) {
-            LOG(WARN) << "line connection exclude defined in node " << id
-                      << " for edge from " << nid2
-                      << ", but no such node exists.";
-            continue;
-          }
+// _____________________________________________________________________________
+void LineGraph::readFromBin(std::istream* s, double smooth) {
+  BinReader r(s);
+
+  char magic[sizeof(BIN_MAGIC)];
+  r.bytes(magic, sizeof(magic));
+  if (memcmp(magic, BIN_MAGIC, sizeof(magic)))
+    r.err("Not a binary line graph");
+
+  uint64_t version = r.varint();
+  if (version != BIN_VERSION) {
+    r.err("Unsupported binary line graph version " +
+          util::toString(version));
+  }
+
+  // graph attributes are only informational
+  r.str();
 
-          LineNode* n1 = idMap[nid1];
-          LineNode* n2 = idMap[nid2];
+  _bbox = util::geo::Box<double>();
 
-          LineEdge* a = getEdg(n, n1);
-          LineEdge* b = getEdg(n, n2);
+  std::vector<std::string> strs(r.count());
+  for (auto& str : strs) str = r.str();
 
-          if (!a) {
-            LOG(WARN) << "line connection exclude defined in node " << id
-                      << " for edge from " << nid1
-                      << ", but no such edge exists.";
-            continue;
-          }
+  std::vector<const Line*> lines(r.count());
+  for (auto& line : lines) {
+    const std::string& id = strs[r.idx(strs.size())];
+    const std::string& label = strs[r.idx(strs.size())];
+    const std::string& color = strs[r.idx(strs.size())];
 
-          if (!b) {
-            LOG(WARN) << "line connection exclude defined in node " << id
-                      << " for edge from " << nid2
-                      << ", but no such edge exists.";
-            continue;
-          }
+    line = getLine(id);
+    if (!line) {
+      line = new Line(id, label, color);
+      addLine(line);
+    }
+  }
 
-          n->pl().addConnExc(r, a, b);
-        }
+  std::vector<LineNode*> nds(r.count());
+  DPoint prev(0, 0);
+  for (auto& nd : nds) {
+    prev = r.point(prev);
+    nd = addNd(prev);
+    expandBBox(prev);
+
+    size_t numStops = r.count();
+    for (size_t i = 0; i < numStops; i++) {
+      const std::string& id = strs[r.idx(strs.size())];
+      const std::string& name = strs[r.idx(strs.size())];
+      nd->pl().addStop(Station(id, name, r.point(prev)));
+    }
+
+    size_t numNotServed = r.count();
+    for (size_t i = 0; i < numNotServed; i++) {
+      nd->pl().addLineNotServed(lines[r.idx(lines.size())]);
+    }
+  }
+
+  std::vector<LineEdge*> edgs(r.count());
+  for (auto& e : edgs) {
+    LineNode* fr = nds[r.idx(nds.size())];
+    LineNode* to = nds[r.idx(nds.size())];
+    uint8_t flags = r.u8();
+
+    PolyLine<double> pl;
+    size_t numPoints = r.count();
+    DPoint last = *fr->pl().getGeom();
+    for (size_t i = 0; i < numPoints; i++) {
+      last = r.point(last);
+      pl << last;
+      expandBBox(last);
+    }
+
+    pl.applyChaikinSmooth(smooth);
+
+    e = addEdg(fr, to, pl);
+    if (flags & 1) e->pl().setDontContract(true);
+
+    size_t numLines = r.count();
+    for (size_t i = 0; i < numLines; i++) {
+      const Line* l = lines[r.idx(lines.size())];
+      size_t dir = r.idx(nds.size() + 1);
+
+      if (r.u8() & 1) {
+        shared::style::LineStyle ls;
+        ls.setCss(strs[r.idx(strs.size())]);
+        ls.setOutlineCss(strs[r.idx(strs.size())]);
+        e->pl().addLine(l, dir ? nds[dir - 1] : 0, ls);
+      } else {
+        e->pl().addLine(l, dir ? nds[dir - 1] : 0);
       }
     }
   }
 
-  _bbox = util::geo::pad(_bbox, 100);
+  size_t numExcs = r.count();
+  for (size_t i = 0; i < numExcs; i++) {
+    LineNode* n = nds[r.idx(nds.size())];
+    const Line* l = lines[r.idx(lines.size())];
+    LineEdge* a = edgs[r.idx(edgs.size())];
+    LineEdge* b = edgs[r.idx(edgs.size())];
+    n->pl().addConnExc(l, a, b);
+  }
 
+  _bbox = util::geo::pad(_bbox, 100);
   buildGrids();
 }
 
 // _____________________________________________________________________________
-void LineGraph::readFromJson(std::istream* s, double smooth) {
-  nlohmann::json j;
-  (*s) >> j;
+void LineGraph::readFromGraph(LineGraph* other, double smooth) {
+  *this = std::move(*other);
+
+  proced.clear();
+  _lines.clear();
+  _bbox = util::geo::Box<double>();
+
+  // renumber nodes and edges in the order the binary writer would output
+  // them, and drop all state a reader would not restore
+  _nextNdId = 0;
+  _nextEdgId = 0;
+
+  std::vector<LineEdge*> edgs;
+  for (auto n : getNds()) {
+    n->setId(_nextNdId++);
+    n->pl().clearFronts();
+    expandBBox(*n->pl().getGeom());
+    for (auto l : n->pl().notServed()) addLine(l);
+    for (const auto& ro : n->pl().getConnExc()) addLine(ro.first);
+    for (auto e : n->getAdjList()) {
+      if (e->getFrom() == n) edgs.push_back(e);
+    }
+  }
+
+  for (auto e : edgs) {
+    e->setId(_nextEdgId++);
+    for (const auto& p : *e->pl().getGeom()) expandBBox(p);
+    for (const auto& lo : e->pl().getLines()) addLine(lo.line);
+
+    PolyLine<double> pl = e->pl().getPolyline();
+    pl.applyChaikinSmooth(smooth);
+    e->pl().setPolyline(std::move(pl));
+  }
+
+  // a reader adds the edges of a node in id order
+  for (auto n : getNds()) {
+    auto adj = n->getAdjList();
+    std::sort(adj.begin(), adj.end(),
+              util::graph::IdCmp<util::graph::Edge<LineNodePL, LineEdgePL>>());
+    for (auto e : adj) n->removeEdge(e);
+    for (auto e : adj) n->addEdge(e);
+  }
 
-  if (j["type"] == "FeatureCollection") readFromGeoJson(j["features"], smooth);
-  if (j["type"] == "Topology")
-    readFromTopoJson(j["objects"], j["arcs"], smooth);
+  _bbox = util::geo::pad(_bbox, 100);
+  buildGrids();
 }
 
 // _____________________________________________________________________________
@@ -409,11 +950,15 @@ void LineGraph::topologizeIsects() {
 
     double pa = i.a->pl().getPolyline().projectOn(i.bp.p).totalPos;
 
-    auto ba = addEdg(i.b->getFrom(), x, i.b->pl());
-    ba->pl().setPolyline(i.b->pl().getPolyline().getSegment(0, i.bp.totalPos));
+    auto ba = addEdg(
+        i.b->getFrom(), x,
+        LineEdgePL(i.b->pl(),
+                   i.b->pl().getPolyline().getSegment(0, i.bp.totalPos)));
 
-    auto bb = addEdg(x, i.b->getTo(), i.b->pl());
-    bb->pl().setPolyline(i.b->pl().getPolyline().getSegment(i.bp.totalPos, 1));
+    auto bb = addEdg(
+        x, i.b->getTo(),
+        LineEdgePL(i.b->pl(),
+                   i.b->pl().getPolyline().getSegment(i.bp.totalPos, 1)));
 
     edgeRpl(i.b->getFrom(), i.b, ba);
     edgeRpl(i.b->getTo(), i.b, bb);
@@ -424,10 +969,12 @@ void LineGraph::topologizeIsects() {
     _edgeGrid.add(*ba->pl().getGeom(), ba);
     _edgeGrid.add(*bb->pl().getGeom(), bb);
 
-    auto aa = addEdg(i.a->getFrom(), x, i.a->pl());
-    aa->pl().setPolyline(i.a->pl().getPolyline().getSegment(0, pa));
-    auto ab = addEdg(x, i.a->getTo(), i.a->pl());
-    ab->pl().setPolyline(i.a->pl().getPolyline().getSegment(pa, 1));
+    auto aa = addEdg(
+        i.a->getFrom(), x,
+        LineEdgePL(i.a->pl(), i.a->pl().getPolyline().getSegment(0, pa)));
+    auto ab = addEdg(
+        x, i.a->getTo(),
+        LineEdgePL(i.a->pl(), i.a->pl().getPolyline().getSegment(pa, 1)));
 
     edgeRpl(i.a->getFrom(), i.a, aa);
     edgeRpl(i.a->getTo(), i.a, ab);
@@ -594,6 +1141,22 @@ size_t LineGraph::maxDeg() const {
   return ret;
 }
 
+// _____________________________________________________________________________
+size_t LineGraph::geomMemUsage() const {
+  size_t ret = 0;
+  for (auto nd : getNds()) {
+    for (auto e : nd->getAdjList()) {
+      if (e->getFrom() == nd) ret += e->pl().getPolyline().memUsage();
+    }
+  }
+  return ret;
+}
+
+// _____________________________________________________________________________
+size_t LineGraph::gridMemUsage() const {
+  return _nodeGrid.memUsage() + _edgeGrid.memUsage();
+}
+
 // _____________________________________________________________________________
 std::vector<const Line*> LineGraph::getSharedLines(const LineEdge* a,
                                                    const LineEdge* b) {
@@ -778,64 +1341,13 @@ void LineGraph::splitNodes(size_t maxDeg) {
 
 // _____________________________________________________________________________
 void LineGraph::edgeDel(LineNode* n, const LineEdge* oldE) {
-  // remove from from
-  for (auto& r : n->pl().getConnExc()) {
-    auto exFr = r.second.begin();
-    while (exFr != r.second.end()) {
-      if (exFr->first == oldE) {
-        exFr = r.second.erase(exFr);
-      } else {
-        exFr++;
-      }
-    }
-  }
-
-  // remove from to
-  for (auto& r : n->pl().getConnExc()) {
-    for (auto& exFr : r.second) {
-      auto exTo = exFr.second.begin();
-      while (exTo != exFr.second.end()) {
-        if (*exTo == oldE) {
-          exTo = exFr.second.erase(exTo);
-        } else {
-          exTo++;
-        }
-      }
-    }
-  }
+  n->pl().delConnExcEdg(oldE);
 }
 
 // _____________________________________________________________________________
 void LineGraph::edgeRpl(LineNode* n, const LineEdge* oldE,
                         const LineEdge* newE) {
-  if (oldE == newE) return;
-  // replace in from
-  for (auto& r : n->pl().getConnExc()) {
-    auto exFr = r.second.begin();
-    while (exFr != r.second.end()) {
-      if (exFr->first == oldE) {
-        std::swap(r.second[newE], exFr->second);
-        exFr = r.second.erase(exFr);
-      } else {
-        exFr++;
-      }
-    }
-  }
-
-  // replace in to
-  for (auto& r : n->pl().getConnExc()) {
-    for (auto& exFr : r.second) {
-      auto exTo = exFr.second.begin();
-      while (exTo != exFr.second.end()) {
-        if (*exTo == oldE) {
-          exFr.second.insert(newE);
-          exTo = exFr.second.erase(exTo);
-        } else {
-          exTo++;
-        }
-      }
-    }
-  }
+  n->pl().rplConnExcEdg(oldE, newE);
 }
 
 // _____________________________________________________________________________
@@ -5,6 +5,9 @@
 #ifndef SHARED_LINEGRAPH_LINEGRAPH_H_
 #define SHARED_LINEGRAPH_LINEGRAPH_H_
 
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include "3rdparty/json.hpp"
 #include "shared/linegraph/EdgeOrdering.h"
 #include "shared/linegraph/LineEdgePL.h"
@@ -12,6 +15,7 @@
 #include "util/geo/Geo.h"
 #include "util/geo/Grid.h"
 #include "util/graph/UndirGraph.h"
+#include "util/json/Reader.h"
 
 namespace shared {
 namespace linegraph {
@@ -36,21 +40,21 @@ struct Partner {
   const Line* line;
 };
 
-class LineGraph : public util::graph::UndirGraph<LineNodePL, LineEdgePL> {
+class LineGraph : public util::graph::UndirGraph<LineNodePL, LineEdgePL,
+                                                 util::graph::PoolAlloc> {
  public:
   LineGraph() = default;
   LineGraph(const LineGraph& other) = delete;
   void operator=(const LineGraph& other) = delete;
 
-  LineGraph(LineGraph&& other) {
+  LineGraph(LineGraph&& other)
+      : util::graph::UndirGraph<LineNodePL, LineEdgePL,
+                                util::graph::PoolAlloc>(std::move(other)) {
     _bbox = other._bbox;
     proced = other.proced;
     _lines = other._lines;
     _nodeGrid = std::move(other._nodeGrid);
     _edgeGrid = std::move(other._edgeGrid);
-
-    _nodes = other._nodes;
-    other._nodes.clear();
   }
 
   LineGraph& operator=(LineGraph&& other) {
@@ -60,22 +64,49 @@ class LineGraph : public util::graph::UndirGraph<LineNodePL, LineEdgePL> {
     _nodeGrid = std::move(other._nodeGrid);
     _edgeGrid = std::move(other._edgeGrid);
 
-    _nodes = other._nodes;
-    other._nodes.clear();
+    util::graph::UndirGraph<LineNodePL, LineEdgePL, util::graph::PoolAlloc>::
+    operator=(std::move(other));
     return *this;
   }
 
+  // read a GeoJSON document feature by feature, without building a DOM
   virtual void readFromJson(std::istream* s, double smooth);
   virtual void readFromGeoJson(nlohmann::json::array_t, double smooth);
+
+  // read the features array the reader is positioned at
+  virtual void readFromGeoJson(util::json::Reader* r, double smooth);
   virtual void readFromTopoJson(nlohmann::json::array_t objects,
                                 nlohmann::json::array_t arc, double smooth);
   virtual void readFromDot(std::istream* s, double smooth);
 
+  // read a DOT graph from a memory block, which must stay valid during the
+  // call
+  virtual void readFromDot(const char* data, size_t len, double smooth);
+
+  // read a graph in the binary interchange format, see BinFormat.h
+  virtual void readFromBin(std::istream* s, double smooth);
+
+  // read a graph in the given format (geojson, bin or dot) from a file.
+  // GeoJSON files are memory-mapped and their features decoded in parallel
+  virtual void readFromFile(const std::string& path, const std::string& format,
+                            double smooth);
+
+  // take over the graph of another tool stage, which is left empty. The
+  // result is the same as writing other in the binary format and reading it
+  // back in.
+  virtual void readFromGraph(LineGraph* other, double smooth);
+
   const util::geo::Box<double>& getBBox() const;
   void topologizeIsects();
 
   size_t maxDeg() const;
 
+  // estimated bytes of the edge geometries
+  size_t geomMemUsage() const;
+
+  // estimated bytes of the node and edge grids
+  size_t gridMemUsage() const;
+
   // TODO: make the following functions private
   void addLine(const Line* r);
   const Line* getLine(const std::string& id) const;
@@ -151,6 +182,41 @@ class LineGraph : public util::graph::UndirGraph<LineNodePL, LineEdgePL> {
 
   void buildGrids();
 
+  // a single GeoJSON feature, as far as we need it
+  struct JsonFeature;
+  typedef std::unordered_map<std::string, LineNode*> JsonIdMap;
+
+  static void parseJsonFeature(util::json::Reader* r, JsonFeature* f);
+  static void parseJsonGeom(util::json::Reader* r, JsonFeature* f);
+  static void parseJsonCoords(util::json::Reader* r, std::vector<double>* c);
+  static void parseJsonProps(util::json::Reader* r, JsonFeature* f);
+  static void parseJsonLines(util::json::Reader* r, JsonFeature* f);
+
+  // decode the features starting at byte start of the mapped document until
+  // the first feature boundary at or after end, returns the byte position
+  // after the last decoded feature
+  static size_t parseJsonChunk(const char* data, size_t len, size_t start,
+                               size_t end, std::vector<JsonFeature>* feats,
+                               bool* arrEnd);
+
+  void readJsonDoc(util::json::Reader* r, const char* data, size_t len,
+                   double smooth);
+  void readJsonFeatures(util::json::Reader* r, const char* data, size_t len,
+                        double smooth);
+
+  void addJsonFeature(JsonFeature* f, JsonIdMap* ids,
+                      std::vector<JsonFeature>* pendingEdgs,
+                      std::vector<JsonFeature>* pendingExcs, double smooth);
+  void addJsonPending(const JsonIdMap& ids,
+                      const std::vector<JsonFeature>& pendingEdgs,
+                      const std::vector<JsonFeature>& pendingExcs,
+                      double smooth);
+
+  void addJsonNd(const JsonFeature& f, JsonIdMap* ids);
+  bool addJsonEdg(const JsonFeature& f, const JsonIdMap& ids, double smooth,
+                  bool force);
+  void addJsonExcs(const JsonFeature& f, const JsonIdMap& ids);
+
   // TODO: remove this
   std::set<LineEdge*> proced;
   std::map<std::string, const Line*> _lines;
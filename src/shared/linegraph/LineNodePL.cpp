@@ -2,32 +2,65 @@
 // Chair of Algorithms and Data Structures.
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
 #include "shared/linegraph/LineGraph.h"
 #include "shared/linegraph/LineNodePL.h"
 #include "shared/linegraph/NodeFront.h"
 
+using shared::linegraph::ConnEx;
 using shared::linegraph::LineNodePL;
 using shared::linegraph::NodeFront;
+using shared::linegraph::NotServedLines;
 using shared::linegraph::Station;
 using util::geo::DPoint;
 using util::geo::Point;
 
 // _____________________________________________________________________________
-LineNodePL::LineNodePL(Point<double> pos) : _pos(pos) {}
+LineNodePL::LineNodePL(Point<double> pos) : _pos(pos), _excStride(0) {}
 
 // _____________________________________________________________________________
 const Point<double>* LineNodePL::getGeom() const { return &_pos; }
 
 // _____________________________________________________________________________
-void LineNodePL::clearConnExc() { _connEx.clear(); }
+void LineNodePL::clearConnExc() {
+  _excEdgs.clear();
+  _excLines.clear();
+  _excBits.clear();
+  _excStride = 0;
+}
 
 // _____________________________________________________________________________
 size_t LineNodePL::numConnExcs() const {
   size_t ret = 0;
 
-  for (const auto& conn : _connEx) ret += conn.second.size();
+  // exceptions are always stored in both directions
+  for (size_t l = 0; l < _excLines.size(); l++) {
+    for (size_t a = 0; a < _excEdgs.size(); a++) {
+      for (size_t b = a; b < _excEdgs.size(); b++) {
+        if (excBit(l, a, b)) ret++;
+      }
+    }
+  }
+
+  return ret;
+}
+
+// _____________________________________________________________________________
+ConnEx LineNodePL::getConnExc() const {
+  ConnEx ret;
+
+  for (size_t l = 0; l < _excLines.size(); l++) {
+    for (size_t a = 0; a < _excEdgs.size(); a++) {
+      for (size_t b = 0; b < _excEdgs.size(); b++) {
+        if (excBit(l, a, b)) ret[_excLines[l]][_excEdgs[a]].insert(_excEdgs[b]);
+      }
+    }
+  }
 
-  return ret/2; // exceptions are always stored in both directions
+  return ret;
 }
 
 // _____________________________________________________________________________
@@ -54,38 +87,60 @@ std::string LineNodePL::toString() const {
 }
 
 // _____________________________________________________________________________
-util::json::Dict LineNodePL::getAttrs() const {
-  util::json::Dict obj;
-  if (_is.size() > 0) {
-    obj["station_id"] = _is.begin()->id;
-    obj["station_label"] = _is.begin()->name;
-  }
+std::vector<std::tuple<std::string, size_t, size_t>> LineNodePL::getConnExcNds()
+    const {
+  // exceptions are stored in pointer order, sort them by their ids to get a
+  // stable output
+  std::vector<std::tuple<std::string, size_t, size_t>> excs;
 
-  auto arr = util::json::Array();
-
-  for (const auto& ro : _connEx) {
+  for (const auto& ro : getConnExc()) {
     for (const auto& exFr : ro.second) {
       for (const auto* exTo : exFr.second) {
-        util::json::Dict ex;
-        ex["route"] = util::toString(ro.first->id());
         if (exFr.first == exTo) continue;
         auto shrd = LineGraph::sharedNode(exFr.first, exTo);
         if (!shrd) continue;
         auto nd1 = exFr.first->getOtherNd(shrd);
         auto nd2 = exTo->getOtherNd(shrd);
-        ex["edge1_node"] = util::toString(nd1);
-        ex["edge2_node"] = util::toString(nd2);
-        arr.push_back(ex);
+        excs.push_back(
+            std::make_tuple(ro.first->id(), nd1->getId(), nd2->getId()));
       }
     }
   }
 
+  std::sort(excs.begin(), excs.end());
+  return excs;
+}
+
+// _____________________________________________________________________________
+util::json::Dict LineNodePL::getAttrs() const {
+  util::json::Dict obj;
+  if (_is.size() > 0) {
+    obj["station_id"] = _is.begin()->id;
+    obj["station_label"] = _is.begin()->name;
+  }
+
+  auto excs = getConnExcNds();
+
+  auto arr = util::json::Array();
+
+  for (const auto& exc : excs) {
+    util::json::Dict ex;
+    ex["route"] = std::get<0>(exc);
+    ex["edge1_node"] = util::toString(std::get<1>(exc));
+    ex["edge2_node"] = util::toString(std::get<2>(exc));
+    arr.push_back(ex);
+  }
+
   if (arr.size()) obj["excluded_line_conns"] = arr;
 
+  std::vector<std::string> notServed;
+  for (const auto& no : _notServed) notServed.push_back(no->id());
+  std::sort(notServed.begin(), notServed.end());
+
   auto nonServedArr = util::json::Array();
 
-  for (const auto& no : _notServed) {
-    nonServedArr.push_back(util::toString(no->id()));
+  for (const auto& no : notServed) {
+    nonServedArr.push_back(no);
   }
 
   if (nonServedArr.size()) obj["not_serving"] = nonServedArr;
@@ -105,29 +160,174 @@ void LineNodePL::clearStops() { _is.clear(); }
 // _____________________________________________________________________________
 void LineNodePL::addConnExc(const Line* r, const LineEdge* edgeA,
                             const LineEdge* edgeB) {
-  _connEx[r][edgeA].insert(edgeB);
+  if (!edgeA || !edgeB) return;
+  size_t l = addExcLine(r);
+  size_t a = addExcEdg(edgeA);
+  size_t b = addExcEdg(edgeB);
+
+  setExcBit(l, a, b, true);
   // index the other direction also, will lead to faster lookups later on
-  _connEx[r][edgeB].insert(edgeA);
+  setExcBit(l, b, a, true);
 }
 
 // _____________________________________________________________________________
 void LineNodePL::delConnExc(const Line* r, const LineEdge* edgeA,
                             const LineEdge* edgeB) {
-  if (!_connEx.count(r)) return;
-  if (_connEx[r].count(edgeA)) _connEx[r][edgeA].erase(edgeB);
-  if (_connEx[r].count(edgeB)) _connEx[r][edgeB].erase(edgeA);
+  size_t l = excLineId(r);
+  size_t a = excEdgId(edgeA);
+  size_t b = excEdgId(edgeB);
+  if (l == _excLines.size() || a == _excEdgs.size() || b == _excEdgs.size())
+    return;
+
+  setExcBit(l, a, b, false);
+  setExcBit(l, b, a, false);
 }
 
 // _____________________________________________________________________________
 bool LineNodePL::connOccurs(const Line* r, const LineEdge* edgeA,
                             const LineEdge* edgeB) const {
-  const auto& i = _connEx.find(r);
-  if (i == _connEx.end()) return true;
+  size_t l = excLineId(r);
+  if (l == _excLines.size()) return true;
+
+  size_t a = excEdgId(edgeA);
+  if (a == _excEdgs.size()) return true;
+
+  size_t b = excEdgId(edgeB);
+  if (b == _excEdgs.size()) return true;
+
+  return !excBit(l, a, b);
+}
+
+// _____________________________________________________________________________
+void LineNodePL::delConnExcEdg(const LineEdge* e) {
+  size_t id = excEdgId(e);
+  if (id == _excEdgs.size()) return;
+  clearExcEdg(id);
+}
+
+// _____________________________________________________________________________
+void LineNodePL::rplConnExcEdg(const LineEdge* oldE, const LineEdge* newE) {
+  if (oldE == newE) return;
+  size_t o = excEdgId(oldE);
+  if (o == _excEdgs.size()) return;
+
+  size_t n = excEdgId(newE);
+  if (n == _excEdgs.size()) {
+    // simple renaming
+    _excEdgs[o] = newE;
+    return;
+  }
 
-  const auto& ii = i->second.find(edgeA);
-  if (ii == i->second.end()) return true;
+  // the exceptions starting at the old edge replace those of the new edge,
+  // exceptions ending at the old edge are moved to the new edge
+  for (size_t l = 0; l < _excLines.size(); l++) {
+    bool hasRow = false;
+    for (size_t i = 0; i < _excEdgs.size(); i++) hasRow |= excBit(l, o, i);
+    if (hasRow) {
+      for (size_t i = 0; i < _excEdgs.size(); i++) {
+        setExcBit(l, n, i, excBit(l, o, i));
+        setExcBit(l, o, i, false);
+      }
+    }
+    for (size_t i = 0; i < _excEdgs.size(); i++) {
+      if (excBit(l, i, o)) setExcBit(l, i, n, true);
+    }
+  }
+
+  clearExcEdg(o);
+}
+
+// _____________________________________________________________________________
+size_t LineNodePL::excEdgId(const LineEdge* e) const {
+  // the number of edges is bounded by the node degree, a linear scan is
+  // faster than any hashing here
+  if (!e) return _excEdgs.size();
+  for (size_t i = 0; i < _excEdgs.size(); i++) {
+    if (_excEdgs[i] == e) return i;
+  }
+  return _excEdgs.size();
+}
+
+// _____________________________________________________________________________
+size_t LineNodePL::excLineId(const Line* r) const {
+  for (size_t i = 0; i < _excLines.size(); i++) {
+    if (_excLines[i] == r) return i;
+  }
+  return _excLines.size();
+}
+
+// _____________________________________________________________________________
+size_t LineNodePL::addExcEdg(const LineEdge* e) {
+  size_t id = excEdgId(e);
+  if (id != _excEdgs.size()) return id;
+
+  // re-use a free slot
+  for (size_t i = 0; i < _excEdgs.size(); i++) {
+    if (!_excEdgs[i]) {
+      _excEdgs[i] = e;
+      return i;
+    }
+  }
 
-  return ii->second.find(edgeB) == ii->second.end();
+  // grow the matrices by one row and column
+  size_t oldK = _excEdgs.size();
+  size_t newK = oldK + 1;
+  size_t newStride = (newK + 63) / 64;
+
+  std::vector<uint64_t> newBits(_excLines.size() * newK * newStride, 0);
+  for (size_t l = 0; l < _excLines.size(); l++) {
+    for (size_t a = 0; a < oldK; a++) {
+      for (size_t w = 0; w < _excStride; w++) {
+        newBits[(l * newK + a) * newStride + w] =
+            _excBits[(l * oldK + a) * _excStride + w];
+      }
+    }
+  }
+
+  _excBits.swap(newBits);
+  _excStride = newStride;
+  _excEdgs.push_back(e);
+
+  return oldK;
+}
+
+// _____________________________________________________________________________
+size_t LineNodePL::addExcLine(const Line* r) {
+  size_t id = excLineId(r);
+  if (id != _excLines.size()) return id;
+
+  _excLines.push_back(r);
+  _excBits.resize(_excLines.size() * _excEdgs.size() * _excStride, 0);
+
+  return id;
+}
+
+// _____________________________________________________________________________
+bool LineNodePL::excBit(size_t l, size_t a, size_t b) const {
+  size_t row = (l * _excEdgs.size() + a) * _excStride;
+  return (_excBits[row + b / 64] >> (b % 64)) & 1;
+}
+
+// _____________________________________________________________________________
+void LineNodePL::setExcBit(size_t l, size_t a, size_t b, bool v) {
+  size_t row = (l * _excEdgs.size() + a) * _excStride;
+  if (v) {
+    _excBits[row + b / 64] |= uint64_t(1) << (b % 64);
+  } else {
+    _excBits[row + b / 64] &= ~(uint64_t(1) << (b % 64));
+  }
+}
+
+// _____________________________________________________________________________
+void LineNodePL::clearExcEdg(size_t e) {
+  for (size_t l = 0; l < _excLines.size(); l++) {
+    for (size_t i = 0; i < _excEdgs.size(); i++) {
+      setExcBit(l, e, i, false);
+      setExcBit(l, i, e, false);
+    }
+  }
+
+  _excEdgs[e] = 0;
 }
 
 // _____________________________________________________________________________
@@ -163,9 +363,21 @@ void LineNodePL::addFront(const NodeFront& f) {
 }
 
 // _____________________________________________________________________________
-void LineNodePL::addLineNotServed(const Line* r) { _notServed.insert(r); }
+void LineNodePL::clearFronts() {
+  _nodeFronts.clear();
+  _edgToNf.clear();
+}
+
+// _____________________________________________________________________________
+void LineNodePL::addLineNotServed(const Line* r) {
+  auto it = std::lower_bound(_notServed.begin(), _notServed.end(), r);
+  if (it == _notServed.end() || *it != r) _notServed.insert(it, r);
+}
 
 // _____________________________________________________________________________
 bool LineNodePL::lineServed(const Line* r) const {
-  return !_notServed.count(r);
+  return !std::binary_search(_notServed.begin(), _notServed.end(), r);
 }
+
+// _____________________________________________________________________________
+const NotServedLines& LineNodePL::notServed() const { return _notServed; }
@@ -5,6 +5,11 @@
 #ifndef SHARED_LINEGRAPH_LINENODEPL_H_
 #define SHARED_LINEGRAPH_LINENODEPL_H_
 
+#include <cstdint>
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
 #include "shared/linegraph/Line.h"
 #include "shared/linegraph/LineEdgePL.h"
 #include "util/geo/Geo.h"
@@ -21,7 +26,7 @@ typedef std::map<const Line*,
                  std::map<const LineEdge*, std::set<const LineEdge*>>>
     ConnEx;
 
-typedef std::set<const Line*> NotServedLines;
+typedef std::vector<const Line*> NotServedLines;
 
 struct NodeFront {
   NodeFront(LineNode* n, LineEdge* e) : n(n), edge(e) {}
@@ -61,7 +66,7 @@ struct ConnException {
 
 class LineNodePL : util::geograph::GeoNodePL<double> {
  public:
-  LineNodePL(){};
+  LineNodePL() : _excStride(0){};
   LineNodePL(util::geo::Point<double> pos);
 
   const util::geo::Point<double>* getGeom() const;
@@ -79,6 +84,7 @@ class LineNodePL : util::geograph::GeoNodePL<double> {
   const NodeFront* frontFor(const LineEdge* e) const;
 
   void addFront(const NodeFront& f);
+  void clearFronts();
 
   void addConnExc(const Line* r, const LineEdge* edgeA, const LineEdge* edgeB);
 
@@ -87,15 +93,26 @@ class LineNodePL : util::geograph::GeoNodePL<double> {
   bool connOccurs(const Line* r, const LineEdge* edgeA,
                   const LineEdge* edgeB) const;
 
+  // remove all exceptions involving an edge
+  void delConnExcEdg(const LineEdge* e);
+
+  // replace an edge in all exceptions
+  void rplConnExcEdg(const LineEdge* oldE, const LineEdge* newE);
+
   void addLineNotServed(const Line* r);
   bool lineServed(const Line* r) const;
+  const NotServedLines& notServed() const;
 
   void clearConnExc();
 
   size_t numConnExcs() const;
 
-  ConnEx& getConnExc() { return _connEx; }
-  const ConnEx& getConnExc() const { return _connEx; }
+  // the exceptions in map form, only meant for I/O
+  ConnEx getConnExc() const;
+
+  // the exceptions as (line id, other node of edge A, other node of edge B)
+  // id triples, sorted
+  std::vector<std::tuple<std::string, size_t, size_t>> getConnExcNds() const;
 
   std::string toString() const;
 
@@ -106,8 +123,30 @@ class LineNodePL : util::geograph::GeoNodePL<double> {
   std::map<const LineEdge*, size_t> _edgToNf;
   std::vector<NodeFront> _nodeFronts;
 
-  ConnEx _connEx;
+  // edges taking part in an exception at this node, the position of an edge
+  // is its local id, 0 marks a free slot
+  std::vector<const LineEdge*> _excEdgs;
+
+  // lines with exceptions at this node, the position is the local line id
+  std::vector<const Line*> _excLines;
+
+  // for each local line, a row-major bit matrix over the local edge ids
+  std::vector<uint64_t> _excBits;
+
+  // number of words per matrix row
+  size_t _excStride;
+
+  // sorted
   NotServedLines _notServed;
+
+  size_t excEdgId(const LineEdge* e) const;
+  size_t excLineId(const Line* r) const;
+  size_t addExcEdg(const LineEdge* e);
+  size_t addExcLine(const Line* r);
+
+  bool excBit(size_t l, size_t a, size_t b) const;
+  void setExcBit(size_t l, size_t a, size_t b, bool v);
+  void clearExcEdg(size_t e);
 };
 }  // namespace linegraph
 }  // namespace shared
@@ -5,6 +5,7 @@
 #ifndef SHARED_OPTIM_ILPSOLVER_H_
 #define SHARED_OPTIM_ILPSOLVER_H_
 
+#include <cstddef>
 #include <fstream>
 #include <map>
 #include <string>
@@ -66,6 +67,15 @@ class ILPSolver {
   virtual int getNumConstrs() const = 0;
   virtual int getNumVars() const = 0;
 
+  // rough estimate of the bytes used by the model. Solvers keep a name,
+  // bounds and a sparse matrix column or row for every variable and
+  // constraint.
+  size_t memUsage() const {
+    return (static_cast<size_t>(getNumVars()) +
+            static_cast<size_t>(getNumConstrs())) *
+           128;
+  }
+
   virtual void writeMps(const std::string& path) const = 0;
   void writeMst(const std::string& path, const StarterSol& sol) const {
     std::ofstream fo;
@@ -335,7 +335,12 @@ std::vector<util::geo::Polygon<double>> RenderGraph::getIndStopPolys(
     orderedEdgs.push_back({unserved, e});
   }
 
-  std::sort(orderedEdgs.begin(), orderedEdgs.end());
+  std::sort(orderedEdgs.begin(), orderedEdgs.end(),
+            [](const std::pair<size_t, const LineEdge*>& a,
+               const std::pair<size_t, const LineEdge*>& b) {
+              if (a.first != b.first) return a.first < b.first;
+              return a.second->getId() < b.second->getId();
+            });
 
   std::set<const Line*> proced;
 
@@ -618,7 +623,7 @@ std::vector<NodeFront> RenderGraph::getNextMetaNodeCand() const {
     if (n->pl().stops().size()) continue;
     if (getOpenNodeFronts(n).size() != 1) continue;
 
-    std::set<const LineNode*> potClique;
+    std::set<const LineNode*, util::graph::IdCmp<LineNode>> potClique;
 
     std::stack<const LineNode*> nodeStack;
     nodeStack.push(n);
@@ -666,7 +671,9 @@ std::vector<NodeFront> RenderGraph::getNextMetaNodeCand() const {
 }
 
 // _____________________________________________________________________________
-bool RenderGraph::isClique(std::set<const LineNode*> potClique) const {
+bool RenderGraph::isClique(
+    const std::set<const LineNode*, util::graph::IdCmp<LineNode>>& potClique)
+    const {
   if (potClique.size() < 2) return false;
 
   for (const LineNode* a : potClique) {
@@ -105,7 +105,10 @@ class RenderGraph : public shared::linegraph::LineGraph {
   std::vector<shared::linegraph::NodeFront> getOpenNodeFronts(
       const shared::linegraph::LineNode* n) const;
 
-  bool isClique(std::set<const shared::linegraph::LineNode*> potClique) const;
+  bool isClique(
+      const std::set<const shared::linegraph::LineNode*,
+                     util::graph::IdCmp<shared::linegraph::LineNode>>& potClique)
+      const;
 
   std::vector<shared::linegraph::NodeFront> getNextMetaNodeCand() const;
 };
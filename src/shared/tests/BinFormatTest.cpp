@@ -0,0 +1,215 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include "shared/linegraph/BinFormat.h"
+#include "shared/linegraph/BinOutput.h"
+#include "shared/linegraph/LineGraph.h"
+#include "shared/tests/BinFormatTest.h"
+#include "util/Misc.h"
+
+using shared::linegraph::BinFormatException;
+using shared::linegraph::BinOutput;
+using shared::linegraph::Line;
+using shared::linegraph::LineEdge;
+using shared::linegraph::LineGraph;
+using shared::linegraph::LineNode;
+using shared::linegraph::Station;
+using shared::style::LineStyle;
+using util::geo::DPoint;
+using util::geo::PolyLine;
+
+namespace {
+// _____________________________________________________________________________
+uint64_t bits(double d) {
+  uint64_t ret;
+  std::memcpy(&ret, &d, sizeof(d));
+  return ret;
+}
+
+// _____________________________________________________________________________
+double negZero() {
+  // -0.0 literals are folded to 0 with -fno-signed-zeros
+  uint64_t b = 0x8000000000000000ULL;
+  double ret;
+  std::memcpy(&ret, &b, sizeof(ret));
+  return ret;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void BinFormatTest::run() {
+  LineGraph g;
+
+  const Line* a = new Line("A", "A\"1", "ff0000");
+  const Line* b = new Line("B", "B", "0000ff");
+  const Line* c = new Line("C", "", "");
+  g.addLine(a);
+  g.addLine(b);
+  g.addLine(c);
+
+  // coordinates which are not representable in decimal
+  LineNode* n1 = g.addNd(DPoint(0.1, 1.0 / 3));
+  LineNode* n2 = g.addNd(DPoint(10.0 / 7, negZero()));
+  LineNode* n3 = g.addNd(DPoint(-1e-300, 8e300));
+  LineNode* n4 = g.addNd(DPoint(873838.4254750526, 6099451.017543876));
+
+  n1->pl().addStop(Station("s1", "Stat\xC3\xA4on", DPoint(0.1, 0.3)));
+  n1->pl().addStop(Station("s2", "", DPoint(0.2, 0.3)));
+
+  PolyLine<double> pl;
+  pl << DPoint(0.1, 1.0 / 3) << DPoint(0.7, 0.9) << DPoint(10.0 / 7, negZero());
+  LineEdge* e12 = g.addEdg(n1, n2, pl);
+  LineEdge* e23 = g.addEdg(n2, n3, PolyLine<double>());
+  LineEdge* e24 = g.addEdg(n4, n2, PolyLine<double>(DPoint(873838.4254750526,
+                                                           6099451.017543876),
+                                                    DPoint(10.0 / 7, 0)));
+
+  LineStyle ls;
+  ls.setCss("dashed");
+  ls.setOutlineCss("");
+
+  // insertion order is the line ordering and has to be kept
+  e12->pl().addLine(c, 0);
+  e12->pl().addLine(a, n2);
+  e12->pl().addLine(b, 0, ls);
+  e23->pl().addLine(a, n2);
+  e24->pl().addLine(b, n4);
+  e24->pl().addLine(a, 0);
+  e12->pl().setDontContract(true);
+
+  n2->pl().addLineNotServed(c);
+  n2->pl().addConnExc(a, e12, e23);
+
+  std::stringstream bin;
+  BinOutput().print(g, bin, util::json::Dict{{"a", 1}});
+  std::string binStr = bin.str();
+
+  LineGraph h;
+  h.readFromBin(&bin, 0);
+
+  TEST(h.numNds(), ==, 4);
+  TEST(h.numEdgs(), ==, 3);
+  TEST(h.numLines(), ==, 3);
+  TEST(h.getLine("A")->label(), ==, "A\"1");
+  TEST(h.getLine("C")->color(), ==, "");
+
+  std::vector<LineNode*> nds(h.getNds().begin(), h.getNds().end());
+  TEST(nds.size(), ==, 4);
+
+  // coordinates are bit-exact
+  TEST(*nds[0]->pl().getGeom() == *n1->pl().getGeom());
+  TEST(*nds[1]->pl().getGeom() == *n2->pl().getGeom());
+  TEST(*nds[2]->pl().getGeom() == *n3->pl().getGeom());
+  TEST(*nds[3]->pl().getGeom() == *n4->pl().getGeom());
+  TEST(bits(nds[1]->pl().getGeom()->getY()), ==, bits(negZero()));
+
+  TEST(nds[0]->pl().stops().size(), ==, 2);
+  TEST(nds[0]->pl().stops()[0].name, ==, "Stat\xC3\xA4on");
+  TEST(nds[0]->pl().stops()[1].id, ==, "s2");
+  TEST(nds[0]->pl().stops()[1].pos == DPoint(0.2, 0.3));
+
+  const Line* ha = h.getLine("A");
+  const Line* hb = h.getLine("B");
+  const Line* hc = h.getLine("C");
+
+  LineEdge* h12 = h.getEdg(nds[0], nds[1]);
+  LineEdge* h23 = h.getEdg(nds[1], nds[2]);
+  LineEdge* h24 = h.getEdg(nds[3], nds[1]);
+  TEST(h12);
+  TEST(h23);
+  TEST(h24);
+  TEST(h24->getFrom() == nds[3]);
+
+  TEST(h12->pl().getGeom()->size(), ==, 3);
+  TEST((*h12->pl().getGeom())[1] == DPoint(0.7, 0.9));
+  TEST(h23->pl().getGeom()->size(), ==, 0);
+
+  TEST(h12->pl().dontContract());
+  TEST(!h23->pl().dontContract());
+
+  TEST(h12->pl().getLines().size(), ==, 3);
+  TEST(h12->pl().getLines()[0].line == hc);
+  TEST(h12->pl().getLines()[1].line == ha);
+  TEST(h12->pl().getLines()[1].direction == nds[1]);
+  TEST(h12->pl().getLines()[2].line == hb);
+  TEST(h12->pl().getLines()[2].direction == 0);
+  TEST(h12->pl().getLines()[2].style.get().getCss(), ==, "dashed");
+  TEST(h12->pl().getLines()[0].style.isNull());
+  TEST(h24->pl().getLines()[0].line == hb);
+  TEST(h24->pl().getLines()[0].direction == nds[3]);
+
+  TEST(!nds[1]->pl().lineServed(hc));
+  TEST(nds[1]->pl().lineServed(ha));
+  TEST(!nds[1]->pl().connOccurs(ha, h12, h23));
+  TEST(nds[1]->pl().connOccurs(hb, h12, h24));
+  TEST(nds[1]->pl().numConnExcs(), ==, n2->pl().numConnExcs());
+
+  // writing the read graph again gives the same bytes
+  std::stringstream bin2;
+  BinOutput().print(h, bin2, util::json::Dict{{"a", 1}});
+  TEST(bin2.str() == binStr);
+
+  // taking over the graph in memory is the same as a write and read
+  {
+    LineGraph k;
+    k.readFromGraph(&g, 0);
+    TEST(g.numNds(), ==, 0);
+    TEST(k.numNds(), ==, 4);
+    TEST(k.numLines(), ==, 3);
+
+    std::stringstream bin3;
+    BinOutput().print(k, bin3, util::json::Dict{{"a", 1}});
+    TEST(bin3.str() == binStr);
+
+    size_t id = 0;
+    for (auto nd : k.getNds()) TEST(nd->getId(), ==, id++);
+    TEST(k.getBBox().getLowerLeft() == h.getBBox().getLowerLeft());
+    TEST(k.getBBox().getUpperRight() == h.getBBox().getUpperRight());
+  }
+
+  // truncated input
+  for (size_t i : {0, 3, 7, 20}) {
+    std::stringstream trunc(binStr.substr(0, i));
+    LineGraph t;
+    bool thrown = false;
+    try {
+      t.readFromBin(&trunc, 0);
+    } catch (const BinFormatException& e) {
+      thrown = true;
+    }
+    TEST(thrown);
+  }
+
+  // element counts larger than the input are rejected before allocating
+  {
+    // magic, version 1, empty attributes, string count 2^62
+    std::string huge("LGRB\x01\x00\x80\x80\x80\x80\x80\x80\x80\x80\x40",
+                     15);
+    std::stringstream hugeCnt(huge);
+    LineGraph t;
+    bool thrown = false;
+    try {
+      t.readFromBin(&hugeCnt, 0);
+    } catch (const BinFormatException& e) {
+      thrown = true;
+    }
+    TEST(thrown);
+  }
+
+  // GeoJSON is not accepted
+  {
+    std::stringstream json("{\"type\": \"FeatureCollection\"}");
+    LineGraph t;
+    bool thrown = false;
+    try {
+      t.readFromBin(&json, 0);
+    } catch (const BinFormatException& e) {
+      thrown = true;
+    }
+    TEST(thrown);
+  }
+}
@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef SHARED_TEST_BINFORMATTEST_H_
+#define SHARED_TEST_BINFORMATTEST_H_
+
+class BinFormatTest {
+  public:
+    void run();
+};
+
+#endif
@@ -0,0 +1,144 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <map>
+#include <sstream>
+#include <string>
+#include "dot/Lexer.h"
+#include "dot/Parser.h"
+#include "shared/linegraph/LineGraph.h"
+#include "shared/tests/DotTest.h"
+#include "util/Misc.h"
+
+using dot::parser::Lexer;
+using dot::parser::Parser;
+using dot::parser::Stmt;
+using shared::linegraph::LineGraph;
+using shared::linegraph::LineNode;
+
+// _____________________________________________________________________________
+void DotTest::run() {
+  std::string dot =
+      "digraph \"g\" {\n"
+      "  graph [splines=true];\n"
+      "  node [shape=circle]\n"
+      "  rankdir = LR\n"
+      "  a [pos=\"0,0\", label=\"Haupt bf\", station_id=s1];\n"
+      "  b [pos=\"10,0\"] c [pos = \"10,10\" color=red]\n"
+      "  subgraph x {\n"
+      "    a -> b -> c [color=\"ff0000\", id=A];\n"
+      "  }\n"
+      "  { b -> c [label=B color=\"0000ff\"] }\n"
+      "  a -> d\n"
+      "}\n";
+
+  {
+    // the lexer returns the same statements as the stream parser
+    std::stringstream ss(dot);
+    Parser p(&ss);
+    Lexer lx(dot.data(), dot.size());
+    Stmt s;
+
+    std::vector<dot::parser::Entity> ents;
+    while (p.has()) {
+      auto ent = p.get();
+      if (ent.type != dot::parser::EMPTY) ents.push_back(ent);
+    }
+
+    size_t i = 0;
+    while (lx.next(&s)) {
+      TEST(i, <, ents.size());
+      TEST(s.type, ==, ents[i].type);
+      TEST(s.graphType, ==, dot::parser::DIGRAPH);
+      TEST(s.ids.size(), ==, ents[i].ids.size());
+      for (size_t j = 0; j < s.ids.size(); j++) {
+        TEST(lx.id(s.ids[j]).str(), ==, ents[i].ids[j]);
+      }
+
+      std::map<std::string, std::string> attrs;
+      for (const auto& kv : s.attrs) {
+        attrs[lx.attrKey(kv.first).str()] = kv.second.str();
+      }
+      TEST(attrs == ents[i].attrs);
+      i++;
+    }
+    TEST(i, ==, ents.size());
+  }
+
+  {
+    // escape sequences are kept, the last of repeated keys wins
+    std::string d = "strict graph{a[label=\"x\\\"y\" label=z][color=red]}";
+    Lexer lx(d.data(), d.size());
+    size_t label = lx.key("label");
+    size_t color = lx.key("color");
+    Stmt s;
+    TEST(lx.next(&s));
+    TEST(s.graphType, ==, dot::parser::STRICT_GRAPH);
+    TEST(s.attrs.size(), ==, 3);
+    TEST(s.attrs[0].second.str(), ==, "x\\\"y");
+    TEST(s.get(label)->str(), ==, "z");
+    TEST(s.get(color)->str(), ==, "red");
+    TEST(!lx.next(&s));
+  }
+
+  {
+    // comments, HTML strings and numerals
+    std::string d =
+        "graph {\n"
+        "  // a comment\n"
+        "  1 -- -2.5 [label=<<b>x</b>>] /* another\n"
+        "  comment */\n"
+        "# a preprocessor line\n"
+        "}";
+    Lexer lx(d.data(), d.size());
+    size_t label = lx.key("label");
+    Stmt s;
+    TEST(lx.next(&s));
+    TEST(s.type, ==, dot::parser::EDGE);
+    TEST(lx.id(s.ids[0]).str(), ==, "1");
+    TEST(lx.id(s.ids[1]).str(), ==, "-2.5");
+    TEST(s.get(label)->str(), ==, "<b>x</b>");
+    TEST(!lx.next(&s));
+  }
+
+  {
+    std::stringstream ss(dot);
+    LineGraph g;
+    g.readFromDot(&ss, 0);
+
+    // d has no position, but is referenced by an edge
+    TEST(g.numNds(), ==, 4);
+    TEST(g.numEdgs(), ==, 3);
+    TEST(g.numLines(), ==, 3);
+
+    const auto* a = g.getLine("A");
+    const auto* b = g.getLine("B");
+    TEST(a);
+    TEST(b);
+    TEST(a->color(), ==, "ff0000");
+    TEST(b->label(), ==, "B");
+
+    LineNode* na = 0;
+    LineNode* nb = 0;
+    LineNode* nc = 0;
+    for (auto n : g.getNds()) {
+      if (n->pl().stops().size()) na = n;
+      if (n->pl().getGeom()->getX() == 10 && n->pl().getGeom()->getY() == 0)
+        nb = n;
+      if (n->pl().getGeom()->getY() == 10) nc = n;
+    }
+
+    TEST(na);
+    TEST(nb);
+    TEST(nc);
+    TEST(na->pl().stops().front().id, ==, "s1");
+    TEST(na->pl().stops().front().name, ==, "Haupt bf");
+
+    auto ebc = g.getEdg(nb, nc);
+    TEST(ebc);
+    TEST(ebc->pl().getLines().size(), ==, 2);
+    TEST(ebc->pl().lineOcc(a).direction == nc);
+    TEST(ebc->pl().lineOcc(b).direction == nc);
+    TEST(g.getEdg(na, nb)->pl().getLines().size(), ==, 1);
+  }
+}
@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef SHARED_TEST_DOTTEST_H_
+#define SHARED_TEST_DOTTEST_H_
+
+class DotTest {
+  public:
+    void run();
+};
+
+#endif
@@ -0,0 +1,96 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <sstream>
+#include <string>
+#include "shared/linegraph/JsonOutput.h"
+#include "shared/linegraph/LineGraph.h"
+#include "shared/tests/JsonOutputTest.h"
+#include "util/Misc.h"
+#include "util/geo/output/GeoGraphJsonOutput.h"
+
+using shared::linegraph::JsonOutput;
+using shared::linegraph::Line;
+using shared::linegraph::LineEdge;
+using shared::linegraph::LineGraph;
+using shared::linegraph::LineNode;
+using shared::linegraph::Station;
+using shared::style::LineStyle;
+using util::geo::DPoint;
+using util::geo::PolyLine;
+
+// _____________________________________________________________________________
+void JsonOutputTest::run() {
+  LineGraph g;
+
+  const Line* a = new Line("A", "A\"1", "ff0000");
+  const Line* b = new Line("B", "B", "0000ff");
+  const Line* c = new Line("C", "", "");
+  g.addLine(a);
+  g.addLine(b);
+  g.addLine(c);
+
+  LineNode* n1 = g.addNd(DPoint(0.1, 1.0 / 3));
+  LineNode* n2 = g.addNd(DPoint(10.0 / 7, -0.0));
+  LineNode* n3 = g.addNd(DPoint(873838.4254750526, 6099451.017543876));
+  LineNode* n4 = g.addNd(DPoint(-5, 7));
+
+  n1->pl().addStop(Station("s1", "Stat\xC3\xA4on\n", DPoint(0.1, 0.3)));
+
+  PolyLine<double> pl;
+  pl << DPoint(0.1, 1.0 / 3) << DPoint(0.7, 0.9) << DPoint(10.0 / 7, -0.0);
+  LineEdge* e12 = g.addEdg(n1, n2, pl);
+  LineEdge* e23 = g.addEdg(n2, n3, PolyLine<double>());
+  LineEdge* e42 = g.addEdg(n4, n2, PolyLine<double>(DPoint(-5, 7),
+                                                    DPoint(10.0 / 7, 0)));
+
+  LineStyle ls;
+  ls.setCss("dashed");
+  ls.setOutlineCss("x");
+
+  e12->pl().addLine(c, 0);
+  e12->pl().addLine(a, n2);
+  e12->pl().addLine(b, 0, ls);
+  e23->pl().addLine(a, n2);
+  e42->pl().addLine(b, n4);
+  e42->pl().addLine(a, 0);
+
+  n2->pl().addLineNotServed(c);
+  n2->pl().addLineNotServed(b);
+  n2->pl().addConnExc(a, e12, e23);
+
+  // the direct output is the same as the generic one
+  {
+    std::stringstream exp, got;
+    util::geo::output::GeoGraphJsonOutput().print(g, exp);
+    JsonOutput().print(g, got);
+    TEST(got.str(), ==, exp.str());
+  }
+
+  {
+    std::stringstream exp, got;
+    util::json::Dict attrs{{"a", 1}, {"b", util::json::Array{1.5, "x"}}};
+    util::geo::output::GeoGraphJsonOutput().print(g, exp, attrs);
+    JsonOutput().print(g, got, attrs);
+    TEST(got.str(), ==, exp.str());
+  }
+
+  // shortest output reads back exactly
+  {
+    std::stringstream ss;
+    JsonOutput(util::json::PREC_SHORTEST).print(g, ss);
+
+    LineGraph h;
+    h.readFromJson(&ss, 0);
+    TEST(h.numNds(), ==, 4);
+    TEST(h.numEdgs(), ==, 3);
+
+    for (auto nd : h.getNds()) {
+      bool found = false;
+      for (auto orig : g.getNds()) {
+        if (*orig->pl().getGeom() == *nd->pl().getGeom()) found = true;
+      }
+      TEST(found);
+    }
+  }
+}
@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef SHARED_TEST_JSONOUTPUTTEST_H_
+#define SHARED_TEST_JSONOUTPUTTEST_H_
+
+class JsonOutputTest {
+  public:
+    void run();
+};
+
+#endif
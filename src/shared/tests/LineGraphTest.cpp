@@ -0,0 +1,167 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "shared/linegraph/LineGraph.h"
+#include "shared/tests/LineGraphTest.h"
+#include "util/Misc.h"
+
+using shared::linegraph::LineEdge;
+using shared::linegraph::LineGraph;
+using shared::linegraph::LineNode;
+
+// _____________________________________________________________________________
+void LineGraphTest::run() {
+  // edges before the nodes they reference, escaped strings, unknown members
+  std::string json =
+      "{\"features\": ["
+      "{\"type\": \"Feature\", \"properties\": {\"from\": \"1\", \"to\": \"2\","
+      "\"lines\": [{\"id\": \"A\", \"label\": \"\\u0041\\\"1\", \"color\": "
+      "\"ff0000\", \"direction\": \"2\"}, {\"label\": \"B\", \"color\": "
+      "\"0000ff\", \"style\": \"dashed\"}], \"dontcontract\": 1},"
+      "\"geometry\": {\"type\": \"LineString\", \"coordinates\": [[0, 0, 5], "
+      "[10, 0, 5]]}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"LineString\", "
+      "\"coordinates\": [[10, 0], [20, 0]]}, \"properties\": {\"from\": \"2\","
+      "\"to\": \"3\", \"lines\": [{\"id\": \"A\", \"color\": \"ff0000\"}]}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"LineString\", "
+      "\"coordinates\": [[10, 0], [10, 10]]}, \"properties\": {\"from\": "
+      "\"2\", \"to\": \"4\", \"lines\": []}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+      "\"coordinates\": [0, 0]}, \"properties\": {\"id\": \"1\", "
+      "\"station_id\": \"s1\", \"station_label\": \"Stat\\u00e4on\","
+      "\"extra\": {\"a\": [1, {\"b\": null}]}}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+      "\"coordinates\": [10, 0]}, \"properties\": {\"id\": \"2\", "
+      "\"not_serving\": [\"B\"], \"excluded_line_conns\": [{\"route\": \"A\","
+      "\"edge1_node\": \"1\", \"edge2_node\": \"3\"}]}},"
+      "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+      "\"coordinates\": [20, 0]}, \"properties\": {\"id\": 3}}"
+      "], \"type\": \"FeatureCollection\"}";
+
+  {
+    std::stringstream ss(json);
+    LineGraph g;
+    g.readFromJson(&ss, 0);
+
+    TEST(g.numNds(), ==, 3);
+    TEST(g.numEdgs(), ==, 2);
+    TEST(g.numLines(), ==, 2);
+
+    const auto* a = g.getLine("A");
+    const auto* b = g.getLine("B");
+    TEST(a);
+    TEST(b);
+    TEST(a->label(), ==, "A\"1");
+    TEST(b->color(), ==, "0000ff");
+
+    LineNode* n1 = 0;
+    LineNode* n2 = 0;
+    LineNode* n3 = 0;
+    for (auto n : g.getNds()) {
+      if (n->pl().getGeom()->getX() == 0) n1 = n;
+      if (n->pl().getGeom()->getX() == 10) n2 = n;
+      if (n->pl().getGeom()->getX() == 20) n3 = n;
+    }
+
+    TEST(n1);
+    TEST(n2);
+    TEST(n3);
+
+    TEST(n1->pl().stops().size(), ==, 1);
+    TEST(n1->pl().stops().front().id, ==, "s1");
+    TEST(n1->pl().stops().front().name, ==, "Stat\xC3\xA4on");
+    TEST(n2->pl().stops().size(), ==, 0);
+
+    LineEdge* e12 = g.getEdg(n1, n2);
+    LineEdge* e23 = g.getEdg(n2, n3);
+    TEST(e12);
+    TEST(e23);
+
+    TEST(e12->pl().dontContract());
+    TEST(!e23->pl().dontContract());
+    TEST(e12->pl().getLines().size(), ==, 2);
+    TEST(e12->pl().lineOcc(a).direction == n2);
+    TEST(e12->pl().lineOcc(b).direction == 0);
+    TEST(!e12->pl().lineOcc(b).style.isNull());
+
+    TEST(!n2->pl().lineServed(b));
+    TEST(n2->pl().lineServed(a));
+    TEST(!n2->pl().connOccurs(a, e12, e23));
+  }
+
+  {
+    // the DOM based reader gives the same graph
+    nlohmann::json j = nlohmann::json::parse(json);
+    LineGraph g;
+    g.readFromGeoJson(j["features"], 0);
+
+    TEST(g.numNds(), ==, 3);
+    TEST(g.numEdgs(), ==, 2);
+    TEST(g.numLines(), ==, 2);
+    TEST(g.getLine("A")->label(), ==, "A\"1");
+  }
+
+  {
+    // the memory mapped file reader gives the same graph
+    std::string path = "/tmp/loom-linegraph-test.json";
+    std::ofstream out(path);
+    out << json;
+    out.close();
+
+    LineGraph g;
+    g.readFromFile(path, "geojson", 0);
+    std::remove(path.c_str());
+
+    TEST(g.numNds(), ==, 3);
+    TEST(g.numEdgs(), ==, 2);
+    TEST(g.numLines(), ==, 2);
+    TEST(g.getLine("A")->label(), ==, "A\"1");
+    TEST(g.getLine("B")->color(), ==, "0000ff");
+  }
+
+  {
+    // a multi-line network large enough to be decoded in several chunks
+    std::stringstream big;
+    big << "{\"type\": \"FeatureCollection\", \"features\": [";
+    for (size_t i = 0; i < 20000; i++) {
+      big << "{\"type\": \"Feature\", \"geometry\": {\"type\": "
+          << "\"LineString\", \"coordinates\": [[" << i * 10 << ", 0], ["
+          << (i + 1) * 10 << ", 0]]}, \"properties\": {\"from\": \"" << i
+          << "\", \"to\": \"" << i + 1 << "\", \"lines\": [{\"id\": "
+          << "\"A\", \"color\": \"ff0000\"}, {\"id\": \"B\", \"color\": "
+          << "\"00ff00\"}, {\"id\": \"C\", \"color\": \"0000ff\"}]}}, ";
+    }
+    for (size_t i = 0; i <= 20000; i++) {
+      big << "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+          << "\"coordinates\": [" << i * 10 << ", 0]}, \"properties\": "
+          << "{\"id\": \"" << i << "\", \"excluded_line_conns\": [";
+      if (i > 0 && i < 20000) {
+        big << "{\"route\": \"A\", \"edge1_node\": \"" << i - 1
+            << "\", \"edge2_node\": \"" << i + 1 << "\"}";
+      }
+      big << "]}}" << (i < 20000 ? ", " : "");
+    }
+    big << "]}";
+    TEST(big.str().size(), >, 4 << 20);
+
+    std::string path = "/tmp/loom-linegraph-test-big.json";
+    std::ofstream out(path);
+    out << big.str();
+    out.close();
+
+    LineGraph g, h;
+    g.readFromFile(path, "geojson", 0);
+    std::remove(path.c_str());
+    h.readFromJson(&big, 0);
+
+    TEST(g.numNds(), ==, 20001);
+    TEST(g.numEdgs(), ==, 20000);
+    TEST(g.numLines(), ==, 3);
+    TEST(g.numNds(), ==, h.numNds());
+    TEST(g.numEdgs(), ==, h.numEdgs());
+  }
+}
@@ -0,0 +1,90 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include "shared/linegraph/LineGraph.h"
+#include "shared/tests/LineNodePLTest.h"
+#include "util/Misc.h"
+
+using shared::linegraph::Line;
+using shared::linegraph::LineEdge;
+using shared::linegraph::LineEdgePL;
+using shared::linegraph::LineGraph;
+using shared::linegraph::LineNode;
+
+// _____________________________________________________________________________
+void LineNodePLTest::run() {
+  {
+    LineGraph g;
+    auto a = g.addNd({{0.0, 0.0}});
+    auto b = g.addNd({{10.0, 0.0}});
+    auto c = g.addNd({{20.0, 0.0}});
+    auto d = g.addNd({{10.0, 10.0}});
+    auto e = g.addNd({{10.0, -10.0}});
+
+    auto ab = g.addEdg(a, b, LineEdgePL());
+    auto bc = g.addEdg(b, c, LineEdgePL());
+    auto bd = g.addEdg(b, d, LineEdgePL());
+    auto be = g.addEdg(b, e, LineEdgePL());
+
+    Line l1("1", "1", "red");
+    Line l2("2", "2", "blue");
+
+    TEST(b->pl().connOccurs(&l1, ab, bc));
+    TEST(b->pl().numConnExcs(), ==, 0);
+
+    b->pl().addConnExc(&l1, ab, bc);
+    b->pl().addConnExc(&l2, bd, bc);
+
+    TEST(!b->pl().connOccurs(&l1, ab, bc));
+    TEST(!b->pl().connOccurs(&l1, bc, ab));
+    TEST(b->pl().connOccurs(&l1, bd, bc));
+    TEST(b->pl().connOccurs(&l2, ab, bc));
+    TEST(!b->pl().connOccurs(&l2, bc, bd));
+    TEST(b->pl().numConnExcs(), ==, 2);
+
+    auto ex = b->pl().getConnExc();
+    TEST(ex.size(), ==, 2);
+    TEST(ex[&l1][ab].count(bc), ==, 1);
+    TEST(ex[&l1][bc].count(ab), ==, 1);
+    TEST(ex[&l2][bd].count(bc), ==, 1);
+
+    // growing the matrices must not change existing exceptions
+    b->pl().addConnExc(&l1, bd, be);
+    TEST(!b->pl().connOccurs(&l1, ab, bc));
+    TEST(!b->pl().connOccurs(&l1, be, bd));
+    TEST(!b->pl().connOccurs(&l2, bc, bd));
+    TEST(b->pl().numConnExcs(), ==, 3);
+
+    b->pl().delConnExc(&l1, bc, ab);
+    TEST(b->pl().connOccurs(&l1, ab, bc));
+    TEST(b->pl().numConnExcs(), ==, 2);
+
+    b->pl().delConnExcEdg(bd);
+    TEST(b->pl().connOccurs(&l2, bc, bd));
+    TEST(b->pl().connOccurs(&l1, be, bd));
+    TEST(b->pl().numConnExcs(), ==, 0);
+
+    b->pl().addConnExc(&l2, ab, be);
+    b->pl().rplConnExcEdg(be, bd);
+    TEST(b->pl().connOccurs(&l2, ab, be));
+    TEST(!b->pl().connOccurs(&l2, ab, bd));
+    TEST(!b->pl().connOccurs(&l2, bd, ab));
+
+    b->pl().clearConnExc();
+    TEST(b->pl().connOccurs(&l2, ab, bd));
+    TEST(b->pl().numConnExcs(), ==, 0);
+  }
+
+  {
+    shared::linegraph::LineNodePL pl;
+    Line l1("1", "1", "red");
+    Line l2("2", "2", "blue");
+
+    TEST(pl.lineServed(&l1));
+    pl.addLineNotServed(&l2);
+    pl.addLineNotServed(&l1);
+    pl.addLineNotServed(&l2);
+    TEST(!pl.lineServed(&l1));
+    TEST(!pl.lineServed(&l2));
+  }
+}
@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef SHARED_TEST_LINENODEPLTEST_H_
+#define SHARED_TEST_LINENODEPLTEST_H_
+
+class LineNodePLTest {
+  public:
+    void run();
+};
+
+#endif
@@ -1,7 +1,12 @@
 // Copyright 2016
 // Author: Patrick Brosi
 
+#include "shared/tests/BinFormatTest.h"
+#include "shared/tests/DotTest.h"
 #include "shared/tests/ILPSolverTest.h"
+#include "shared/tests/JsonOutputTest.h"
+#include "shared/tests/LineGraphTest.h"
+#include "shared/tests/LineNodePLTest.h"
 
 #include "util/Misc.h"
 
@@ -10,6 +15,16 @@ int main(int argc, char** argv) {
   UNUSED(argc);
   UNUSED(argv);
   ILPSolverTest gs;
+  LineNodePLTest lnt;
+  LineGraphTest lgt;
+  BinFormatTest bft;
+  JsonOutputTest jot;
+  DotTest dt;
 
   gs.run();
+  lnt.run();
+  lgt.run();
+  bft.run();
+  jot.run();
+  dt.run();
 }
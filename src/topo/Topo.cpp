@@ -0,0 +1,160 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <sstream>
+#include "shared/linegraph/BinOutput.h"
+#include "topo/Topo.h"
+#include "topo/mapconstructor/MapConstructor.h"
+#include "topo/restr/RestrInferrer.h"
+#include "topo/statinserter/StatInserter.h"
+#include "util/Stats.h"
+#include "util/log/Log.h"
+
+using shared::linegraph::LineGraph;
+using topo::config::TopoConfig;
+
+// _____________________________________________________________________________
+void topo::run(const config::TopoConfig* cfg, LineGraph* tg,
+               util::json::Dict* stats) {
+  STATS_PHASE("topo");
+
+  topo::restr::RestrInferrer ri(cfg, tg);
+  topo::MapConstructor mc(cfg, tg);
+  topo::StatInserter si(cfg, tg);
+
+  util::stats::MemTrack graphMem(util::stats::MEM_GRAPH);
+  util::stats::MemTrack geomMem(util::stats::MEM_GEOM);
+  util::stats::MemTrack gridMem(util::stats::MEM_GRID);
+  STATS_MEM(graphMem, tg->memUsage());
+  STATS_MEM(geomMem, tg->geomMemUsage());
+  STATS_MEM(gridMem, tg->gridMemUsage());
+
+  double lenBef = 0, lenAfter = 0;
+
+  if (cfg->outputStats) {
+    for (const auto& nd : tg->getNds()) {
+      for (const auto& e : nd->getAdjList()) {
+        if (e->getFrom() != nd) continue;
+        lenBef += e->pl().getPolyline().getLength();
+      }
+    }
+  }
+
+  size_t statFr = mc.freeze();
+  si.init();
+
+  mc.averageNodePositions();
+
+  mc.cleanUpGeoms();
+
+  // does preserve existing turn restrictions
+  mc.removeNodeArtifacts(false);
+
+  // init restriction inferrer
+  ri.init();
+  size_t restrFr = mc.freeze();
+
+  // only remove the artifacts after the restriction inferrer has been
+  // initialized, as these operations do not guarantee that the restrictions
+  // are preserved!
+  mc.removeEdgeArtifacts();
+
+  T_START(construction);
+  size_t iters = 0;
+  iters += mc.collapseShrdSegs(10);
+  iters += mc.collapseShrdSegs(cfg->maxAggrDistance);
+  double constrT = T_STOP(construction);
+
+  mc.removeNodeArtifacts(false);
+
+  STATS_MEM(graphMem, tg->memUsage());
+  STATS_MEM(geomMem, tg->geomMemUsage());
+  STATS_MEM(gridMem, tg->gridMemUsage());
+
+  double avgMergedEdgs = 0;
+  size_t maxMergedEdgs = 0;
+  if (cfg->outputStats) {
+    size_t c = 0;
+    const auto& origEdgs = mc.freezeTrack(restrFr);
+    for (const auto& nd : tg->getNds()) {
+      for (const auto& e : nd->getAdjList()) {
+        if (e->getFrom() != nd) continue;
+        size_t cur = origEdgs.at(e).size();
+        if (cur > maxMergedEdgs) maxMergedEdgs = cur;
+        avgMergedEdgs += cur;
+        c++;
+      }
+    }
+    avgMergedEdgs /= c;
+  }
+
+  // infer restrictions
+  T_START(restrInf);
+  if (!cfg->noInferRestrs) ri.infer(mc.freezeTrack(restrFr));
+  double restrT = T_STOP(restrInf);
+
+  // insert stations
+  T_START(stationIns);
+  si.insertStations(mc.freezeTrack(statFr));
+  double stationT = T_STOP(stationIns);
+
+  // remove orphan lines, which may be introduced by another station
+  // placement
+  mc.removeOrphanLines();
+
+  mc.removeNodeArtifacts(true);
+
+  mc.reconstructIntersections();
+
+  if (cfg->outputStats) {
+    for (const auto& nd : tg->getNds()) {
+      for (const auto& e : nd->getAdjList()) {
+        if (e->getFrom() != nd) continue;
+        lenAfter += e->pl().getPolyline().getLength();
+      }
+    }
+
+    *stats = {
+        {"statistics",
+         util::json::Dict{
+             {"iters", iters},
+             {"time_const", constrT},
+             {"time_restr_inf", restrT},
+             {"time_station_insert", stationT},
+             {"len_before", lenBef},
+             {"num_restrs", tg->numConnExcs()},
+             {"avg_merged_edgs", avgMergedEdgs},
+             {"max_merged_edgs", maxMergedEdgs},
+             {"len_after", lenAfter},
+         }}};
+  }
+}
+
+// _____________________________________________________________________________
+void topo::sweep(const std::vector<TopoConfig>& cfgs, const LineGraph& tg,
+                 std::vector<util::json::Dict>* stats) {
+  STATS_PHASE("topo/sweep");
+
+  // the parsed input is shared by all sets, every set starts from a copy
+  std::stringstream snap;
+  shared::linegraph::BinOutput().print(tg, snap);
+  const std::string snapStr = snap.str();
+
+  stats->clear();
+  stats->resize(cfgs.size());
+
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < cfgs.size(); i++) {
+    TopoConfig cfg = cfgs[i];
+    cfg.outputStats = true;
+
+    std::stringstream s(snapStr);
+    LineGraph g;
+    g.readFromBin(&s, 0);
+
+    T_START(set);
+    run(&cfg, &g, &(*stats)[i]);
+    (*stats)[i]["time-ms"] = T_STOP(set);
+  }
+}
@@ -0,0 +1,28 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef TOPO_TOPO_H_
+#define TOPO_TOPO_H_
+
+#include <vector>
+#include "shared/linegraph/LineGraph.h"
+#include "topo/config/TopoConfig.h"
+#include "util/json/Writer.h"
+
+namespace topo {
+
+// construct the topology of tg in place. If cfg->outputStats is set, the
+// graph-level statistics are written to stats.
+void run(const config::TopoConfig* cfg, shared::linegraph::LineGraph* tg,
+         util::json::Dict* stats);
+
+// construct the topology of a copy of tg for every configuration in cfgs, in
+// parallel. The graph-level statistics of cfgs[i] are written to (*stats)[i].
+void sweep(const std::vector<config::TopoConfig>& cfgs,
+           const shared::linegraph::LineGraph& tg,
+           std::vector<util::json::Dict>* stats);
+
+}  // namespace topo
+
+#endif  // TOPO_TOPO_H_
@@ -7,14 +7,17 @@
 #include <fstream>
 #include <iostream>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <vector>
+#include "shared/linegraph/BinOutput.h"
+#include "shared/linegraph/JsonOutput.h"
 #include "shared/linegraph/LineGraph.h"
-#include "topo/mapconstructor/MapConstructor.h"
-#include "topo/statinserter/StatInserter.h"
+#include "topo/Topo.h"
 #include "topo/config/ConfigReader.h"
 #include "topo/config/TopoConfig.h"
-#include "topo/restr/RestrInferrer.h"
-#include "util/geo/output/GeoGraphJsonOutput.h"
+#include "util/Stats.h"
+#include "util/Sweep.h"
 #include "util/log/Log.h"
 
 // _____________________________________________________________________________
@@ -22,124 +25,91 @@ int main(int argc, char** argv) {
   // disable output buffering for standard output
   setbuf(stdout, NULL);
 
+  // write log messages to stderr from a background thread
+  util::AsyncLog::start(&std::cerr);
+
   // initialize randomness
   srand(time(NULL) + rand());
 
   topo::config::TopoConfig cfg;
   shared::linegraph::LineGraph tg;
-  topo::restr::RestrInferrer ri(&cfg, &tg);
-  topo::MapConstructor mc(&cfg, &tg);
-  topo::StatInserter si(&cfg, &tg);
 
   // read config
   topo::config::ConfigReader cr;
   cr.read(&cfg, argc, argv);
 
-  // read input graph
-  tg.readFromJson(&(std::cin), 0);
-
-  double lenBef = 0, lenAfter = 0;
+  if (cfg.outputStats || !cfg.traceFile.empty()) util::stats::enable();
 
-  if (cfg.outputStats) {
-    for (const auto& nd : tg.getNds()) {
-      for (const auto& e : nd->getAdjList()) {
-        if (e->getFrom() != nd) continue;
-        lenBef += e->pl().getPolyline().getLength();
-      }
+  // read input graph
+  {
+    STATS_PHASE("read");
+    if (!cfg.inputFile.empty()) {
+      tg.readFromFile(cfg.inputFile, cfg.inFormat, 0);
+    } else if (cfg.inFormat == "bin") {
+      tg.readFromBin(&(std::cin), 0);
+    } else {
+      tg.readFromJson(&(std::cin), 0);
     }
   }
 
-  size_t statFr = mc.freeze();
-  si.init();
-
-  mc.averageNodePositions();
-
-  mc.cleanUpGeoms();
-
-  // does preserve existing turn restrictions
-  mc.removeNodeArtifacts(false);
-
-  // init restriction inferrer
-  ri.init();
-  size_t restrFr = mc.freeze();
-
-  // only remove the artifacts after the restriction inferrer has been
-  // initialized, as these operations do not guarantee that the restrictions
-  // are preserved!
-  mc.removeEdgeArtifacts();
+  if (!cfg.sweepFile.empty()) {
+    std::vector<util::sweep::ParamSet> sets;
+    try {
+      sets = util::sweep::readFile(cfg.sweepFile);
+    } catch (const std::runtime_error& e) {
+      LOG(ERROR) << e.what();
+      exit(1);
+    }
 
-  T_START(construction);
-  size_t iters = 0;
-  iters += mc.collapseShrdSegs(10);
-  iters += mc.collapseShrdSegs(cfg.maxAggrDistance);
-  double constrT = T_STOP(construction);
+    // every set is parsed on top of the command line
+    std::vector<topo::config::TopoConfig> cfgs(sets.size());
+    for (size_t i = 0; i < sets.size(); i++) {
+      util::sweep::parse<topo::config::ConfigReader>(argc, argv, sets[i],
+                                                     &cfgs[i]);
+      cfgs[i].deadline = cfg.deadline;
+    }
 
-  mc.removeNodeArtifacts(false);
+    LOGTO(DEBUG, std::cerr) << "Running " << sets.size()
+                            << " parameter sets...";
 
+    std::vector<util::json::Dict> stats;
+    topo::sweep(cfgs, tg, &stats);
+    util::sweep::writeStats(sets, stats, &std::cout);
 
-  double avgMergedEdgs = 0;
-  size_t maxMergedEdgs = 0;
-  if (cfg.outputStats) {
-    size_t c = 0;
-    const auto& origEdgs = mc.freezeTrack(restrFr);
-    for (const auto& nd : tg.getNds()) {
-      for (const auto& e : nd->getAdjList()) {
-        if (e->getFrom() != nd) continue;
-        size_t cur = origEdgs.at(e).size();
-        if (cur > maxMergedEdgs) maxMergedEdgs = cur;
-        avgMergedEdgs += cur;
-        c++;
-      }
+    if (!cfg.traceFile.empty() && !util::stats::writeTrace(cfg.traceFile)) {
+      return 1;
     }
-    avgMergedEdgs /= c;
-  }
-
-  // infer restrictions
-  T_START(restrInf);
-  if (!cfg.noInferRestrs) ri.infer(mc.freezeTrack(restrFr));
-  double restrT = T_STOP(restrInf);
 
-  // insert stations
-  T_START(stationIns);
-  si.insertStations(mc.freezeTrack(statFr));
-  double stationT = T_STOP(stationIns);
-
-  // remove orphan lines, which may be introduced by another station
-  // placement
-  mc.removeOrphanLines();
+    return 0;
+  }
 
-  mc.removeNodeArtifacts(true);
+  util::json::Dict jsonStats;
+  topo::run(&cfg, &tg, &jsonStats);
 
-  mc.reconstructIntersections();
+  if (cfg.outputStats) jsonStats["instrumentation"] = util::stats::toJson();
 
-  if (cfg.outputStats) {
-    for (const auto& nd : tg.getNds()) {
-      for (const auto& e : nd->getAdjList()) {
-        if (e->getFrom() != nd) continue;
-        lenAfter += e->pl().getPolyline().getLength();
+  // output
+  {
+    STATS_PHASE("write");
+    shared::linegraph::JsonOutput out(cfg.outPrecision);
+    shared::linegraph::BinOutput binOut;
+    if (cfg.outputStats) {
+      if (cfg.outFormat == "bin") {
+        binOut.print(tg, std::cout, jsonStats);
+      } else {
+        out.print(tg, std::cout, jsonStats);
+      }
+    } else {
+      if (cfg.outFormat == "bin") {
+        binOut.print(tg, std::cout);
+      } else {
+        out.print(tg, std::cout);
       }
     }
   }
 
-  // output
-  util::geo::output::GeoGraphJsonOutput out;
-  if (cfg.outputStats) {
-    util::json::Dict jsonStats = {
-        {"statistics",
-         util::json::Dict{
-             {"iters", iters},
-             {"time_const", constrT},
-             {"time_restr_inf", restrT},
-             {"time_station_insert", stationT},
-             {"len_before", lenBef},
-             {"num_restrs", tg.numConnExcs()},
-             {"avg_merged_edgs", avgMergedEdgs},
-             {"max_merged_edgs", maxMergedEdgs},
-             {"len_after", lenAfter},
-         }}};
-    out.print(tg, std::cout, jsonStats);
-  } else {
-    out.print(tg, std::cout);
+  if (!cfg.traceFile.empty() && !util::stats::writeTrace(cfg.traceFile)) {
+    return 1;
   }
 
   return (0);
@@ -4,11 +4,13 @@
 
 #include <float.h>
 #include <getopt.h>
+#include <unistd.h>
 #include <exception>
 #include <iostream>
 #include <string>
 #include "topo/_config.h"
 #include "topo/config/ConfigReader.h"
+#include "util/json/Writer.h"
 #include "util/log/Log.h"
 
 using topo::config::ConfigReader;
@@ -42,10 +44,26 @@ void ConfigReader::help(const char* bin) const {
             << "maximum distance between segments\n"
             << std::setw(35) << "  --write-stats"
             << "write statistics to output file\n"
+            << std::setw(35) << "  --trace-file arg"
+            << "write a Chrome trace of the run to this file\n"
+            << std::setw(35) << "  --time-budget arg (=-1)"
+            << "wall-clock budget in seconds, -1 for none\n"
+            << std::setw(35) << "  --sweep arg"
+            << "run every parameter set in this file in\n"
+            << std::setw(35) << " "
+            << " parallel, write their stats as JSON lines\n"
             << std::setw(35) << "  --no-infer-restrs"
             << "don't infer turn restrictions\n"
             << std::setw(35) << "  --max-length-dev arg (=500)"
-            << "maxumum distance deviation for turn restrictions infer\n";
+            << "maxumum distance deviation for turn restrictions infer\n"
+            << std::setw(35) << "  --in-format arg (=geojson)"
+            << "input format, either geojson or bin\n"
+            << std::setw(35) << "  --input arg"
+            << "read input from this file instead of stdin\n"
+            << std::setw(35) << "  --out-format arg (=geojson)"
+            << "output format, either geojson or bin\n"
+            << std::setw(35) << "  --out-precision arg (=10)"
+            << "decimals of GeoJSON coordinates, -1 for shortest exact\n";
 }
 
 // _____________________________________________________________________________
@@ -58,6 +76,13 @@ void ConfigReader::read(TopoConfig* cfg, int argc, char** argv) const {
                          {"no-infer-restrs", no_argument, 0, 1},
                          {"write-stats", no_argument, 0, 2},
                          {"max-length-dev", required_argument, 0, 3},
+                         {"in-format", required_argument, 0, 4},
+                         {"out-format", required_argument, 0, 5},
+                         {"out-precision", required_argument, 0, 6},
+                         {"input", required_argument, 0, 7},
+                         {"trace-file", required_argument, 0, 8},
+                         {"time-budget", required_argument, 0, 9},
+                         {"sweep", required_argument, 0, 10},
                          {0, 0, 0, 0}};
 
   char c;
@@ -81,6 +106,28 @@ void ConfigReader::read(TopoConfig* cfg, int argc, char** argv) const {
       case 3:
         cfg->maxAggrDistance = atof(optarg);
         break;
+      case 4:
+        cfg->inFormat = optarg;
+        break;
+      case 5:
+        cfg->outFormat = optarg;
+        break;
+      case 6:
+        cfg->outPrecision = atoi(optarg) < 0 ? util::json::PREC_SHORTEST
+                                               : atoi(optarg);
+        break;
+      case 7:
+        cfg->inputFile = optarg;
+        break;
+      case 8:
+        cfg->traceFile = optarg;
+        break;
+      case 9:
+        cfg->deadline = util::Deadline(atof(optarg));
+        break;
+      case 10:
+        cfg->sweepFile = optarg;
+        break;
       case ':':
         std::cerr << argv[optind - 1];
         std::cerr << " requires an argument" << std::endl;
@@ -96,4 +143,26 @@ void ConfigReader::read(TopoConfig* cfg, int argc, char** argv) const {
         break;
     }
   }
+
+  if (cfg->inFormat != "geojson" && cfg->inFormat != "bin") {
+    LOG(ERROR) << "Unknown input format " << cfg->inFormat
+               << ", must be one of {geojson, bin}";
+    exit(1);
+  }
+
+  if (!cfg->inputFile.empty() && access(cfg->inputFile.c_str(), R_OK) != 0) {
+    LOG(ERROR) << "Cannot read input file " << cfg->inputFile;
+    exit(1);
+  }
+
+  if (!cfg->sweepFile.empty() && access(cfg->sweepFile.c_str(), R_OK) != 0) {
+    LOG(ERROR) << "Cannot read parameter set file " << cfg->sweepFile;
+    exit(1);
+  }
+
+  if (cfg->outFormat != "geojson" && cfg->outFormat != "bin") {
+    LOG(ERROR) << "Unknown output format " << cfg->outFormat
+               << ", must be one of {geojson, bin}";
+    exit(1);
+  }
 }
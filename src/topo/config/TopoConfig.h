@@ -6,6 +6,7 @@
 #define TOPO_CONFIG_TOPOCONFIG_H_
 
 #include <string>
+#include "util/Deadline.h"
 
 namespace topo {
 namespace config {
@@ -15,6 +16,26 @@ struct TopoConfig {
   double maxLengthDev = 500;
   bool outputStats = false;
   bool noInferRestrs = false;
+
+  // read the input from this file instead of stdin
+  std::string inputFile;
+
+  // write a Chrome trace-event file of the instrumented phases here
+  std::string traceFile;
+
+  // read parameter sets from this file and run them all, see --sweep
+  std::string sweepFile;
+
+  // wall-clock budget of the run, see --time-budget
+  util::Deadline deadline;
+
+  // either geojson or bin
+  std::string inFormat = "geojson";
+  std::string outFormat = "geojson";
+
+  // decimals of GeoJSON output coordinates, util::json::PREC_SHORTEST for
+  // the shortest exact representation
+  size_t outPrecision = 10;
 };
 
 }  // namespace config
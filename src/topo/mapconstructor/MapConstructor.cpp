@@ -2,10 +2,12 @@
 // Chair of Algorithms and Data Structures.
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
 #include "shared/linegraph/LineGraph.h"
 #include "topo/mapconstructor/MapConstructor.h"
+#include "util/Stats.h"
 #include "util/geo/Geo.h"
 #include "util/geo/Grid.h"
 #include "util/geo/output/GeoGraphJsonOutput.h"
@@ -193,6 +195,7 @@ int MapConstructor::collapseShrdSegs(double dCut) {
 
 // _____________________________________________________________________________
 int MapConstructor::collapseShrdSegs(double dCut, size_t MAX_ITERS) {
+  STATS_TIMER("topo/collapse");
   size_t ITER = 0;
   for (; ITER < MAX_ITERS; ITER++) {
     shared::linegraph::LineGraph tgNew;
@@ -213,7 +216,12 @@ int MapConstructor::collapseShrdSegs(double dCut, size_t MAX_ITERS) {
       }
     }
 
-    std::sort(sortedEdges.rbegin(), sortedEdges.rend());
+    // longest edges first, equally long edges in insertion order
+    std::stable_sort(sortedEdges.begin(), sortedEdges.end(),
+                     [](const std::pair<double, LineEdge*>& a,
+                        const std::pair<double, LineEdge*>& b) {
+                       return a.first > b.first;
+                     });
 
     size_t j = 0;
     for (const auto& ep : sortedEdges) {
@@ -456,6 +464,14 @@ int MapConstructor::collapseShrdSegs(double dCut, size_t MAX_ITERS) {
       }
     }
 
+    // the old and the new graph both exist at this point
+    util::stats::MemTrack newMem(util::stats::MEM_GRAPH);
+    util::stats::MemTrack newGeomMem(util::stats::MEM_GEOM);
+    util::stats::MemTrack gridMem(util::stats::MEM_GRID);
+    STATS_MEM(newMem, tgNew.memUsage());
+    STATS_MEM(newGeomMem, tgNew.geomMemUsage());
+    STATS_MEM(gridMem, grid.memUsage());
+
     // convergence criteria
     double THRESHOLD = 0.002;
 
@@ -480,6 +496,12 @@ int MapConstructor::collapseShrdSegs(double dCut, size_t MAX_ITERS) {
     LOGTO(DEBUG, std::cerr)
         << "iter " << ITER << ", distance gap: " << (1 - LEN_NEW / LEN_OLD);
     if (fabs(1 - LEN_NEW / LEN_OLD) < THRESHOLD) break;
+
+    // every iteration leaves a consistent graph, stop early if out of time
+    if (_cfg->deadline.expired()) {
+      LOGTO(DEBUG, std::cerr) << "Time budget used up after iter " << ITER;
+      break;
+    }
   }
 
   return ITER + 1;
@@ -1001,8 +1023,8 @@ void MapConstructor::supportEdge(LineEdge* ex, LineGraph* g) {
   auto plB = ex->pl().getPolyline().getSegment(0.5, 1).getLine();
   auto supNd = g->addNd(plA.back());
 
-  auto eA = g->addEdg(ex->getFrom(), supNd, ex->pl());
-  auto eB = g->addEdg(supNd, ex->getTo(), ex->pl());
+  auto eA = g->addEdg(ex->getFrom(), supNd, LineEdgePL(ex->pl(), plA));
+  auto eB = g->addEdg(supNd, ex->getTo(), LineEdgePL(ex->pl(), plB));
 
   combContEdgs(eA, ex);
   combContEdgs(eB, ex);
@@ -1010,9 +1032,6 @@ void MapConstructor::supportEdge(LineEdge* ex, LineGraph* g) {
   LineGraph::nodeRpl(eA, ex->getTo(), supNd);
   LineGraph::nodeRpl(eB, ex->getFrom(), supNd);
 
-  eA->pl().setGeom(plA);
-  eB->pl().setGeom(plB);
-
   g->delEdg(ex->getFrom(), ex->getTo());
   delOrigEdgsFor(ex);
 }
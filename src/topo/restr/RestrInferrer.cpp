@@ -9,6 +9,7 @@
 #include "topo/mapconstructor/MapConstructor.h"
 #include "topo/restr/RestrGraph.h"
 #include "topo/restr/RestrInferrer.h"
+#include "util/Stats.h"
 #include "util/geo/output/GeoGraphJsonOutput.h"
 #include "util/graph/Dijkstra.h"
 
@@ -66,6 +67,7 @@ void RestrInferrer::init() {
 
 // _____________________________________________________________________________
 size_t RestrInferrer::infer(const OrigEdgs& origEdgs) {
+  STATS_TIMER("topo/restr-infer");
   // delete all existing restrictions
 
   for (auto nd : _tg->getNds()) {
@@ -82,6 +84,17 @@ size_t RestrInferrer::infer(const OrigEdgs& origEdgs) {
   // outs.open("restr_graph.json");
   // out.print(_rg, outs);
 
+  // the checks are grouped by their source handles and line, each group is
+  // answered by a single one-to-many search
+  std::vector<ChkGrp> grps;
+  std::map<std::tuple<const LineEdge*, bool, const Line*>, size_t> grpIds;
+
+  // the candidate exceptions, together with the checks in both directions
+  std::vector<std::tuple<LineNode*, const LineEdge*, const LineEdge*,
+                         const Line*, std::pair<size_t, size_t>,
+                         std::pair<size_t, size_t>>>
+      cands;
+
   for (auto nd : _tg->getNds()) {
     for (auto edg1 : nd->getAdjList()) {
       // check every other edge
@@ -103,15 +116,28 @@ size_t RestrInferrer::infer(const OrigEdgs& origEdgs) {
             continue;
           }
 
-          if (!check(ro1.line, edg1, edg2) && !check(ro1.line, edg2, edg1)) {
-            nd->pl().addConnExc(ro1.line, edg1, edg2);
-            ret++;
-          }
+          cands.push_back({nd, edg1, edg2, ro1.line,
+                           addCheck(ro1.line, edg1, edg2, &grpIds, &grps),
+                           addCheck(ro1.line, edg2, edg1, &grpIds, &grps)});
         }
       }
     }
   }
 
+  // all checks are read-only on the restriction graph
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < grps.size(); i++) check(&grps[i]);
+
+  for (const auto& cand : cands) {
+    const auto& a = std::get<4>(cand);
+    const auto& b = std::get<5>(cand);
+    if (!grps[a.first].res[a.second] && !grps[b.first].res[b.second]) {
+      std::get<0>(cand)->pl().addConnExc(std::get<3>(cand), std::get<1>(cand),
+                                         std::get<2>(cand));
+      ret++;
+    }
+  }
+
   return ret;
 }
 
@@ -256,47 +282,76 @@ void RestrInferrer::addHndls(const LineEdge* e, const OrigEdgs& origEdgs,
 }
 
 // _____________________________________________________________________________
-bool RestrInferrer::check(const Line* r, const LineEdge* edg1,
-                          const LineEdge* edg2) const {
-  std::set<RestrEdge*> from, to;
+std::set<RestrEdge*> RestrInferrer::getHndlEdgs(const LineEdge* e,
+                                                const LineNode* shrdNd) const {
+  std::set<RestrEdge*> ret;
+  const auto& hndls = shrdNd == e->getFrom() ? _handlesA : _handlesB;
+
+  auto it = hndls.find(e);
+  if (it == hndls.end()) return ret;
+
+  for (auto nd : it->second) {
+    ret.insert(nd->getAdjListIn().begin(), nd->getAdjListIn().end());
+  }
+
+  return ret;
+}
+
+// _____________________________________________________________________________
+std::pair<size_t, size_t> RestrInferrer::addCheck(
+    const Line* r, const LineEdge* edg1, const LineEdge* edg2,
+    std::map<std::tuple<const LineEdge*, bool, const Line*>, size_t>* grpIds,
+    std::vector<ChkGrp>* grps) const {
   auto shrdNd = shared::linegraph::LineGraph::sharedNode(edg1, edg2);
 
   double curD = edg1->pl().getPolyline().getLength() * 0.33 +
                 edg2->pl().getPolyline().getLength() * 0.33;
 
-  if (shrdNd == edg1->getFrom()) {
-    if (_handlesA.count(edg1)) {
-      for (auto nd : _handlesA.find(edg1)->second) {
-        from.insert(nd->getAdjListIn().begin(), nd->getAdjListIn().end());
-      }
-    }
-  } else {
-    if (_handlesB.count(edg1)) {
-      for (auto nd : _handlesB.find(edg1)->second) {
-        from.insert(nd->getAdjListIn().begin(), nd->getAdjListIn().end());
-      }
-    }
+  auto key = std::make_tuple(edg1, shrdNd == edg1->getFrom(), r);
+
+  auto it = grpIds->find(key);
+  if (it == grpIds->end()) {
+    it = grpIds->insert({key, grps->size()}).first;
+    grps->push_back(ChkGrp(r, getHndlEdgs(edg1, shrdNd)));
   }
 
-  if (shrdNd == edg2->getFrom()) {
-    if (_handlesA.count(edg2)) {
-      for (auto nd : _handlesA.find(edg2)->second) {
-        to.insert(nd->getAdjListIn().begin(), nd->getAdjListIn().end());
-      }
-    }
-  } else {
-    if (_handlesB.count(edg2)) {
-      for (auto nd : _handlesB.find(edg2)->second) {
-        to.insert(nd->getAdjListIn().begin(), nd->getAdjListIn().end());
-      }
-    }
+  auto& grp = (*grps)[it->second];
+  grp.tos.push_back({getHndlEdgs(edg2, shrdNd), curD});
+
+  return {it->second, grp.tos.size() - 1};
+}
+
+// _____________________________________________________________________________
+void RestrInferrer::check(ChkGrp* grp) const {
+  grp->res.assign(grp->tos.size(), false);
+
+  std::set<RestrEdge*> to;
+  double maxD = 0;
+
+  for (const auto& t : grp->tos) {
+    to.insert(t.first.begin(), t.first.end());
+    maxD = std::max(maxD, t.second);
   }
 
-  // curdist + maxL is the inf. We do not have to check any further as we
-  // only return true below if cost - curD < maxL <=> cost < curD + maxL
-  // + epsilon to avoid integer rounding issues in the < comparison below
+  if (grp->from.size() == 0 || to.size() == 0) return;
+
+  // the search is bounded by the largest curD + maxL of all targets, the
+  // cost of each target is then compared against its own bound below
   double eps = 0.1;
-  CostFunc cFunc(r, curD + _cfg->maxLengthDev + eps);
+  CostFunc cFunc(grp->line, maxD + _cfg->maxLengthDev + eps);
 
-  return EDijkstra::shortestPath(from, to, cFunc) - curD < _cfg->maxLengthDev;
+  std::unordered_map<RestrEdge*, double> initCosts;
+  for (auto e : grp->from) initCosts[e] = 0;
+
+  const auto& costs = EDijkstra::shortestPath(
+      grp->from, to, initCosts, cFunc.inf(), cFunc,
+      util::graph::ZeroHeurFunc<RestrNodePL, RestrEdgePL, double>());
+
+  for (size_t i = 0; i < grp->tos.size(); i++) {
+    double cost = cFunc.inf();
+    for (auto e : grp->tos[i].first) {
+      cost = std::min(cost, costs.find(e)->second.second);
+    }
+    grp->res[i] = cost - grp->tos[i].second < _cfg->maxLengthDev;
+  }
 }
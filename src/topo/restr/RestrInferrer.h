@@ -5,7 +5,10 @@
 #ifndef TOPO_RESTR_RESTRINFERRER_H_
 #define TOPO_RESTR_RESTRINFERRER_H_
 
+#include <map>
+#include <tuple>
 #include <unordered_map>
+#include <vector>
 #include "shared/linegraph/LineGraph.h"
 #include "shared/linegraph/Line.h"
 #include "topo/config/TopoConfig.h"
@@ -67,6 +70,21 @@ struct CostFunc : public EDijkstra::CostFunc<RestrNodePL, RestrEdgePL, double> {
   const Line* _line;
 };
 
+// a batch of connection checks for a single line which all start at the same
+// set of handle edges, answered by a single one-to-many search
+struct ChkGrp {
+  ChkGrp(const Line* line, const std::set<RestrEdge*>& from)
+      : line(line), from(from) {}
+  const Line* line;
+  std::set<RestrEdge*> from;
+
+  // the target handle edges and the current distance of each check
+  std::vector<std::pair<std::set<RestrEdge*>, double>> tos;
+
+  // the check results, one per target
+  std::vector<bool> res;
+};
+
 struct HndlCmp {
   bool operator()(const Hndl& a, const Hndl& b) const {
     return a.second < b.second;
@@ -97,8 +115,17 @@ class RestrInferrer {
   // graph representation
   std::unordered_map<const LineNode*, RestrNode*> _nMap;
 
-  // check whether a connection ocurred in the original graph
-  bool check(const Line* r, const LineEdge* edg1, const LineEdge* edg2) const;
+  // check whether the connections of a group ocurred in the original graph
+  void check(ChkGrp* grp) const;
+
+  // add a check to the matching group, return (group id, target id)
+  std::pair<size_t, size_t> addCheck(
+      const Line* r, const LineEdge* edg1, const LineEdge* edg2,
+      std::map<std::tuple<const LineEdge*, bool, const Line*>, size_t>* grpIds,
+      std::vector<ChkGrp>* grps) const;
+
+  std::set<RestrEdge*> getHndlEdgs(const LineEdge* e,
+                                   const LineNode* shrdNd) const;
 
   void addHndls(const OrigEdgs& origEdgs);
   void addHndls(const LineEdge* e, const OrigEdgs& origEdgs,
@@ -6,6 +6,7 @@
 #include <climits>
 #include "shared/linegraph/LineGraph.h"
 #include "topo/statinserter/StatInserter.h"
+#include "util/Stats.h"
 #include "util/geo/Geo.h"
 #include "util/geo/Grid.h"
 #include "util/log/Log.h"
@@ -216,6 +217,7 @@ std::vector<StationCand> StatInserter::candidates(const StationOcc& occ,
 
 // _____________________________________________________________________________
 bool StatInserter::insertStations(const OrigEdgs& origEdgs) {
+  STATS_TIMER("topo/station-insert");
   OrigEdgs modOrigEdgs = origEdgs;
   auto idx = geoIndex();
 
@@ -304,32 +306,5 @@ LineEdgePair StatInserter::split(LineEdgePL& a, LineNode* fr, LineNode* to,
 // _____________________________________________________________________________
 void StatInserter::edgeRpl(LineNode* n, const LineEdge* oldE,
                            const LineEdge* newE) {
-  if (oldE == newE) return;
-  // replace in from
-  for (auto& r : n->pl().getConnExc()) {
-    auto exFr = r.second.begin();
-    while (exFr != r.second.end()) {
-      if (exFr->first == oldE) {
-        std::swap(r.second[newE], exFr->second);
-        exFr = r.second.erase(exFr);
-      } else {
-        exFr++;
-      }
-    }
-  }
-
-  // replace in to
-  for (auto& r : n->pl().getConnExc()) {
-    for (auto& exFr : r.second) {
-      auto exTo = exFr.second.begin();
-      while (exTo != exFr.second.end()) {
-        if (*exTo == oldE) {
-          exFr.second.insert(newE);
-          exTo = exFr.second.erase(exTo);
-        } else {
-          exTo++;
-        }
-      }
-    }
-  }
+  n->pl().rplConnExcEdg(oldE, newE);
 }
@@ -7,6 +7,8 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <random>
 #include <set>
 #include <string>
 #include "shared/linegraph/LineGraph.h"
@@ -25,6 +27,26 @@ util::geo::Grid<topoeval::DirLineNode*, Point, double> gtGrid;
 std::unordered_map<std::string, std::set<topoeval::DirLineNode*>> stationsGt;
 std::unordered_map<std::string, std::set<topoeval::DirLineNode*>> stationsTest;
 
+// ground truth lines to the same lines in the test graph
+typedef std::map<const shared::linegraph::Line*,
+                 const shared::linegraph::Line*>
+    LineMap;
+
+// the result of a single sample
+struct Sample {
+  // neither graph has a path between the sampled points
+  bool noPath = false;
+
+  // only one of the graphs has a path
+  bool oneSided = false;
+
+  // the Frechet distance between both paths
+  double frechet = 0;
+
+  // the sampled line, if it does not exist in the test graph
+  const shared::linegraph::Line* missingLine = 0;
+};
+
 struct CostFunc
     : public util::graph::EDijkstra::CostFunc<topoeval::DirLineNodePL,
                                               topoeval::DirLineEdgePL, double> {
@@ -165,19 +187,23 @@ std::pair<std::pair<std::set<topoeval::DirLineNode*>,
                     std::set<topoeval::DirLineNode*>>,
           std::pair<std::set<topoeval::DirLineNode*>,
                     std::set<topoeval::DirLineNode*>>>
-getFromToCandsStat() {
+getFromToCandsStat(std::mt19937* rng) {
   std::pair<std::pair<std::set<topoeval::DirLineNode*>,
                       std::set<topoeval::DirLineNode*>>,
             std::pair<std::set<topoeval::DirLineNode*>,
                       std::set<topoeval::DirLineNode*>>>
       ret;
-  auto fromStat = gtStations[rand() % gtStations.size()];
-  auto toStat = gtStations[rand() % gtStations.size()];
+  const auto& fromStat = gtStations[(*rng)() % gtStations.size()];
+  const auto& toStat = gtStations[(*rng)() % gtStations.size()];
+
+  ret.first.first = stationsGt.at(fromStat);
+  ret.first.second = stationsGt.at(toStat);
 
-  ret.first.first = stationsGt[fromStat];
-  ret.first.second = stationsGt[toStat];
-  ret.second.first = stationsTest[fromStat];
-  ret.second.second = stationsTest[toStat];
+  // the station may be missing in the test graph
+  auto fr = stationsTest.find(fromStat);
+  auto to = stationsTest.find(toStat);
+  if (fr != stationsTest.end()) ret.second.first = fr->second;
+  if (to != stationsTest.end()) ret.second.second = to->second;
 
   return ret;
 }
@@ -187,14 +213,14 @@ std::pair<std::pair<std::set<topoeval::DirLineNode*>,
                     std::set<topoeval::DirLineNode*>>,
           std::pair<std::set<topoeval::DirLineNode*>,
                     std::set<topoeval::DirLineNode*>>>
-getFromToCands(double d) {
+getFromToCands(double d, std::mt19937* rng) {
   std::pair<std::pair<std::set<topoeval::DirLineNode*>,
                       std::set<topoeval::DirLineNode*>>,
             std::pair<std::set<topoeval::DirLineNode*>,
                       std::set<topoeval::DirLineNode*>>>
       ret;
-  auto from = gtNds[rand() % gtNds.size()];
-  auto to = gtNds[rand() % gtNds.size()];
+  auto from = gtNds[(*rng)() % gtNds.size()];
+  auto to = gtNds[(*rng)() % gtNds.size()];
 
   std::set<topoeval::DirLineNode*> testNeighsFr;
   std::set<topoeval::DirLineNode*> testNeighsTo;
@@ -246,15 +272,116 @@ getFromToCands(double d) {
   return ret;
 }
 
+// _____________________________________________________________________________
+Sample evalSample(size_t i, unsigned int seed, double d, bool fromStations,
+                  const LineMap& lineMap) {
+  // every sample has its own generator, seeded by the sample number, so runs
+  // with the same seed give the same output for any number of threads
+  std::seed_seq seq{seed, static_cast<unsigned int>(i)};
+  std::mt19937 rng(seq);
+
+  Sample ret;
+
+  std::vector<const shared::linegraph::Line*> lines;
+  std::set<const shared::linegraph::Line*> linesSet;
+
+  std::pair<std::pair<std::set<topoeval::DirLineNode*>,
+                      std::set<topoeval::DirLineNode*>>,
+            std::pair<std::set<topoeval::DirLineNode*>,
+                      std::set<topoeval::DirLineNode*>>>
+      cands;
+
+  if (fromStations)
+    cands = getFromToCandsStat(&rng);
+  else
+    cands = getFromToCands(d, &rng);
+
+  const auto& gtFr = cands.first.first;
+  const auto& gtTo = cands.first.second;
+
+  const auto& testFr = cands.second.first;
+  const auto& testTo = cands.second.second;
+
+  for (auto from : gtFr) {
+    for (auto e : from->getAdjList()) {
+      for (auto l : e->pl().lines) {
+        if (linesSet.count(l)) continue;
+        lines.push_back(l);
+        linesSet.insert(l);
+      }
+    }
+  }
+
+  for (auto to : gtTo) {
+    for (auto e : to->getAdjList()) {
+      for (auto l : e->pl().lines) {
+        if (linesSet.count(l)) continue;
+        lines.push_back(l);
+        linesSet.insert(l);
+      }
+    }
+  }
+
+  auto gtLine = lines[rng() % lines.size()];
+  CostFunc cFuncGt(gtLine);
+
+  util::graph::EList<topoeval::DirLineNodePL, topoeval::DirLineEdgePL>*
+      resEdges = 0;
+  util::graph::NList<topoeval::DirLineNodePL, topoeval::DirLineEdgePL>
+      resNodesGt;
+  util::graph::NList<topoeval::DirLineNodePL, topoeval::DirLineEdgePL>
+      resNodesTest;
+
+  util::graph::EList<topoeval::DirLineNodePL, topoeval::DirLineEdgePL>
+      resEdgesTest;
+
+  auto cGt = util::graph::EDijkstra::shortestPath(gtFr, gtTo, cFuncGt,
+                                                  resEdges, &resNodesGt);
+
+  auto testLine = lineMap.find(gtLine);
+  if (testLine == lineMap.end() || !testLine->second) {
+    ret.missingLine = gtLine;
+    return ret;
+  }
+
+  CostFunc cFuncTest(testLine->second);
+  auto cTest = util::graph::EDijkstra::shortestPath(
+      testFr, testTo, cFuncTest, &resEdgesTest, &resNodesTest);
+
+  util::geo::Line<double> lineTest, lineGt;
+
+  for (auto nd : resNodesGt) lineGt.push_back(*nd->pl().getGeom());
+  for (auto nd : resNodesTest) lineTest.push_back(*nd->pl().getGeom());
+
+  if (cGt > std::numeric_limits<double>::max() &&
+      cTest > std::numeric_limits<double>::max()) {
+    ret.noPath = true;
+    return ret;
+  }
+
+  if ((cGt > std::numeric_limits<double>::max()) ^
+      (cTest > std::numeric_limits<double>::max())) {
+    ret.oneSided = true;
+    return ret;
+  }
+
+  ret.frechet = util::geo::frechetDist(lineTest, lineGt, 15);
+  LOG(DEBUG) << " for line " << gtLine->label() << " : " << cGt << " vs "
+             << cTest << ": fr " << ret.frechet;
+
+  return ret;
+}
+
 // _____________________________________________________________________________
 int main(int argc, char** argv) {
   // disable output buffering for standard output
   setbuf(stdout, NULL);
 
-  // initialize randomness
-  srand(time(NULL) + rand());
+  // write log messages to stderr from a background thread
+  util::AsyncLog::start(&std::cerr);
 
   double d = 150;
+  unsigned int seed = 0;
   size_t SAMPLES = 10000;
 
   bool fromStations = false;
@@ -266,7 +393,7 @@ int main(int argc, char** argv) {
     if (cur == "-h" || cur == "--help") {
       std::cerr << "Usage: " << argv[0]
                 << "[-d <maxdist=150>] [-s <numsamples=10000>] "
-                   "[--sample-stations] <ground truth "
+                   "[--seed <seed=0>] [--sample-stations] <ground truth "
                    "graph> <test graph>"
                 << std::endl;
       exit(0);
@@ -284,6 +411,12 @@ int main(int argc, char** argv) {
         exit(1);
       }
       SAMPLES = atoi(argv[i]);
+    } else if (cur == "--seed") {
+      if (++i >= argc) {
+        LOG(ERROR) << "Missing argument for seed (--seed).";
+        exit(1);
+      }
+      seed = atoi(argv[i]);
     } else {
       if (gtPath.empty())
         gtPath = cur;
@@ -362,8 +495,7 @@ int main(int argc, char** argv) {
   gtNds = std::vector<shared::linegraph::LineNode*>(gtGraph.getNds().begin(),
                                                     gtGraph.getNds().end());
 
-  std::map<const shared::linegraph::Line*, const shared::linegraph::Line*>
-      lineMap;
+  LineMap lineMap;
 
   for (auto nd : gtGraph.getNds()) {
     for (auto e : nd->getAdjList()) {
@@ -391,98 +523,35 @@ int main(int argc, char** argv) {
   double maxFrech = 0;
   double frechAvg = 0;
 
-  for (size_t i = 0; i < SAMPLES; i++) {
-    std::vector<const shared::linegraph::Line*> lines;
-    std::set<const shared::linegraph::Line*> linesSet;
+  std::vector<Sample> samples(SAMPLES);
 
-    std::pair<std::pair<std::set<topoeval::DirLineNode*>,
-                        std::set<topoeval::DirLineNode*>>,
-              std::pair<std::set<topoeval::DirLineNode*>,
-                        std::set<topoeval::DirLineNode*>>>
-        cands;
-
-    if (fromStations)
-      cands = getFromToCandsStat();
-    else
-      cands = getFromToCands(d);
-
-    auto gtFr = cands.first.first;
-    auto gtTo = cands.first.second;
-
-    auto testFr = cands.second.first;
-    auto testTo = cands.second.second;
-
-    for (auto from : gtFr) {
-      for (auto e : from->getAdjList()) {
-        for (auto l : e->pl().lines) {
-          if (linesSet.count(l)) continue;
-          lines.push_back(l);
-          linesSet.insert(l);
-        }
-      }
-    }
-
-    for (auto to : gtTo) {
-      for (auto e : to->getAdjList()) {
-        for (auto l : e->pl().lines) {
-          if (linesSet.count(l)) continue;
-          lines.push_back(l);
-          linesSet.insert(l);
-        }
-      }
-    }
-
-    auto gtLine = lines[rand() % lines.size()];
-    CostFunc cFuncGt(gtLine);
-
-    util::graph::EList<topoeval::DirLineNodePL, topoeval::DirLineEdgePL>*
-        resEdges = 0;
-    util::graph::NList<topoeval::DirLineNodePL, topoeval::DirLineEdgePL>
-        resNodesGt;
-    util::graph::NList<topoeval::DirLineNodePL, topoeval::DirLineEdgePL>
-        resNodesTest;
-
-    util::graph::EList<topoeval::DirLineNodePL, topoeval::DirLineEdgePL>
-        resEdgesTest;
-
-    auto cGt = util::graph::EDijkstra::shortestPath(gtFr, gtTo, cFuncGt,
-                                                    resEdges, &resNodesGt);
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < SAMPLES; i++) {
+    samples[i] = evalSample(i, seed, d, fromStations, lineMap);
+  }
 
-    if (!lineMap[gtLine]) {
-      LOG(ERROR) << "Input line " << gtLine->id() << " (" << gtLine->label()
-                 << ") not found in test data";
+  // aggregate in sample order, the result does not depend on the number of
+  // threads
+  for (const auto& sample : samples) {
+    if (sample.missingLine) {
+      LOG(ERROR) << "Input line " << sample.missingLine->id() << " ("
+                 << sample.missingLine->label() << ") not found in test data";
       exit(1);
     }
-    CostFunc cFuncTest(lineMap[gtLine]);
-    auto cTest = util::graph::EDijkstra::shortestPath(
-        testFr, testTo, cFuncTest, &resEdgesTest, &resNodesTest);
-
-    util::geo::Line<double> lineTest, lineGt;
 
-    for (auto nd : resNodesGt) lineGt.push_back(*nd->pl().getGeom());
-    for (auto nd : resNodesTest) lineTest.push_back(*nd->pl().getGeom());
+    if (sample.noPath) continue;
 
-    if (cGt > std::numeric_limits<double>::max() &&
-        cTest > std::numeric_limits<double>::max()) {
-      continue;
-    }
-
-    if ((cGt > std::numeric_limits<double>::max()) ^
-        (cTest > std::numeric_limits<double>::max())) {
+    if (sample.oneSided) {
       unmatch += 1;
       continue;
     }
 
-    double frechetDist = util::geo::frechetDist(lineTest, lineGt, 15);
-    LOG(DEBUG) << " for line " << gtLine->label() << " : " << cGt << " vs "
-               << cTest << ": fr " << frechetDist;
-
-    frechAvg += frechetDist;
+    frechAvg += sample.frechet;
 
-    if (frechetDist > maxFrech) maxFrech = frechetDist;
-    if (frechetDist < minFrech) minFrech = frechetDist;
+    if (sample.frechet > maxFrech) maxFrech = sample.frechet;
+    if (sample.frechet < minFrech) minFrech = sample.frechet;
 
-    if (frechetDist < d)
+    if (sample.frechet < d)
       match += 1;
     else {
       unmatch += 1;
@@ -0,0 +1,173 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include "transitmap/TransitMap.h"
+#include "transitmap/graph/GraphBuilder.h"
+#include "transitmap/output/MvtRenderer.h"
+#include "transitmap/output/PngRenderer.h"
+#include "transitmap/output/SvgRenderer.h"
+#include "util/Misc.h"
+#include "util/Stats.h"
+#include "util/String.h"
+#include "util/log/Log.h"
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_get_num_procs() 1
+#endif
+
+using shared::rendergraph::RenderGraph;
+using transitmapper::BatchJob;
+
+// _____________________________________________________________________________
+void transitmapper::run(const config::Config* cfg, RenderGraph* g,
+                        std::ostream* out) {
+  STATS_PHASE("transitmap");
+  transitmapper::graph::GraphBuilder b(cfg);
+
+  {
+    STATS_TIMER("transitmap/node-fronts");
+    g->smooth();
+
+    b.writeNodeFronts(g);
+
+    b.expandOverlappinFronts(g);
+
+    // find expanded node fronts that form a node and replace them with a
+    // single node
+    g->createMetaNodes();
+  }
+
+  util::stats::MemTrack graphMem(util::stats::MEM_GRAPH);
+  util::stats::MemTrack geomMem(util::stats::MEM_GEOM);
+  util::stats::MemTrack gridMem(util::stats::MEM_GRID);
+  STATS_MEM(graphMem, g->memUsage());
+  STATS_MEM(geomMem, g->geomMemUsage());
+  STATS_MEM(gridMem, g->gridMemUsage());
+
+  if (cfg->renderMethod == "svg") {
+    LOGTO(DEBUG, std::cerr) << "Outputting to SVG ...";
+    transitmapper::output::SvgRenderer svgOut(out, cfg);
+    svgOut.print(*g);
+  } else if (cfg->renderMethod == "mvt") {
+    LOGTO(DEBUG, std::cerr) << "Outputting to MVT tiles ...";
+    transitmapper::output::MvtRenderer mvtOut(cfg);
+    mvtOut.print(*g);
+  } else if (cfg->renderMethod == "png") {
+    LOGTO(DEBUG, std::cerr) << "Outputting to PNG ...";
+    transitmapper::output::PngRenderer pngOut(out, cfg);
+    pngOut.print(*g);
+  } else {
+    throw std::runtime_error("Unknown render method " + cfg->renderMethod);
+  }
+}
+
+// _____________________________________________________________________________
+std::vector<BatchJob> transitmapper::readManifest(std::istream* in) {
+  std::vector<BatchJob> ret;
+  std::string line;
+  size_t lineNum = 0;
+
+  while (std::getline(*in, line)) {
+    lineNum++;
+    line = util::trim(line);
+    if (line.empty() || line[0] == '#') continue;
+
+    std::stringstream ss(line);
+    BatchJob job;
+    std::string rest;
+    if (!(ss >> job.input >> job.output) || (ss >> rest)) {
+      throw std::runtime_error("Expected <input> <output> in batch line " +
+                               std::to_string(lineNum));
+    }
+    ret.push_back(job);
+  }
+
+  return ret;
+}
+
+// _____________________________________________________________________________
+void transitmapper::batch(const config::Config* cfg,
+                          const std::vector<BatchJob>& jobs,
+                          size_t numThreads,
+                          std::vector<util::json::Dict>* stats) {
+  STATS_PHASE("transitmap/batch");
+  if (numThreads == 0) numThreads = omp_get_num_procs();
+
+  stats->clear();
+  stats->resize(jobs.size());
+
+  LOGTO(DEBUG, std::cerr) << "Rendering " << jobs.size() << " networks on "
+                          << numThreads << " threads...";
+
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+  for (size_t i = 0; i < jobs.size(); i++) {
+    const auto& job = jobs[i];
+    util::json::Dict& st = (*stats)[i];
+    st = util::json::Dict{{"input", job.input}, {"output", job.output}};
+
+    T_START(job);
+    try {
+      // the tiles go to the output directory, and every job gets the full
+      // time budget, everything else is shared
+      config::Config jobCfg = *cfg;
+      if (cfg->renderMethod == "mvt") jobCfg.mvtPath = job.output;
+      if (cfg->timeBudget >= 0) {
+        jobCfg.deadline = util::Deadline(cfg->timeBudget);
+      }
+
+      T_START(read);
+      RenderGraph g(cfg->lineWidth, cfg->lineSpacing);
+      g.readFromFile(job.input, cfg->fromDot ? "dot" : cfg->inFormat,
+                     cfg->inputSmoothing);
+      st["read-ms"] = T_STOP(read);
+      st["nodes"] = g.numNds();
+      st["edges"] = g.numEdgs();
+
+      T_START(render);
+      if (cfg->renderMethod == "mvt") {
+        std::stringstream out;
+        run(&jobCfg, &g, &out);
+      } else {
+        // render next to the output and move the file there only on success,
+        // so a failed job leaves an existing output untouched
+        std::string tmp = job.output + ".tmp-" + std::to_string(i);
+        std::ofstream out(tmp, std::ios::binary);
+        if (!out.good()) {
+          throw std::runtime_error("Could not open " + tmp);
+        }
+        try {
+          run(&jobCfg, &g, &out);
+          out.close();
+          if (out.fail()) {
+            throw std::runtime_error("Could not write " + tmp);
+          }
+          if (std::rename(tmp.c_str(), job.output.c_str()) != 0) {
+            throw std::runtime_error("Could not write " + job.output);
+          }
+        } catch (...) {
+          out.close();
+          std::remove(tmp.c_str());
+          throw;
+        }
+      }
+      st["render-ms"] = T_STOP(render);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << job.input << ": " << e.what();
+      st["error"] = std::string(e.what());
+    }
+    st["time-ms"] = T_STOP(job);
+
+    if (!st.count("error")) {
+      LOGTO(INFO, std::cerr) << "Rendered " << job.input << " to "
+                             << job.output << " (" << st["time-ms"].f
+                             << "ms)";
+    }
+  }
+}
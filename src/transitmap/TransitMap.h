@@ -0,0 +1,44 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef TRANSITMAP_TRANSITMAP_H_
+#define TRANSITMAP_TRANSITMAP_H_
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "shared/rendergraph/RenderGraph.h"
+#include "transitmap/config/TransitMapConfig.h"
+#include "util/json/Writer.h"
+
+namespace transitmapper {
+
+// an input graph and the output rendered from it in batch mode. For mvt, the
+// output is the tile directory.
+struct BatchJob {
+  std::string input, output;
+};
+
+// render g with the configured render engine to out. Throws
+// std::runtime_error if the output cannot be rendered or written.
+void run(const config::Config* cfg, shared::rendergraph::RenderGraph* g,
+         std::ostream* out);
+
+// read the jobs of a batch manifest, one "<input> <output>" pair per line.
+// Empty lines and lines starting with # are skipped. Throws
+// std::runtime_error on malformed lines.
+std::vector<BatchJob> readManifest(std::istream* in);
+
+// render the jobs concurrently on a pool of threads, each of which holds a
+// single network at a time, so at most numThreads networks are in memory.
+// The configuration is shared by all jobs, but the time budget applies to
+// every job on its own. Writes the timings of every job, or its error, to
+// stats.
+void batch(const config::Config* cfg, const std::vector<BatchJob>& jobs,
+           size_t numThreads, std::vector<util::json::Dict>* stats);
+
+}  // namespace transitmapper
+
+#endif  // TRANSITMAP_TRANSITMAP_H_
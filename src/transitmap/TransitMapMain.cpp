@@ -8,12 +8,13 @@
 #include <iostream>
 #include <set>
 #include <string>
-#include "shared/rendergraph/Penalties.h"
+#include <vector>
 #include "shared/rendergraph/RenderGraph.h"
+#include "transitmap/TransitMap.h"
 #include "transitmap/config/ConfigReader.cpp"
 #include "transitmap/config/TransitMapConfig.h"
-#include "transitmap/graph/GraphBuilder.h"
-#include "transitmap/output/SvgRenderer.h"
+#include "util/Stats.h"
+#include "util/json/Writer.h"
 #include "util/log/Log.h"
 
 // _____________________________________________________________________________
@@ -21,6 +22,9 @@ int main(int argc, char** argv) {
   // disable output buffering for standard output
   setbuf(stdout, NULL);
 
+  // write log messages to stderr from a background thread
+  util::AsyncLog::start(&std::cerr);
+
   // initialize randomness
   srand(time(NULL) + rand());
 
@@ -29,33 +33,78 @@ int main(int argc, char** argv) {
   transitmapper::config::ConfigReader cr;
   cr.read(&cfg, argc, argv);
 
-  LOGTO(DEBUG, std::cerr) << "Reading graph...";
-  shared::rendergraph::RenderGraph g(cfg.lineWidth, cfg.lineSpacing);
-  transitmapper::graph::GraphBuilder b(&cfg);
+  if (cfg.writeStats || !cfg.traceFile.empty()) util::stats::enable();
+
+  if (!cfg.batchFile.empty()) {
+    std::vector<transitmapper::BatchJob> jobs;
+    try {
+      std::ifstream f(cfg.batchFile);
+      jobs = transitmapper::readManifest(&f);
+    } catch (const std::runtime_error& e) {
+      LOG(ERROR) << e.what();
+      return 1;
+    }
+
+    std::vector<util::json::Dict> stats;
+    transitmapper::batch(&cfg, jobs, cfg.batchJobs, &stats);
+
+    size_t failed = 0;
+    for (const auto& st : stats) {
+      failed += st.count("error");
+      util::json::Writer wr(&std::cout, 10, false);
+      wr.val(st);
+      wr.closeAll();
+      std::cout << "\n";
+    }
+    std::cout.flush();
+
+    if (cfg.writeStats) {
+      util::json::Writer wr(&std::cerr, 3, true);
+      wr.val(util::stats::toJson());
+      wr.closeAll();
+      std::cerr << std::endl;
+    }
 
-  if (cfg.fromDot) {
-    g.readFromDot(&std::cin, cfg.inputSmoothing);
-  } else {
-    g.readFromJson(&std::cin, cfg.inputSmoothing);
+    if (!cfg.traceFile.empty() && !util::stats::writeTrace(cfg.traceFile)) {
+      return 1;
+    }
+
+    return failed ? 1 : 0;
   }
 
-  g.smooth();
+  LOGTO(DEBUG, std::cerr) << "Reading graph...";
+  shared::rendergraph::RenderGraph g(cfg.lineWidth, cfg.lineSpacing);
 
-  b.writeNodeFronts(&g);
+  {
+    STATS_PHASE("read");
+    if (!cfg.inputFile.empty()) {
+      g.readFromFile(cfg.inputFile, cfg.fromDot ? "dot" : cfg.inFormat,
+                     cfg.inputSmoothing);
+    } else if (cfg.fromDot) {
+      g.readFromDot(&std::cin, cfg.inputSmoothing);
+    } else if (cfg.inFormat == "bin") {
+      g.readFromBin(&std::cin, cfg.inputSmoothing);
+    } else {
+      g.readFromJson(&std::cin, cfg.inputSmoothing);
+    }
+  }
 
-  b.expandOverlappinFronts(&g);
+  try {
+    transitmapper::run(&cfg, &g, &std::cout);
+  } catch (const std::runtime_error& e) {
+    LOG(ERROR) << e.what();
+    return 1;
+  }
 
-  // find expanded node fronts that form a node and replace them with a
-  // single node
-  g.createMetaNodes();
+  if (cfg.writeStats) {
+    util::json::Writer wr(&std::cerr, 3, true);
+    wr.val(util::stats::toJson());
+    wr.closeAll();
+    std::cerr << std::endl;
+  }
 
-  if (cfg.renderMethod == "svg") {
-    LOGTO(DEBUG, std::cerr) << "Outputting to SVG ...";
-    transitmapper::output::SvgRenderer svgOut(&std::cout, &cfg);
-    svgOut.print(g);
-  } else {
-    LOG(ERROR) << "Unknown render method " << cfg.renderMethod;
-    exit(1);
+  if (!cfg.traceFile.empty() && !util::stats::writeTrace(cfg.traceFile)) {
+    return 1;
   }
 
   return (0);
@@ -4,11 +4,13 @@
 
 #include <float.h>
 #include <getopt.h>
+#include <unistd.h>
 #include <exception>
 #include <iostream>
 #include <string>
 #include "transitmap/_config.h"
 #include "transitmap/config/ConfigReader.h"
+#include "util/String.h"
 #include "util/log/Log.h"
 
 using transitmapper::config::ConfigReader;
@@ -36,7 +38,11 @@ void ConfigReader::help(const char* bin) const {
             << std::setw(37) << "  -h [ --help ]"
             << "show this help message\n"
             << std::setw(37) << "  --render-engine arg (=svg)"
-            << "Render engine, only SVG support atm\n"
+            << "render engine, either svg, mvt or png\n"
+            << std::setw(37) << "  --mvt-path arg (=.)"
+            << "output directory of the mvt tiles\n"
+            << std::setw(37) << "  --zoom arg (=0-14)"
+            << "mvt zoom levels, e.g. 0-14 or 10,12,14\n"
             << std::setw(37) << "  --line-width arg (=20)"
             << "width of a single transit line\n"
             << std::setw(37) << "  --line-spacing arg (=10)"
@@ -56,8 +62,16 @@ void ConfigReader::help(const char* bin) const {
             << "Misc:\n"
             << std::setw(37) << "  -D [ --from-dot ]"
             << "input is in dot format\n"
+            << std::setw(37) << "  --in-format arg (=geojson)"
+            << "input format, either geojson or bin\n"
+            << std::setw(37) << "  --input arg"
+            << "read input from this file instead of stdin\n"
             << std::setw(37) << "  --padding arg (=-1)"
             << "padding, -1 for auto\n"
+            << std::setw(37) << "  --out-precision arg (=2)"
+            << "decimals of output coordinates\n"
+            << std::setw(37) << "  --lod-tolerance arg (=0.5)"
+            << "drop details below this size in pixels, 0 to disable\n"
             << std::setw(37) << "  --smoothing arg (=3)"
             << "input line smoothing\n"
             << std::setw(37) << "  --no-render-stations"
@@ -69,7 +83,23 @@ void ConfigReader::help(const char* bin) const {
             << std::setw(37) << "  --no-render-node-connections"
             << "don't render inner node connections\n"
             << std::setw(37) << "  --render-node-fronts"
-            << "render node fronts\n";
+            << "render node fronts\n"
+            << std::setw(37) << "  --stats"
+            << "write timings and counters as JSON to stderr\n"
+            << std::setw(37) << "  --trace-file arg"
+            << "write a Chrome trace of the run to this file\n"
+            << std::setw(37) << "  --time-budget arg (=-1)"
+            << "wall-clock budget in seconds, -1 for none. With\n"
+            << std::setw(37) << " "
+            << "--batch, every network gets the full budget\n"
+            << std::setw(37) << "  --batch arg"
+            << "render the input and output pairs listed in this\n"
+            << std::setw(37) << " "
+            << "file concurrently, write their timings as JSON\n"
+            << std::setw(37) << " "
+            << "lines\n"
+            << std::setw(37) << "  --batch-jobs arg (=0)"
+            << "networks rendered at once, 0 for one per core\n";
 }
 
 // _____________________________________________________________________________
@@ -93,6 +123,17 @@ void ConfigReader::read(Config* cfg, int argc, char** argv) const {
                          {"padding", required_argument, 0, 13},
                          {"smoothing", required_argument, 0, 14},
                          {"render-node-fronts", no_argument, 0, 15},
+                         {"in-format", required_argument, 0, 17},
+                         {"out-precision", required_argument, 0, 18},
+                         {"mvt-path", required_argument, 0, 19},
+                         {"zoom", required_argument, 0, 20},
+                         {"lod-tolerance", required_argument, 0, 21},
+                         {"input", required_argument, 0, 22},
+                         {"stats", no_argument, 0, 23},
+                         {"trace-file", required_argument, 0, 24},
+                         {"time-budget", required_argument, 0, 25},
+                         {"batch", required_argument, 0, 26},
+                         {"batch-jobs", required_argument, 0, 27},
                          {0, 0, 0, 0}};
 
   char c;
@@ -152,6 +193,52 @@ void ConfigReader::read(Config* cfg, int argc, char** argv) const {
       case 16:
         cfg->dontLabelDeg2 = true;
         break;
+      case 17:
+        cfg->inFormat = optarg;
+        break;
+      case 18:
+        cfg->outPrecision = atoi(optarg);
+        break;
+      case 19:
+        cfg->mvtPath = optarg;
+        break;
+      case 20:
+        cfg->mvtZooms.clear();
+        for (const auto& r : util::split(optarg, ',')) {
+          auto lr = util::split(r, '-');
+          if (lr.size() < 1 || lr.size() > 2 || lr.front().empty() ||
+              lr.back().empty()) {
+            LOG(ERROR) << "Invalid zoom level range " << r;
+            exit(1);
+          }
+          for (int z = atoi(lr.front().c_str()); z <= atoi(lr.back().c_str());
+               z++) {
+            cfg->mvtZooms.push_back(z);
+          }
+        }
+        break;
+      case 21:
+        cfg->lodTolerance = atof(optarg);
+        break;
+      case 22:
+        cfg->inputFile = optarg;
+        break;
+      case 23:
+        cfg->writeStats = true;
+        break;
+      case 24:
+        cfg->traceFile = optarg;
+        break;
+      case 25:
+        cfg->timeBudget = atof(optarg);
+        cfg->deadline = util::Deadline(cfg->timeBudget);
+        break;
+      case 26:
+        cfg->batchFile = optarg;
+        break;
+      case 27:
+        cfg->batchJobs = atol(optarg);
+        break;
       case 'D':
         cfg->fromDot = true;
         break;
@@ -170,6 +257,41 @@ void ConfigReader::read(Config* cfg, int argc, char** argv) const {
         break;
     }
   }
+  if (cfg->inFormat != "geojson" && cfg->inFormat != "bin") {
+    LOG(ERROR) << "Unknown input format " << cfg->inFormat
+               << ", must be one of {geojson, bin}";
+    exit(1);
+  }
+
+  if (!cfg->inputFile.empty() && access(cfg->inputFile.c_str(), R_OK) != 0) {
+    LOG(ERROR) << "Cannot read input file " << cfg->inputFile;
+    exit(1);
+  }
+
+  if (!cfg->batchFile.empty() && access(cfg->batchFile.c_str(), R_OK) != 0) {
+    LOG(ERROR) << "Cannot read batch file " << cfg->batchFile;
+    exit(1);
+  }
+
+  if (cfg->renderMethod != "svg" && cfg->renderMethod != "mvt" &&
+      cfg->renderMethod != "png") {
+    LOG(ERROR) << "Unknown render engine " << cfg->renderMethod
+               << ", must be one of {svg, mvt, png}";
+    exit(1);
+  }
+
+  for (size_t z : cfg->mvtZooms) {
+    if (z > 25) {
+      LOG(ERROR) << "Zoom level must be at most 25";
+      exit(1);
+    }
+  }
+
+  if (cfg->outPrecision > 9) {
+    LOG(ERROR) << "Output precision must be at most 9";
+    exit(1);
+  }
+
   if (cfg->outputPadding < 0) {
     cfg->outputPadding = (cfg->lineWidth + cfg->lineSpacing);
   }
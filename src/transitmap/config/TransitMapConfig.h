@@ -6,6 +6,8 @@
 #define TRANSITMAP_CONFIG_TRANSITMAPCONFIG_H_
 
 #include <string>
+#include <vector>
+#include "util/Deadline.h"
 
 namespace transitmapper {
 namespace config {
@@ -17,14 +19,26 @@ struct Config {
   double lineLabelSize = 40;
   double stationLabelSize = 60;
 
+  // either svg, mvt or png
   std::string renderMethod = "svg";
 
+  // output directory and zoom levels of the mvt tile pyramid
+  std::string mvtPath = ".";
+  std::vector<size_t> mvtZooms = {0, 1, 2,  3,  4,  5,  6,  7,
+                                  8, 9, 10, 11, 12, 13, 14};
+
   double outputResolution = 0.1;
   double inputSmoothing = 3;
   double innerGeometryPrecision = 3;
 
+  // generalisation tolerance in output pixels, 0 to disable
+  double lodTolerance = 0.5;
+
   double outputPadding = -1;
 
+  // number of decimals of SVG coordinates
+  size_t outPrecision = 2;
+
   double outlineWidth = 2;
   std::string outlineColor;
 
@@ -36,6 +50,31 @@ struct Config {
   bool dontLabelDeg2 = false;
   bool fromDot = false;
 
+  // read the input from this file instead of stdin
+  std::string inputFile;
+
+  // write timings and counters to stderr
+  bool writeStats = false;
+
+  // write a Chrome trace-event file of the instrumented phases here
+  std::string traceFile;
+
+  // wall-clock budget of the run, see --time-budget
+  util::Deadline deadline;
+
+  // the budget in seconds (negative for none), batch jobs get a deadline of
+  // their own
+  double timeBudget = -1;
+
+  // render the input and output pairs listed in this file, see --batch
+  std::string batchFile;
+
+  // networks rendered at once in batch mode, 0 for one per core
+  size_t batchJobs = 0;
+
+  // either geojson or bin
+  std::string inFormat = "geojson";
+
   bool renderNodeConnections = true;
   bool tightStations = false;
 
@@ -32,7 +32,7 @@ GraphBuilder::GraphBuilder(const config::Config* cfg) : _cfg(cfg) {}
 // _____________________________________________________________________________
 void GraphBuilder::writeNodeFronts(RenderGraph* graph) {
   for (auto n : graph->getNds()) {
-    std::set<LineEdge*> eSet;
+    std::set<LineEdge*, util::graph::IdCmp<LineEdge>> eSet;
     eSet.insert(n->getAdjList().begin(), n->getAdjList().end());
 
     for (LineEdge* e : eSet) {
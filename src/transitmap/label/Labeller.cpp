@@ -4,6 +4,7 @@
 
 #include "shared/rendergraph/RenderGraph.h"
 #include "transitmap/label/Labeller.h"
+#include "util/Stats.h"
 #include "util/geo/Geo.h"
 
 using shared::rendergraph::RenderGraph;
@@ -20,6 +21,7 @@ Labeller::Labeller(const config::Config* cfg) : _cfg(cfg) {}
 
 // _____________________________________________________________________________
 void Labeller::label(const RenderGraph& g, bool notDeg2) {
+  STATS_TIMER("transitmap/label");
   // leave enough room for labels
   auto bbox = util::geo::pad(g.getBBox(), 500);
   _statLblGrid = StatLblGrid(200, 200, bbox);
@@ -95,6 +97,10 @@ void Labeller::labelStations(const RenderGraph& g, bool notdeg2) {
   std::sort(orderedNds.begin(), orderedNds.end(), statNdCmp);
 
   for (auto n : orderedNds) {
+    // stations are ordered by importance, if out of time, leave the
+    // remaining ones unlabelled
+    if (_cfg->deadline.expired()) break;
+
     double fontSize = _cfg->stationLabelSize;
 
     std::vector<StationLabel> cands;
@@ -187,6 +193,7 @@ void Labeller::labelLines(const RenderGraph& g) {
   auto bbox = util::geo::pad(g.getBBox(), 500);
   LineLblGrid labelGrid = LineLblGrid(200, 200, bbox);
   for (auto n : g.getNds()) {
+    if (_cfg->deadline.expired()) break;
     for (auto e : n->getAdjList()) {
       if (e->getFrom() != n) continue;
       double geomLen = util::geo::len(*e->pl().getGeom());
@@ -277,6 +284,10 @@ void Labeller::labelLines(const RenderGraph& g) {
       labelGrid.add(cands.front().geom.getLine(), _lineLabels.size() - 1);
     }
   }
+
+  // both label grids are alive here
+  util::stats::MemTrack gridMem(util::stats::MEM_GRID);
+  STATS_MEM(gridMem, labelGrid.memUsage() + _statLblGrid.memUsage());
 }
 
 // _____________________________________________________________________________
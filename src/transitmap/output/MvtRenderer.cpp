@@ -0,0 +1,483 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <errno.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "shared/linegraph/Line.h"
+#include "shared/rendergraph/RenderGraph.h"
+#include "transitmap/config/TransitMapConfig.h"
+#include "transitmap/label/Labeller.h"
+#include "transitmap/output/MvtRenderer.h"
+#include "util/Misc.h"
+#include "util/log/Log.h"
+
+using shared::linegraph::Line;
+using shared::rendergraph::RenderGraph;
+using transitmapper::label::Labeller;
+using transitmapper::output::MvtAttrs;
+using transitmapper::output::MvtRenderer;
+using transitmapper::output::MvtTile;
+using util::geo::DLine;
+using util::geo::DPoint;
+using util::geo::ILine;
+using util::geo::IPoint;
+using util::geo::PolyLine;
+
+namespace {
+
+// half the extent of the web mercator plane
+const double WORLD = 20037508.342789244;
+
+typedef std::pair<size_t, size_t> TileId;
+
+// _____________________________________________________________________________
+bool mkdirs(const std::string& path) {
+  for (size_t i = 1; i <= path.size(); i++) {
+    if (i == path.size() || path[i] == '/') {
+      if (mkdir(path.substr(0, i).c_str(), 0755) != 0 && errno != EEXIST)
+        return false;
+    }
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+bool clipT(double p, double q, double* t0, double* t1) {
+  if (p == 0) return q >= 0;
+  double r = q / p;
+  if (p < 0) {
+    if (r > *t1) return false;
+    if (r > *t0) *t0 = r;
+  } else {
+    if (r < *t0) return false;
+    if (r < *t1) *t1 = r;
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+std::vector<DLine> clipLine(const DLine& l, double min, double max) {
+  // Liang-Barsky on each segment, a line leaving and re-entering the box
+  // is split into several parts
+  std::vector<DLine> ret;
+  bool open = false;
+  for (size_t i = 1; i < l.size(); i++) {
+    const DPoint& a = l[i - 1];
+    double dx = l[i].getX() - a.getX();
+    double dy = l[i].getY() - a.getY();
+    double t0 = 0, t1 = 1;
+
+    if (!clipT(-dx, a.getX() - min, &t0, &t1) ||
+        !clipT(dx, max - a.getX(), &t0, &t1) ||
+        !clipT(-dy, a.getY() - min, &t0, &t1) ||
+        !clipT(dy, max - a.getY(), &t0, &t1)) {
+      open = false;
+      continue;
+    }
+
+    if (!open || t0 > 0) {
+      ret.push_back({DPoint(a.getX() + t0 * dx, a.getY() + t0 * dy)});
+      open = true;
+    }
+    ret.back().push_back(DPoint(a.getX() + t1 * dx, a.getY() + t1 * dy));
+    if (t1 < 1) open = false;
+  }
+  return ret;
+}
+
+// _____________________________________________________________________________
+DLine clipRing(const DLine& ring, double min, double max) {
+  // Sutherland-Hodgman against the four box sides
+  DLine ret = ring;
+  for (size_t side = 0; side < 4; side++) {
+    bool isX = side < 2;
+    double bound = side % 2 ? max : min;
+    auto in = [&](const DPoint& p) {
+      double v = isX ? p.getX() : p.getY();
+      return side % 2 ? v <= bound : v >= bound;
+    };
+
+    DLine cur;
+    for (size_t i = 0; i < ret.size(); i++) {
+      const DPoint& a = ret[i];
+      const DPoint& b = ret[(i + 1) % ret.size()];
+      bool aIn = in(a);
+      bool bIn = in(b);
+      if (aIn) cur.push_back(a);
+      if (aIn != bIn) {
+        double t = isX ? (bound - a.getX()) / (b.getX() - a.getX())
+                       : (bound - a.getY()) / (b.getY() - a.getY());
+        cur.push_back(DPoint(a.getX() + t * (b.getX() - a.getX()),
+                             a.getY() + t * (b.getY() - a.getY())));
+      }
+    }
+    ret = cur;
+  }
+  return ret;
+}
+
+// _____________________________________________________________________________
+ILine toInt(const DLine& l) {
+  ILine ret;
+  for (const auto& p : l) {
+    IPoint ip(std::lround(p.getX()), std::lround(p.getY()));
+    if (ret.empty() || ret.back() != ip) ret.push_back(ip);
+  }
+  return ret;
+}
+
+// _____________________________________________________________________________
+int64_t area2(const ILine& ring) {
+  int64_t ret = 0;
+  for (size_t i = 0; i < ring.size(); i++) {
+    const auto& a = ring[i];
+    const auto& b = ring[(i + 1) % ring.size()];
+    ret += static_cast<int64_t>(a.getX()) * b.getY() -
+           static_cast<int64_t>(b.getX()) * a.getY();
+  }
+  return ret;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+MvtRenderer::MvtRenderer(const config::Config* cfg) : _cfg(cfg) {}
+
+// _____________________________________________________________________________
+void MvtRenderer::print(const RenderGraph& outG) {
+  _layers = {{"lines", {}}, {"stations", {}}, {"nodefronts", {}},
+             {"labels", {}}};
+
+  if (_cfg->renderEdges) addEdges(outG, &_layers[0]);
+  if (_cfg->renderNodeConnections) addNodeConnections(outG, &_layers[0]);
+  if (_cfg->renderStations) addStations(outG, &_layers[1]);
+  if (_cfg->renderNodeFronts) addNodeFronts(outG, &_layers[2]);
+  if (_cfg->renderLabels) addLabels(outG, &_layers[3]);
+
+  if (!mkdirs(_cfg->mvtPath)) {
+    throw std::runtime_error("Could not create tile directory " +
+                             _cfg->mvtPath);
+  }
+
+  for (size_t z : _cfg->mvtZooms) {
+    T_START(zoom);
+    size_t n = renderZoom(z);
+    LOGTO(INFO, std::cerr) << "Wrote " << n << " tiles for zoom " << z
+                           << " in " << T_STOP(zoom) << "ms";
+  }
+}
+
+// _____________________________________________________________________________
+size_t MvtRenderer::renderZoom(size_t z) const {
+  size_t numTiles = size_t(1) << z;
+  double tileSize = 2 * WORLD / numTiles;
+  double unit = tileSize / MVT_EXTENT;
+  double buffer = MVT_BUFFER * unit;
+
+  // per-zoom simplification, to the precision of a single tile unit
+  std::vector<std::vector<DLine>> simple(_layers.size());
+  for (size_t li = 0; li < _layers.size(); li++) {
+    const auto& feats = _layers[li].feats;
+    simple[li].resize(feats.size());
+#pragma omp parallel for schedule(dynamic)
+    for (size_t fi = 0; fi < feats.size(); fi++) {
+      if (feats[fi].geom.size() < 3) {
+        simple[li][fi] = feats[fi].geom;
+      } else {
+        simple[li][fi] = util::geo::simplify(feats[fi].geom, unit);
+      }
+    }
+  }
+
+  auto tileX = [&](double x) {
+    double t = std::floor((x + WORLD) / tileSize);
+    return static_cast<size_t>(std::min<double>(
+        std::max<double>(t, 0), static_cast<double>(numTiles - 1)));
+  };
+  auto tileY = [&](double y) {
+    double t = std::floor((WORLD - y) / tileSize);
+    return static_cast<size_t>(std::min<double>(
+        std::max<double>(t, 0), static_cast<double>(numTiles - 1)));
+  };
+
+  // assign features to tiles. Line strings are assigned per segment, to not
+  // touch every tile in the bounding box of long diagonal lines
+  std::map<TileId, std::vector<std::pair<size_t, size_t>>> tiles;
+  for (size_t li = 0; li < _layers.size(); li++) {
+    for (size_t fi = 0; fi < simple[li].size(); fi++) {
+      const auto& geom = simple[li][fi];
+      if (geom.empty()) continue;
+
+      std::vector<util::geo::DBox> boxes;
+      if (_layers[li].feats[fi].type == MvtTile::LINESTRING &&
+          _layers[li].feats[fi].clip && geom.size() > 1) {
+        for (size_t i = 1; i < geom.size(); i++) {
+          boxes.push_back(util::geo::getBoundingBox(
+              util::geo::DLineSegment(geom[i - 1], geom[i])));
+        }
+      } else {
+        boxes.push_back(util::geo::getBoundingBox(geom));
+      }
+
+      std::set<TileId> ids;
+      for (auto box : boxes) {
+        box = util::geo::pad(box, buffer);
+        for (size_t x = tileX(box.getLowerLeft().getX());
+             x <= tileX(box.getUpperRight().getX()); x++) {
+          for (size_t y = tileY(box.getUpperRight().getY());
+               y <= tileY(box.getLowerLeft().getY()); y++) {
+            ids.insert({x, y});
+          }
+        }
+      }
+
+      for (const auto& id : ids) tiles[id].push_back({li, fi});
+    }
+  }
+
+  std::vector<const std::pair<const TileId,
+                              std::vector<std::pair<size_t, size_t>>>*>
+      todo;
+  for (const auto& t : tiles) todo.push_back(&t);
+
+  size_t written = 0;
+  size_t failed = 0;
+
+#pragma omp parallel for schedule(dynamic) reduction(+ : written, failed)
+  for (size_t i = 0; i < todo.size(); i++) {
+    size_t x = todo[i]->first.first;
+    size_t y = todo[i]->first.second;
+    double minX = -WORLD + x * tileSize;
+    double maxY = WORLD - y * tileSize;
+
+    MvtTile tile(MVT_EXTENT);
+    size_t curLayer = 0;
+    tile.addLayer(_layers[0].name);
+
+    for (const auto& f : todo[i]->second) {
+      while (curLayer < f.first) tile.addLayer(_layers[++curLayer].name);
+      const Feature& feat = _layers[f.first].feats[f.second];
+
+      // to tile coordinates, y axis pointing down
+      DLine local;
+      local.reserve(simple[f.first][f.second].size());
+      for (const auto& p : simple[f.first][f.second]) {
+        local.push_back(
+            DPoint((p.getX() - minX) / unit, (maxY - p.getY()) / unit));
+      }
+
+      double lo = -static_cast<double>(MVT_BUFFER);
+      double hi = static_cast<double>(MVT_EXTENT + MVT_BUFFER);
+
+      std::vector<ILine> parts;
+      if (feat.type == MvtTile::POLYGON) {
+        ILine ring = toInt(feat.clip ? clipRing(local, lo, hi) : local);
+        if (ring.size() > 1 && ring.front() == ring.back()) ring.pop_back();
+        int64_t a = area2(ring);
+        if (ring.size() < 3 || a == 0) continue;
+        if (a < 0) std::reverse(ring.begin(), ring.end());
+        parts.push_back(ring);
+      } else if (feat.type == MvtTile::LINESTRING) {
+        std::vector<DLine> clipped;
+        if (feat.clip) {
+          clipped = clipLine(local, lo, hi);
+        } else {
+          clipped.push_back(local);
+        }
+        for (const auto& part : clipped) {
+          ILine l = toInt(part);
+          if (l.size() > 1) parts.push_back(l);
+        }
+        if (parts.empty()) continue;
+      } else {
+        parts.push_back(toInt(local));
+      }
+
+      tile.addFeature(f.second + 1, feat.type, parts, feat.attrs);
+    }
+
+    if (tile.empty()) continue;
+
+    std::string dir = _cfg->mvtPath + "/" + std::to_string(z) + "/" +
+                      std::to_string(x);
+    std::ofstream out;
+    if (mkdirs(dir)) {
+      out.open(dir + "/" + std::to_string(y) + ".mvt", std::ios::binary);
+      std::string data = tile.serialize();
+      out.write(data.data(), data.size());
+    }
+
+    if (out.good()) {
+      written++;
+    } else {
+      failed++;
+    }
+  }
+
+  if (failed) {
+    throw std::runtime_error("Could not write " + std::to_string(failed) +
+                             " tiles for zoom " + std::to_string(z) + " to " +
+                             _cfg->mvtPath);
+  }
+
+  return written;
+}
+
+// _____________________________________________________________________________
+MvtAttrs MvtRenderer::lineAttrs(const Line* line,
+                                const std::string& type) const {
+  return {{"type", type},
+          {"line", line->id()},
+          {"label", line->label()},
+          {"color", "#" + line->color()}};
+}
+
+// _____________________________________________________________________________
+void MvtRenderer::addEdges(const RenderGraph& outG, Layer* l) const {
+  // the same line geometries as in the SVG output, offset from the edge
+  // center and cut at the node fronts
+  for (auto n : outG.getNds()) {
+    for (auto e : n->getAdjList()) {
+      if (e->getFrom() != n) continue;
+      const auto* nfTo = e->getTo()->pl().frontFor(e);
+      const auto* nfFrom = e->getFrom()->pl().frontFor(e);
+      if (!nfTo || !nfFrom) continue;
+
+      PolyLine<double> center = *e->pl().getGeom();
+
+      double offsetStep = _cfg->lineWidth + _cfg->lineSpacing;
+      double oo = outG.getTotalWidth(e);
+      double o = oo;
+
+      for (size_t i = 0; i < e->pl().getLines().size(); i++) {
+        const auto& lo = e->pl().lineOccAtPos(i);
+        PolyLine<double> p = center;
+
+        if (p.getLength() < 0.01) continue;
+
+        p.offsetPerp(-(o - oo / 2.0 - _cfg->lineWidth / 2.0));
+
+        auto iSects = nfTo->geom.getIntersections(p);
+        if (iSects.size() > 0) {
+          p = p.getSegment(0, iSects.begin()->totalPos);
+        } else {
+          p << nfTo->geom.projectOn(p.back()).p;
+        }
+
+        auto iSects2 = nfFrom->geom.getIntersections(p);
+        if (iSects2.size() > 0) {
+          p = p.getSegment(iSects2.begin()->totalPos, 1);
+        } else {
+          p >> nfFrom->geom.projectOn(p.front()).p;
+        }
+
+        MvtAttrs attrs = lineAttrs(lo.line, "edge");
+        if (!lo.style.isNull()) {
+          attrs.push_back({"css", lo.style.get().getCss()});
+          attrs.push_back({"outline-css", lo.style.get().getOutlineCss()});
+        }
+
+        l->feats.push_back({MvtTile::LINESTRING, p.getLine(), attrs, true});
+
+        o -= offsetStep;
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void MvtRenderer::addNodeConnections(const RenderGraph& outG,
+                                     Layer* l) const {
+  for (auto n : outG.getNds()) {
+    for (const auto& ig : outG.innerGeoms(n, _cfg->innerGeometryPrecision)) {
+      l->feats.push_back({MvtTile::LINESTRING, ig.geom.getLine(),
+                          lineAttrs(ig.from.line, "inner"), true});
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void MvtRenderer::addStations(const RenderGraph& outG, Layer* l) const {
+  for (auto n : outG.getNds()) {
+    if (n->pl().stops().size() == 0 || n->pl().fronts().size() == 0) continue;
+    const auto& stop = n->pl().stops().front();
+    for (const auto& geom :
+         outG.getStopGeoms(n, (_cfg->lineSpacing + _cfg->lineWidth) * 0.8,
+                           _cfg->tightStations, 32)) {
+      l->feats.push_back({MvtTile::POLYGON,
+                          geom.getOuter(),
+                          {{"id", stop.id}, {"name", stop.name}},
+                          true});
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void MvtRenderer::addNodeFronts(const RenderGraph& outG, Layer* l) const {
+  for (auto n : outG.getNds()) {
+    for (const auto& f : n->pl().fronts()) {
+      l->feats.push_back(
+          {MvtTile::LINESTRING,
+           f.geom.getLine(),
+           {{"station", n->pl().stops().size() ? "yes" : "no"}},
+           true});
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void MvtRenderer::addLabels(const RenderGraph& outG, Layer* l) const {
+  Labeller labeller(_cfg);
+  labeller.label(outG, _cfg->dontLabelDeg2);
+
+  // text paths are reversed as in the SVG output, to be read left to right
+  for (const auto& label : labeller.getStationLabels()) {
+    auto textPath = label.geom;
+    double ang = util::geo::angBetween(textPath.front(), textPath.back());
+    if ((fabs(ang) < (3 * M_PI / 2)) && (fabs(ang) > (M_PI / 2))) {
+      textPath.reverse();
+    }
+
+    l->feats.push_back({MvtTile::LINESTRING,
+                        textPath.getLine(),
+                        {{"type", "station"},
+                         {"text", label.s.name},
+                         {"font-size", label.fontSize},
+                         {"font-weight", label.bold ? "bold" : "normal"}},
+                        false});
+  }
+
+  for (const auto& label : labeller.getLineLabels()) {
+    auto textPath = label.geom;
+    double ang = util::geo::angBetween(textPath.front(), textPath.back());
+    if ((fabs(ang) < (3 * M_PI / 2)) && (fabs(ang) > (M_PI / 2))) {
+      textPath.reverse();
+    }
+
+    std::string text, colors;
+    for (const auto* line : label.lines) {
+      if (!text.empty()) {
+        text += " ";
+        colors += ",";
+      }
+      text += line->label();
+      colors += "#" + line->color();
+    }
+
+    l->feats.push_back({MvtTile::LINESTRING,
+                        textPath.getLine(),
+                        {{"type", "line"},
+                         {"text", text},
+                         {"colors", colors},
+                         {"font-size", label.fontSize}},
+                        false});
+  }
+}
@@ -0,0 +1,69 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef TRANSITMAP_OUTPUT_MVTRENDERER_H_
+#define TRANSITMAP_OUTPUT_MVTRENDERER_H_
+
+#include <string>
+#include <vector>
+#include "Renderer.h"
+#include "shared/rendergraph/RenderGraph.h"
+#include "transitmap/config/TransitMapConfig.h"
+#include "transitmap/output/MvtTile.h"
+#include "util/geo/Geo.h"
+
+namespace transitmapper {
+namespace output {
+
+// tile extent and clipping buffer, in tile units
+const uint32_t MVT_EXTENT = 4096;
+const uint32_t MVT_BUFFER = 64;
+
+// renders the graph into a z/x/y pyramid of Mapbox Vector Tiles below
+// cfg->mvtPath. Geometries are simplified per zoom level and clipped to the
+// (buffered) tile, only non-empty tiles are written.
+class MvtRenderer : public Renderer {
+ public:
+  explicit MvtRenderer(const config::Config* cfg);
+  virtual ~MvtRenderer(){};
+
+  virtual void print(const shared::rendergraph::RenderGraph& outG);
+
+ private:
+  struct Feature {
+    MvtTile::GeomType type;
+    util::geo::DLine geom;
+    MvtAttrs attrs;
+    // labels are not clipped, text paths would be cut otherwise
+    bool clip;
+  };
+
+  struct Layer {
+    std::string name;
+    std::vector<Feature> feats;
+  };
+
+  const config::Config* _cfg;
+  std::vector<Layer> _layers;
+
+  void addEdges(const shared::rendergraph::RenderGraph& outG, Layer* l) const;
+  void addNodeConnections(const shared::rendergraph::RenderGraph& outG,
+                          Layer* l) const;
+  void addStations(const shared::rendergraph::RenderGraph& outG,
+                   Layer* l) const;
+  void addNodeFronts(const shared::rendergraph::RenderGraph& outG,
+                     Layer* l) const;
+  void addLabels(const shared::rendergraph::RenderGraph& outG, Layer* l) const;
+
+  // returns the number of written tiles
+  size_t renderZoom(size_t z) const;
+
+  MvtAttrs lineAttrs(const shared::linegraph::Line* line,
+                     const std::string& type) const;
+};
+
+}  // namespace output
+}  // namespace transitmapper
+
+#endif  // TRANSITMAP_OUTPUT_MVTRENDERER_H_
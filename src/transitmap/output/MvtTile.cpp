@@ -0,0 +1,158 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "transitmap/output/MvtTile.h"
+
+using transitmapper::output::MvtAttrs;
+using transitmapper::output::MvtTile;
+using util::geo::ILine;
+
+namespace {
+
+// protobuf wire types
+const uint8_t VARINT = 0;
+const uint8_t FIXED64 = 1;
+const uint8_t LEN = 2;
+
+// _____________________________________________________________________________
+void varint(std::string* out, uint64_t v) {
+  while (v >= 0x80) {
+    *out += static_cast<char>((v & 0x7F) | 0x80);
+    v >>= 7;
+  }
+  *out += static_cast<char>(v);
+}
+
+// _____________________________________________________________________________
+void key(std::string* out, uint32_t field, uint8_t type) {
+  varint(out, (field << 3) | type);
+}
+
+// _____________________________________________________________________________
+void lenDelim(std::string* out, uint32_t field, const std::string& v) {
+  key(out, field, LEN);
+  varint(out, v.size());
+  *out += v;
+}
+
+// _____________________________________________________________________________
+uint32_t zigzag(int32_t v) {
+  return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+// _____________________________________________________________________________
+uint32_t cmd(uint32_t id, uint32_t count) { return (id & 0x7) | (count << 3); }
+}  // namespace
+
+// _____________________________________________________________________________
+MvtTile::MvtTile(uint32_t extent) : _extent(extent) {}
+
+// _____________________________________________________________________________
+void MvtTile::addLayer(const std::string& name) {
+  _layers.push_back(Layer());
+  _layers.back().name = name;
+  _layers.back().numFeatures = 0;
+}
+
+// _____________________________________________________________________________
+void MvtTile::addFeature(uint64_t id, GeomType type,
+                         const std::vector<ILine>& parts,
+                         const MvtAttrs& attrs) {
+  Layer& l = _layers.back();
+
+  std::string tags;
+  for (const auto& kv : attrs) {
+    auto k = l.keyIdx.find(kv.first);
+    if (k == l.keyIdx.end()) {
+      k = l.keyIdx.insert({kv.first, l.keys.size()}).first;
+      l.keys.push_back(kv.first);
+    }
+
+    std::string val;
+    if (kv.second.isNum) {
+      // double_value
+      key(&val, 3, FIXED64);
+      char buf[sizeof(double)];
+      memcpy(buf, &kv.second.num, sizeof(double));
+      val.append(buf, sizeof(double));
+    } else {
+      // string_value
+      lenDelim(&val, 1, kv.second.str);
+    }
+
+    auto v = l.valIdx.find(val);
+    if (v == l.valIdx.end()) {
+      v = l.valIdx.insert({val, l.vals.size()}).first;
+      l.vals.push_back(val);
+    }
+
+    varint(&tags, k->second);
+    varint(&tags, v->second);
+  }
+
+  // geometry commands, the cursor is kept over all parts
+  std::string geom;
+  int32_t cx = 0, cy = 0;
+  for (const auto& part : parts) {
+    if (part.empty()) continue;
+    varint(&geom, cmd(1, 1));
+    varint(&geom, zigzag(part[0].getX() - cx));
+    varint(&geom, zigzag(part[0].getY() - cy));
+    cx = part[0].getX();
+    cy = part[0].getY();
+
+    if (part.size() > 1) varint(&geom, cmd(2, part.size() - 1));
+    for (size_t i = 1; i < part.size(); i++) {
+      varint(&geom, zigzag(part[i].getX() - cx));
+      varint(&geom, zigzag(part[i].getY() - cy));
+      cx = part[i].getX();
+      cy = part[i].getY();
+    }
+
+    if (type == POLYGON) varint(&geom, cmd(7, 1));
+  }
+
+  std::string feature;
+  key(&feature, 1, VARINT);
+  varint(&feature, id);
+  if (!tags.empty()) lenDelim(&feature, 2, tags);
+  key(&feature, 3, VARINT);
+  varint(&feature, type);
+  lenDelim(&feature, 4, geom);
+
+  lenDelim(&l.features, 2, feature);
+  l.numFeatures++;
+}
+
+// _____________________________________________________________________________
+bool MvtTile::empty() const {
+  for (const auto& l : _layers) {
+    if (l.numFeatures) return false;
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+std::string MvtTile::serialize() const {
+  std::string ret;
+  for (const auto& l : _layers) {
+    if (!l.numFeatures) continue;
+
+    std::string layer;
+    key(&layer, 15, VARINT);
+    varint(&layer, 2);
+    lenDelim(&layer, 1, l.name);
+    layer += l.features;
+    for (const auto& k : l.keys) lenDelim(&layer, 3, k);
+    for (const auto& v : l.vals) lenDelim(&layer, 4, v);
+    key(&layer, 5, VARINT);
+    varint(&layer, _extent);
+
+    lenDelim(&ret, 3, layer);
+  }
+  return ret;
+}
@@ -0,0 +1,72 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef TRANSITMAP_OUTPUT_MVTTILE_H_
+#define TRANSITMAP_OUTPUT_MVTTILE_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "util/geo/Geo.h"
+
+namespace transitmapper {
+namespace output {
+
+// attribute value of a tile feature, either a string or a number
+struct MvtVal {
+  MvtVal(const std::string& str) : str(str), num(0), isNum(false) {}
+  MvtVal(const char* str) : str(str), num(0), isNum(false) {}
+  MvtVal(double num) : num(num), isNum(true) {}
+  std::string str;
+  double num;
+  bool isNum;
+};
+
+typedef std::vector<std::pair<std::string, MvtVal>> MvtAttrs;
+
+// a single Mapbox Vector Tile (version 2) under construction. Features are
+// given in integer tile coordinates and encoded immediately.
+class MvtTile {
+ public:
+  enum GeomType { POINT = 1, LINESTRING = 2, POLYGON = 3 };
+
+  explicit MvtTile(uint32_t extent);
+
+  // start a new layer, features are added to the last layer
+  void addLayer(const std::string& name);
+
+  // add a feature to the current layer. Each part is a line string or a
+  // polygon ring without the closing point, exterior rings have to be
+  // clockwise in tile coordinates.
+  void addFeature(uint64_t id, GeomType type,
+                  const std::vector<util::geo::ILine>& parts,
+                  const MvtAttrs& attrs);
+
+  // true if no layer contains a feature
+  bool empty() const;
+
+  // the protobuf encoded tile, empty layers are left out
+  std::string serialize() const;
+
+ private:
+  struct Layer {
+    std::string name;
+    std::string features;
+    size_t numFeatures;
+    std::vector<std::string> keys;
+    std::map<std::string, uint32_t> keyIdx;
+    // encoded Value messages
+    std::vector<std::string> vals;
+    std::map<std::string, uint32_t> valIdx;
+  };
+
+  uint32_t _extent;
+  std::vector<Layer> _layers;
+};
+
+}  // namespace output
+}  // namespace transitmapper
+
+#endif  // TRANSITMAP_OUTPUT_MVTTILE_H_
@@ -0,0 +1,220 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "shared/linegraph/Line.h"
+#include "shared/rendergraph/RenderGraph.h"
+#include "transitmap/config/TransitMapConfig.h"
+#include "transitmap/output/PngRenderer.h"
+#include "transitmap/output/PngWriter.h"
+#include "util/log/Log.h"
+
+using shared::rendergraph::RenderGraph;
+using transitmapper::output::PngRenderer;
+using transitmapper::output::Raster;
+using transitmapper::output::Rgba;
+using util::geo::DLine;
+using util::geo::DPoint;
+using util::geo::PolyLine;
+
+namespace {
+// largest supported image, in pixels
+const size_t MAX_PIXELS = size_t(1) << 28;
+}  // namespace
+
+// _____________________________________________________________________________
+PngRenderer::PngRenderer(std::ostream* o, const config::Config* cfg)
+    : _o(o), _cfg(cfg), _xOff(0), _yOff(0), _height(0) {}
+
+// _____________________________________________________________________________
+void PngRenderer::print(const RenderGraph& outG) {
+  if (_cfg->renderLabels) {
+    LOG(WARN) << "Labels are not rendered by the png render engine";
+  }
+
+  auto box = outG.getBBox();
+  box = util::geo::pad(
+      box, outG.getMaxLineNum() * (_cfg->lineWidth + _cfg->lineSpacing));
+  box = util::geo::pad(box, _cfg->outputPadding);
+
+  if (!_cfg->worldFilePath.empty()) {
+    std::ofstream file;
+    file.open(_cfg->worldFilePath);
+    if (file) {
+      file << 1 / _cfg->outputResolution << std::endl
+           << 0 << std::endl
+           << 0 << std::endl
+           << -1 / _cfg->outputResolution << std::endl
+           << std::fixed << box.getLowerLeft().getX() << std::endl
+           << box.getUpperRight().getY() << std::endl;
+      file.close();
+    }
+  }
+
+  _xOff = box.getLowerLeft().getX();
+  _yOff = box.getLowerLeft().getY();
+  _height = box.getUpperRight().getY() - _yOff;
+
+  double w = std::ceil((box.getUpperRight().getX() - _xOff) *
+                       _cfg->outputResolution);
+  double h = std::ceil(_height * _cfg->outputResolution);
+
+  if (w < 1 || h < 1 || w * h > MAX_PIXELS) {
+    std::stringstream ss;
+    ss << "Cannot render a " << w << "x" << h
+       << " px image, adjust the resolution";
+    throw std::runtime_error(ss.str());
+  }
+
+  Raster r(w, h);
+
+  T_START(png);
+  if (_cfg->renderEdges) renderEdges(outG, &r);
+  if (_cfg->renderNodeConnections) renderNodeConnections(outG, &r);
+  if (_cfg->renderStations) renderStations(outG, &r);
+  if (_cfg->renderNodeFronts) renderNodeFronts(outG, &r);
+  LOGTO(DEBUG, std::cerr) << "Built shapes in " << T_STOP(png) << "ms";
+
+  T_START(raster);
+  r.render();
+  LOGTO(DEBUG, std::cerr) << "Rasterised " << w << "x" << h << " px in "
+                          << T_STOP(raster) << "ms";
+
+  T_START(write);
+  PngWriter(_o).write(r.getPixels(), r.getWidth(), r.getHeight());
+  LOGTO(DEBUG, std::cerr) << "Wrote PNG in " << T_STOP(write) << "ms";
+}
+
+// _____________________________________________________________________________
+void PngRenderer::renderEdges(const RenderGraph& outG, Raster* r) const {
+  double res = _cfg->outputResolution;
+
+  // the same line geometries as in the SVG output, offset from the edge
+  // center and cut at the node fronts
+  for (auto n : outG.getNds()) {
+    for (auto e : n->getAdjList()) {
+      if (e->getFrom() != n) continue;
+      const auto* nfTo = e->getTo()->pl().frontFor(e);
+      const auto* nfFrom = e->getFrom()->pl().frontFor(e);
+      if (!nfTo || !nfFrom) continue;
+
+      PolyLine<double> center = *e->pl().getGeom();
+
+      double offsetStep = _cfg->lineWidth + _cfg->lineSpacing;
+      double oo = outG.getTotalWidth(e);
+      double o = oo;
+
+      for (size_t i = 0; i < e->pl().getLines().size(); i++) {
+        const auto& lo = e->pl().lineOccAtPos(i);
+        PolyLine<double> p = center;
+
+        if (p.getLength() < 0.01) continue;
+
+        p.offsetPerp(-(o - oo / 2.0 - _cfg->lineWidth / 2.0));
+
+        auto iSects = nfTo->geom.getIntersections(p);
+        if (iSects.size() > 0) {
+          p = p.getSegment(0, iSects.begin()->totalPos);
+        } else {
+          p << nfTo->geom.projectOn(p.back()).p;
+        }
+
+        auto iSects2 = nfFrom->geom.getIntersections(p);
+        if (iSects2.size() > 0) {
+          p = p.getSegment(iSects2.begin()->totalPos, 1);
+        } else {
+          p >> nfFrom->geom.projectOn(p.front()).p;
+        }
+
+        auto l = toPx(p.getLine(), true);
+        if (_cfg->outlineWidth > 0) {
+          r->stroke(l, (_cfg->lineWidth + _cfg->outlineWidth) * res,
+                    Rgba(0, 0, 0, 255), true, false);
+        }
+        r->stroke(l, _cfg->lineWidth * res, color(lo.line->color()), true,
+                  false);
+
+        o -= offsetStep;
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void PngRenderer::renderNodeConnections(const RenderGraph& outG,
+                                        Raster* r) const {
+  double res = _cfg->outputResolution;
+  double prec = std::max(_cfg->innerGeometryPrecision,
+                         std::max(_cfg->lodTolerance, 0.0) / res);
+
+  for (auto n : outG.getNds()) {
+    auto geoms = outG.innerGeoms(n, prec);
+
+    // outlines first, to not cut through crossing connections
+    if (_cfg->outlineWidth > 0) {
+      for (const auto& ig : geoms) {
+        r->stroke(toPx(ig.geom.getLine(), true),
+                  (_cfg->lineWidth + _cfg->outlineWidth) * res,
+                  Rgba(0, 0, 0, 255), false, false);
+      }
+    }
+    for (const auto& ig : geoms) {
+      r->stroke(toPx(ig.geom.getLine(), true), _cfg->lineWidth * res,
+                color(ig.from.line->color()), true, false);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void PngRenderer::renderStations(const RenderGraph& outG, Raster* r) const {
+  double strokeWidth = (_cfg->lineWidth / 2) * _cfg->outputResolution;
+  for (auto n : outG.getNds()) {
+    if (n->pl().stops().size() == 0 || n->pl().fronts().size() == 0) continue;
+    for (const auto& geom :
+         outG.getStopGeoms(n, (_cfg->lineSpacing + _cfg->lineWidth) * 0.8,
+                           _cfg->tightStations, 32)) {
+      // station rings are small, they are not generalised
+      auto ring = toPx(geom.getOuter(), false);
+      r->fill({ring}, Rgba(255, 255, 255, 255));
+      r->stroke(ring, strokeWidth, Rgba(0, 0, 0, 255), false, true);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void PngRenderer::renderNodeFronts(const RenderGraph& outG, Raster* r) const {
+  for (auto n : outG.getNds()) {
+    Rgba c = n->pl().stops().size() > 0 ? Rgba(255, 0, 0, 230)
+                                        : Rgba(0, 0, 0, 230);
+    for (const auto& f : n->pl().fronts()) {
+      r->stroke(toPx(f.geom.getLine(), true), 1, c, true, false);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+DLine PngRenderer::toPx(const DLine& l, bool generalise) const {
+  double res = _cfg->outputResolution;
+  DLine ret;
+  ret.reserve(l.size());
+  for (const auto& p : l) {
+    ret.push_back(DPoint((p.getX() - _xOff) * res,
+                         (_height - (p.getY() - _yOff)) * res));
+  }
+  if (!generalise || _cfg->lodTolerance <= 0 || ret.size() < 3) return ret;
+  return util::geo::simplify(ret, _cfg->lodTolerance);
+}
+
+// _____________________________________________________________________________
+Rgba PngRenderer::color(const std::string& hex) {
+  if (hex.size() != 6) return Rgba(0, 0, 0, 255);
+  uint32_t c = strtoul(hex.c_str(), 0, 16);
+  return Rgba((c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF, 255);
+}
@@ -0,0 +1,53 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef TRANSITMAP_OUTPUT_PNGRENDERER_H_
+#define TRANSITMAP_OUTPUT_PNGRENDERER_H_
+
+#include <ostream>
+#include <string>
+#include "Renderer.h"
+#include "shared/rendergraph/RenderGraph.h"
+#include "transitmap/config/TransitMapConfig.h"
+#include "transitmap/output/Raster.h"
+#include "util/geo/Geo.h"
+
+namespace transitmapper {
+namespace output {
+
+// renders the graph into a PNG image, with the same geometries as the SVG
+// output. Labels, direction markers and line styles are not rendered.
+class PngRenderer : public Renderer {
+ public:
+  PngRenderer(std::ostream* o, const config::Config* cfg);
+  virtual ~PngRenderer(){};
+
+  virtual void print(const shared::rendergraph::RenderGraph& outG);
+
+ private:
+  std::ostream* _o;
+  const config::Config* _cfg;
+
+  // lower left of the rendered box and image height, in map units
+  double _xOff, _yOff, _height;
+
+  void renderEdges(const shared::rendergraph::RenderGraph& outG,
+                   Raster* r) const;
+  void renderNodeConnections(const shared::rendergraph::RenderGraph& outG,
+                             Raster* r) const;
+  void renderStations(const shared::rendergraph::RenderGraph& outG,
+                      Raster* r) const;
+  void renderNodeFronts(const shared::rendergraph::RenderGraph& outG,
+                        Raster* r) const;
+
+  // l in pixel coordinates, optionally generalised to the LOD tolerance
+  util::geo::DLine toPx(const util::geo::DLine& l, bool generalise) const;
+
+  static Rgba color(const std::string& hex);
+};
+
+}  // namespace output
+}  // namespace transitmapper
+
+#endif  // TRANSITMAP_OUTPUT_PNGRENDERER_H_
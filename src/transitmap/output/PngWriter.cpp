@@ -0,0 +1,212 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef ZLIB_CONST
+#define ZLIB_CONST
+#endif
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#ifdef ZLIB_FOUND
+#include <zlib.h>
+#endif
+#include "transitmap/output/PngWriter.h"
+
+using transitmapper::output::PngWriter;
+
+namespace {
+
+// zlib output buffer size
+const size_t BSIZE = 1024 * 64;
+
+// number of image rows which are compressed independently
+const size_t BAND = 256;
+
+const uint32_t ADLER_BASE = 65521;
+
+// _____________________________________________________________________________
+void u32(std::string* out, uint32_t v) {
+  *out += static_cast<char>(v >> 24);
+  *out += static_cast<char>(v >> 16);
+  *out += static_cast<char>(v >> 8);
+  *out += static_cast<char>(v);
+}
+
+#ifndef ZLIB_FOUND
+// _____________________________________________________________________________
+std::vector<uint32_t> crcTable() {
+  std::vector<uint32_t> ret(256);
+  for (uint32_t n = 0; n < 256; n++) {
+    uint32_t c = n;
+    for (size_t k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+    ret[n] = c;
+  }
+  return ret;
+}
+#endif
+
+// _____________________________________________________________________________
+uint32_t adler32(const std::string& data) {
+  uint32_t a = 1, b = 0;
+  size_t pos = 0;
+  while (pos < data.size()) {
+    // largest block without an overflow of b
+    size_t end = std::min(data.size(), pos + 5552);
+    for (; pos < end; pos++) {
+      a += static_cast<unsigned char>(data[pos]);
+      b += a;
+    }
+    a %= ADLER_BASE;
+    b %= ADLER_BASE;
+  }
+  return (b << 16) | a;
+}
+
+// _____________________________________________________________________________
+uint32_t adlerCombine(uint32_t a1, uint32_t a2, size_t len2) {
+  // the checksum of the concatenation, see adler32_combine() of zlib
+  uint32_t rem = len2 % ADLER_BASE;
+  uint32_t s1 = a1 & 0xFFFF;
+  uint32_t s2 = (rem * s1) % ADLER_BASE;
+  s1 += (a2 & 0xFFFF) + ADLER_BASE - 1;
+  s2 += ((a1 >> 16) & 0xFFFF) + ((a2 >> 16) & 0xFFFF) + ADLER_BASE - rem;
+  if (s1 >= ADLER_BASE) s1 -= ADLER_BASE;
+  if (s1 >= ADLER_BASE) s1 -= ADLER_BASE;
+  if (s2 >= (ADLER_BASE << 1)) s2 -= (ADLER_BASE << 1);
+  if (s2 >= ADLER_BASE) s2 -= ADLER_BASE;
+  return (s2 << 16) | s1;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+PngWriter::PngWriter(std::ostream* o) : _o(o) {}
+
+// _____________________________________________________________________________
+void PngWriter::write(const std::vector<uint8_t>& px, size_t w, size_t h) {
+  _o->write("\x89PNG\r\n\x1a\n", 8);
+
+  std::string ihdr;
+  u32(&ihdr, w);
+  u32(&ihdr, h);
+  // 8 bit depth, RGBA, deflate, adaptive filtering, no interlacing
+  ihdr += std::string("\x08\x06\x00\x00\x00", 5);
+  chunk("IHDR", ihdr);
+
+  // bands of rows are deflated in parallel into a single zlib stream, each
+  // into its own IDAT chunk
+  size_t numBands = std::max<size_t>(1, (h + BAND - 1) / BAND);
+  std::vector<std::string> chunks(numBands);
+  std::vector<uint32_t> adlers(numBands);
+  std::vector<size_t> lens(numBands);
+
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < numBands; i++) {
+    // each row is prefixed with its filter type, 0 (none)
+    std::string raw;
+    raw.reserve(BAND * (w * 4 + 1));
+    for (size_t y = i * BAND; y < std::min(h, (i + 1) * BAND); y++) {
+      raw += '\0';
+      raw.append(reinterpret_cast<const char*>(px.data()) + y * w * 4, w * 4);
+    }
+
+    adlers[i] = adler32(raw);
+    lens[i] = raw.size();
+    chunks[i] = chunkData("IDAT", deflate(raw, i + 1 == numBands));
+  }
+
+  uint32_t adler = 1;
+  for (size_t i = 0; i < numBands; i++) {
+    adler = adlerCombine(adler, adlers[i], lens[i]);
+  }
+
+  // zlib header, 32K window, fastest compression
+  chunk("IDAT", std::string("\x78\x01", 2));
+  for (const auto& c : chunks) _o->write(c.data(), c.size());
+  std::string trailer;
+  u32(&trailer, adler);
+  chunk("IDAT", trailer);
+
+  chunk("IEND", "");
+}
+
+// _____________________________________________________________________________
+void PngWriter::chunk(const char* type, const std::string& data) {
+  std::string c = chunkData(type, data);
+  _o->write(c.data(), c.size());
+}
+
+// _____________________________________________________________________________
+std::string PngWriter::chunkData(const char* type, const std::string& data) {
+  std::string ret;
+  ret.reserve(data.size() + 12);
+  u32(&ret, data.size());
+  ret.append(type, 4);
+  ret += data;
+  u32(&ret, crc32(ret.substr(4)));
+  return ret;
+}
+
+// _____________________________________________________________________________
+uint32_t PngWriter::crc32(const std::string& data) {
+#ifdef ZLIB_FOUND
+  return ::crc32(::crc32(0, Z_NULL, 0),
+                 reinterpret_cast<const Bytef*>(data.data()), data.size());
+#else
+  static const std::vector<uint32_t> table = crcTable();
+
+  uint32_t c = 0xFFFFFFFF;
+  for (unsigned char b : data) c = table[(c ^ b) & 0xFF] ^ (c >> 8);
+  return c ^ 0xFFFFFFFF;
+#endif
+}
+
+// _____________________________________________________________________________
+std::string PngWriter::deflate(const std::string& data, bool last) {
+  std::string ret;
+#ifdef ZLIB_FOUND
+  z_stream defStr;
+  defStr.zalloc = Z_NULL;
+  defStr.zfree = Z_NULL;
+  defStr.opaque = Z_NULL;
+  defStr.avail_in = 0;
+  defStr.next_in = Z_NULL;
+
+  // raw deflate, previews are written often, so favour speed over size
+  if (deflateInit2(&defStr, Z_BEST_SPEED, Z_DEFLATED, -15, 8,
+                   Z_DEFAULT_STRATEGY) == Z_OK) {
+    defStr.next_in = reinterpret_cast<z_const Bytef*>(data.data());
+    defStr.avail_in = static_cast<unsigned int>(data.size());
+
+    // the output of a sync flush ends on a byte boundary, so the parts
+    // can be concatenated
+    size_t cSize = 0;
+    do {
+      if (ret.size() < (cSize + BSIZE)) ret.resize(cSize + BSIZE);
+      defStr.avail_out = BSIZE;
+      defStr.next_out = reinterpret_cast<Bytef*>(&ret[0] + cSize);
+      ::deflate(&defStr, last ? Z_FINISH : Z_SYNC_FLUSH);
+      cSize += BSIZE - defStr.avail_out;
+    } while (defStr.avail_out == 0);
+
+    deflateEnd(&defStr);
+    ret.resize(cSize);
+    return ret;
+  }
+#endif
+
+  // without zlib, stored blocks
+  size_t pos = 0;
+  do {
+    size_t len = std::min<size_t>(data.size() - pos, 0xFFFF);
+    ret += static_cast<char>(last && pos + len == data.size());
+    ret += static_cast<char>(len & 0xFF);
+    ret += static_cast<char>(len >> 8);
+    ret += static_cast<char>(~len & 0xFF);
+    ret += static_cast<char>((~len >> 8) & 0xFF);
+    ret.append(data, pos, len);
+    pos += len;
+  } while (pos < data.size());
+  return ret;
+}
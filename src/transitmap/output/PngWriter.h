@@ -0,0 +1,40 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef TRANSITMAP_OUTPUT_PNGWRITER_H_
+#define TRANSITMAP_OUTPUT_PNGWRITER_H_
+
+#include <stdint.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace transitmapper {
+namespace output {
+
+// writes 8 bit RGBA images as PNG. Bands of the image are deflated in
+// parallel with zlib if available, and written in stored blocks otherwise.
+class PngWriter {
+ public:
+  explicit PngWriter(std::ostream* o);
+
+  // write the RGBA pixels (not premultiplied) of a w x h image, row by row
+  void write(const std::vector<uint8_t>& px, size_t w, size_t h);
+
+  static uint32_t crc32(const std::string& data);
+
+ private:
+  std::ostream* _o;
+
+  void chunk(const char* type, const std::string& data);
+  static std::string chunkData(const char* type, const std::string& data);
+
+  // raw deflate data, only the last part of a stream is finished
+  static std::string deflate(const std::string& data, bool last);
+};
+
+}  // namespace output
+}  // namespace transitmapper
+
+#endif  // TRANSITMAP_OUTPUT_PNGWRITER_H_
@@ -0,0 +1,349 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "transitmap/output/Raster.h"
+
+using transitmapper::output::Raster;
+using transitmapper::output::Rgba;
+using util::geo::DBox;
+using util::geo::DLine;
+using util::geo::DPoint;
+
+namespace {
+
+// maximum deviation of arcs from the true circle, in px
+const double ARC_PREC = 0.1;
+
+// row stride of the accumulation buffer, contributions at the right tile
+// border spill over into the two additional columns
+const size_t STRIDE = transitmapper::output::RASTER_TILE + 2;
+
+// _____________________________________________________________________________
+double area2(const DLine& ring) {
+  double ret = 0;
+  for (size_t i = 0; i < ring.size(); i++) {
+    const auto& a = ring[i];
+    const auto& b = ring[(i + 1) % ring.size()];
+    ret += a.getX() * b.getY() - b.getX() * a.getY();
+  }
+  return ret;
+}
+
+// _____________________________________________________________________________
+void accumulate(float* acc, double h, DPoint a, DPoint b) {
+  // adds the signed area covered left of the segment to each pixel, the
+  // prefix sum of a row is then the winding coverage of each pixel. The
+  // segment has to lie in [0, tile width] horizontally.
+  if (a.getY() == b.getY()) return;
+
+  double dir = 1;
+  if (a.getY() > b.getY()) {
+    dir = -1;
+    std::swap(a, b);
+  }
+
+  double dxdy = (b.getX() - a.getX()) / (b.getY() - a.getY());
+  double ys = std::max(a.getY(), 0.0);
+  double ye = std::min(b.getY(), h);
+  if (ys >= ye) return;
+
+  double x = a.getX() + (ys - a.getY()) * dxdy;
+
+  for (int y = std::floor(ys); y < std::ceil(ye); y++) {
+    float* row = acc + y * STRIDE;
+    double dy = std::min<double>(y + 1, ye) - std::max<double>(y, ys);
+    double xnext = x + dxdy * dy;
+    double d = dy * dir;
+
+    double xa = std::min(x, xnext);
+    double xb = std::max(x, xnext);
+    double xaFloor = std::floor(xa);
+    double xbCeil = std::ceil(xb);
+    int xai = xaFloor;
+    int xbi = xbCeil;
+
+    if (xbi <= xai + 1) {
+      double xmf = 0.5 * (x + xnext) - xaFloor;
+      row[xai] += d - d * xmf;
+      row[xai + 1] += d * xmf;
+    } else {
+      double s = 1 / (xb - xa);
+      double xaf = xa - xaFloor;
+      double a0 = 0.5 * s * (1 - xaf) * (1 - xaf);
+      double xbf = xb - xbCeil + 1;
+      double am = 0.5 * s * xbf * xbf;
+
+      row[xai] += d * a0;
+      if (xbi == xai + 2) {
+        row[xai + 1] += d * (1 - a0 - am);
+      } else {
+        double a1 = s * (1.5 - xaf);
+        row[xai + 1] += d * (a1 - a0);
+        for (int xi = xai + 2; xi < xbi - 1; xi++) row[xi] += d * s;
+        double a2 = a1 + (xbi - xai - 3) * s;
+        row[xbi - 1] += d * (1 - a2 - am);
+      }
+      row[xbi] += d * am;
+    }
+
+    x = xnext;
+  }
+}
+
+// _____________________________________________________________________________
+void line(float* acc, double w, double h, const DPoint& a, const DPoint& b) {
+  // parts left or right of the tile are moved onto its border, where they
+  // still contribute to the winding of the pixels right of them
+  double dx = b.getX() - a.getX();
+  double ts[4] = {0, 1, 1, 1};
+  size_t n = 1;
+  if (dx != 0) {
+    double t0 = -a.getX() / dx;
+    double t1 = (w - a.getX()) / dx;
+    if (t0 > 0 && t0 < 1) ts[n++] = t0;
+    if (t1 > 0 && t1 < 1) ts[n++] = t1;
+    std::sort(ts, ts + n);
+  }
+  ts[n] = 1;
+
+  for (size_t i = 0; i < n; i++) {
+    DPoint pa(a.getX() + ts[i] * dx,
+              a.getY() + ts[i] * (b.getY() - a.getY()));
+    DPoint pb(a.getX() + ts[i + 1] * dx,
+              a.getY() + ts[i + 1] * (b.getY() - a.getY()));
+    pa.setX(std::min(std::max(pa.getX(), 0.0), w));
+    pb.setX(std::min(std::max(pb.getX(), 0.0), w));
+    accumulate(acc, h, pa, pb);
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+Raster::Raster(size_t width, size_t height)
+    : _w(width), _h(height), _px(width * height * 4, 0) {}
+
+// _____________________________________________________________________________
+void Raster::fill(const std::vector<DLine>& rings, const Rgba& color) {
+  Shape s;
+  s.color = color;
+  for (const auto& ring : rings) {
+    if (ring.size() < 3) continue;
+    // overlapping rings are only united if they are oriented alike
+    double a = area2(ring);
+    if (a == 0) continue;
+    s.rings.push_back(ring);
+    if (a < 0) std::reverse(s.rings.back().begin(), s.rings.back().end());
+    s.boxes.push_back(util::geo::getBoundingBox(ring));
+  }
+  if (!s.rings.empty()) _shapes.push_back(s);
+}
+
+// _____________________________________________________________________________
+void Raster::stroke(const DLine& l, double width, const Rgba& color,
+                    bool roundCaps, bool closed) {
+  double r = width / 2;
+  if (r <= 0) return;
+
+  DLine pts;
+  for (const auto& p : l) {
+    if (pts.empty() || util::geo::dist(p, pts.back()) > 1e-9) pts.push_back(p);
+  }
+  if (closed && pts.size() > 1 &&
+      util::geo::dist(pts.front(), pts.back()) <= 1e-9) {
+    pts.pop_back();
+  }
+  if (pts.empty()) return;
+
+  std::vector<DLine> rings;
+  if (pts.size() == 1) {
+    if (roundCaps) rings.push_back(arc(pts[0], r, 0, 2 * M_PI));
+    fill(rings, color);
+    return;
+  }
+
+  size_t n = pts.size();
+  size_t segs = closed ? n : n - 1;
+
+  // segment directions, as unit vectors
+  std::vector<DPoint> dirs(segs);
+  for (size_t i = 0; i < segs; i++) {
+    const auto& a = pts[i];
+    const auto& b = pts[(i + 1) % n];
+    double len = util::geo::dist(a, b);
+    dirs[i] = DPoint((b.getX() - a.getX()) / len, (b.getY() - a.getY()) / len);
+
+    DPoint nv(-dirs[i].getY() * r, dirs[i].getX() * r);
+    rings.push_back({DPoint(a.getX() + nv.getX(), a.getY() + nv.getY()),
+                     DPoint(b.getX() + nv.getX(), b.getY() + nv.getY()),
+                     DPoint(b.getX() - nv.getX(), b.getY() - nv.getY()),
+                     DPoint(a.getX() - nv.getX(), a.getY() - nv.getY())});
+  }
+
+  // round joins, the quads already overlap on the inner side of a turn, so
+  // only the wedge on the outer side is added
+  for (size_t i = closed ? 0 : 1; i < (closed ? n : n - 1); i++) {
+    const auto& d1 = dirs[(i + segs - 1) % segs];
+    const auto& d2 = dirs[i];
+    double turn = atan2(d1.getX() * d2.getY() - d1.getY() * d2.getX(),
+                        d1.getX() * d2.getX() + d1.getY() * d2.getY());
+    if (r * turn * turn / 8 < ARC_PREC / 10) continue;
+    double side = turn > 0 ? -1 : 1;
+    rings.push_back(arc(pts[i], r,
+                        atan2(side * d1.getX(), -side * d1.getY()), turn));
+  }
+
+  if (roundCaps && !closed) {
+    const auto& d0 = dirs.front();
+    const auto& dn = dirs.back();
+    rings.push_back(arc(pts.front(), r, atan2(d0.getX(), -d0.getY()), M_PI));
+    rings.push_back(arc(pts.back(), r, atan2(dn.getX(), -dn.getY()), -M_PI));
+  }
+
+  fill(rings, color);
+}
+
+// _____________________________________________________________________________
+DLine Raster::arc(const DPoint& c, double r, double start, double sweep) {
+  double step = 2 * acos(std::max(-1.0, 1 - ARC_PREC / r));
+  size_t steps = std::max<size_t>(1, std::ceil(fabs(sweep) / step));
+
+  DLine ret;
+  if (fabs(sweep) < 2 * M_PI) ret.push_back(c);
+  for (size_t i = 0; i <= steps; i++) {
+    double ang = start + sweep * i / steps;
+    ret.push_back(DPoint(c.getX() + r * cos(ang), c.getY() + r * sin(ang)));
+  }
+  return ret;
+}
+
+// _____________________________________________________________________________
+void Raster::render() {
+  size_t tilesX = (_w + RASTER_TILE - 1) / RASTER_TILE;
+  size_t tilesY = (_h + RASTER_TILE - 1) / RASTER_TILE;
+
+  // shapes per tile, in painting order. Each ring is assigned separately, to
+  // not touch every tile in the bounding box of long strokes
+  std::vector<std::vector<size_t>> tiles(tilesX * tilesY);
+  for (size_t si = 0; si < _shapes.size(); si++) {
+    for (const auto& box : _shapes[si].boxes) {
+      double minX = std::max(box.getLowerLeft().getX(), 0.0);
+      double minY = std::max(box.getLowerLeft().getY(), 0.0);
+      double maxX = box.getUpperRight().getX();
+      double maxY = box.getUpperRight().getY();
+      if (maxX < 0 || maxY < 0 || minX >= _w || minY >= _h) continue;
+
+      size_t x0 = minX / RASTER_TILE;
+      size_t y0 = minY / RASTER_TILE;
+      size_t x1 = std::min<size_t>(maxX / RASTER_TILE, tilesX - 1);
+      size_t y1 = std::min<size_t>(maxY / RASTER_TILE, tilesY - 1);
+
+      for (size_t y = y0; y <= y1; y++) {
+        for (size_t x = x0; x <= x1; x++) {
+          auto& t = tiles[y * tilesX + x];
+          if (t.empty() || t.back() != si) t.push_back(si);
+        }
+      }
+    }
+  }
+
+#pragma omp parallel
+  {
+    std::vector<float> acc(STRIDE * RASTER_TILE, 0);
+#pragma omp for schedule(dynamic)
+    for (size_t i = 0; i < tiles.size(); i++) {
+      renderTile(i % tilesX, i / tilesX, tiles[i], &acc);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void Raster::renderTile(size_t tx, size_t ty, const std::vector<size_t>& shapes,
+                        std::vector<float>* acc) {
+  if (shapes.empty()) return;
+
+  size_t ox = tx * RASTER_TILE;
+  size_t oy = ty * RASTER_TILE;
+  size_t w = std::min(RASTER_TILE, _w - tx * RASTER_TILE);
+  size_t h = std::min(RASTER_TILE, _h - ty * RASTER_TILE);
+
+  // the tile is composited premultiplied
+  std::vector<float> buf(w * h * 4, 0);
+
+  for (size_t si : shapes) {
+    const Shape& s = _shapes[si];
+
+    // pixel range which received contributions
+    double minX = w, minY = h, maxX = 0, maxY = 0;
+
+    for (size_t ri = 0; ri < s.rings.size(); ri++) {
+      const auto& box = s.boxes[ri];
+      if (box.getUpperRight().getX() - ox < 0 ||
+          box.getUpperRight().getY() - oy < 0 ||
+          box.getLowerLeft().getX() - ox >= w ||
+          box.getLowerLeft().getY() - oy >= h) {
+        continue;
+      }
+
+      minX = std::min(minX, box.getLowerLeft().getX() - ox);
+      minY = std::min(minY, box.getLowerLeft().getY() - oy);
+      maxX = std::max(maxX, box.getUpperRight().getX() - ox);
+      maxY = std::max(maxY, box.getUpperRight().getY() - oy);
+
+      const auto& ring = s.rings[ri];
+      for (size_t i = 0; i < ring.size(); i++) {
+        const auto& a = ring[i];
+        const auto& b = ring[(i + 1) % ring.size()];
+        line(acc->data(), w, h, DPoint(a.getX() - ox, a.getY() - oy),
+             DPoint(b.getX() - ox, b.getY() - oy));
+      }
+    }
+
+    if (minX > maxX) continue;
+
+    size_t x0 = std::max(0.0, std::floor(minX));
+    size_t y0 = std::max(0.0, std::floor(minY));
+    size_t x1 = std::min<double>(w + 2, std::ceil(maxX) + 2);
+    size_t y1 = std::min<double>(h, std::ceil(maxY));
+
+    float r = s.color.r / 255.0;
+    float g = s.color.g / 255.0;
+    float b = s.color.b / 255.0;
+    float a = s.color.a / 255.0;
+
+    for (size_t y = y0; y < y1; y++) {
+      float* row = acc->data() + y * STRIDE;
+      float* px = buf.data() + (y * w) * 4;
+      float sum = 0;
+      for (size_t x = x0; x < x1; x++) {
+        sum += row[x];
+        row[x] = 0;
+        if (x >= w) continue;
+        float cov = std::min(1.0f, fabsf(sum));
+        if (cov < 1.0f / 512) continue;
+        float ca = cov * a;
+        float* p = px + x * 4;
+        p[0] = r * ca + p[0] * (1 - ca);
+        p[1] = g * ca + p[1] * (1 - ca);
+        p[2] = b * ca + p[2] * (1 - ca);
+        p[3] = ca + p[3] * (1 - ca);
+      }
+    }
+  }
+
+  for (size_t y = 0; y < h; y++) {
+    const float* src = buf.data() + y * w * 4;
+    uint8_t* dst = _px.data() + ((oy + y) * _w + ox) * 4;
+    for (size_t x = 0; x < w * 4; x += 4) {
+      float a = src[x + 3];
+      if (a <= 0) continue;
+      dst[x] = std::lround(std::min(1.0f, src[x] / a) * 255);
+      dst[x + 1] = std::lround(std::min(1.0f, src[x + 1] / a) * 255);
+      dst[x + 2] = std::lround(std::min(1.0f, src[x + 2] / a) * 255);
+      dst[x + 3] = std::lround(std::min(1.0f, a) * 255);
+    }
+  }
+}
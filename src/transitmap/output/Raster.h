@@ -0,0 +1,71 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef TRANSITMAP_OUTPUT_RASTER_H_
+#define TRANSITMAP_OUTPUT_RASTER_H_
+
+#include <stdint.h>
+#include <vector>
+#include "util/geo/Geo.h"
+
+namespace transitmapper {
+namespace output {
+
+// edge length of the square tiles which are rasterised in parallel, in px
+const size_t RASTER_TILE = 256;
+
+struct Rgba {
+  Rgba() : r(0), g(0), b(0), a(0) {}
+  Rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a) : r(r), g(g), b(b), a(a) {}
+  uint8_t r, g, b, a;
+};
+
+// an RGBA image into which polygons are rasterised with exact area coverage
+// anti-aliasing. Shapes are collected first and rasterised in painting order
+// by render(), the tiles of the image in parallel. Coordinates are in pixels,
+// with the y axis pointing down.
+class Raster {
+ public:
+  Raster(size_t width, size_t height);
+
+  // fill the union of the rings, holes are not supported
+  void fill(const std::vector<util::geo::DLine>& rings, const Rgba& color);
+
+  // stroke l with round joins and either round or butt caps, if closed, the
+  // last point is connected to the first one
+  void stroke(const util::geo::DLine& l, double width, const Rgba& color,
+              bool roundCaps, bool closed);
+
+  // rasterise all shapes, in the order they were added
+  void render();
+
+  size_t getWidth() const { return _w; }
+  size_t getHeight() const { return _h; }
+
+  // the rendered RGBA pixels (not premultiplied), row by row
+  const std::vector<uint8_t>& getPixels() const { return _px; }
+
+ private:
+  struct Shape {
+    std::vector<util::geo::DLine> rings;
+    std::vector<util::geo::DBox> boxes;
+    Rgba color;
+  };
+
+  size_t _w, _h;
+  std::vector<uint8_t> _px;
+  std::vector<Shape> _shapes;
+
+  void renderTile(size_t tx, size_t ty, const std::vector<size_t>& shapes,
+                  std::vector<float>* acc);
+
+  // sector of the circle around c with radius r, starting at angle start
+  static util::geo::DLine arc(const util::geo::DPoint& c, double r,
+                              double start, double sweep);
+};
+
+}  // namespace output
+}  // namespace transitmapper
+
+#endif  // TRANSITMAP_OUTPUT_RASTER_H_
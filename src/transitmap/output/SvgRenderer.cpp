@@ -4,6 +4,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <fstream>
 #include <ostream>
 
@@ -17,6 +18,7 @@
 #include "util/log/Log.h"
 
 using shared::linegraph::Line;
+using shared::linegraph::LineIdCmp;
 using shared::linegraph::LineNode;
 using shared::rendergraph::InnerGeom;
 using shared::rendergraph::RenderGraph;
@@ -32,11 +34,14 @@ using util::geo::PolyLine;
 
 // _____________________________________________________________________________
 SvgRenderer::SvgRenderer(std::ostream* o, const config::Config* cfg)
-    : _o(o), _w(o, true), _cfg(cfg) {}
+    : _o(o),
+      _w(o, cfg->outPrecision),
+      _cfg(cfg),
+      _tol(cfg->lodTolerance > 0 ? cfg->lodTolerance / cfg->outputResolution
+                                 : 0) {}
 
 // _____________________________________________________________________________
 void SvgRenderer::print(const RenderGraph& outG) {
-  std::map<std::string, std::string> params;
   RenderParams rparams;
 
   auto box = outG.getBBox();
@@ -78,53 +83,50 @@ void SvgRenderer::print(const RenderGraph& outG) {
   rparams.width *= _cfg->outputResolution;
   rparams.height *= _cfg->outputResolution;
 
+  _w.setTransform(rparams.xOff, rparams.yOff, _cfg->outputResolution,
+                  rparams.height);
+
   auto latLngLL = util::geo::webMercToLatLng<double>(box.getLowerLeft().getX(),
                                                      box.getLowerLeft().getY());
   auto latLngUR = util::geo::webMercToLatLng<double>(
       box.getUpperRight().getX(), box.getUpperRight().getY());
 
-  params["latlng-box"] = std::to_string(latLngLL.getX()) + "," +
-                         std::to_string(latLngLL.getY()) + "," +
-                         std::to_string(latLngUR.getX()) + "," +
-                         std::to_string(latLngUR.getY());
-
-  params["width"] = std::to_string(rparams.width);
-  params["height"] = std::to_string(rparams.height);
-  params["viewBox"] = "0 0 " + std::to_string(rparams.width) + " " +
-                      std::to_string(rparams.height);
-  params["xmlns"] = "http://www.w3.org/2000/svg";
-  params["xmlns:xlink"] = "http://www.w3.org/1999/xlink";
-
-  *_o << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-  *_o << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" "
-         "\"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">";
+  _w.raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+  _w.raw("<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\" "
+         "\"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">");
 
   LOGTO(DEBUG, std::cerr) << "Rendering edges...";
   if (_cfg->renderEdges) {
-    outputEdges(outG, rparams);
+    outputEdges(outG);
   }
-  _w.openTag("svg", params);
+
+  _w.openTag("svg");
+  _w.attr("height", rparams.height);
+  _w.attr("latlng-box", std::to_string(latLngLL.getX()) + "," +
+                            std::to_string(latLngLL.getY()) + "," +
+                            std::to_string(latLngUR.getX()) + "," +
+                            std::to_string(latLngUR.getY()));
+  _w.attr("viewBox", "0 0 " + _w.num(rparams.width) + " " +
+                         _w.num(rparams.height));
+  _w.attr("width", rparams.width);
+  _w.attr("xmlns", "http://www.w3.org/2000/svg");
+  _w.attr("xmlns:xlink", "http://www.w3.org/1999/xlink");
 
   _w.openTag("defs");
 
   LOGTO(DEBUG, std::cerr) << "Rendering markers...";
   for (auto const& m : _markers) {
-    params.clear();
-    params["id"] = m.name;
-    params["orient"] = "auto";
-    params["markerWidth"] = "20";
-    params["markerHeight"] = "4";
-    params["refY"] = "0.5";
-    params["refX"] = "0";
-
-    _w.openTag("marker", params);
-
-    params.clear();
-    params["d"] = m.path;
-    params["fill"] = m.color;
-    ;
-
-    _w.openTag("path", params);
+    _w.openTag("marker");
+    _w.attr("id", m.name);
+    _w.attr("markerHeight", "4");
+    _w.attr("markerWidth", "20");
+    _w.attr("orient", "auto");
+    _w.attr("refX", "0");
+    _w.attr("refY", "0.5");
+
+    _w.openTag("path");
+    _w.attr("d", m.path);
+    _w.attr("fill", m.color);
 
     _w.closeTag();
     _w.closeTag();
@@ -135,46 +137,40 @@ void SvgRenderer::print(const RenderGraph& outG) {
   LOGTO(DEBUG, std::cerr) << "Rendering nodes...";
   for (auto n : outG.getNds()) {
     if (_cfg->renderNodeConnections) {
-      renderNodeConnections(outG, n, rparams);
+      renderNodeConnections(outG, n);
     }
   }
 
   LOGTO(DEBUG, std::cerr) << "Writing edges...";
-  renderDelegates(outG, rparams);
+  renderDelegates(outG);
 
   LOGTO(DEBUG, std::cerr) << "Writing nodes...";
-  outputNodes(outG, rparams);
+  outputNodes(outG);
   if (_cfg->renderNodeFronts) {
-    renderNodeFronts(outG, rparams);
+    renderNodeFronts(outG);
   }
 
   LOGTO(DEBUG, std::cerr) << "Writing labels...";
   if (_cfg->renderLabels) {
-    renderLineLabels(labeller, rparams);
-    renderStationLabels(labeller, rparams);
+    renderLineLabels(labeller);
+    renderStationLabels(labeller);
   }
 
   _w.closeTags();
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::outputNodes(const RenderGraph& outG,
-                              const RenderParams& rparams) {
+void SvgRenderer::outputNodes(const RenderGraph& outG) {
   _w.openTag("g");
+  std::string strokeWidth =
+      _w.num((_cfg->lineWidth / 2) * _cfg->outputResolution);
   for (auto n : outG.getNds()) {
-    std::map<std::string, std::string> params;
-
     if (_cfg->renderStations && n->pl().stops().size() > 0 &&
         n->pl().fronts().size() > 0) {
-      params["stroke"] = "black";
-      params["stroke-width"] =
-          util::toString((_cfg->lineWidth / 2) * _cfg->outputResolution);
-      params["fill"] = "white";
-
       for (const auto& geom :
            outG.getStopGeoms(n, (_cfg->lineSpacing + _cfg->lineWidth) * 0.8,
                              _cfg->tightStations, 32)) {
-        printPolygon(geom, params, rparams);
+        printStationPoly(geom, strokeWidth);
       }
     }
   }
@@ -182,38 +178,32 @@ void SvgRenderer::outputNodes(const RenderGraph& outG,
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::renderNodeFronts(const RenderGraph& outG,
-                                   const RenderParams& rparams) {
+void SvgRenderer::renderNodeFronts(const RenderGraph& outG) {
   _w.openTag("g");
   for (auto n : outG.getNds()) {
     std::string color = n->pl().stops().size() > 0 ? "red" : "black";
     for (auto& f : n->pl().fronts()) {
       const PolyLine<double> p = f.geom;
-      std::stringstream style;
-      style << "fill:none;stroke:" << color
-            << ";stroke-linejoin: "
-               "miter;stroke-linecap:round;stroke-opacity:0.9;stroke-width:1";
-      std::map<std::string, std::string> params;
-      params["style"] = style.str();
-      printLine(p, params, rparams);
+      printLine(p,
+                "fill:none;stroke:" + color +
+                    ";stroke-linejoin: "
+                    "miter;stroke-linecap:round;stroke-opacity:0.9;"
+                    "stroke-width:1");
 
       DPoint a = p.getPointAt(.5).p;
 
-      std::stringstream styleA;
-      styleA << "fill:none;stroke:" << color
-             << ";stroke-linejoin: "
-                "miter;stroke-linecap:round;stroke-opacity:1;stroke-width:.5";
-      params["style"] = styleA.str();
-
-      printLine(PolyLine<double>(*n->pl().getGeom(), a), params, rparams);
+      printLine(PolyLine<double>(*n->pl().getGeom(), a),
+                "fill:none;stroke:" + color +
+                    ";stroke-linejoin: "
+                    "miter;stroke-linecap:round;stroke-opacity:1;"
+                    "stroke-width:.5");
     }
   }
   _w.closeTag();
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::outputEdges(const RenderGraph& outG,
-                              const RenderParams& rparams) {
+void SvgRenderer::outputEdges(const RenderGraph& outG) {
   struct cmp {
     bool operator()(const LineNode* lhs, const LineNode* rhs) const {
       return lhs->getAdjList().size() > rhs->getAdjList().size() ||
@@ -221,7 +211,7 @@ void SvgRenderer::outputEdges(const RenderGraph& outG,
               RenderGraph::getConnCardinality(lhs) >
                   RenderGraph::getConnCardinality(rhs)) ||
              (lhs->getAdjList().size() == rhs->getAdjList().size() &&
-              lhs > rhs);
+              lhs->getId() > rhs->getId());
     }
   };
 
@@ -230,7 +220,7 @@ void SvgRenderer::outputEdges(const RenderGraph& outG,
                     const shared::linegraph::LineEdge* rhs) const {
       return lhs->pl().getLines().size() < rhs->pl().getLines().size() ||
              (lhs->pl().getLines().size() == rhs->pl().getLines().size() &&
-              lhs < rhs);
+              lhs->getId() < rhs->getId());
     }
   };
 
@@ -244,17 +234,27 @@ void SvgRenderer::outputEdges(const RenderGraph& outG,
     edgesOrdered.insert(n->getAdjList().begin(), n->getAdjList().end());
 
     for (const auto* e : edgesOrdered) {
-      if (rendered.insert(e).second) renderEdgeTripGeom(outG, e, rparams);
+      if (rendered.insert(e).second) renderEdgeTripGeom(outG, e);
     }
   }
 }
 
 // _____________________________________________________________________________
 void SvgRenderer::renderNodeConnections(const RenderGraph& outG,
-                                        const LineNode* n,
-                                        const RenderParams& rparams) {
-  UNUSED(rparams);
-  auto geoms = outG.innerGeoms(n, _cfg->innerGeometryPrecision);
+                                        const LineNode* n) {
+  // bezier curves are not sampled finer than the generalisation tolerance
+  auto geoms =
+      outG.innerGeoms(n, std::max(_cfg->innerGeometryPrecision, _tol));
+
+  // connections below the tolerance are covered by the round line caps of
+  // the adjacent edges
+  if (_tol > 0) {
+    geoms.erase(std::remove_if(geoms.begin(), geoms.end(),
+                               [this](const InnerGeom& g) {
+                                 return g.geom.getLength() < _tol;
+                               }),
+                geoms.end());
+  }
 
   for (auto& clique : getInnerCliques(n, geoms, 9999)) renderClique(clique, n);
 }
@@ -370,7 +370,7 @@ bool SvgRenderer::hasSameOrigin(const InnerGeom& a, const InnerGeom& b) const {
 // _____________________________________________________________________________
 void SvgRenderer::renderClique(const InnerClique& cc, const LineNode* n) {
   _innerDelegates.push_back(
-      std::map<uintptr_t, std::vector<OutlinePrintPair>>());
+      std::map<const Line*, std::vector<OutlinePrintPair>, LineIdCmp>());
   std::multiset<InnerClique> renderCliques = getInnerCliques(n, cc.geoms, 0);
   for (const auto& c : renderCliques) {
     // the longest geom will be the ref geom
@@ -408,30 +408,23 @@ void SvgRenderer::renderClique(const InnerClique& cc, const LineNode* n) {
         }
       }
 
-      std::stringstream styleOutlineCropped;
-      styleOutlineCropped << "fill:none;stroke:#000000";
-
-      styleOutlineCropped << ";stroke-linecap:butt;stroke-width:"
-                          << (_cfg->lineWidth + _cfg->outlineWidth) *
-                                 _cfg->outputResolution;
-      Params paramsOutlineCropped;
-      paramsOutlineCropped["style"] = styleOutlineCropped.str();
-      paramsOutlineCropped["class"] += " inner-geom-outline";
-      paramsOutlineCropped["class"] += " " + getLineClass(c.geoms[i].from.line->id());
-
-      std::stringstream styleStr;
-      styleStr << "fill:none;stroke:#" << c.geoms[i].from.line->color();
-
-      styleStr << ";stroke-linecap:round;stroke-opacity:1;stroke-width:"
-               << _cfg->lineWidth * _cfg->outputResolution;
-      Params params;
-      params["style"] = styleStr.str();
-      params["class"] += " inner-geom ";
-      params["class"] += " " + getLineClass(c.geoms[i].from.line->id());
-
-      _innerDelegates.back()[(uintptr_t)c.geoms[i].from.line].push_back(
-          OutlinePrintPair(PrintDelegate(params, pl),
-                           PrintDelegate(paramsOutlineCropped, pl)));
+      std::string lineClass = getLineClass(c.geoms[i].from.line->id());
+
+      LineAttrs attrsOutlineCropped(
+          "inner-geom-outline " + lineClass,
+          "fill:none;stroke:#000000;stroke-linecap:butt;stroke-width:" +
+              _w.num((_cfg->lineWidth + _cfg->outlineWidth) *
+                     _cfg->outputResolution));
+
+      LineAttrs attrs("inner-geom " + lineClass,
+                      "fill:none;stroke:#" + c.geoms[i].from.line->color() +
+                          ";stroke-linecap:round;stroke-opacity:1;"
+                          "stroke-width:" +
+                          _w.num(_cfg->lineWidth * _cfg->outputResolution));
+
+      _innerDelegates.back()[c.geoms[i].from.line].push_back(
+          OutlinePrintPair(PrintDelegate(attrs, pl),
+                           PrintDelegate(attrsOutlineCropped, pl)));
     }
   }
 }
@@ -448,37 +441,33 @@ void SvgRenderer::renderLinePart(const PolyLine<double> p, double width,
                                  const Line& line, const std::string& css,
                                  const std::string& oCss,
                                  const std::string& endMarker) {
-  std::stringstream styleOutline;
-  styleOutline << "fill:none;stroke:#000000;stroke-linecap:round;stroke-width:"
-               << (width + _cfg->outlineWidth) * _cfg->outputResolution << ";"
-               << oCss;
-  Params paramsOutline;
-  paramsOutline["style"] = styleOutline.str();
-  paramsOutline["class"] = "transit-edge-outline " + getLineClass(line.id());
+  std::string lineClass = getLineClass(line.id());
+
+  LineAttrs attrsOutline(
+      "transit-edge-outline " + lineClass,
+      "fill:none;stroke:#000000;stroke-linecap:round;stroke-width:" +
+          _w.num((width + _cfg->outlineWidth) * _cfg->outputResolution) + ";" +
+          oCss);
 
-  std::stringstream styleStr;
-  styleStr << "fill:none;stroke:#" << line.color() << ";" << css;
+  std::string style = "fill:none;stroke:#" + line.color() + ";" + css;
 
   if (!endMarker.empty()) {
-    styleStr << ";marker-end:url(#" << endMarker << ")";
+    style += ";marker-end:url(#" + endMarker + ")";
   }
 
-  styleStr << ";stroke-linecap:round;stroke-opacity:1;stroke-width:"
-           << width * _cfg->outputResolution;
-  Params params;
-  params["style"] = styleStr.str();
-  params["class"] = "transit-edge " + getLineClass(line.id());
+  style += ";stroke-linecap:round;stroke-opacity:1;stroke-width:" +
+           _w.num(width * _cfg->outputResolution);
 
-  _delegates[0].insert(_delegates[0].begin(),
-                       OutlinePrintPair(PrintDelegate(params, p),
-                                        PrintDelegate(paramsOutline, p)));
+  LineAttrs attrs("transit-edge " + lineClass, style);
+
+  // printed in reverse order, see renderDelegates()
+  _delegates[0].push_back(OutlinePrintPair(PrintDelegate(attrs, p),
+                                           PrintDelegate(attrsOutline, p)));
 }
 
 // _____________________________________________________________________________
 void SvgRenderer::renderEdgeTripGeom(const RenderGraph& outG,
-                                     const shared::linegraph::LineEdge* e,
-                                     const RenderParams& rparams) {
-  UNUSED(rparams);
+                                     const shared::linegraph::LineEdge* e) {
   const shared::linegraph::NodeFront* nfTo = e->getTo()->pl().frontFor(e);
   const shared::linegraph::NodeFront* nfFrom = e->getFrom()->pl().frontFor(e);
 
@@ -571,16 +560,16 @@ std::string SvgRenderer::getMarkerPathMale(double w) const {
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::renderDelegates(const RenderGraph& outG,
-                                  const RenderParams& rparams) {
+void SvgRenderer::renderDelegates(const RenderGraph& outG) {
   UNUSED(outG);
   for (auto& a : _delegates) {
     _w.openTag("g");
-    for (auto& pd : a.second) {
+    // line parts are printed in reverse order of their rendering
+    for (auto pd = a.second.rbegin(); pd != a.second.rend(); pd++) {
       if (_cfg->outlineWidth > 0) {
-        printLine(pd.back.second, pd.back.first, rparams);
+        printLine(pd->back.second, pd->back.first);
       }
-      printLine(pd.front.second, pd.front.first, rparams);
+      printLine(pd->front.second, pd->front.first);
     }
     _w.closeTag();
   }
@@ -590,11 +579,11 @@ void SvgRenderer::renderDelegates(const RenderGraph& outG,
     for (auto& b : a) {
       for (auto& pd : b.second) {
         if (_cfg->outlineWidth > 0) {
-          printLine(pd.back.second, pd.back.first, rparams);
+          printLine(pd.back.second, pd.back.first);
         }
       }
       for (auto& pd : b.second) {
-        printLine(pd.front.second, pd.front.first, rparams);
+        printLine(pd.front.second, pd.front.first);
       }
     }
     _w.closeTag();
@@ -602,89 +591,52 @@ void SvgRenderer::renderDelegates(const RenderGraph& outG,
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::printPoint(const DPoint& p, const std::string& style,
-                             const RenderParams& rparams) {
-  std::map<std::string, std::string> params;
-  params["cx"] =
-      std::to_string((p.getX() - rparams.xOff) * _cfg->outputResolution);
-  params["cy"] = std::to_string(rparams.height - (p.getY() - rparams.yOff) *
-                                                     _cfg->outputResolution);
-  params["r"] = "2";
-  params["style"] = style;
-  _w.openTag("circle", params);
+void SvgRenderer::printPoint(const DPoint& p, const std::string& style) {
+  _w.openTag("circle");
+  _w.pointAttrs("cx", "cy", p);
+  _w.attr("r", "2");
+  _w.attr("style", style);
   _w.closeTag();
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::printLine(const PolyLine<double>& l, const std::string& style,
-                            const RenderParams& rparams) {
-  std::map<std::string, std::string> params;
-  params["style"] = style;
-  printLine(l, params, rparams);
+void SvgRenderer::printLine(const PolyLine<double>& l, const std::string& style) {
+  printLine(l, LineAttrs("", style));
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::printLine(const PolyLine<double>& l,
-                            const std::map<std::string, std::string>& ps,
-                            const RenderParams& rparams) {
-  std::map<std::string, std::string> params = ps;
-  std::stringstream points;
-
-  for (auto& p : l.getLine()) {
-    points << " " << (p.getX() - rparams.xOff) * _cfg->outputResolution << ","
-           << rparams.height -
-                  (p.getY() - rparams.yOff) * _cfg->outputResolution;
-  }
-
-  params["points"] = points.str();
-
-  _w.openTag("polyline", params);
+void SvgRenderer::printLine(const PolyLine<double>& l, const LineAttrs& attrs) {
+  _w.openTag("path");
+  if (!attrs.cls.empty()) _w.attr("class", attrs.cls);
+  _w.pathAttr("d", generalize(l.getLine(), _tol), false);
+  _w.attr("style", attrs.style);
   _w.closeTag();
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::printPolygon(const Polygon<double>& g,
-                               const std::map<std::string, std::string>& ps,
-                               const RenderParams& rparams) {
-  std::map<std::string, std::string> params = ps;
-  std::stringstream points;
-
-  for (auto& p : g.getOuter()) {
-    points << " " << (p.getX() - rparams.xOff) * _cfg->outputResolution << ","
-           << rparams.height -
-                  (p.getY() - rparams.yOff) * _cfg->outputResolution;
-  }
-
-  params["points"] = points.str();
-  params["class"] = "station-poly";
-
-  _w.openTag("polygon", params);
+void SvgRenderer::printStationPoly(const Polygon<double>& g,
+                                   const std::string& strokeWidth) {
+  _w.openTag("path");
+  _w.attr("class", "station-poly");
+  // rings below the tolerance are kept as coarse shapes instead of
+  // collapsing them
+  double d = util::geo::dist(util::geo::getBoundingBox(g).getLowerLeft(),
+                             util::geo::getBoundingBox(g).getUpperRight());
+  auto ring = generalize(g.getOuter(), std::min(_tol, d / 16));
+  _w.pathAttr("d", ring.size() < 4 ? g.getOuter() : ring, true);
+  _w.attr("fill", "white");
+  _w.attr("stroke", "black");
+  _w.attr("stroke-width", strokeWidth);
   _w.closeTag();
 }
 
 // _____________________________________________________________________________
 void SvgRenderer::printCircle(const DPoint& center, double rad,
-                              const std::string& style,
-                              const RenderParams& rparams) {
-  std::map<std::string, std::string> params;
-  params["style"] = style;
-  printCircle(center, rad, params, rparams);
-}
-
-// _____________________________________________________________________________
-void SvgRenderer::printCircle(const DPoint& center, double rad,
-                              const std::map<std::string, std::string>& ps,
-                              const RenderParams& rparams) {
-  std::map<std::string, std::string> params = ps;
-  std::stringstream points;
-
-  params["cx"] =
-      std::to_string((center.getX() - rparams.xOff) * _cfg->outputResolution);
-  params["cy"] = std::to_string(
-      rparams.height - (center.getY() - rparams.yOff) * _cfg->outputResolution);
-  params["r"] = std::to_string(rad * _cfg->outputResolution);
-
-  _w.openTag("circle", params);
+                              const std::string& style) {
+  _w.openTag("circle");
+  _w.pointAttrs("cx", "cy", center);
+  _w.attr("r", rad * _cfg->outputResolution);
+  _w.attr("style", style);
   _w.closeTag();
 }
 
@@ -702,8 +654,7 @@ size_t InnerClique::getNumBranchesIn(
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::renderStationLabels(const Labeller& labeller,
-                                      const RenderParams& rparams) {
+void SvgRenderer::renderStationLabels(const Labeller& labeller) {
   _w.openTag("g");
   size_t id = 0;
   for (auto label : labeller.getStationLabels()) {
@@ -720,48 +671,31 @@ void SvgRenderer::renderStationLabels(const Labeller& labeller,
       textPath.reverse();
     }
 
-    std::stringstream points;
-    std::map<std::string, std::string> pathPars;
-
-    points << "M"
-           << (textPath.front().getX() - rparams.xOff) * _cfg->outputResolution
-           << " "
-           << rparams.height - (textPath.front().getY() - rparams.yOff) *
-                                   _cfg->outputResolution;
-
-    for (auto& p : textPath.getLine()) {
-      points << " L" << (p.getX() - rparams.xOff) * _cfg->outputResolution
-             << " "
-             << rparams.height -
-                    (p.getY() - rparams.yOff) * _cfg->outputResolution;
-    }
-
     std::string idStr = "stlblp" + util::toString(id);
 
-    pathPars["d"] = points.str();
-    pathPars["id"] = idStr;
     id++;
 
     _w.openTag("defs");
-    _w.openTag("path", pathPars);
+    _w.openTag("path");
+    _w.pathAttr("d", textPath.getLine(), false);
+    _w.attr("id", idStr);
     _w.closeTag();
     _w.closeTag();
 
-    std::map<std::string, std::string> params;
-    params["class"] = "station-label";
-    params["font-weight"] = label.bold ? "bold" : "normal";
-    params["font-family"] = "Ubuntu Condensed";
-    params["dy"] = shift;
-    params["font-size"] =
-        util::toString(label.fontSize * _cfg->outputResolution);
-
-    _w.openTag("text", params);
-    _w.openTag("textPath", {{"dy", shift},
-                            {"xlink:href", "#" + idStr},
-                            {"startOffset", startOffset},
-                            {"text-anchor", textAnchor}});
-
-    _w.writeText(label.s.name);
+    _w.openTag("text");
+    _w.attr("class", "station-label");
+    _w.attr("dy", shift);
+    _w.attr("font-family", "Ubuntu Condensed");
+    _w.attr("font-size", label.fontSize * _cfg->outputResolution);
+    _w.attr("font-weight", label.bold ? "bold" : "normal");
+
+    _w.openTag("textPath");
+    _w.attr("dy", shift);
+    _w.attr("startOffset", startOffset);
+    _w.attr("text-anchor", textAnchor);
+    _w.attr("xlink:href", "#" + idStr);
+
+    _w.text(label.s.name);
     _w.closeTag();
     _w.closeTag();
   }
@@ -769,8 +703,7 @@ void SvgRenderer::renderStationLabels(const Labeller& labeller,
 }
 
 // _____________________________________________________________________________
-void SvgRenderer::renderLineLabels(const Labeller& labeller,
-                                   const RenderParams& rparams) {
+void SvgRenderer::renderLineLabels(const Labeller& labeller) {
   _w.openTag("g");
   size_t id = 0;
   for (auto label : labeller.getLineLabels()) {
@@ -783,53 +716,37 @@ void SvgRenderer::renderLineLabels(const Labeller& labeller,
       textPath.reverse();
     }
 
-    std::stringstream points;
-    std::map<std::string, std::string> pathPars;
-
-    points << "M"
-           << (textPath.front().getX() - rparams.xOff) * _cfg->outputResolution
-           << " "
-           << rparams.height - (textPath.front().getY() - rparams.yOff) *
-                                   _cfg->outputResolution;
-
-    for (auto& p : textPath.getLine()) {
-      points << " L" << (p.getX() - rparams.xOff) * _cfg->outputResolution
-             << " "
-             << rparams.height -
-                    (p.getY() - rparams.yOff) * _cfg->outputResolution;
-    }
-
     std::string idStr = "textp" + util::toString(id);
 
-    pathPars["d"] = points.str();
-    pathPars["id"] = idStr;
     id++;
 
     _w.openTag("defs");
-    _w.openTag("path", pathPars);
+    _w.openTag("path");
+    _w.pathAttr("d", textPath.getLine(), false);
+    _w.attr("id", idStr);
     _w.closeTag();
     _w.closeTag();
 
-    std::map<std::string, std::string> params;
-    params["class"] = "line-label";
-    params["font-weight"] = "bold";
-    params["font-family"] = "Ubuntu";
-    params["dy"] = shift;
-    params["font-size"] =
-        util::toString(label.fontSize * _cfg->outputResolution);
+    _w.openTag("text");
+    _w.attr("class", "line-label");
+    _w.attr("dy", shift);
+    _w.attr("font-family", "Ubuntu");
+    _w.attr("font-size", label.fontSize * _cfg->outputResolution);
+    _w.attr("font-weight", "bold");
 
-    _w.openTag("text", params);
-    _w.openTag("textPath", {{"dy", shift},
-                            {"xlink:href", "#" + idStr},
-                            {"text-anchor", "middle"},
-                            {"startOffset", "50%"}});
+    _w.openTag("textPath");
+    _w.attr("dy", shift);
+    _w.attr("startOffset", "50%");
+    _w.attr("text-anchor", "middle");
+    _w.attr("xlink:href", "#" + idStr);
 
     double dy = 0;
     for (auto line : label.lines) {
-      _w.openTag("tspan",
-                 {{"fill", "#" + line->color()}, {"dx", util::toString(dy)}});
+      _w.openTag("tspan");
+      _w.attr("dx", dy);
+      _w.attr("fill", "#" + line->color());
       dy = (label.fontSize * _cfg->outputResolution) / 3;
-      _w.writeText(line->label());
+      _w.text(line->label());
       _w.closeTag();
     }
     _w.closeTag();
@@ -865,6 +782,13 @@ std::string SvgRenderer::getLineClass(const std::string& id) const {
   return "line-" + std::to_string(lineClassId);
 }
 
+// _____________________________________________________________________________
+util::geo::DLine SvgRenderer::generalize(const util::geo::DLine& l,
+                                         double tol) const {
+  if (tol <= 0 || l.size() < 3) return l;
+  return util::geo::simplify(l, tol);
+}
+
 // _____________________________________________________________________________
 bool InnerClique::operator<(const InnerClique& rhs) const {
   // more weight = more to the bottom
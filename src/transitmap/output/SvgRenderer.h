@@ -14,9 +14,9 @@
 #include "shared/rendergraph/RenderGraph.h"
 #include "transitmap/config/TransitMapConfig.h"
 #include "transitmap/label/Labeller.h"
+#include "transitmap/output/SvgWriter.h"
 #include "util/geo/Geo.h"
 #include "util/geo/PolyLine.h"
-#include "util/xml/XmlWriter.h"
 
 using util::Nullable;
 
@@ -66,8 +66,15 @@ struct EndMarker {
   double width, height;
 };
 
-typedef std::map<std::string, std::string> Params;
-typedef std::pair<Params, util::geo::PolyLine<double>> PrintDelegate;
+// attributes of a printed line, in fixed slots
+struct LineAttrs {
+  LineAttrs(const std::string& cls, const std::string& style)
+      : cls(cls), style(style) {}
+  std::string cls;
+  std::string style;
+};
+
+typedef std::pair<LineAttrs, util::geo::PolyLine<double>> PrintDelegate;
 
 struct OutlinePrintPair {
   OutlinePrintPair(PrintDelegate front, PrintDelegate back)
@@ -84,47 +91,40 @@ class SvgRenderer : public Renderer {
 
   virtual void print(const shared::rendergraph::RenderGraph& outputGraph);
 
-  void printLine(const util::geo::PolyLine<double>& l,
-                 const std::map<std::string, std::string>& ps,
-                 const RenderParams& params);
-  void printLine(const util::geo::PolyLine<double>& l, const std::string& style,
-                 const RenderParams& params);
-  void printPoint(const util::geo::DPoint& p, const std::string& style,
-                  const RenderParams& params);
-  void printPolygon(const util::geo::Polygon<double>& g,
-                    const std::map<std::string, std::string>& ps,
-                    const RenderParams& params);
-  void printCircle(const util::geo::DPoint& center, double rad,
-                   const std::map<std::string, std::string>& ps,
-                   const RenderParams& rparams);
+  void printLine(const util::geo::PolyLine<double>& l, const LineAttrs& attrs);
+  void printLine(const util::geo::PolyLine<double>& l, const std::string& style);
+  void printPoint(const util::geo::DPoint& p, const std::string& style);
+  void printStationPoly(const util::geo::Polygon<double>& g,
+                        const std::string& strokeWidth);
   void printCircle(const util::geo::DPoint& center, double rad,
-                   const std::string& style, const RenderParams& rparams);
+                   const std::string& style);
 
  private:
   std::ostream* _o;
-  util::xml::XmlWriter _w;
+  SvgWriter _w;
 
   const config::Config* _cfg;
 
+  // generalisation tolerance in map units
+  double _tol;
+
   std::map<uintptr_t, std::vector<OutlinePrintPair>> _delegates;
-  std::vector<std::map<uintptr_t, std::vector<OutlinePrintPair>>>
+  std::vector<std::map<const shared::linegraph::Line*,
+                       std::vector<OutlinePrintPair>,
+                       shared::linegraph::LineIdCmp>>
       _innerDelegates;
   std::vector<EndMarker> _markers;
   mutable std::map<std::string, int> lineClassIds;
   mutable int lineClassId = 0;
 
-  void outputNodes(const shared::rendergraph::RenderGraph& outputGraph,
-                   const RenderParams& params);
-  void outputEdges(const shared::rendergraph::RenderGraph& outputGraph,
-                   const RenderParams& params);
+  void outputNodes(const shared::rendergraph::RenderGraph& outputGraph);
+  void outputEdges(const shared::rendergraph::RenderGraph& outputGraph);
 
   void renderEdgeTripGeom(const shared::rendergraph::RenderGraph& outG,
-                          const shared::linegraph::LineEdge* e,
-                          const RenderParams& params);
+                          const shared::linegraph::LineEdge* e);
 
   void renderNodeConnections(const shared::rendergraph::RenderGraph& outG,
-                             const shared::linegraph::LineNode* n,
-                             const RenderParams& params);
+                             const shared::linegraph::LineNode* n);
 
   void renderLinePart(const util::geo::PolyLine<double> p, double width,
                       const shared::linegraph::Line& line,
@@ -137,17 +137,13 @@ class SvgRenderer : public Renderer {
                       const std::string& oCss,
                       const std::string& endMarker);
 
-  void renderDelegates(const shared::rendergraph::RenderGraph& outG,
-                       const RenderParams& params);
+  void renderDelegates(const shared::rendergraph::RenderGraph& outG);
 
-  void renderNodeFronts(const shared::rendergraph::RenderGraph& outG,
-                        const RenderParams& params);
+  void renderNodeFronts(const shared::rendergraph::RenderGraph& outG);
 
-  void renderLineLabels(const label::Labeller& lbler,
-                        const RenderParams& params);
+  void renderLineLabels(const label::Labeller& lbler);
 
-  void renderStationLabels(const label::Labeller& lbler,
-                           const RenderParams& params);
+  void renderStationLabels(const label::Labeller& lbler);
 
   std::multiset<InnerClique> getInnerCliques(
       const shared::linegraph::LineNode* n,
@@ -167,6 +163,9 @@ class SvgRenderer : public Renderer {
 
   std::string getLineClass(const std::string& id) const;
 
+  // l without the vertices which are below the tolerance tol
+  util::geo::DLine generalize(const util::geo::DLine& l, double tol) const;
+
   std::string getMarkerPathMale(double w) const;
   std::string getMarkerPathFemale(double w) const;
 };
@@ -0,0 +1,264 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include "transitmap/output/SvgWriter.h"
+
+using transitmapper::output::SvgWriter;
+using util::geo::DPoint;
+
+namespace {
+
+// _____________________________________________________________________________
+char* fmtFixed(int64_t v, size_t prec, uint64_t pow, char* end) {
+  // write v * 10^-prec backwards, ending at end, without trailing zeros in
+  // the fraction. Returns the start of the written text.
+  uint64_t u = v < 0 ? -static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+  uint64_t in = u / pow;
+  uint64_t frac = u % pow;
+
+  char* p = end;
+  if (frac) {
+    size_t d = prec;
+    while (frac % 10 == 0) {
+      frac /= 10;
+      d--;
+    }
+    while (d--) {
+      *--p = '0' + frac % 10;
+      frac /= 10;
+    }
+    *--p = '.';
+  }
+
+  // leading zeros are omitted, e.g. ".5" instead of "0.5"
+  while (in || p == end) {
+    *--p = '0' + in % 10;
+    in /= 10;
+  }
+
+  if (v < 0) *--p = '-';
+  return p;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+SvgWriter::SvgWriter(std::ostream* out, size_t prec)
+    : _out(out),
+      _inText(0),
+      _prec(std::min(prec, MAX_PREC)),
+      _pow(std::pow(10.0, static_cast<double>(_prec))),
+      _xOff(0),
+      _yOff(0),
+      _scale(1),
+      _height(0) {
+  _buf.reserve(BUF_SIZE + 1024);
+}
+
+// _____________________________________________________________________________
+SvgWriter::~SvgWriter() { flush(); }
+
+// _____________________________________________________________________________
+void SvgWriter::setTransform(double xOff, double yOff, double scale,
+                             double height) {
+  _xOff = xOff;
+  _yOff = yOff;
+  _scale = scale;
+  _height = height;
+}
+
+// _____________________________________________________________________________
+void SvgWriter::raw(const std::string& str) {
+  closeHanging();
+  _buf += str;
+}
+
+// _____________________________________________________________________________
+void SvgWriter::openTag(const char* tag) {
+  closeHanging();
+  newLine();
+  _buf += '<';
+  _buf += tag;
+  _stack.push_back({tag, true});
+  if (strcmp(tag, "text") == 0) _inText++;
+}
+
+// _____________________________________________________________________________
+void SvgWriter::attr(const char* key, const std::string& val) {
+  _buf += ' ';
+  _buf += key;
+  _buf += "=\"";
+  esc(val.c_str(), val.size(), true);
+  _buf += '"';
+}
+
+// _____________________________________________________________________________
+void SvgWriter::attr(const char* key, const char* val) {
+  _buf += ' ';
+  _buf += key;
+  _buf += "=\"";
+  esc(val, strlen(val), true);
+  _buf += '"';
+}
+
+// _____________________________________________________________________________
+void SvgWriter::attr(const char* key, double val) {
+  _buf += ' ';
+  _buf += key;
+  _buf += "=\"";
+  writeFixed(fixed(val));
+  _buf += '"';
+}
+
+// _____________________________________________________________________________
+void SvgWriter::pointAttrs(const char* keyX, const char* keyY,
+                           const DPoint& p) {
+  attr(keyX, (p.getX() - _xOff) * _scale);
+  attr(keyY, _height - (p.getY() - _yOff) * _scale);
+}
+
+// _____________________________________________________________________________
+void SvgWriter::pathAttr(const char* key, const std::vector<DPoint>& pts,
+                         bool close) {
+  _buf += ' ';
+  _buf += key;
+  _buf += "=\"";
+
+  // deltas are taken between the rounded absolute coordinates, so rounding
+  // errors do not add up along the path
+  int64_t lastX = 0, lastY = 0;
+  for (size_t i = 0; i < pts.size(); i++) {
+    int64_t x = fixed((pts[i].getX() - _xOff) * _scale);
+    int64_t y = fixed(_height - (pts[i].getY() - _yOff) * _scale);
+
+    if (i == 0) {
+      _buf += 'M';
+      writeFixed(x);
+      if (y >= 0) _buf += ' ';
+      writeFixed(y);
+    } else {
+      int64_t dx = x - lastX;
+      int64_t dy = y - lastY;
+      if (i == 1) {
+        _buf += 'l';
+      } else if (dx >= 0) {
+        _buf += ' ';
+      }
+      writeFixed(dx);
+      if (dy >= 0) _buf += ' ';
+      writeFixed(dy);
+    }
+
+    lastX = x;
+    lastY = y;
+  }
+
+  if (close && pts.size()) _buf += 'z';
+  _buf += '"';
+
+  if (_buf.size() > BUF_SIZE) flush();
+}
+
+// _____________________________________________________________________________
+void SvgWriter::text(const std::string& text) {
+  closeHanging();
+  esc(text.c_str(), text.size(), false);
+}
+
+// _____________________________________________________________________________
+void SvgWriter::closeTag() {
+  if (_stack.empty()) return;
+
+  const Tag& t = _stack.back();
+  if (t.hanging) {
+    _buf += " />";
+  } else {
+    newLine();
+    _buf += "</";
+    _buf += t.name;
+    _buf += '>';
+  }
+
+  if (strcmp(t.name, "text") == 0) _inText--;
+  _stack.pop_back();
+
+  if (_buf.size() > BUF_SIZE) flush();
+}
+
+// _____________________________________________________________________________
+void SvgWriter::closeTags() {
+  while (!_stack.empty()) closeTag();
+  flush();
+}
+
+// _____________________________________________________________________________
+void SvgWriter::flush() {
+  _out->write(_buf.data(), _buf.size());
+  _buf.clear();
+}
+
+// _____________________________________________________________________________
+std::string SvgWriter::num(double v) const {
+  char buf[32];
+  char* end = buf + sizeof(buf);
+  char* start = fmtFixed(fixed(v), _prec, static_cast<uint64_t>(_pow), end);
+  return std::string(start, end);
+}
+
+// _____________________________________________________________________________
+void SvgWriter::closeHanging() {
+  if (!_stack.empty() && _stack.back().hanging) {
+    _buf += '>';
+    _stack.back().hanging = false;
+  }
+}
+
+// _____________________________________________________________________________
+void SvgWriter::newLine() {
+  if (!_inText) _buf += '\n';
+}
+
+// _____________________________________________________________________________
+void SvgWriter::esc(const char* s, size_t n, bool quot) {
+  for (size_t i = 0; i < n; i++) {
+    switch (s[i]) {
+      case '"':
+        if (quot) {
+          _buf += "&quot;";
+        } else {
+          _buf += '"';
+        }
+        break;
+      case '<':
+        _buf += "&lt;";
+        break;
+      case '>':
+        _buf += "&gt;";
+        break;
+      case '&':
+        _buf += "&amp;";
+        break;
+      default:
+        _buf += s[i];
+    }
+  }
+}
+
+// _____________________________________________________________________________
+int64_t SvgWriter::fixed(double v) const {
+  if (!std::isfinite(v)) return 0;
+  return std::llround(v * _pow);
+}
+
+// _____________________________________________________________________________
+void SvgWriter::writeFixed(int64_t v) {
+  char buf[32];
+  char* end = buf + sizeof(buf);
+  char* start = fmtFixed(v, _prec, static_cast<uint64_t>(_pow), end);
+  _buf.append(start, end - start);
+}
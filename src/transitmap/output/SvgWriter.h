@@ -0,0 +1,93 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef TRANSITMAP_OUTPUT_SVGWRITER_H_
+#define TRANSITMAP_OUTPUT_SVGWRITER_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "util/geo/Geo.h"
+
+namespace transitmapper {
+namespace output {
+
+// low-overhead SVG writer. Attributes are written directly into a buffer in
+// the order they are given, numbers are written with a fixed maximum number
+// of decimals and paths use relative commands. Output is written to the
+// stream on flush(), closeTags() and destruction.
+class SvgWriter {
+ public:
+  // maximum number of decimals
+  static const size_t MAX_PREC = 9;
+
+  SvgWriter(std::ostream* out, size_t prec);
+  ~SvgWriter();
+
+  // set the transformation from map coordinates to SVG coordinates,
+  // x' = (x - xOff) * scale, y' = height - (y - yOff) * scale
+  void setTransform(double xOff, double yOff, double scale, double height);
+
+  // write unescaped content, e.g. the prolog
+  void raw(const std::string& str);
+
+  void openTag(const char* tag);
+
+  // attributes of the last opened tag
+  void attr(const char* key, const std::string& val);
+  void attr(const char* key, const char* val);
+  void attr(const char* key, double val);
+
+  // path data of a transformed point sequence, as an absolute moveto
+  // followed by relative linetos. Closed with "z" if close is true.
+  void pathAttr(const char* key, const std::vector<util::geo::DPoint>& pts,
+                bool close);
+
+  // transformed point coordinates
+  void pointAttrs(const char* keyX, const char* keyY,
+                  const util::geo::DPoint& p);
+
+  void text(const std::string& text);
+
+  void closeTag();
+  void closeTags();
+
+  void flush();
+
+  // v with the precision of this writer
+  std::string num(double v) const;
+
+ private:
+  static const size_t BUF_SIZE = 1 << 16;
+
+  struct Tag {
+    const char* name;
+    bool hanging;
+  };
+
+  std::ostream* _out;
+  std::string _buf;
+  std::vector<Tag> _stack;
+
+  // number of open <text> tags, no whitespace is written inside them
+  size_t _inText;
+
+  size_t _prec;
+  double _pow;
+
+  double _xOff, _yOff, _scale, _height;
+
+  void closeHanging();
+  void newLine();
+  void esc(const char* s, size_t n, bool quot);
+
+  // v in units of 10^-prec
+  int64_t fixed(double v) const;
+  void writeFixed(int64_t v);
+};
+
+}  // namespace output
+}  // namespace transitmapper
+
+#endif  // TRANSITMAP_OUTPUT_SVGWRITER_H_
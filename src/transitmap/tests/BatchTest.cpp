@@ -0,0 +1,121 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "transitmap/TransitMap.h"
+#include "transitmap/config/TransitMapConfig.h"
+#include "transitmap/tests/BatchTest.h"
+#include "util/Misc.h"
+
+using transitmapper::BatchJob;
+
+// _____________________________________________________________________________
+void BatchTest::run() {
+  {
+    std::stringstream ss(
+        "# nightly\n"
+        "a.json  a.svg\n"
+        "\n"
+        "  b.json\tb.svg  \n");
+    auto jobs = transitmapper::readManifest(&ss);
+    TEST(jobs.size(), ==, 2);
+    TEST(jobs[0].input, ==, "a.json");
+    TEST(jobs[0].output, ==, "a.svg");
+    TEST(jobs[1].input, ==, "b.json");
+    TEST(jobs[1].output, ==, "b.svg");
+  }
+
+  {
+    for (std::string line : {"a.json\n", "a.json a.svg c.svg\n"}) {
+      std::stringstream ss("a.json a.svg\n" + line);
+      bool thrown = false;
+      try {
+        transitmapper::readManifest(&ss);
+      } catch (const std::runtime_error& e) {
+        thrown = true;
+        TEST(std::string(e.what()).find("line 2"), !=, std::string::npos);
+      }
+      TEST(thrown);
+    }
+  }
+
+  {
+    // two lines which share the edge 1-2 and part at node 2
+    std::string json =
+        "{\"type\": \"FeatureCollection\", \"features\": ["
+        "{\"type\": \"Feature\", \"geometry\": {\"type\": \"LineString\", "
+        "\"coordinates\": [[0, 0], [1000, 0]]}, \"properties\": {\"from\": "
+        "\"1\", \"to\": \"2\", \"lines\": [{\"id\": \"A\", \"color\": "
+        "\"ff0000\"}, {\"id\": \"B\", \"color\": \"0000ff\"}]}},"
+        "{\"type\": \"Feature\", \"geometry\": {\"type\": \"LineString\", "
+        "\"coordinates\": [[1000, 0], [2000, 1000]]}, \"properties\": "
+        "{\"from\": \"2\", \"to\": \"3\", \"lines\": [{\"id\": \"A\", "
+        "\"color\": \"ff0000\"}]}},"
+        "{\"type\": \"Feature\", \"geometry\": {\"type\": \"LineString\", "
+        "\"coordinates\": [[1000, 0], [2000, -1000]]}, \"properties\": "
+        "{\"from\": \"2\", \"to\": \"4\", \"lines\": [{\"id\": \"B\", "
+        "\"color\": \"0000ff\"}]}},"
+        "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+        "\"coordinates\": [0, 0]}, \"properties\": {\"id\": \"1\"}},"
+        "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+        "\"coordinates\": [1000, 0]}, \"properties\": {\"id\": \"2\"}},"
+        "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+        "\"coordinates\": [2000, 1000]}, \"properties\": {\"id\": \"3\"}},"
+        "{\"type\": \"Feature\", \"geometry\": {\"type\": \"Point\", "
+        "\"coordinates\": [2000, -1000]}, \"properties\": {\"id\": \"4\"}}]}";
+
+    std::string in = "/tmp/loom-batch-test.json";
+    std::ofstream out(in);
+    out << json;
+    out.close();
+
+    std::vector<BatchJob> jobs = {{in, "/tmp/loom-batch-test-0.svg"},
+                                  {"/tmp/loom-batch-test-missing.json",
+                                   "/tmp/loom-batch-test-1.svg"},
+                                  {in, "/tmp/loom-batch-test-2.svg"}};
+
+    transitmapper::config::Config cfg;
+    std::vector<util::json::Dict> stats;
+    transitmapper::batch(&cfg, jobs, 2, &stats);
+
+    TEST(stats.size(), ==, 3);
+    TEST(stats[0].count("error"), ==, 0);
+    TEST(stats[0]["nodes"].ui, ==, 4);
+    TEST(stats[0]["edges"].ui, ==, 3);
+    TEST(stats[0]["time-ms"].f, >=, stats[0]["render-ms"].f);
+    TEST(stats[1].count("error"), ==, 1);
+    TEST(stats[1]["input"].str, ==, "/tmp/loom-batch-test-missing.json");
+    TEST(stats[2].count("error"), ==, 0);
+
+    // both jobs share the configuration and give the same map
+    std::ifstream a("/tmp/loom-batch-test-0.svg");
+    std::ifstream b("/tmp/loom-batch-test-2.svg");
+    std::stringstream sa, sb;
+    sa << a.rdbuf();
+    sb << b.rdbuf();
+    TEST(sa.str().find("<svg"), !=, std::string::npos);
+    TEST(sa.str(), ==, sb.str());
+
+    // an unknown render method fails the jobs, not the process, and leaves
+    // the existing output untouched
+    cfg.renderMethod = "xyz";
+    transitmapper::batch(&cfg, {{in, "/tmp/loom-batch-test-0.svg"}}, 1, &stats);
+    TEST(stats.size(), ==, 1);
+    TEST(stats[0]["error"].str, ==, "Unknown render method xyz");
+
+    std::ifstream c("/tmp/loom-batch-test-0.svg");
+    std::stringstream sc;
+    sc << c.rdbuf();
+    TEST(sc.str(), ==, sa.str());
+    TEST(!std::ifstream("/tmp/loom-batch-test-0.svg.tmp-0").good());
+
+    std::remove(in.c_str());
+    std::remove("/tmp/loom-batch-test-0.svg");
+    std::remove("/tmp/loom-batch-test-2.svg");
+  }
+}
@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef TRANSITMAP_TEST_BATCHTEST_H_
+#define TRANSITMAP_TEST_BATCHTEST_H_
+
+class BatchTest {
+  public:
+    void run();
+};
+
+#endif
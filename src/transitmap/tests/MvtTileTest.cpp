@@ -0,0 +1,74 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <string>
+#include <vector>
+#include "transitmap/output/MvtTile.h"
+#include "transitmap/tests/MvtTileTest.h"
+#include "util/Misc.h"
+
+using transitmapper::output::MvtTile;
+using util::geo::ILine;
+using util::geo::IPoint;
+
+// _____________________________________________________________________________
+void MvtTileTest::run() {
+  {
+    MvtTile tile(4096);
+    TEST(tile.empty());
+    tile.addLayer("a");
+    TEST(tile.empty());
+    TEST(tile.serialize(), ==, "");
+  }
+
+  {
+    // geometries from the examples of the vector tile specification
+    MvtTile tile(4096);
+    tile.addLayer("empty");
+    tile.addLayer("a");
+    tile.addFeature(1, MvtTile::LINESTRING,
+                    {ILine{IPoint(2, 2), IPoint(2, 10), IPoint(10, 10)}},
+                    {{"k", "v"}});
+    tile.addFeature(2, MvtTile::POLYGON,
+                    {ILine{IPoint(3, 6), IPoint(8, 12), IPoint(20, 34)}}, {});
+    TEST(!tile.empty());
+
+    std::string feat1(
+        "\x08\x01\x12\x02\x00\x00\x18\x02\x22\x08\x09\x04\x04\x12\x00\x10\x10"
+        "\x00",
+        18);
+    std::string feat2(
+        "\x08\x02\x18\x03\x22\x09\x09\x06\x0C\x12\x0A\x0C\x18\x2C\x0F", 15);
+    std::string layer = std::string("\x78\x02\x0A\x01" "a", 5) +
+                        std::string("\x12\x12", 2) + feat1 +
+                        std::string("\x12\x0F", 2) + feat2 +
+                        std::string("\x1A\x01" "k", 3) +
+                        std::string("\x22\x03\x0A\x01" "v", 5) +
+                        std::string("\x28\x80\x20", 3);
+    TEST(layer.size(), ==, 53);
+
+    TEST(tile.serialize() == std::string("\x1A\x35", 2) + layer);
+  }
+
+  {
+    // keys and values are shared between features, numbers are doubles
+    MvtTile tile(256);
+    tile.addLayer("b");
+    tile.addFeature(1, MvtTile::POINT, {ILine{IPoint(-1, 0)}},
+                    {{"x", 1.0}, {"y", "z"}});
+    tile.addFeature(2, MvtTile::POINT, {ILine{IPoint(0, 0)}},
+                    {{"y", "z"}, {"x", 1.0}});
+
+    std::string s = tile.serialize();
+    // MoveTo(1), zigzag(-1) = 1
+    TEST(s.find(std::string("\x22\x03\x09\x01\x00", 5)) != std::string::npos);
+    // tags of the second feature reference the same keys and values
+    TEST(s.find(std::string("\x12\x04\x00\x00\x01\x01", 6)) !=
+         std::string::npos);
+    TEST(s.find(std::string("\x12\x04\x01\x01\x00\x00", 6)) !=
+         std::string::npos);
+    // double 1.0
+    TEST(s.find(std::string("\x19\x00\x00\x00\x00\x00\x00\xF0\x3F", 9)) !=
+         std::string::npos);
+  }
+}
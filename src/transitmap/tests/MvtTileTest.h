@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef TRANSITMAP_TEST_MVTTILETEST_H_
+#define TRANSITMAP_TEST_MVTTILETEST_H_
+
+class MvtTileTest {
+  public:
+    void run();
+};
+
+#endif
@@ -0,0 +1,138 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "transitmap/output/PngWriter.h"
+#include "transitmap/output/Raster.h"
+#include "transitmap/tests/RasterTest.h"
+#include "util/Misc.h"
+
+using transitmapper::output::PngWriter;
+using transitmapper::output::Raster;
+using transitmapper::output::Rgba;
+using util::geo::DLine;
+using util::geo::DPoint;
+
+namespace {
+// _____________________________________________________________________________
+const uint8_t* px(const Raster& r, size_t x, size_t y) {
+  return r.getPixels().data() + (y * r.getWidth() + x) * 4;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void RasterTest::run() {
+  {
+    Raster r(10, 10);
+    r.fill({DLine{DPoint(2.5, 2), DPoint(7.5, 2), DPoint(7.5, 4),
+                  DPoint(2.5, 4)}},
+           Rgba(255, 0, 0, 255));
+    r.render();
+
+    TEST(r.getPixels().size(), ==, 400);
+    TEST(px(r, 3, 3)[0], ==, 255);
+    TEST(px(r, 3, 3)[1], ==, 0);
+    TEST(px(r, 3, 3)[3], ==, 255);
+    TEST(px(r, 2, 3)[0], ==, 255);
+    TEST(px(r, 2, 3)[3], ==, 128);
+    TEST(px(r, 7, 2)[3], ==, 128);
+    TEST(px(r, 8, 3)[3], ==, 0);
+    TEST(px(r, 3, 4)[3], ==, 0);
+    TEST(px(r, 3, 1)[3], ==, 0);
+  }
+
+  {
+    // shapes spanning several tiles, later shapes are painted over earlier
+    Raster r(600, 20);
+    r.fill({DLine{DPoint(100, 5), DPoint(500, 5), DPoint(500, 15),
+                  DPoint(100, 15)}},
+           Rgba(255, 0, 0, 255));
+    r.fill({DLine{DPoint(300, 0), DPoint(400, 0), DPoint(400, 20),
+                  DPoint(300, 20)}},
+           Rgba(0, 0, 255, 255));
+    r.render();
+
+    TEST(px(r, 99, 10)[3], ==, 0);
+    TEST(px(r, 100, 10)[3], ==, 255);
+    TEST(px(r, 255, 10)[0], ==, 255);
+    TEST(px(r, 256, 10)[0], ==, 255);
+    TEST(px(r, 299, 10)[0], ==, 255);
+    TEST(px(r, 300, 10)[0], ==, 0);
+    TEST(px(r, 300, 10)[2], ==, 255);
+    TEST(px(r, 350, 2)[2], ==, 255);
+    TEST(px(r, 499, 10)[0], ==, 255);
+    TEST(px(r, 500, 10)[3], ==, 0);
+  }
+
+  {
+    // overlapping rings of a shape are united, not painted twice
+    Raster r(10, 10);
+    r.fill({DLine{DPoint(1, 1), DPoint(6, 1), DPoint(6, 6), DPoint(1, 6)},
+            DLine{DPoint(9, 9), DPoint(9, 4), DPoint(4, 4), DPoint(4, 9)}},
+           Rgba(0, 0, 0, 128));
+    r.render();
+
+    TEST(px(r, 2, 2)[3], ==, 128);
+    TEST(px(r, 5, 5)[3], ==, 128);
+    TEST(px(r, 8, 8)[3], ==, 128);
+    TEST(px(r, 8, 2)[3], ==, 0);
+  }
+
+  {
+    // no seams between the segments of a stroke, round caps
+    Raster r(60, 20);
+    r.stroke(DLine{DPoint(10, 10), DPoint(30, 10), DPoint(50, 10)}, 4,
+             Rgba(0, 255, 0, 255), true, false);
+    r.render();
+
+    for (size_t x = 10; x < 50; x++) {
+      TEST(px(r, x, 8)[3], ==, 255);
+      TEST(px(r, x, 11)[3], ==, 255);
+      TEST(px(r, x, 7)[3], ==, 0);
+      TEST(px(r, x, 12)[3], ==, 0);
+    }
+    TEST(px(r, 8, 9)[3], >, 200);
+    TEST(px(r, 8, 9)[3], <, 255);
+    TEST(px(r, 7, 9)[3], <, 50);
+    TEST(px(r, 51, 10)[3], >, 200);
+    TEST(px(r, 53, 10)[3], ==, 0);
+  }
+
+  {
+    // round joins on the outer side of a turn
+    Raster r(30, 30);
+    r.stroke(DLine{DPoint(5, 10), DPoint(20, 10), DPoint(20, 25)}, 4,
+             Rgba(0, 0, 0, 255), false, false);
+    r.render();
+
+    TEST(px(r, 19, 8)[3], ==, 255);
+    TEST(px(r, 20, 9)[3], ==, 255);
+    TEST(px(r, 21, 21)[3], ==, 255);
+    TEST(px(r, 20, 8)[3], >, 0);
+    TEST(px(r, 20, 8)[3], <, 255);
+    TEST(px(r, 21, 9)[3], >, 0);
+    TEST(px(r, 21, 9)[3], <, 255);
+    TEST(px(r, 22, 8)[3], ==, 0);
+    TEST(px(r, 4, 10)[3], ==, 0);
+    TEST(px(r, 20, 25)[3], ==, 0);
+  }
+
+  {
+    TEST(PngWriter::crc32("123456789"), ==, 0xCBF43926);
+    TEST(PngWriter::crc32("IEND"), ==, 0xAE426082);
+
+    std::stringstream ss;
+    PngWriter(&ss).write(std::vector<uint8_t>(3 * 2 * 4, 255), 3, 2);
+    std::string png = ss.str();
+
+    TEST(png.substr(0, 8) == std::string("\x89PNG\r\n\x1a\n", 8));
+    TEST(png.substr(8, 8) == std::string("\0\0\0\x0DIHDR", 8));
+    TEST(png.substr(16, 13) ==
+         std::string("\0\0\0\x03\0\0\0\x02\x08\x06\0\0\0", 13));
+    TEST(png.substr(33, 8).substr(4) == "IDAT");
+    TEST(png.substr(png.size() - 12) ==
+         std::string("\0\0\0\0IEND\xAE\x42\x60\x82", 12));
+  }
+}
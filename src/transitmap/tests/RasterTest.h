@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef TRANSITMAP_TEST_RASTERTEST_H_
+#define TRANSITMAP_TEST_RASTERTEST_H_
+
+class RasterTest {
+  public:
+    void run();
+};
+
+#endif
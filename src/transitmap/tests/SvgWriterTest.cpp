@@ -0,0 +1,99 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "transitmap/output/SvgWriter.h"
+#include "transitmap/tests/SvgWriterTest.h"
+#include "util/Misc.h"
+
+using transitmapper::output::SvgWriter;
+using util::geo::DPoint;
+
+// _____________________________________________________________________________
+void SvgWriterTest::run() {
+  {
+    std::stringstream ss;
+    SvgWriter w(&ss, 2);
+    TEST(w.num(0), ==, "0");
+    TEST(w.num(1), ==, "1");
+    TEST(w.num(1.5), ==, "1.5");
+    TEST(w.num(1.005001), ==, "1.01");
+    TEST(w.num(-0.001), ==, "0");
+    TEST(w.num(-2.25), ==, "-2.25");
+    TEST(w.num(-0.05), ==, "-.05");
+    TEST(w.num(1234567.891), ==, "1234567.89");
+    TEST(w.num(0.999), ==, "1");
+  }
+
+  {
+    std::stringstream ss;
+    SvgWriter w(&ss, 0);
+    TEST(w.num(2.5), ==, "3");
+    TEST(w.num(-7.4), ==, "-7");
+  }
+
+  {
+    std::stringstream ss;
+    SvgWriter w(&ss, 6);
+    TEST(w.num(0.000001), ==, ".000001");
+    TEST(w.num(10.10001), ==, "10.10001");
+  }
+
+  {
+    // relative path commands, deltas are taken between rounded coordinates
+    std::stringstream ss;
+    {
+      SvgWriter w(&ss, 1);
+      w.setTransform(10, 20, 2, 100);
+      w.openTag("path");
+      w.pathAttr("d",
+                 {DPoint(10, 20), DPoint(10.33, 20), DPoint(10.66, 20),
+                  DPoint(11, 25), DPoint(15, 30)},
+                 false);
+      w.attr("style", "a\"<b>&c");
+      w.closeTag();
+    }
+    TEST(ss.str(), ==,
+         "\n<path d=\"M0 100l.7 0 .6 0 .7-10 8-10\" "
+         "style=\"a&quot;&lt;b&gt;&amp;c\" />");
+  }
+
+  {
+    std::stringstream ss;
+    {
+      SvgWriter w(&ss, 2);
+      w.openTag("path");
+      w.pathAttr("d", {DPoint(1, -1), DPoint(2, 1), DPoint(1, 2)}, true);
+      w.closeTag();
+      w.openTag("path");
+      w.pathAttr("d", {}, true);
+      w.closeTag();
+    }
+    TEST(ss.str(), ==, "\n<path d=\"M1 1l1-2-1-1z\" />\n<path d=\"\" />");
+  }
+
+  {
+    // no whitespace inside text elements
+    std::stringstream ss;
+    {
+      SvgWriter w(&ss, 2);
+      w.raw("<?xml?>");
+      w.openTag("svg");
+      w.openTag("g");
+      w.openTag("text");
+      w.attr("font-size", 4.0);
+      w.openTag("textPath");
+      w.text("A \"&\" B");
+      w.closeTag();
+      w.openTag("tspan");
+      w.closeTag();
+      w.closeTag();
+      w.closeTags();
+    }
+    TEST(ss.str(), ==,
+         "<?xml?>\n<svg>\n<g>\n<text font-size=\"4\"><textPath>A \"&amp;\" "
+         "B</textPath><tspan /></text>\n</g>\n</svg>");
+  }
+}
@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef TRANSITMAP_TEST_SVGWRITERTEST_H_
+#define TRANSITMAP_TEST_SVGWRITERTEST_H_
+
+class SvgWriterTest {
+  public:
+    void run();
+};
+
+#endif
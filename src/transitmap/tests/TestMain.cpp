@@ -1,12 +1,26 @@
 // Copyright 2016
 // Author: Patrick Brosi
 
+#include "transitmap/tests/BatchTest.h"
+#include "transitmap/tests/MvtTileTest.h"
+#include "transitmap/tests/RasterTest.h"
+#include "transitmap/tests/SvgWriterTest.h"
+
 #include "util/Misc.h"
 
 // _____________________________________________________________________________
 int main(int argc, char** argv) {
   UNUSED(argc);
   UNUSED(argv);
+  SvgWriterTest swt;
+  MvtTileTest mtt;
+  RasterTest rt;
+  BatchTest bt;
+
+  swt.run();
+  mtt.run();
+  rt.run();
+  bt.run();
 
   return 0;
 }
@@ -0,0 +1,74 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef UTIL_DEADLINE_H_
+#define UTIL_DEADLINE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+
+namespace util {
+
+// A wall-clock budget for long running computations, which may also be
+// cancelled explicitly. Copies share their cancellation state, so a deadline
+// handed to a computation can be cancelled from another thread. A default
+// constructed deadline never expires on its own.
+class Deadline {
+  typedef std::chrono::steady_clock Clock;
+
+ public:
+  Deadline()
+      : _cancelled(std::make_shared<std::atomic<bool>>(false)),
+        _end(Clock::time_point::max()) {}
+
+  // expires the given number of seconds from now, a negative budget means
+  // no time limit
+  explicit Deadline(double secs) : Deadline() {
+    if (secs >= 0) {
+      _end = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                std::chrono::duration<double>(secs));
+    }
+  }
+
+  // true if the deadline has passed or it has been cancelled
+  bool expired() const {
+    if (_cancelled->load(std::memory_order_relaxed)) return true;
+    return limited() && Clock::now() >= _end;
+  }
+
+  void cancel() const { _cancelled->store(true, std::memory_order_relaxed); }
+
+  // true if there is a time limit
+  bool limited() const { return _end != Clock::time_point::max(); }
+
+  // remaining seconds, the largest double if there is no time limit (not
+  // infinity, which is undefined under -ffinite-math-only)
+  double remaining() const {
+    if (_cancelled->load(std::memory_order_relaxed)) return 0;
+    if (!limited()) return std::numeric_limits<double>::max();
+    return std::max(
+        0.0, std::chrono::duration<double>(_end - Clock::now()).count());
+  }
+
+  // the given solver time limit in seconds (negative for none), clamped to
+  // the remaining time. Never below 1 s, as solvers treat 0 as "no limit".
+  int clampTimeLim(int secs) const {
+    if (!limited() && !_cancelled->load(std::memory_order_relaxed)) {
+      return secs;
+    }
+    int rem = std::max(1, static_cast<int>(remaining()));
+    return secs < 0 ? rem : std::min(secs, rem);
+  }
+
+ private:
+  std::shared_ptr<std::atomic<bool>> _cancelled;
+  Clock::time_point _end;
+};
+
+}  // namespace util
+
+#endif  // UTIL_DEADLINE_H_
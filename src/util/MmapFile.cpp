@@ -0,0 +1,53 @@
+// Copyright 2018, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "util/MmapFile.h"
+
+using util::MmapFile;
+
+// _____________________________________________________________________________
+MmapFile::MmapFile(const std::string& path) : _data(""), _size(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Could not open " + path + ": " +
+                             strerror(errno));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw std::runtime_error("Could not stat " + path + ": " +
+                             strerror(errno));
+  }
+
+  // an empty mapping is not allowed
+  if (st.st_size > 0) {
+    void* p = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Could not map " + path + ": " +
+                               strerror(errno));
+    }
+    // the file is read front to back, in parallel
+    madvise(p, st.st_size, MADV_WILLNEED);
+    _data = static_cast<const char*>(p);
+    _size = st.st_size;
+  }
+
+  // the mapping stays valid after closing the descriptor
+  close(fd);
+}
+
+// _____________________________________________________________________________
+MmapFile::~MmapFile() {
+  if (_size) munmap(const_cast<char*>(_data), _size);
+}
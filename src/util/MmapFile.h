@@ -0,0 +1,32 @@
+// Copyright 2018, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef UTIL_MMAPFILE_H_
+#define UTIL_MMAPFILE_H_
+
+#include <string>
+
+namespace util {
+
+// read-only memory mapping of a whole file, throws std::runtime_error if the
+// file cannot be mapped
+class MmapFile {
+ public:
+  explicit MmapFile(const std::string& path);
+  ~MmapFile();
+
+  MmapFile(const MmapFile& other) = delete;
+  void operator=(const MmapFile& other) = delete;
+
+  const char* data() const { return _data; }
+  size_t size() const { return _size; }
+
+ private:
+  const char* _data;
+  size_t _size;
+};
+
+}  // namespace util
+
+#endif  // UTIL_MMAPFILE_H_
@@ -0,0 +1,44 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef UTIL_SHA256_H_
+#define UTIL_SHA256_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace util {
+
+// incremental SHA-256 (FIPS 180-4)
+class Sha256 {
+ public:
+  Sha256();
+
+  void update(const char* data, size_t len);
+  void update(const std::string& data) { update(data.data(), data.size()); }
+
+  // the digest of all data added so far as 64 lower case hex characters.
+  // The object must not be updated afterwards.
+  std::string hex();
+
+ private:
+  uint32_t _h[8];
+  unsigned char _blk[64];
+  size_t _blkLen;
+  uint64_t _len;
+
+  void compress(const unsigned char* blk);
+};
+
+// the hex SHA-256 digest of data
+inline std::string sha256(const std::string& data) {
+  Sha256 h;
+  h.update(data);
+  return h.hex();
+}
+
+}  // namespace util
+
+#endif  // UTIL_SHA256_H_
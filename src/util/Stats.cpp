@@ -0,0 +1,366 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include "util/Misc.h"
+#include "util/Stats.h"
+#include "util/log/Log.h"
+
+using util::json::Array;
+using util::json::Dict;
+using util::stats::Event;
+using util::stats::ThreadStats;
+
+bool util::stats::ENABLED = false;
+
+namespace {
+
+const char* COUNTER_NAMES[] = {"settled_nodes", "pq_pushes", "relaxations",
+                               "grid_queries", "scorer_calls"};
+
+const char* MEM_NAMES[] = {"graph",     "grid",    "geometry", "ilp",
+                           "order_cfg", "drawing", "geo_pens"};
+
+const auto EPOCH = std::chrono::steady_clock::now();
+
+// the current and peak bytes of every subsystem, shared by all threads
+std::atomic<size_t> memCur[util::stats::NUM_MEMS];
+std::atomic<size_t> memPeaks[util::stats::NUM_MEMS];
+
+// the running peak measurements of all threads, see PeakRss
+std::mutex peakMut;
+std::vector<util::stats::PeakRss*> peaks;
+
+// _____________________________________________________________________________
+size_t hwm() {
+  // the peak since the last reset, getrusage() is never reset
+  std::ifstream f("/proc/self/status");
+  std::string line;
+  while (std::getline(f, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return std::strtoull(line.c_str() + 6, 0, 10) * 1024;
+    }
+  }
+  return util::getPeakRSS();
+}
+
+// the live threads, and what is left of finished ones
+struct Registry {
+  std::mutex mut;
+  size_t nextTid = 0;
+  std::vector<ThreadStats*> threads;
+  std::map<size_t, std::vector<size_t>> retiredCounters;
+  std::map<size_t, std::vector<Event>> retiredEvents;
+};
+
+// _____________________________________________________________________________
+Registry& reg() {
+  // never destroyed, threads may still finish during static destruction
+  static Registry* r = new Registry();
+  return *r;
+}
+
+// _____________________________________________________________________________
+void collect(std::map<size_t, std::vector<size_t>>* counters,
+             std::map<size_t, std::vector<Event>>* events) {
+  Registry& r = reg();
+  std::lock_guard<std::mutex> lock(r.mut);
+  *counters = r.retiredCounters;
+  *events = r.retiredEvents;
+
+  for (auto t : r.threads) {
+    auto& c = (*counters)[t->tid];
+    c.resize(util::stats::NUM_COUNTERS);
+    for (size_t i = 0; i < util::stats::NUM_COUNTERS; i++) {
+      c[i] = t->counters[i].load(std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> tlock(t->mut);
+    auto& e = (*events)[t->tid];
+    e.insert(e.end(), t->events.begin(), t->events.end());
+  }
+}
+
+// _____________________________________________________________________________
+Dict counterDict(const std::vector<size_t>& c) {
+  Dict ret;
+  for (size_t i = 0; i < util::stats::NUM_COUNTERS; i++) {
+    ret[COUNTER_NAMES[i]] = c[i];
+  }
+  return ret;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+ThreadStats::ThreadStats() {
+  for (size_t i = 0; i < NUM_COUNTERS; i++) counters[i] = 0;
+
+  Registry& r = reg();
+  std::lock_guard<std::mutex> lock(r.mut);
+  tid = r.nextTid++;
+  r.threads.push_back(this);
+}
+
+// _____________________________________________________________________________
+ThreadStats::~ThreadStats() {
+  Registry& r = reg();
+  std::lock_guard<std::mutex> lock(r.mut);
+  r.threads.erase(std::find(r.threads.begin(), r.threads.end(), this));
+
+  auto& c = r.retiredCounters[tid];
+  c.resize(NUM_COUNTERS);
+  for (size_t i = 0; i < NUM_COUNTERS; i++) c[i] += counters[i].load();
+
+  std::lock_guard<std::mutex> tlock(mut);
+  if (events.size()) {
+    auto& e = r.retiredEvents[tid];
+    e.insert(e.end(), events.begin(), events.end());
+  }
+}
+
+// _____________________________________________________________________________
+void util::stats::enable() { ENABLED = true; }
+
+// _____________________________________________________________________________
+void util::stats::reset() {
+  Registry& r = reg();
+  std::lock_guard<std::mutex> lock(r.mut);
+  r.retiredCounters.clear();
+  r.retiredEvents.clear();
+
+  for (auto t : r.threads) {
+    for (size_t i = 0; i < NUM_COUNTERS; i++) t->counters[i] = 0;
+    std::lock_guard<std::mutex> tlock(t->mut);
+    t->events.clear();
+  }
+
+  for (size_t i = 0; i < NUM_MEMS; i++) memPeaks[i] = memCur[i].load();
+}
+
+// _____________________________________________________________________________
+void util::stats::MemTrack::set(size_t bytes) {
+  if (bytes >= _bytes) {
+    size_t cur = memCur[_m].fetch_add(bytes - _bytes) + bytes - _bytes;
+    size_t peak = memPeaks[_m].load(std::memory_order_relaxed);
+    while (cur > peak && !memPeaks[_m].compare_exchange_weak(peak, cur)) {
+    }
+  } else {
+    memCur[_m].fetch_sub(_bytes - bytes);
+  }
+  _bytes = bytes;
+}
+
+// _____________________________________________________________________________
+size_t util::stats::memUsage(Mem m) { return memCur[m].load(); }
+
+// _____________________________________________________________________________
+size_t util::stats::memPeak(Mem m) { return memPeaks[m].load(); }
+
+// _____________________________________________________________________________
+const char* util::stats::memName(Mem m) { return MEM_NAMES[m]; }
+
+// _____________________________________________________________________________
+int64_t util::stats::now() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - EPOCH)
+      .count();
+}
+
+// _____________________________________________________________________________
+Dict util::stats::toJson() {
+  std::map<size_t, std::vector<size_t>> counters;
+  std::map<size_t, std::vector<Event>> events;
+  collect(&counters, &events);
+
+  std::vector<size_t> total(NUM_COUNTERS, 0);
+  Array threads;
+  for (const auto& c : counters) {
+    bool empty = true;
+    for (size_t i = 0; i < NUM_COUNTERS; i++) {
+      total[i] += c.second[i];
+      if (c.second[i]) empty = false;
+    }
+    if (empty) continue;
+    threads.push_back(
+        Dict{{"tid", c.first}, {"counters", counterDict(c.second)}});
+  }
+
+  std::map<std::string, Dict> timers;
+  std::vector<Event> phases;
+
+  for (const auto& tEvs : events) {
+    for (const auto& e : tEvs.second) {
+      if (e.peakRss) {
+        phases.push_back(e);
+        continue;
+      }
+
+      double ms = e.dur / 1000.0;
+      auto& t = timers[e.name];
+      if (t.empty()) {
+        t = {{"count", size_t(0)}, {"total_ms", 0.0}, {"max_ms", 0.0}};
+      }
+      t["count"] = t["count"].ui + 1;
+      t["total_ms"] = t["total_ms"].f + ms;
+      t["max_ms"] = std::max(t["max_ms"].f, ms);
+    }
+  }
+
+  std::sort(phases.begin(), phases.end(),
+            [](const Event& a, const Event& b) { return a.start < b.start; });
+
+  Array phasesArr;
+  for (const auto& e : phases) {
+    phasesArr.push_back(Dict{{"name", e.name},
+                             {"start_ms", e.start / 1000.0},
+                             {"ms", e.dur / 1000.0},
+                             {"rss_before", e.rssBefore},
+                             {"rss_after", e.rssAfter},
+                             {"peak_rss", e.peakRss}});
+  }
+
+  Dict timersDict;
+  for (const auto& t : timers) timersDict[t.first] = t.second;
+
+  // estimated from the data structures, see MemTrack
+  Dict memDict{{"peak_rss", util::getPeakRSS()}};
+  for (size_t i = 0; i < NUM_MEMS; i++) {
+    memDict[MEM_NAMES[i]] = Dict{{"bytes", memUsage(static_cast<Mem>(i))},
+                                 {"peak_bytes", memPeak(static_cast<Mem>(i))}};
+  }
+
+  return {{"counters", counterDict(total)},
+          {"threads", threads},
+          {"timers", timersDict},
+          {"phases", phasesArr},
+          {"memory", memDict}};
+}
+
+// _____________________________________________________________________________
+void util::stats::writeTrace(std::ostream* out) {
+  std::map<size_t, std::vector<size_t>> counters;
+  std::map<size_t, std::vector<Event>> events;
+  collect(&counters, &events);
+
+  util::json::Writer wr(out, 3, false);
+  wr.obj();
+  wr.keyVal("displayTimeUnit", "ms");
+  wr.key("traceEvents");
+  wr.arr();
+
+  size_t end = now();
+
+  for (const auto& tEvs : events) {
+    for (const auto& e : tEvs.second) {
+      Dict ev{{"name", e.name},
+              {"ph", "X"},
+              {"pid", 1},
+              {"tid", tEvs.first},
+              {"ts", size_t(e.start)},
+              {"dur", size_t(e.dur)}};
+
+      if (e.peakRss) {
+        ev["args"] = Dict{{"rss_before", e.rssBefore},
+                          {"rss_after", e.rssAfter},
+                          {"peak_rss", e.peakRss}};
+
+        // memory usage as a counter track
+        wr.val(Dict{{"name", "rss"},
+                    {"ph", "C"},
+                    {"pid", 1},
+                    {"ts", size_t(e.start)},
+                    {"args", Dict{{"bytes", e.rssBefore}}}});
+        wr.val(Dict{{"name", "rss"},
+                    {"ph", "C"},
+                    {"pid", 1},
+                    {"ts", size_t(e.start + e.dur)},
+                    {"args", Dict{{"bytes", e.rssAfter}}}});
+      }
+
+      wr.val(ev);
+    }
+  }
+
+  // final counter values of each thread
+  for (const auto& c : counters) {
+    wr.val(Dict{{"name", "counters"},
+                {"ph", "C"},
+                {"pid", 1},
+                {"tid", c.first},
+                {"ts", end},
+                {"args", counterDict(c.second)}});
+  }
+
+  wr.closeAll();
+}
+
+// _____________________________________________________________________________
+bool util::stats::writeTrace(const std::string& path) {
+  std::ofstream f(path);
+  if (!f.good()) {
+    LOG(ERROR) << "Could not write trace file " << path;
+    return false;
+  }
+  writeTrace(&f);
+  return f.good();
+}
+
+// _____________________________________________________________________________
+util::stats::PeakRss::PeakRss() : _peak(0) {
+  std::lock_guard<std::mutex> lock(peakMut);
+
+  // the peak since the last reset belongs to all running measurements
+  size_t cur = hwm();
+  for (auto p : peaks) p->_peak = std::max(p->_peak, cur);
+
+  // on Linux, writing 5 to clear_refs resets the peak to the current size
+  std::ofstream f("/proc/self/clear_refs");
+  if (f.good()) f << "5";
+
+  peaks.push_back(this);
+}
+
+// _____________________________________________________________________________
+util::stats::PeakRss::~PeakRss() {
+  std::lock_guard<std::mutex> lock(peakMut);
+  peaks.erase(std::find(peaks.begin(), peaks.end(), this));
+}
+
+// _____________________________________________________________________________
+size_t util::stats::PeakRss::get() {
+  std::lock_guard<std::mutex> lock(peakMut);
+  _peak = std::max(_peak, hwm());
+  return _peak;
+}
+
+// _____________________________________________________________________________
+util::stats::Timer::Timer(const char* name, bool mem)
+    : _name(name), _on(ENABLED), _mem(mem), _start(0), _rss(0), _peak(0) {
+  if (!_on) return;
+  if (_mem) {
+    _rss = util::getCurrentRSS();
+    _peak = new PeakRss();
+  }
+  _start = now();
+}
+
+// _____________________________________________________________________________
+util::stats::Timer::~Timer() {
+  if (!_on) return;
+  Event e{_name, _start, now() - _start, 0, 0, 0};
+
+  if (_mem) {
+    e.rssBefore = _rss;
+    e.rssAfter = util::getCurrentRSS();
+    e.peakRss = std::max<size_t>(1, _peak->get());
+    delete _peak;
+  }
+
+  ThreadStats& s = local();
+  std::lock_guard<std::mutex> lock(s.mut);
+  s.events.push_back(e);
+}
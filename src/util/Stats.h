@@ -0,0 +1,197 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef UTIL_STATS_H_
+#define UTIL_STATS_H_
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "util/json/Writer.h"
+
+// hot-path instrumentation, compile with -DUTIL_STATS=0 to remove it
+#ifndef UTIL_STATS
+#define UTIL_STATS 1
+#endif
+
+#define _STATS_CAT2(a, b) a##b
+#define _STATS_CAT(a, b) _STATS_CAT2(a, b)
+
+#if UTIL_STATS
+// count n events of counter c on the calling thread
+#define STATS_COUNT(c, n)                                          \
+  do {                                                             \
+    if (util::stats::ENABLED) util::stats::count(util::stats::c, n); \
+  } while (0)
+// time the enclosing scope
+#define STATS_TIMER(name) \
+  util::stats::Timer _STATS_CAT(_stats_tmr_, __LINE__)(name, false)
+// time the enclosing scope and record the memory usage before and after it
+#define STATS_PHASE(name) \
+  util::stats::Timer _STATS_CAT(_stats_tmr_, __LINE__)(name, true)
+// set the bytes accounted by a MemTrack, bytes is only evaluated if enabled
+#define STATS_MEM(track, bytes)                      \
+  do {                                               \
+    if (util::stats::ENABLED) (track).set(bytes);    \
+  } while (0)
+#else
+#define STATS_COUNT(c, n) do {} while (0)
+#define STATS_TIMER(name) do {} while (0)
+#define STATS_PHASE(name) do {} while (0)
+#define STATS_MEM(track, bytes) do {} while (0)
+#endif
+
+namespace util {
+namespace stats {
+
+enum Counter {
+  SETTLED_NDS,
+  PQ_PUSHES,
+  RELAXATIONS,
+  GRID_QUERIES,
+  SCORER_CALLS,
+  NUM_COUNTERS
+};
+
+// subsystems whose memory usage is accounted
+enum Mem {
+  MEM_GRAPH,
+  MEM_GRID,
+  MEM_GEOM,
+  MEM_ILP,
+  MEM_ORDER_CFG,
+  MEM_DRAWING,
+  MEM_GEO_PENS,
+  NUM_MEMS
+};
+
+// a finished timer
+struct Event {
+  const char* name;
+  // microseconds since the start of the process
+  int64_t start, dur;
+  // resident set size before and after, and the peak resident set size
+  // during a phase (see PeakRss), 0 for plain timers
+  size_t rssBefore, rssAfter, peakRss;
+};
+
+// the counters and events of a single thread. Counters are only written by
+// their thread, and may be read by others at any time.
+struct ThreadStats {
+  ThreadStats();
+  ~ThreadStats();
+
+  size_t tid;
+  std::atomic<size_t> counters[NUM_COUNTERS];
+  std::mutex mut;
+  std::vector<Event> events;
+};
+
+// whether statistics are collected at runtime, see enable()
+extern bool ENABLED;
+
+// start collecting statistics. Should be called before any threads are
+// spawned.
+void enable();
+
+// reset all counters, drop all recorded events and lower the memory peaks
+// to the current usage
+void reset();
+
+// the counters, timers, phases and memory usage of all threads as
+// {"counters": {...}, "timers": {...}, "phases": [...], "memory": {...}}
+util::json::Dict toJson();
+
+// write all recorded events as a Chrome trace-event file, which can be
+// opened in chrome://tracing or Perfetto
+void writeTrace(std::ostream* out);
+
+// write the trace to a file, returns false if it could not be written
+bool writeTrace(const std::string& path);
+
+// microseconds since the start of the process
+int64_t now();
+
+// _____________________________________________________________________________
+inline ThreadStats& local() {
+  static thread_local ThreadStats s;
+  return s;
+}
+
+// _____________________________________________________________________________
+inline void count(Counter c, size_t n) {
+  // no atomic read-modify-write needed, we are the only writer
+  auto& v = local().counters[c];
+  v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// the peak resident set size of the process during the lifetime of the
+// object. On Linux, the peak of the process (VmHWM) is reset when a
+// measurement starts, after it was added to the running measurements, so they
+// may nest and overlap. Where it cannot be reset, this is the peak of the
+// process so far.
+class PeakRss {
+ public:
+  PeakRss();
+  ~PeakRss();
+
+  // the peak since the construction
+  size_t get();
+
+ private:
+  size_t _peak;
+};
+
+// records the time spent in its scope on destruction, with mem also the
+// resident set size before and after and the peak in between
+class Timer {
+ public:
+  Timer(const char* name, bool mem);
+  ~Timer();
+
+ private:
+  const char* _name;
+  bool _on;
+  bool _mem;
+  int64_t _start;
+  size_t _rss;
+  PeakRss* _peak;
+};
+
+// accounts the estimated size of a data structure to a subsystem, until it
+// is destroyed. The current and the peak usage of every subsystem are
+// reported by toJson().
+class MemTrack {
+ public:
+  explicit MemTrack(Mem m) : _m(m), _bytes(0) {}
+  MemTrack(const MemTrack& other) = delete;
+  MemTrack& operator=(const MemTrack& other) = delete;
+  ~MemTrack() {
+    if (_bytes) set(0);
+  }
+
+  // set the current size of the tracked structure
+  void set(size_t bytes);
+
+ private:
+  Mem _m;
+  size_t _bytes;
+};
+
+// the accounted bytes of a subsystem
+size_t memUsage(Mem m);
+
+// the peak of the accounted bytes of a subsystem
+size_t memPeak(Mem m);
+
+// the name of a subsystem in the statistics
+const char* memName(Mem m);
+
+}  // namespace stats
+}  // namespace util
+
+#endif  // UTIL_STATS_H_
@@ -0,0 +1,96 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "util/String.h"
+#include "util/Sweep.h"
+
+using util::sweep::ParamSet;
+
+namespace {
+
+// _____________________________________________________________________________
+void expand(const std::vector<std::vector<std::string>>& alts, size_t i,
+            ParamSet* cur, std::vector<ParamSet>* ret) {
+  if (i == alts.size()) {
+    ret->push_back(*cur);
+    return;
+  }
+
+  for (const auto& a : alts[i]) {
+    cur->push_back(a);
+    expand(alts, i + 1, cur, ret);
+    cur->pop_back();
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::vector<ParamSet> util::sweep::read(std::istream* in) {
+  std::vector<ParamSet> ret;
+  std::string line;
+  size_t lineNum = 0;
+
+  while (std::getline(*in, line)) {
+    lineNum++;
+    line = util::trim(line);
+    if (line.empty() || line[0] == '#') continue;
+
+    // the alternatives of every token of the line
+    std::vector<std::vector<std::string>> alts;
+
+    std::stringstream ss(line);
+    std::string tok;
+    while (ss >> tok) {
+      if (tok.front() == '{' || tok.back() == '}') {
+        if (tok.size() < 2 || tok.front() != '{' || tok.back() != '}') {
+          throw std::runtime_error("Unbalanced braces in parameter set line " +
+                                   std::to_string(lineNum));
+        }
+        alts.push_back(util::split(tok.substr(1, tok.size() - 2), ','));
+        if (alts.back().empty()) alts.back().push_back("");
+      } else {
+        alts.push_back({tok});
+      }
+    }
+
+    ParamSet cur;
+    expand(alts, 0, &cur, &ret);
+  }
+
+  return ret;
+}
+
+// _____________________________________________________________________________
+std::vector<ParamSet> util::sweep::readFile(const std::string& path) {
+  std::ifstream f(path);
+  if (!f.good()) {
+    throw std::runtime_error("Could not read parameter sets from " + path);
+  }
+  return read(&f);
+}
+
+// _____________________________________________________________________________
+std::string util::sweep::toString(const ParamSet& set) {
+  return util::implode(set, " ");
+}
+
+// _____________________________________________________________________________
+void util::sweep::writeStats(const std::vector<ParamSet>& sets,
+                             const std::vector<util::json::Dict>& stats,
+                             std::ostream* out) {
+  for (size_t i = 0; i < sets.size() && i < stats.size(); i++) {
+    util::json::Dict rec = stats[i];
+    rec["set"] = i;
+    rec["params"] = toString(sets[i]);
+
+    util::json::Writer wr(out, 10, false);
+    wr.val(rec);
+    wr.closeAll();
+    (*out) << "\n";
+  }
+  out->flush();
+}
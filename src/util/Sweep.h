@@ -0,0 +1,57 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef UTIL_SWEEP_H_
+#define UTIL_SWEEP_H_
+
+#include <getopt.h>
+#include <istream>
+#include <string>
+#include <vector>
+#include "util/json/Writer.h"
+
+namespace util {
+namespace sweep {
+
+// the command line options of a single parameter set of a sweep
+typedef std::vector<std::string> ParamSet;
+
+// read parameter sets from a stream, one per line, given as command line
+// options (e.g. "-d 30 --no-infer-restrs"). Empty lines and lines starting
+// with # are skipped. A value of the form {a,b,c} expands its line into one
+// set per value, several of them into the cartesian product. Throws
+// std::runtime_error on unbalanced braces.
+std::vector<ParamSet> read(std::istream* in);
+
+// read parameter sets from a file, see read()
+std::vector<ParamSet> readFile(const std::string& path);
+
+// the parameter set as a single string
+std::string toString(const ParamSet& set);
+
+// write one JSON record per line and parameter set to out, holding the index
+// and the options of the set together with its statistics
+void writeStats(const std::vector<ParamSet>& sets,
+                const std::vector<util::json::Dict>& stats, std::ostream* out);
+
+// parse the command line argv, followed by the options of set, into cfg
+// using a config reader. Options of the set override those of the command
+// line. Not thread-safe, as getopt keeps global state.
+template <typename Reader, typename Config>
+void parse(int argc, char** argv, const ParamSet& set, Config* cfg) {
+  std::vector<std::string> args(argv, argv + argc);
+  args.insert(args.end(), set.begin(), set.end());
+
+  std::vector<char*> cargv;
+  for (auto& a : args) cargv.push_back(&a[0]);
+  cargv.push_back(0);
+
+  optind = 0;
+  Reader().read(cfg, args.size(), &cargv[0]);
+}
+
+}  // namespace sweep
+}  // namespace util
+
+#endif  // UTIL_SWEEP_H_
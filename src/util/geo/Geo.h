@@ -1892,35 +1892,6 @@ inline Line<T> densify(const Line<T>& l, double d) {
   return ret;
 }
 
-// _____________________________________________________________________________
-template <typename T>
-inline double frechetDistC(size_t i, size_t j, const Line<T>& p,
-                           const Line<T>& q, std::vector<float>& ca) {
-  // based on Eiter / Mannila
-  // http://www.kr.tuwien.ac.at/staff/eiter/et-archive/cdtr9464.pdf
-
-  if (ca[i * q.size() + j] > -1)
-    return ca[i * q.size() + j];
-  else if (i == 0 && j == 0)
-    ca[i * q.size() + j] = dist(p[0], q[0]);
-  else if (i > 0 && j == 0)
-    ca[i * q.size() + j] =
-        std::max(frechetDistC(i - 1, 0, p, q, ca), dist(p[i], q[0]));
-  else if (i == 0 && j > 0)
-    ca[i * q.size() + j] =
-        std::max(frechetDistC(0, j - 1, p, q, ca), dist(p[0], q[j]));
-  else if (i > 0 && j > 0)
-    ca[i * q.size() + j] =
-        std::max(std::min(std::min(frechetDistC(i - 1, j, p, q, ca),
-                                   frechetDistC(i - 1, j - 1, p, q, ca)),
-                          frechetDistC(i, j - 1, p, q, ca)),
-                 dist(p[i], q[j]));
-  else
-    ca[i * q.size() + j] = std::numeric_limits<float>::infinity();
-
-  return ca[i * q.size() + j];
-}
-
 // _____________________________________________________________________________
 template <typename T>
 inline double frechetDist(const Line<T>& a, const Line<T>& b, double d) {
@@ -1930,10 +1901,25 @@ inline double frechetDist(const Line<T>& a, const Line<T>& b, double d) {
   const auto& p = densify(a, d);
   const auto& q = densify(b, d);
 
-  std::vector<float> ca(p.size() * q.size(), -1.0);
-  double fd = frechetDistC(p.size() - 1, q.size() - 1, p, q, ca);
+  // fill the coupling table row by row, only keeping the last row
+  std::vector<float> prev(q.size()), cur(q.size());
+  for (size_t i = 0; i < p.size(); i++) {
+    for (size_t j = 0; j < q.size(); j++) {
+      float dd = dist(p[i], q[j]);
+      if (i == 0 && j == 0)
+        cur[j] = dd;
+      else if (j == 0)
+        cur[j] = std::max(prev[0], dd);
+      else if (i == 0)
+        cur[j] = std::max(cur[j - 1], dd);
+      else
+        cur[j] = std::max(std::min(std::min(prev[j], prev[j - 1]), cur[j - 1]),
+                          dd);
+    }
+    std::swap(prev, cur);
+  }
 
-  return fd;
+  return prev.back();
 }
 
 // _____________________________________________________________________________
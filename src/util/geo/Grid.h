@@ -8,6 +8,7 @@
 #include <map>
 #include <set>
 #include <vector>
+#include "util/Stats.h"
 #include "util/geo/Geo.h"
 
 namespace util {
@@ -96,6 +97,9 @@ class Grid {
   size_t getXWidth() const;
   size_t getYHeight() const;
 
+  // estimated bytes used by the cells and the value index
+  size_t memUsage() const;
+
   size_t getCellXFromX(double lon) const;
   size_t getCellYFromY(double lat) const;
 
@@ -83,6 +83,8 @@ void Grid<V, G, T>::add(size_t x, size_t y, V val) {
 // _____________________________________________________________________________
 template <typename V, template <typename> class G, typename T>
 void Grid<V, G, T>::get(const Box<T>& box, std::set<V>* s) const {
+  STATS_COUNT(GRID_QUERIES, 1);
+
   size_t swX = getCellXFromX(box.getLowerLeft().getX());
   size_t swY = getCellYFromY(box.getLowerLeft().getY());
 
@@ -225,3 +227,25 @@ template <typename V, template <typename> class G, typename T>
 size_t Grid<V, G, T>::getYHeight() const {
   return _yHeight;
 }
+
+// _____________________________________________________________________________
+template <typename V, template <typename> class G, typename T>
+size_t Grid<V, G, T>::memUsage() const {
+  // a red-black tree node holds 3 pointers and the color besides the value
+  const size_t treeNd = 4 * sizeof(void*);
+
+  size_t ret =
+      _xWidth * (sizeof(std::set<V>*) + _yHeight * sizeof(std::set<V>));
+  for (size_t x = 0; x < _xWidth; x++) {
+    for (size_t y = 0; y < _yHeight; y++) {
+      ret += _grid[x][y].size() * (treeNd + sizeof(V));
+    }
+  }
+
+  for (const auto& i : _index) {
+    ret += treeNd + sizeof(i) +
+           i.second.size() * (treeNd + sizeof(std::pair<size_t, size_t>));
+  }
+
+  return ret + _removed.size() * (treeNd + sizeof(V));
+}
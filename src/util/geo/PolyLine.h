@@ -73,6 +73,9 @@ class PolyLine {
 
   double getLength() const;
 
+  // bytes used by the points
+  size_t memUsage() const;
+
   // return point at dist
   LinePoint<T> getPointAtDist(double dist) const;
 
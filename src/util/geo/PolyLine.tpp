@@ -271,6 +271,12 @@ double PolyLine<T>::getLength() const {
   return len(_line);
 }
 
+// _____________________________________________________________________________
+template <typename T>
+size_t PolyLine<T>::memUsage() const {
+  return _line.capacity() * sizeof(Point<T>);
+}
+
 // _____________________________________________________________________________
 template <typename T>
 PolyLine<T> PolyLine<T>::average(const std::vector<const PolyLine<T>*>& lines,
@@ -50,7 +50,8 @@ void QuadTree<V, T>::insert(int64_t vid, int64_t nid, size_t d) {
 // _____________________________________________________________________________
 template <typename V, typename T>
 void QuadTree<V, T>::split(size_t nid, size_t d) {
-  const auto& box = _nds[nid].bbox;
+  // copy, _nds may be reallocated below
+  const Box<T> box = _nds[nid].bbox;
   T w = (box.getUpperRight().getX() - box.getLowerLeft().getX()) / T(2);
 
   int64_t curEl = _nds[nid].numEls > 0 ? _nds[nid].childs : -1;
@@ -51,7 +51,7 @@ void GeoGraphJsonOutput::printImpl(const util::graph::Graph<N, E>& outG,
   for (util::graph::Node<N, E>* n : outG.getNds()) {
     if (!n->pl().getGeom()) continue;
 
-    json::Dict props{{"id", util::toString(n)},
+    json::Dict props{{"id", util::toString(n->getId())},
                      {"deg", util::toString(n->getDeg())},
                      {"deg_out", util::toString(n->getOutDeg())},
                      {"deg_in", util::toString(n->getInDeg())}};
@@ -71,9 +71,9 @@ void GeoGraphJsonOutput::printImpl(const util::graph::Graph<N, E>& outG,
     for (graph::Edge<N, E>* e : n->getAdjListOut()) {
       // to avoid double output for undirected graphs
       if (e->getFrom() != n) continue;
-      json::Dict props{{"from", util::toString(e->getFrom())},
-                       {"to", util::toString(e->getTo())},
-                       {"id", util::toString(e)}};
+      json::Dict props{{"from", util::toString(e->getFrom()->getId())},
+                       {"to", util::toString(e->getTo()->getId())},
+                       {"id", util::toString(e->getId())}};
 
       auto addProps = e->pl().getAttrs();
       props.insert(addProps.begin(), addProps.end());
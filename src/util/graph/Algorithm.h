@@ -30,13 +30,17 @@ class Algorithm {
     };
   };
 
+  // nodes of a component, in id order
   template <typename N, typename E>
-  static std::vector<std::set<Node<N, E>*> > connectedComponents(
-      const UndirGraph<N, E>& g);
+  using Component = std::set<Node<N, E>*, IdCmp<Node<N, E>>>;
 
   template <typename N, typename E>
-  static std::vector<std::set<Node<N, E>*> > connectedComponents(
-      const UndirGraph<N, E>& g, const EdgeCheckFunc<N, E>& checkFunc);
+  static std::vector<Component<N, E>> connectedComponents(
+      const Graph<N, E>& g);
+
+  template <typename N, typename E>
+  static std::vector<Component<N, E>> connectedComponents(
+      const Graph<N, E>& g, const EdgeCheckFunc<N, E>& checkFunc);
 };
 
 #include "util/graph/Algorithm.tpp"
@@ -4,16 +4,16 @@
 //
 // _____________________________________________________________________________
 template <typename N, typename E>
-std::vector<std::set<Node<N, E>*>> Algorithm::connectedComponents(
-    const UndirGraph<N, E>& g) {
+std::vector<Algorithm::Component<N, E>> Algorithm::connectedComponents(
+    const Graph<N, E>& g) {
   return connectedComponents(g, EdgeCheckFunc<N, E>());
 }
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-std::vector<std::set<Node<N, E>*>> Algorithm::connectedComponents(
-    const UndirGraph<N, E>& g, const EdgeCheckFunc<N, E>& checkFunc) {
-  std::vector<std::set<Node<N, E>*>> ret;
+std::vector<Algorithm::Component<N, E>> Algorithm::connectedComponents(
+    const Graph<N, E>& g, const EdgeCheckFunc<N, E>& checkFunc) {
+  std::vector<Component<N, E>> ret;
   std::set<Node<N, E>*> visited;
 
   for (auto* n : g.getNds()) {
@@ -0,0 +1,74 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef UTIL_GRAPH_ALLOC_H_
+#define UTIL_GRAPH_ALLOC_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace util {
+namespace graph {
+
+// Allocation policies for the nodes and edges of a graph. alloc() constructs
+// a new object, free() destroys a single object and gives its memory back,
+// destroy() only runs the destructor during the teardown of the whole graph.
+
+// allocate every object separately on the heap
+template <typename T>
+class HeapAlloc {
+ public:
+  template <typename... Args>
+  T* alloc(Args&&... args) {
+    return new T(std::forward<Args>(args)...);
+  }
+  void free(T* p) { delete p; }
+  void destroy(T* p) { delete p; }
+  void take(HeapAlloc<T>* other) { (void)other; }
+};
+
+// allocate objects from fixed-size chunks, addresses are stable. Freed
+// objects are recycled, and all chunks are released at once when the pool
+// is destroyed.
+template <typename T>
+class PoolAlloc {
+ public:
+  PoolAlloc();
+  PoolAlloc(const PoolAlloc<T>& other) = delete;
+  PoolAlloc& operator=(const PoolAlloc<T>& other) = delete;
+  ~PoolAlloc();
+
+  template <typename... Args>
+  T* alloc(Args&&... args);
+  void free(T* p);
+  void destroy(T* p);
+
+  // take over the chunks of other, which is left empty
+  void take(PoolAlloc<T>* other);
+
+ private:
+  union Slot {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type obj;
+    Slot* next;
+  };
+
+  static const size_t CHUNK_SIZE = 1024;
+
+  std::vector<Slot*> _chunks;
+
+  // number of used slots in the last chunk
+  size_t _used;
+
+  // freed slots
+  Slot* _free;
+};
+
+#include "util/graph/Alloc.tpp"
+}  // namespace graph
+}  // namespace util
+
+#endif  // UTIL_GRAPH_ALLOC_H_
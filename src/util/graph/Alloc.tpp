@@ -0,0 +1,61 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+// _____________________________________________________________________________
+template <typename T>
+PoolAlloc<T>::PoolAlloc() : _used(CHUNK_SIZE), _free(0) {}
+
+// _____________________________________________________________________________
+template <typename T>
+PoolAlloc<T>::~PoolAlloc() {
+  for (auto c : _chunks) delete[] c;
+}
+
+// _____________________________________________________________________________
+template <typename T>
+template <typename... Args>
+T* PoolAlloc<T>::alloc(Args&&... args) {
+  Slot* s;
+  if (_free) {
+    s = _free;
+    _free = _free->next;
+  } else {
+    if (_used == CHUNK_SIZE) {
+      _chunks.push_back(new Slot[CHUNK_SIZE]);
+      _used = 0;
+    }
+    s = _chunks.back() + _used++;
+  }
+
+  return new (&s->obj) T(std::forward<Args>(args)...);
+}
+
+// _____________________________________________________________________________
+template <typename T>
+void PoolAlloc<T>::free(T* p) {
+  p->~T();
+  Slot* s = reinterpret_cast<Slot*>(p);
+  s->next = _free;
+  _free = s;
+}
+
+// _____________________________________________________________________________
+template <typename T>
+void PoolAlloc<T>::destroy(T* p) {
+  p->~T();
+}
+
+// _____________________________________________________________________________
+template <typename T>
+void PoolAlloc<T>::take(PoolAlloc<T>* other) {
+  // the last chunk of other may be partially used, so put it in front to
+  // keep appending to our own last chunk
+  _chunks.insert(_chunks.begin(), other->_chunks.begin(),
+                 other->_chunks.end());
+  other->_chunks.clear();
+  other->_used = CHUNK_SIZE;
+
+  // free slots of other are simply dropped, they are released with the chunks
+  other->_free = 0;
+}
@@ -11,6 +11,7 @@
 #include <set>
 #include <algorithm>
 #include <unordered_map>
+#include "util/Stats.h"
 #include "util/graph/Edge.h"
 #include "util/graph/Graph.h"
 #include "util/graph/Node.h"
@@ -118,8 +119,6 @@ class BiDijkstra : public ShortestPath<BiDijkstra> {
   static void buildPath(Node<N, E>* curN, Settled<N, E, C>& settledFwd,
                         Settled<N, E, C>& settledBwd, NList<N, E>* resNodes,
                         EList<N, E>* resEdges);
-
-  static size_t ITERS;
 };
 
 #include "util/graph/BiDijkstra.tpp"
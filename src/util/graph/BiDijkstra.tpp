@@ -30,11 +30,13 @@ C BiDijkstra::shortestPathImpl(const std::set<Node<N, E>*> from,
 
   // starter for forward search
   for (auto n : from) pqFwd.emplace(n);
+  STATS_COUNT(PQ_PUSHES, from.size());
 
   auto l = costFunc.inf();
 
   // starter for backward search
   for (auto n : to) pqBwd.emplace(n);
+  STATS_COUNT(PQ_PUSHES, to.size());
 
   RouteNode<N, E, C> cur;
 
@@ -62,7 +64,7 @@ C BiDijkstra::shortestPathImpl(const std::set<Node<N, E>*> from,
       }
     }
 
-    BiDijkstra::ITERS++;
+    STATS_COUNT(SETTLED_NDS, 1);
 
     if (pqFwd.top() < pqBwd.top()) {
       cur = pqBwd.top();
@@ -139,7 +141,7 @@ std::unordered_map<Node<N, E>*, C> BiDijkstra::shortestPathImpl(
   // pq.pop();
   // continue;
   // }
-  // BiDijkstra::ITERS++;
+  // STATS_COUNT(SETTLED_NDS, 1);
 
   // cur = pq.top();
   // pq.pop();
@@ -173,6 +175,7 @@ void BiDijkstra::relax(RouteNode<N, E, C>& cur, const std::set<Node<N, E>*>& to,
                        const util::graph::HeurFunc<N, E, C>& heurFunc,
                        PQ<N, E, C>& pq) {
   for (auto edge : cur.n->getAdjListOut()) {
+    STATS_COUNT(RELAXATIONS, 1);
     C newC = costFunc(cur.n, edge, edge->getOtherNd(cur.n));
     newC = cur.d + newC;
     if (costFunc.inf() <= newC) continue;
@@ -180,6 +183,7 @@ void BiDijkstra::relax(RouteNode<N, E, C>& cur, const std::set<Node<N, E>*>& to,
     // addition done here to avoid it in the PQ
     const C& newH = newC + heurFunc(edge->getOtherNd(cur.n), to);
 
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.emplace(edge->getOtherNd(cur.n), cur.n, newC, newH);
   }
 }
@@ -194,6 +198,7 @@ C BiDijkstra::relaxFwd(RouteNode<N, E, C>& cur, const std::set<Node<N, E>*>& to,
   UNUSED(heurFunc);
   C ret = costFunc.inf();
   for (auto edge : cur.n->getAdjListOut()) {
+    STATS_COUNT(RELAXATIONS, 1);
     C newC = costFunc(cur.n, edge, edge->getOtherNd(cur.n));
     newC = cur.d + newC;
     if (costFunc.inf() <= newC) continue;
@@ -210,6 +215,7 @@ C BiDijkstra::relaxFwd(RouteNode<N, E, C>& cur, const std::set<Node<N, E>*>& to,
       if (bwdCost < ret) ret = bwdCost;
     }
 
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.emplace(edge->getOtherNd(cur.n), cur.n, newC, newH);
   }
 
@@ -227,6 +233,7 @@ C BiDijkstra::relaxBwd(const std::set<Node<N, E>*>& froms,
   UNUSED(heurFunc);
   C ret = costFunc.inf();
   for (auto edge : cur.n->getAdjListIn()) {
+    STATS_COUNT(RELAXATIONS, 1);
     C newC = costFunc(edge->getOtherNd(cur.n), edge, cur.n);
     newC = cur.d + newC;
     if (costFunc.inf() <= newC) continue;
@@ -243,6 +250,7 @@ C BiDijkstra::relaxBwd(const std::set<Node<N, E>*>& froms,
       if (fwdCost < ret) ret = fwdCost;
     }
 
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.emplace(edge->getOtherNd(cur.n), cur.n, newC, newH);
   }
 
@@ -10,6 +10,7 @@
 #include <queue>
 #include <set>
 #include <unordered_map>
+#include "util/Stats.h"
 #include "util/graph/Edge.h"
 #include "util/graph/Graph.h"
 #include "util/graph/Node.h"
@@ -105,8 +106,6 @@ class Dijkstra : public ShortestPath<Dijkstra> {
   template <typename N, typename E, typename C>
   static void buildPath(Node<N, E>* curN, Settled<N, E, C>& settled,
                         NList<N, E>* resNodes, EList<N, E>* resEdges);
-
-  static size_t ITERS;
 };
 
 #include "util/graph/Dijkstra.tpp"
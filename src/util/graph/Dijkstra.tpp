@@ -14,6 +14,7 @@ C Dijkstra::shortestPathImpl(Node<N, E>* from, const std::set<Node<N, E>*>& to,
   PQ<N, E, C> pq;
   bool found = false;
 
+  STATS_COUNT(PQ_PUSHES, 1);
   pq.emplace(from);
   RouteNode<N, E, C> cur;
 
@@ -23,7 +24,7 @@ C Dijkstra::shortestPathImpl(Node<N, E>* from, const std::set<Node<N, E>*>& to,
       pq.pop();
       continue;
     }
-    Dijkstra::ITERS++;
+    STATS_COUNT(SETTLED_NDS, 1);
 
     cur = pq.top();
     pq.pop();
@@ -58,6 +59,7 @@ C Dijkstra::shortestPathImpl(const std::set<Node<N, E>*> from,
 
   // put all nodes in from onto PQ
   for (auto n : from) pq.emplace(n);
+  STATS_COUNT(PQ_PUSHES, from.size());
   RouteNode<N, E, C> cur;
 
   while (!pq.empty()) {
@@ -70,7 +72,7 @@ C Dijkstra::shortestPathImpl(const std::set<Node<N, E>*> from,
         continue;
       }
     }
-    Dijkstra::ITERS++;
+    STATS_COUNT(SETTLED_NDS, 1);
 
     cur = pq.top();
     pq.pop();
@@ -112,6 +114,7 @@ std::unordered_map<Node<N, E>*, C> Dijkstra::shortestPathImpl(
 
   size_t found = 0;
 
+  STATS_COUNT(PQ_PUSHES, 1);
   pq.emplace(from);
   RouteNode<N, E, C> cur;
 
@@ -125,7 +128,7 @@ std::unordered_map<Node<N, E>*, C> Dijkstra::shortestPathImpl(
         continue;
       }
     }
-    Dijkstra::ITERS++;
+    STATS_COUNT(SETTLED_NDS, 1);
 
     cur = pq.top();
     pq.pop();
@@ -159,6 +162,7 @@ void Dijkstra::relax(RouteNode<N, E, C>& cur, const std::set<Node<N, E>*>& to,
                      const util::graph::HeurFunc<N, E, C>& heurFunc,
                      PQ<N, E, C>& pq) {
   for (auto edge : cur.n->getAdjListOut()) {
+    STATS_COUNT(RELAXATIONS, 1);
     C newC = costFunc(cur.n, edge, edge->getOtherNd(cur.n));
     newC = cur.d + newC;
     if (newC < cur.d) continue; // cost overflow!
@@ -172,6 +176,7 @@ void Dijkstra::relax(RouteNode<N, E, C>& cur, const std::set<Node<N, E>*>& to,
 
     if (newH < newC) continue;  // cost overflow!
 
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.emplace(edge->getOtherNd(cur.n), cur.n, newC, newH);
   }
 }
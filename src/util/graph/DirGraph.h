@@ -8,6 +8,7 @@
 #include <set>
 #include <string>
 
+#include "util/graph/Alloc.h"
 #include "util/graph/Graph.h"
 #include "util/graph/Edge.h"
 #include "util/graph/DirNode.h"
@@ -18,18 +19,35 @@ namespace graph {
 template <typename N, typename E>
 using UndirEdge = Edge<N, E>;
 
-template <typename N, typename E>
+// A is the allocation policy for nodes and edges, see util/graph/Alloc.h
+template <typename N, typename E, template <typename> class A = HeapAlloc>
 class DirGraph : public Graph<N, E> {
  public:
+  explicit DirGraph();
+  DirGraph(const DirGraph& other) = delete;
+  DirGraph& operator=(const DirGraph& other) = delete;
+  DirGraph(DirGraph&& other);
+  DirGraph& operator=(DirGraph&& other);
+  virtual ~DirGraph();
+
   using Graph<N, E>::addEdg;
 
   Node<N, E>* addNd();
+  // takes ownership of n, which must have been allocated with new
   Node<N, E>* addNd(DirNode<N, E>* n);
   Node<N, E>* addNd(const N& pl);
   Edge<N, E>* addEdg(Node<N, E>* from, Node<N, E>* to, const E& p);
+  Edge<N, E>* addEdg(Node<N, E>* from, Node<N, E>* to, E&& p);
 
   virtual Node<N, E>* mergeNds(Node<N, E>* a, Node<N, E>* b);
 
+ protected:
+  void freeNd(Node<N, E>* n);
+  void freeEdg(Edge<N, E>* e);
+
+ private:
+  A<DirNode<N, E>> _ndAlloc;
+  A<Edge<N, E>> _edgAlloc;
 };
 
 #include "util/graph/DirGraph.tpp"
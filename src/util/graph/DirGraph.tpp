@@ -3,31 +3,90 @@
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Node<N, E>* DirGraph<N, E>::addNd(const N& pl) {
-  return addNd(new DirNode<N, E>(pl));
+template <typename N, typename E, template <typename> class A>
+DirGraph<N, E, A>::DirGraph() {}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+DirGraph<N, E, A>::DirGraph(DirGraph&& other) {
+  *this = std::move(other);
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+DirGraph<N, E, A>& DirGraph<N, E, A>::operator=(DirGraph&& other) {
+  // our current nodes and edges are not freed here, as references to them
+  // may still be held elsewhere
+  Graph<N, E>::_nodes = std::move(other._nodes);
+  Graph<N, E>::_nextNdId = other._nextNdId;
+  Graph<N, E>::_nextEdgId = other._nextEdgId;
+  other._nodes.clear();
+  _ndAlloc.take(&other._ndAlloc);
+  _edgAlloc.take(&other._edgAlloc);
+  return *this;
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+DirGraph<N, E, A>::~DirGraph() {
+  // bulk teardown, adjacency lists don't have to be updated here
+  for (auto n : Graph<N, E>::_nodes) {
+    for (auto e : n->getAdjListOut()) _edgAlloc.destroy(e);
+  }
+
+  for (auto n : Graph<N, E>::_nodes)
+    _ndAlloc.destroy(static_cast<DirNode<N, E>*>(n));
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+Node<N, E>* DirGraph<N, E, A>::addNd(const N& pl) {
+  auto n = _ndAlloc.alloc(pl);
+  n->setId(Graph<N, E>::_nextNdId++);
+  return *Graph<N, E>::_nodes.insert(n).first;
 }
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Node<N, E>* DirGraph<N, E>::addNd() {
-  return addNd(new DirNode<N, E>());
+template <typename N, typename E, template <typename> class A>
+Node<N, E>* DirGraph<N, E, A>::addNd() {
+  auto n = _ndAlloc.alloc();
+  n->setId(Graph<N, E>::_nextNdId++);
+  return *Graph<N, E>::_nodes.insert(n).first;
 }
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Node<N, E>* DirGraph<N, E>::addNd(DirNode<N, E>* n) {
+template <typename N, typename E, template <typename> class A>
+Node<N, E>* DirGraph<N, E, A>::addNd(DirNode<N, E>* n) {
+  static_assert(
+      std::is_same<A<DirNode<N, E>>, HeapAlloc<DirNode<N, E>>>::value,
+      "Only heap-allocated graphs can take ownership of nodes");
   auto ins = Graph<N, E>::_nodes.insert(n);
+  if (ins.second) n->setId(Graph<N, E>::_nextNdId++);
   return *ins.first;
 }
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Edge<N, E>* DirGraph<N, E>::addEdg(Node<N, E>* from, Node<N, E>* to,
-                                    const E& p) {
+template <typename N, typename E, template <typename> class A>
+Edge<N, E>* DirGraph<N, E, A>::addEdg(Node<N, E>* from, Node<N, E>* to,
+                                        const E& p) {
+  Edge<N, E>* e = Graph<N, E>::getEdg(from, to);
+  if (!e) {
+    e = _edgAlloc.alloc(from, to, p);
+    e->setId(Graph<N, E>::_nextEdgId++);
+    from->addEdge(e);
+    to->addEdge(e);
+  }
+  return e;
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+Edge<N, E>* DirGraph<N, E, A>::addEdg(Node<N, E>* from, Node<N, E>* to,
+                                        E&& p) {
   Edge<N, E>* e = Graph<N, E>::getEdg(from, to);
   if (!e) {
-    e = new Edge<N, E>(from, to, p);
+    e = _edgAlloc.alloc(from, to, std::move(p));
+    e->setId(Graph<N, E>::_nextEdgId++);
     from->addEdge(e);
     to->addEdge(e);
   }
@@ -35,8 +94,8 @@ Edge<N, E>* DirGraph<N, E>::addEdg(Node<N, E>* from, Node<N, E>* to,
 }
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Node<N, E>* DirGraph<N, E>::mergeNds(Node<N, E>* a, Node<N, E>* b) {
+template <typename N, typename E, template <typename> class A>
+Node<N, E>* DirGraph<N, E, A>::mergeNds(Node<N, E>* a, Node<N, E>* b) {
   for (auto e : a->getAdjListOut()) {
     if (e->getTo() != b) {
       addEdg(b, e->getTo(), e->pl());
@@ -49,7 +108,33 @@ Node<N, E>* DirGraph<N, E>::mergeNds(Node<N, E>* a, Node<N, E>* b) {
     }
   }
 
-  DirGraph<N, E>::delNd(a);
+  DirGraph<N, E, A>::delNd(a);
 
   return b;
 }
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+void DirGraph<N, E, A>::freeNd(Node<N, E>* n) {
+  // self edges are in both lists, skip them here and free them below
+  auto in = n->getAdjListIn();
+  for (auto e : in) {
+    if (e->getFrom() == n) continue;
+    e->getFrom()->removeEdge(e);
+    freeEdg(e);
+  }
+
+  auto out = n->getAdjListOut();
+  for (auto e : out) {
+    if (e->getTo() != n) e->getTo()->removeEdge(e);
+    freeEdg(e);
+  }
+
+  _ndAlloc.free(static_cast<DirNode<N, E>*>(n));
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+void DirGraph<N, E, A>::freeEdg(Edge<N, E>* e) {
+  _edgAlloc.free(e);
+}
@@ -19,6 +19,7 @@ class DirNode : public Node<N, E> {
  public:
   DirNode();
   DirNode(const N& pl);
+  // adjacent edges are freed by the owning graph
   ~DirNode();
 
   const std::vector<Edge<N, E>*>& getAdjList() const;
@@ -42,10 +43,14 @@ class DirNode : public Node<N, E> {
   N& pl();
   const N& pl() const;
 
+  size_t getId() const;
+  void setId(size_t id);
+
  private:
   std::vector<Edge<N, E>*> _adjListIn;
   std::vector<Edge<N, E>*> _adjListOut;
   N _pl;
+  size_t _id;
 
   bool adjInContains(const Edge<N, E>* e) const;
   bool adjOutContains(const Edge<N, E>* e) const;
@@ -4,45 +4,15 @@
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-DirNode<N, E>::DirNode() : _pl() {}
+DirNode<N, E>::DirNode() : _pl(), _id(0) {}
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-DirNode<N, E>::DirNode(const N& pl) : _pl(pl) {}
+DirNode<N, E>::DirNode(const N& pl) : _pl(pl), _id(0) {}
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-DirNode<N, E>::~DirNode() {
-  // delete self edges
-  for (auto e = _adjListOut.begin(); e != _adjListOut.end();) {
-    Edge<N, E>* eP = *e;
-    if (eP->getTo() == this) {
-      _adjListIn.erase(std::find(_adjListIn.begin(), _adjListIn.end(), eP));
-      e = _adjListOut.erase(e);
-      delete eP;
-    } else {
-      e++;
-    }
-  }
-
-  for (auto e = _adjListOut.begin(); e != _adjListOut.end(); e++) {
-    Edge<N, E>* eP = *e;
-
-    if (eP->getTo() != this) {
-      eP->getTo()->removeEdge(eP);
-      delete eP;
-    }
-  }
-
-  for (auto e = _adjListIn.begin(); e != _adjListIn.end(); e++) {
-    Edge<N, E>* eP = *e;
-
-    if (eP->getFrom() != this) {
-      eP->getFrom()->removeEdge(eP);
-      delete eP;
-    }
-  }
-}
+DirNode<N, E>::~DirNode() {}
 
 // _____________________________________________________________________________
 template <typename N, typename E>
@@ -155,3 +125,15 @@ bool DirNode<N, E>::adjOutContains(const Edge<N, E>* e) const {
     if (_adjListOut[i] == e) return true;
   return false;
 }
+
+// _____________________________________________________________________________
+template <typename N, typename E>
+size_t DirNode<N, E>::getId() const {
+  return _id;
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E>
+void DirNode<N, E>::setId(size_t id) {
+  _id = id;
+}
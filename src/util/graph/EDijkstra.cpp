@@ -1,7 +0,0 @@
-// Copyright 2017, University of Freiburg,
-// Chair of Algorithms and Data Structures.
-// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
-
-#include "util/graph/EDijkstra.h"
-
-size_t util::graph::EDijkstra::ITERS = 0;
@@ -10,6 +10,7 @@
 #include <set>
 #include <unordered_map>
 #include "util/PriorityQueue.h"
+#include "util/Stats.h"
 #include "util/graph/Edge.h"
 #include "util/graph/Graph.h"
 #include "util/graph/Node.h"
@@ -229,8 +230,6 @@ class EDijkstra : public ShortestPath<EDijkstra> {
   static void relaxInv(RouteEdge<N, E, C>& cur,
                        const util::graph::CostFunc<N, E, C>& costFunc,
                        PQ<N, E, C>& pq);
-
-  static size_t ITERS;
 };
 
 #include "util/graph/EDijkstra.tpp"
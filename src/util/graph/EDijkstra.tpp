@@ -77,8 +77,17 @@ C EDijkstra::shortestPathImpl(const std::set<Edge<N, E>*>& from,
                               EList<N, E>* resEdges, NList<N, E>* resNodes) {
   if (from.size() == 0 || to.size() == 0) return costFunc.inf();
 
-  Settled<N, E, C> settled;
-  PQ<N, E, C> pq;
+  // reuse the search space of the last query on this thread, which keeps its
+  // buckets allocated. Start with a fresh one if the last query used only a
+  // small part of it, as clearing takes time linear in the bucket count.
+  static thread_local Settled<N, E, C> settled;
+  static thread_local PQ<N, E, C> pq;
+  if (settled.bucket_count() > 8 * settled.size() + 1024) {
+    Settled<N, E, C>().swap(settled);
+  } else {
+    settled.clear();
+  }
+  pq.clear();
   bool found = false;
 
   // at the beginning, put all edges on the priority queue,
@@ -86,6 +95,7 @@ C EDijkstra::shortestPathImpl(const std::set<Edge<N, E>*>& from,
   for (auto e : from) {
     C c = costFunc(0, 0, e);
     C h = heurFunc(e, to);
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.push(c + h, {e, (Edge<N, E>*)0, (Node<N, E>*)0, c});
   }
 
@@ -101,7 +111,7 @@ C EDijkstra::shortestPathImpl(const std::set<Edge<N, E>*>& from,
         continue;
       }
     }
-    EDijkstra::ITERS++;
+    STATS_COUNT(SETTLED_NDS, 1);
 
     cur = pq.topVal();
     pq.pop();
@@ -136,6 +146,7 @@ std::unordered_map<Edge<N, E>*, C> EDijkstra::shortestPathImpl(
   std::set<Edge<N, E>*> to;
 
   for (auto e : from) {
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.push(C(), {e, (Edge<N, E>*)0, (Node<N, E>*)0, costFunc(0, 0, e)});
   }
 
@@ -150,7 +161,7 @@ std::unordered_map<Edge<N, E>*, C> EDijkstra::shortestPathImpl(
         continue;
       }
     }
-    EDijkstra::ITERS++;
+    STATS_COUNT(SETTLED_NDS, 1);
 
     cur = pq.topVal();
     pq.pop();
@@ -190,6 +201,7 @@ std::unordered_map<Edge<N, E>*, C> EDijkstra::shortestPathImpl(
 
   C c = costFunc(0, 0, from);
   C h = heurFunc(from, to);
+  STATS_COUNT(PQ_PUSHES, 1);
   pq.push(c + h, {from, (Edge<N, E>*)0, (Node<N, E>*)0, c});
 
   RouteEdge<N, E, C> cur;
@@ -204,7 +216,7 @@ std::unordered_map<Edge<N, E>*, C> EDijkstra::shortestPathImpl(
         continue;
       }
     }
-    EDijkstra::ITERS++;
+    STATS_COUNT(SETTLED_NDS, 1);
 
     cur = pq.topVal();
     pq.pop();
@@ -257,6 +269,7 @@ std::unordered_map<Edge<N, E>*, C> EDijkstra::shortestPathImpl(
   for (auto e : from) {
     C iCost = initCosts.find(e)->second;
     assert(iCost + heurFunc(e, to) >= iCost);
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.push(iCost + heurFunc(e, to),
             {e, (Edge<N, E>*)0, (Node<N, E>*)0, iCost});
   }
@@ -274,7 +287,7 @@ std::unordered_map<Edge<N, E>*, C> EDijkstra::shortestPathImpl(
         continue;
       }
     }
-    EDijkstra::ITERS++;
+    STATS_COUNT(SETTLED_NDS, 1);
 
     cur = pq.topVal();
     pq.pop();
@@ -329,6 +342,7 @@ EDijkstra::shortestPathImpl(const std::set<Edge<N, E>*>& from,
   for (auto e : from) {
     C iCost = initCosts.find(e)->second;
     assert(iCost + heurFunc(e, to) >= iCost);
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.push(iCost + heurFunc(e, to), {e, e, iCost});
   }
 
@@ -345,7 +359,7 @@ EDijkstra::shortestPathImpl(const std::set<Edge<N, E>*>& from,
         continue;
       }
     }
-    EDijkstra::ITERS++;
+    STATS_COUNT(SETTLED_NDS, 1);
 
     cur = pq.topVal();
     pq.pop();
@@ -372,12 +386,14 @@ void EDijkstra::relaxInv(RouteEdge<N, E, C>& cur,
   // handling undirected graph makes no sense here
 
   for (const auto edge : cur.e->getFrom()->getAdjListIn()) {
+    STATS_COUNT(RELAXATIONS, 1);
     if (edge == cur.e) continue;
     C newC = costFunc(edge, cur.e->getFrom(), cur.e);
     newC = cur.d + newC;
     if (costFunc.inf() <= newC) continue;
     if (newC < cur.d) continue;  // cost overflow!
 
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.push(C(), {edge, cur.e, cur.e->getFrom(), newC});
   }
 }
@@ -392,6 +408,7 @@ void EDijkstra::relaxInitNoResEdgs(
       cur.e->getFrom() != cur.e->getTo()) {
     // for undirected graphs
     for (const auto edge : cur.e->getFrom()->getAdjListOut()) {
+      STATS_COUNT(RELAXATIONS, 1);
       if (edge == cur.e) continue;
       C newC = costFunc(cur.e, cur.e->getFrom(), edge);
       C newDwi = cur.dwi + newC;
@@ -410,11 +427,13 @@ void EDijkstra::relaxInitNoResEdgs(
       const C& newH = newC + h;
       if (newH < newC) continue;  // cost overflow!
 
+      STATS_COUNT(PQ_PUSHES, 1);
       pq.push(newH, {edge, cur.parent, newC, newDwi});
     }
   }
 
   for (const auto edge : cur.e->getTo()->getAdjListOut()) {
+    STATS_COUNT(RELAXATIONS, 1);
     if (edge == cur.e) continue;
     C newC = costFunc(cur.e, cur.e->getTo(), edge);
     C newDwi = cur.dwi + newC;
@@ -432,6 +451,7 @@ void EDijkstra::relaxInitNoResEdgs(
     const C& newH = newC + h;
     if (newH < newC) continue;  // cost overflow!
 
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.push(newH, {edge, cur.parent, newC, newDwi});
   }
 }
@@ -447,6 +467,7 @@ void EDijkstra::relaxInit(RouteEdgeInit<N, E, C>& cur,
       cur.e->getFrom() != cur.e->getTo()) {
     // for undirected graphs
     for (const auto edge : cur.e->getFrom()->getAdjListOut()) {
+      STATS_COUNT(RELAXATIONS, 1);
       if (edge == cur.e) continue;
       C newC = costFunc(cur.e, cur.e->getFrom(), edge);
       C newDwi = cur.dwi + newC;
@@ -465,11 +486,13 @@ void EDijkstra::relaxInit(RouteEdgeInit<N, E, C>& cur,
       const C& newH = newC + h;
       if (newH < newC) continue;  // cost overflow!
 
+      STATS_COUNT(PQ_PUSHES, 1);
       pq.push(newH, {edge, cur.e, cur.e->getFrom(), newC, newDwi});
     }
   }
 
   for (const auto edge : cur.e->getTo()->getAdjListOut()) {
+    STATS_COUNT(RELAXATIONS, 1);
     if (edge == cur.e) continue;
     C newC = costFunc(cur.e, cur.e->getTo(), edge);
     C newDwi = cur.dwi + newC;
@@ -487,6 +510,7 @@ void EDijkstra::relaxInit(RouteEdgeInit<N, E, C>& cur,
     const C& newH = newC + h;
     if (newH < newC) continue;  // cost overflow!
 
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.push(newH, {edge, cur.e, cur.e->getTo(), newC, newDwi});
   }
 }
@@ -501,6 +525,7 @@ void EDijkstra::relax(RouteEdge<N, E, C>& cur, const std::set<Edge<N, E>*>& to,
       cur.e->getFrom() != cur.e->getTo()) {
     // for undirected graphs
     for (const auto edge : cur.e->getFrom()->getAdjListOut()) {
+      STATS_COUNT(RELAXATIONS, 1);
       if (edge == cur.e) continue;
       C newC = costFunc(cur.e, cur.e->getFrom(), edge);
       if (costFunc.inf() <= newC) continue;
@@ -513,11 +538,13 @@ void EDijkstra::relax(RouteEdge<N, E, C>& cur, const std::set<Edge<N, E>*>& to,
       const C& newH = newC + h;
       if (newH < newC) continue;  // cost overflow!
 
+      STATS_COUNT(PQ_PUSHES, 1);
       pq.push(newH, {edge, cur.e, cur.e->getFrom(), newC});
     }
   }
 
   for (const auto edge : cur.e->getTo()->getAdjListOut()) {
+    STATS_COUNT(RELAXATIONS, 1);
     if (edge == cur.e) continue;
     C newC = costFunc(cur.e, cur.e->getTo(), edge);
     if (costFunc.inf() <= newC) continue;
@@ -530,6 +557,7 @@ void EDijkstra::relax(RouteEdge<N, E, C>& cur, const std::set<Edge<N, E>*>& to,
     const C& newH = newC + h;
     if (newH < newC) continue;  // cost overflow!
 
+    STATS_COUNT(PQ_PUSHES, 1);
     pq.push(newH, {edge, cur.e, cur.e->getTo(), newC});
   }
 }
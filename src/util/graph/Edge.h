@@ -5,6 +5,7 @@
 #ifndef UTIL_GRAPH_EDGE_H_
 #define UTIL_GRAPH_EDGE_H_
 
+#include <utility>
 #include <vector>
 #include "util/graph/Node.h"
 
@@ -15,6 +16,7 @@ template <typename N, typename E>
 class Edge {
  public:
   Edge(Node<N, E>* from, Node<N, E>* to, const E& pl);
+  Edge(Node<N, E>* from, Node<N, E>* to, E&& pl);
 
   Node<N, E>* getFrom() const;
   Node<N, E>* getTo() const;
@@ -24,10 +26,15 @@ class Edge {
   E& pl();
   const E& pl() const;
 
+  // stable id, unique within the owning graph
+  size_t getId() const;
+  void setId(size_t id);
+
  private:
   Node<N, E>* _from;
   Node<N, E>* _to;
   E _pl;
+  size_t _id;
 };
 
 #include "util/graph/Edge.tpp"
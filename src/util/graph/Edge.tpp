@@ -5,7 +5,14 @@
 // _____________________________________________________________________________
 template <typename N, typename E>
 Edge<N, E>::Edge(Node<N, E>* from, Node<N, E>* to, const E& pl)
- : _from(from), _to(to), _pl(pl) {
+ : _from(from), _to(to), _pl(pl), _id(0) {
+
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E>
+Edge<N, E>::Edge(Node<N, E>* from, Node<N, E>* to, E&& pl)
+ : _from(from), _to(to), _pl(std::move(pl)), _id(0) {
 
 }
 
@@ -39,3 +46,15 @@ template <typename N, typename E>
 const E& Edge<N, E>::pl() const {
   return _pl;
 }
+
+// _____________________________________________________________________________
+template <typename N, typename E>
+size_t Edge<N, E>::getId() const {
+  return _id;
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E>
+void Edge<N, E>::setId(size_t id) {
+  _id = id;
+}
@@ -12,34 +12,52 @@
 
 #include "util/graph/Edge.h"
 #include "util/graph/Node.h"
+#include "util/graph/OrderedSet.h"
 
 namespace util {
 namespace graph {
 
+template <typename N, typename E>
+using NodeSet = OrderedSet<Node<N, E>*>;
+
 template <typename N, typename E>
 class Graph {
  public:
+  Graph();
   virtual ~Graph();
   virtual Node<N, E>* addNd() = 0;
   virtual Node<N, E>* addNd(const N& pl) = 0;
   Edge<N, E>* addEdg(Node<N, E>* from, Node<N, E>* to);
   virtual Edge<N, E>* addEdg(Node<N, E>* from, Node<N, E>* to, const E& p) = 0;
+  virtual Edge<N, E>* addEdg(Node<N, E>* from, Node<N, E>* to, E&& p) = 0;
   Edge<N, E>* getEdg(Node<N, E>* from, Node<N, E>* to);
   const Edge<N, E>* getEdg(const Node<N, E>* from, const Node<N, E>* to) const;
 
   virtual Node<N, E>* mergeNds(Node<N, E>* a, Node<N, E>* b) = 0;
 
-  const std::set<Node<N, E>*>& getNds() const;
+  // nodes in insertion order
+  const NodeSet<N, E>& getNds() const;
 
   static Node<N, E>* sharedNode(const Edge<N, E>* a, const Edge<N, E>* b);
 
-  typename std::set<Node<N, E>*>::iterator delNd(Node<N, E>* n);
-  typename std::set<Node<N, E>*>::iterator delNd(
-      typename std::set<Node<N, E>*>::iterator i);
+  typename NodeSet<N, E>::iterator delNd(Node<N, E>* n);
+  typename NodeSet<N, E>::iterator delNd(
+      typename NodeSet<N, E>::iterator i);
   void delEdg(Node<N, E>* from, Node<N, E>* to);
 
+  // estimated bytes used by the nodes, edges and adjacency lists, without
+  // memory owned by the payloads
+  size_t memUsage() const;
+
  protected:
-  std::set<Node<N, E>*> _nodes;
+  NodeSet<N, E> _nodes;
+
+  // next node and edge ids
+  size_t _nextNdId, _nextEdgId;
+
+  // free a single node together with its adjacent edges
+  virtual void freeNd(Node<N, E>* n) = 0;
+  virtual void freeEdg(Edge<N, E>* e) = 0;
 };
 
 #include "util/graph/Graph.tpp"
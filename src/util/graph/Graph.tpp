@@ -4,9 +4,11 @@
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-Graph<N, E>::~Graph() {
-  for (auto n : _nodes) delete n;
-}
+Graph<N, E>::Graph() : _nextNdId(0), _nextEdgId(0) {}
+
+// _____________________________________________________________________________
+template <typename N, typename E>
+Graph<N, E>::~Graph() {}
 
 // _____________________________________________________________________________
 template <typename N, typename E>
@@ -16,21 +18,21 @@ Edge<N, E>* Graph<N, E>::addEdg(Node<N, E>* from, Node<N, E>* to) {
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-const std::set<Node<N, E>*>& Graph<N, E>::getNds() const {
+const NodeSet<N, E>& Graph<N, E>::getNds() const {
   return _nodes;
 }
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-typename std::set<Node<N, E>*>::iterator Graph<N, E>::delNd(Node<N, E>* n) {
+typename NodeSet<N, E>::iterator Graph<N, E>::delNd(Node<N, E>* n) {
   return delNd(_nodes.find(n));
 }
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-typename std::set<Node<N, E>*>::iterator Graph<N, E>::delNd(
-    typename std::set<Node<N, E>*>::iterator i) {
-  delete *i;
+typename NodeSet<N, E>::iterator Graph<N, E>::delNd(
+    typename NodeSet<N, E>::iterator i) {
+  freeNd(*i);
   return _nodes.erase(i);
 }
 
@@ -45,7 +47,7 @@ void Graph<N, E>::delEdg(Node<N, E>* from, Node<N, E>* to) {
 
   assert(!getEdg(from, to));
 
-  delete toDel;
+  freeEdg(toDel);
 }
 
 // _____________________________________________________________________________
@@ -78,3 +80,19 @@ const Edge<N, E>* Graph<N, E>::getEdg(const Node<N, E>* from,
 
   return 0;
 }
+
+// _____________________________________________________________________________
+template <typename N, typename E>
+size_t Graph<N, E>::memUsage() const {
+  size_t ret = _nodes.memUsage();
+  for (const auto nd : _nodes) {
+    // the node object holds the payload, an id and its adjacency lists
+    ret += sizeof(Node<N, E>) + sizeof(N) + sizeof(size_t) +
+           2 * sizeof(std::vector<Edge<N, E>*>) +
+           nd->getDeg() * sizeof(Edge<N, E>*);
+    for (const auto e : nd->getAdjList()) {
+      if (e->getFrom() == nd) ret += sizeof(Edge<N, E>);
+    }
+  }
+  return ret;
+}
@@ -38,11 +38,24 @@ class Node {
 
   virtual N& pl() = 0;
   virtual const N& pl() const = 0;
+
+  // stable id, unique within the owning graph
+  virtual size_t getId() const = 0;
+  virtual void setId(size_t id) = 0;
 };
 
 template <typename N, typename E>
 inline Node<N, E>::~Node() {}
 
+// orders nodes or edges by their id, use this instead of the default pointer
+// order for containers whose iteration order must not depend on the heap
+template <typename T>
+struct IdCmp {
+  bool operator()(const T* a, const T* b) const {
+    return a->getId() < b->getId();
+  }
+};
+
 }  // namespace graph
 }  // namespace util
 
@@ -0,0 +1,102 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef UTIL_GRAPH_ORDEREDSET_H_
+#define UTIL_GRAPH_ORDEREDSET_H_
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "util/graph/robin/robin_map.h"
+
+namespace util {
+namespace graph {
+
+// Set of (pointer) values which iterates in insertion order. Values are kept
+// in a doubly linked list threaded through a slot vector, so insert and erase
+// are O(1) and iteration does not depend on the memory addresses of the
+// values. Like for std::set, erasing a value only invalidates iterators to
+// that value, and inserting invalidates none.
+template <typename T>
+class OrderedSet {
+ private:
+  struct Slot {
+    T val;
+    size_t prev, next;
+  };
+
+ public:
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T* pointer;
+    typedef const T& reference;
+
+    const_iterator() : _s(0), _i(0) {}
+    const_iterator(const OrderedSet<T>* s, size_t i) : _s(s), _i(i) {}
+
+    reference operator*() const { return _s->_slots[_i].val; }
+    pointer operator->() const { return &_s->_slots[_i].val; }
+    const_iterator& operator++() {
+      _i = _s->_slots[_i].next;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator r = *this;
+      ++(*this);
+      return r;
+    }
+    bool operator==(const const_iterator& o) const { return _i == o._i; }
+    bool operator!=(const const_iterator& o) const { return _i != o._i; }
+
+   private:
+    const OrderedSet<T>* _s;
+    size_t _i;
+    friend class OrderedSet<T>;
+  };
+
+  // values are immutable, as in std::set
+  typedef const_iterator iterator;
+  typedef T value_type;
+  typedef size_t size_type;
+
+  OrderedSet();
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  size_t size() const;
+  bool empty() const;
+
+  const_iterator find(const T& v) const;
+  size_t count(const T& v) const;
+
+  std::pair<const_iterator, bool> insert(const T& v);
+
+  // erase value at i, return iterator to the next value
+  const_iterator erase(const_iterator i);
+  size_t erase(const T& v);
+
+  void clear();
+
+  // estimated bytes used by the set
+  size_t memUsage() const;
+
+ private:
+  // slot 0 is the sentinel, its next is the first and its prev the last value
+  std::vector<Slot> _slots;
+  tsl::robin_map<T, size_t> _idx;
+
+  // head of the list of free slots, 0 if none
+  size_t _free;
+};
+
+#include "util/graph/OrderedSet.tpp"
+}  // namespace graph
+}  // namespace util
+
+#endif  // UTIL_GRAPH_ORDEREDSET_H_
@@ -0,0 +1,113 @@
+// Copyright 2016, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+// _____________________________________________________________________________
+template <typename T>
+OrderedSet<T>::OrderedSet() : _slots(1, Slot{T(), 0, 0}), _free(0) {}
+
+// _____________________________________________________________________________
+template <typename T>
+typename OrderedSet<T>::const_iterator OrderedSet<T>::begin() const {
+  return const_iterator(this, _slots[0].next);
+}
+
+// _____________________________________________________________________________
+template <typename T>
+typename OrderedSet<T>::const_iterator OrderedSet<T>::end() const {
+  return const_iterator(this, 0);
+}
+
+// _____________________________________________________________________________
+template <typename T>
+size_t OrderedSet<T>::size() const {
+  return _idx.size();
+}
+
+// _____________________________________________________________________________
+template <typename T>
+bool OrderedSet<T>::empty() const {
+  return _idx.empty();
+}
+
+// _____________________________________________________________________________
+template <typename T>
+typename OrderedSet<T>::const_iterator OrderedSet<T>::find(const T& v) const {
+  auto i = _idx.find(v);
+  if (i == _idx.end()) return end();
+  return const_iterator(this, i->second);
+}
+
+// _____________________________________________________________________________
+template <typename T>
+size_t OrderedSet<T>::count(const T& v) const {
+  return _idx.count(v);
+}
+
+// _____________________________________________________________________________
+template <typename T>
+std::pair<typename OrderedSet<T>::const_iterator, bool> OrderedSet<T>::insert(
+    const T& v) {
+  auto i = _idx.find(v);
+  if (i != _idx.end()) return {const_iterator(this, i->second), false};
+
+  size_t last = _slots[0].prev;
+  size_t s = _free;
+
+  if (s) {
+    _free = _slots[s].next;
+    _slots[s] = Slot{v, last, 0};
+  } else {
+    s = _slots.size();
+    _slots.push_back(Slot{v, last, 0});
+  }
+
+  _slots[last].next = s;
+  _slots[0].prev = s;
+  _idx[v] = s;
+
+  return {const_iterator(this, s), true};
+}
+
+// _____________________________________________________________________________
+template <typename T>
+typename OrderedSet<T>::const_iterator OrderedSet<T>::erase(
+    const_iterator i) {
+  size_t s = i._i;
+  size_t next = _slots[s].next;
+
+  _slots[_slots[s].prev].next = next;
+  _slots[next].prev = _slots[s].prev;
+  _idx.erase(_slots[s].val);
+
+  _slots[s].next = _free;
+  _free = s;
+
+  return const_iterator(this, next);
+}
+
+// _____________________________________________________________________________
+template <typename T>
+size_t OrderedSet<T>::erase(const T& v) {
+  auto i = find(v);
+  if (i == end()) return 0;
+  erase(i);
+  return 1;
+}
+
+// _____________________________________________________________________________
+template <typename T>
+void OrderedSet<T>::clear() {
+  _slots.resize(1);
+  _slots[0].next = _slots[0].prev = 0;
+  _idx.clear();
+  _free = 0;
+}
+
+// _____________________________________________________________________________
+template <typename T>
+size_t OrderedSet<T>::memUsage() const {
+  // robin map buckets hold the value and the distance to the ideal bucket
+  return _slots.capacity() * sizeof(Slot) +
+         _idx.bucket_count() * (sizeof(std::pair<T, size_t>) + sizeof(size_t));
+}
@@ -3,35 +3,96 @@
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-UndirGraph<N, E>::UndirGraph() {}
+template <typename N, typename E, template <typename> class A>
+UndirGraph<N, E, A>::UndirGraph() {}
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Node<N, E>* UndirGraph<N, E>::addNd(const N& pl) {
-  return addNd(new UndirNode<N, E>(pl));
+template <typename N, typename E, template <typename> class A>
+UndirGraph<N, E, A>::UndirGraph(UndirGraph&& other) {
+  *this = std::move(other);
 }
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Node<N, E>* UndirGraph<N, E>::addNd() {
-  return addNd(new UndirNode<N, E>());
+template <typename N, typename E, template <typename> class A>
+UndirGraph<N, E, A>& UndirGraph<N, E, A>::operator=(UndirGraph&& other) {
+  // our current nodes and edges are not freed here, as references to them
+  // may still be held elsewhere
+  Graph<N, E>::_nodes = std::move(other._nodes);
+  Graph<N, E>::_nextNdId = other._nextNdId;
+  Graph<N, E>::_nextEdgId = other._nextEdgId;
+  other._nodes.clear();
+  _ndAlloc.take(&other._ndAlloc);
+  _edgAlloc.take(&other._edgAlloc);
+  return *this;
 }
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Node<N, E>* UndirGraph<N, E>::addNd(UndirNode<N, E>* n) {
+template <typename N, typename E, template <typename> class A>
+UndirGraph<N, E, A>::~UndirGraph() {
+  // bulk teardown, adjacency lists don't have to be updated here. Edges are
+  // collected first, as they are also referenced from their second node.
+  std::vector<Edge<N, E>*> edgs;
+  for (auto n : Graph<N, E>::_nodes) {
+    for (auto e : n->getAdjList()) {
+      if (e->getFrom() == n) edgs.push_back(e);
+    }
+  }
+
+  for (auto e : edgs) _edgAlloc.destroy(e);
+
+  for (auto n : Graph<N, E>::_nodes)
+    _ndAlloc.destroy(static_cast<UndirNode<N, E>*>(n));
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+Node<N, E>* UndirGraph<N, E, A>::addNd(const N& pl) {
+  auto n = _ndAlloc.alloc(pl);
+  n->setId(Graph<N, E>::_nextNdId++);
+  return *Graph<N, E>::_nodes.insert(n).first;
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+Node<N, E>* UndirGraph<N, E, A>::addNd() {
+  auto n = _ndAlloc.alloc();
+  n->setId(Graph<N, E>::_nextNdId++);
+  return *Graph<N, E>::_nodes.insert(n).first;
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+Node<N, E>* UndirGraph<N, E, A>::addNd(UndirNode<N, E>* n) {
+  static_assert(
+      std::is_same<A<UndirNode<N, E>>, HeapAlloc<UndirNode<N, E>>>::value,
+      "Only heap-allocated graphs can take ownership of nodes");
   auto ins = Graph<N, E>::_nodes.insert(n);
+  if (ins.second) n->setId(Graph<N, E>::_nextNdId++);
   return *ins.first;
 }
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Edge<N, E>* UndirGraph<N, E>::addEdg(Node<N, E>* from, Node<N, E>* to,
-                                     const E& p) {
+template <typename N, typename E, template <typename> class A>
+Edge<N, E>* UndirGraph<N, E, A>::addEdg(Node<N, E>* from, Node<N, E>* to,
+                                        const E& p) {
+  Edge<N, E>* e = Graph<N, E>::getEdg(from, to);
+  if (!e) {
+    e = _edgAlloc.alloc(from, to, p);
+    e->setId(Graph<N, E>::_nextEdgId++);
+    from->addEdge(e);
+    to->addEdge(e);
+  }
+  return e;
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+Edge<N, E>* UndirGraph<N, E, A>::addEdg(Node<N, E>* from, Node<N, E>* to,
+                                        E&& p) {
   Edge<N, E>* e = Graph<N, E>::getEdg(from, to);
   if (!e) {
-    e = new Edge<N, E>(from, to, p);
+    e = _edgAlloc.alloc(from, to, std::move(p));
+    e->setId(Graph<N, E>::_nextEdgId++);
     from->addEdge(e);
     to->addEdge(e);
   }
@@ -39,8 +100,8 @@ Edge<N, E>* UndirGraph<N, E>::addEdg(Node<N, E>* from, Node<N, E>* to,
 }
 
 // _____________________________________________________________________________
-template <typename N, typename E>
-Node<N, E>* UndirGraph<N, E>::mergeNds(Node<N, E>* a, Node<N, E>* b) {
+template <typename N, typename E, template <typename> class A>
+Node<N, E>* UndirGraph<N, E, A>::mergeNds(Node<N, E>* a, Node<N, E>* b) {
   for (auto e : a->getAdjListOut()) {
     if (e->getFrom() != a) continue;
     if (e->getTo() != b) {
@@ -55,7 +116,26 @@ Node<N, E>* UndirGraph<N, E>::mergeNds(Node<N, E>* a, Node<N, E>* b) {
     }
   }
 
-  UndirGraph<N, E>::delNd(a);
+  UndirGraph<N, E, A>::delNd(a);
 
   return b;
 }
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+void UndirGraph<N, E, A>::freeNd(Node<N, E>* n) {
+  auto adj = n->getAdjList();
+  for (auto e : adj) {
+    if (e->getFrom() != n) e->getFrom()->removeEdge(e);
+    if (e->getTo() != n) e->getTo()->removeEdge(e);
+    freeEdg(e);
+  }
+
+  _ndAlloc.free(static_cast<UndirNode<N, E>*>(n));
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E, template <typename> class A>
+void UndirGraph<N, E, A>::freeEdg(Edge<N, E>* e) {
+  _edgAlloc.free(e);
+}
@@ -17,6 +17,7 @@ class UndirNode : public Node<N, E> {
  public:
   UndirNode();
   UndirNode(const N& pl);
+  // adjacent edges are freed by the owning graph
   ~UndirNode();
 
   const std::vector<Edge<N, E>*>& getAdjList() const;
@@ -40,9 +41,13 @@ class UndirNode : public Node<N, E> {
   N& pl();
   const N& pl() const;
 
+  size_t getId() const;
+  void setId(size_t id);
+
  private:
   std::vector<Edge<N, E>*> _adjList;
   N _pl;
+  size_t _id;
 
   bool adjContains(const Edge<N, E>* e) const;
 };
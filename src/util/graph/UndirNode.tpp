@@ -4,42 +4,17 @@
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-UndirNode<N, E>::UndirNode() : _pl() {
+UndirNode<N, E>::UndirNode() : _pl(), _id(0) {
 }
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-UndirNode<N, E>::UndirNode(const N& pl) : _pl(pl) {
+UndirNode<N, E>::UndirNode(const N& pl) : _pl(pl), _id(0) {
 }
 
 // _____________________________________________________________________________
 template <typename N, typename E>
-UndirNode<N, E>::~UndirNode() {
-  // delete self edges
-  for (auto e = _adjList.begin(); e != _adjList.end();) {
-    Edge<N, E>* eP = *e;
-    if (eP->getTo() == this && eP->getFrom() == this) {
-      e = _adjList.erase(e);
-      delete eP;
-    } else {
-      e++;
-    }
-  }
-
-  for (auto e = _adjList.begin(); e != _adjList.end(); e++) {
-    Edge<N, E>* eP = *e;
-
-    if (eP->getTo() != this) {
-      eP->getTo()->removeEdge(eP);
-    }
-
-    if (eP->getFrom() != this) {
-      eP->getFrom()->removeEdge(eP);
-    }
-
-    delete eP;
-  }
-}
+UndirNode<N, E>::~UndirNode() {}
 
 // _____________________________________________________________________________
 template <typename N, typename E>
@@ -128,3 +103,15 @@ template <typename N, typename E>
 const N& UndirNode<N, E>::pl() const {
   return _pl;
 }
+
+// _____________________________________________________________________________
+template <typename N, typename E>
+size_t UndirNode<N, E>::getId() const {
+  return _id;
+}
+
+// _____________________________________________________________________________
+template <typename N, typename E>
+void UndirNode<N, E>::setId(size_t id) {
+  _id = id;
+}
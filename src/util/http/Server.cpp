@@ -10,6 +10,9 @@
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/time.h>
 #include <algorithm>
 #include <csignal>
 #include <memory>
@@ -25,6 +28,7 @@
 #include "util/String.h"
 #include "util/log/Log.h"
 
+using util::http::Answer;
 using util::http::HeaderState;
 using util::http::HttpErr;
 using util::http::HttpServer;
@@ -35,7 +39,7 @@ using util::http::Socket;
 // _____________________________________________________________________________
 Socket::Socket(int port) {
   int y = 1;
-  _sock = socket(PF_INET, SOCK_STREAM, 0);
+  _sock = socket(PF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
   if (_sock < 0)
     throw std::runtime_error(std::string("Could not create socket (") +
                              std::strerror(errno) + ")");
@@ -54,63 +58,194 @@ Socket::Socket(int port) {
                              std::to_string(port) + " (" +
                              std::strerror(errno) + ")");
   }
+
+  if (listen(_sock, BLOG) < 0)
+    throw std::runtime_error(std::string("Cannot listen to socket (") +
+                             std::strerror(errno) + ")");
 }
 
 // _____________________________________________________________________________
 Socket::~Socket() { close(_sock); }
 
 // _____________________________________________________________________________
-int Socket::wait() {
-  if (listen(_sock, BLOG) < 0)
-    throw std::runtime_error(std::string("Cannot listen to socket (") +
-                             std::strerror(errno) + ")");
+int Socket::port() const {
+  sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  if (getsockname(_sock, reinterpret_cast<sockaddr*>(&addr), &len) < 0)
+    return -1;
+  return ntohs(addr.sin_port);
+}
+
+// _____________________________________________________________________________
+int Socket::accept() {
   sockaddr_in cli_addr;
   socklen_t clilen = sizeof(cli_addr);
-  int sock = accept(_sock, reinterpret_cast<sockaddr*>(&cli_addr), &clilen);
+  int sock;
+  do {
+    sock = ::accept(_sock, reinterpret_cast<sockaddr*>(&cli_addr), &clilen);
+  } while (sock < 0 && errno == EINTR);
+  if (sock < 0) return -1;
+
+  // accepted sockets are blocking, but reads and writes time out
+  struct timeval tv;
+  tv.tv_sec = IO_TIMEOUT;
+  tv.tv_usec = 0;
+  setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+  int y = 1;
+  setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &y, sizeof(y));
+
   return sock;
 }
 
 // _____________________________________________________________________________
-void HttpServer::send(int sock, Answer* aw) {
-  // ignore SIGPIPE
-  signal(SIGPIPE, SIG_IGN);
+void HttpServer::writeAll(int sock, const char* data, size_t len) {
+  size_t writes = 0;
 
+  while (writes != len) {
+    int64_t out = write(sock, data + writes, len - writes);
+    if (out < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Failed to write to socket");
+    }
+    writes += out;
+  }
+}
+
+// _____________________________________________________________________________
+void HttpServer::send(int sock, Answer* aw, const Req& req, bool keepAlive) {
   std::string enc = "identity";
-  if (aw->gzip) aw->pl = compress(aw->pl, &enc);
+  bool chunked = false;
+
+  // do not compress small payloads
+  if (aw->gzip && aw->pl.size() >= 500) {
+#ifdef ZLIB_FOUND
+    // HTTP/1.0 clients do not understand chunked answers
+    if (req.ver == "HTTP/1.1")
+      chunked = true;
+    else
+#endif
+      aw->pl = compress(aw->pl, &enc);
+  }
 
-  aw->params["Content-Encoding"] = enc;
-  aw->params["Content-Length"] = std::to_string(aw->pl.size());
+  if (chunked) {
+    aw->params["Content-Encoding"] = "gzip";
+    aw->params["Transfer-Encoding"] = "chunked";
+    aw->params.erase("Content-Length");
+  } else {
+    aw->params["Content-Encoding"] = enc;
+    aw->params["Content-Length"] = std::to_string(aw->pl.size());
+  }
+
+  aw->params["Connection"] = keepAlive ? "keep-alive" : "close";
 
   std::stringstream ss;
   ss << "HTTP/1.1 " << aw->status << "\r\n";
   for (const auto& kv : aw->params)
     ss << kv.first << ": " << kv.second << "\r\n";
-  ss << "\r\n" << aw->pl;
-  std::string buff = ss.str();
+  ss << "\r\n";
 
-  size_t writes = 0;
+  std::string buff = ss.str();
 
-  while (writes != buff.size()) {
-    int64_t out = write(sock, buff.c_str() + writes, buff.size() - writes);
-    if (out < 0) {
-      if (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR) continue;
-      throw std::runtime_error("Failed to write to socket");
-    }
-    writes += out;
+  if (chunked) {
+    writeAll(sock, buff.c_str(), buff.size());
+    sendChunked(sock, aw->pl);
+  } else if (aw->pl.size() < BSIZE_C) {
+    // small answers are written in one go
+    buff += aw->pl;
+    writeAll(sock, buff.c_str(), buff.size());
+  } else {
+    writeAll(sock, buff.c_str(), buff.size());
+    writeAll(sock, aw->pl.c_str(), aw->pl.size());
   }
 }
 
+// _____________________________________________________________________________
+void HttpServer::sendChunked(int sock, const std::string& pl) {
+#ifdef ZLIB_FOUND
+  // based on http://www.zlib.net/zlib_how.html, each filled output buffer is
+  // written as a chunk right away
+  z_stream defStr;
+  defStr.zalloc = Z_NULL;
+  defStr.zfree = Z_NULL;
+  defStr.opaque = Z_NULL;
+  defStr.avail_in = 0;
+  defStr.next_in = Z_NULL;
+
+  if (deflateInit2(&defStr, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+    throw std::runtime_error("Could not initialize compression");
+
+  std::unique_ptr<z_stream, int (*)(z_stream*)> guard(&defStr, deflateEnd);
+
+  std::vector<char> out(BSIZE_C + 32);
+  size_t pos = 0;
+  int flush = Z_NO_FLUSH;
+
+  do {
+    size_t in = std::min(BSIZE_C, pl.size() - pos);
+    defStr.next_in = reinterpret_cast<z_const Bytef*>(pl.c_str() + pos);
+    defStr.avail_in = static_cast<unsigned int>(in);
+    pos += in;
+    flush = pos == pl.size() ? Z_FINISH : Z_NO_FLUSH;
+
+    do {
+      // leave room for the chunk size line in front of the data
+      char* data = &out[0] + 16;
+      defStr.avail_out = BSIZE_C;
+      defStr.next_out = reinterpret_cast<Bytef*>(data);
+      deflate(&defStr, flush);
+      size_t have = BSIZE_C - defStr.avail_out;
+
+      // an empty chunk would end the answer
+      if (!have) continue;
+
+      char head[16];
+      int hl = snprintf(head, sizeof(head), "%zx\r\n", have);
+      memcpy(data - hl, head, hl);
+      memcpy(data + have, "\r\n", 2);
+      writeAll(sock, data - hl, hl + have + 2);
+    } while (defStr.avail_out == 0);
+  } while (flush != Z_FINISH);
+
+  writeAll(sock, "0\r\n\r\n", 5);
+#else
+  UNUSED(sock);
+  UNUSED(pl);
+#endif
+}
+
 // _____________________________________________________________________________
 void HttpServer::handle() {
   int connection = -1;
-  while ((connection = _jobs.get()) != -1) {
+  while ((connection = _jobs.get()) != -1) serve(connection);
+}
+
+// _____________________________________________________________________________
+void HttpServer::serve(int connection) {
+  // bytes read from the connection, but not consumed yet
+  std::string buf;
+
+  while (true) {
+    Req req;
     Answer answ;
+    bool keep = false;
+    bool drain = false;
 
     try {
-      Req req = getReq(connection);
+      if (!getReq(connection, &buf, &req)) {
+        // the client closed the connection
+        close(connection);
+        return;
+      }
+      keep = keepAlive(req);
       answ = _handler->handle(req, connection);
       answ.gzip = gzipSupport(req);
     } catch (const HttpErr& err) {
+      // the request may not have been read completely
+      keep = false;
+      drain = true;
       answ = Answer(err.what(), err.what());
     } catch (...) {
       // catch everything to make sure the server continues running
@@ -118,165 +253,283 @@ void HttpServer::handle() {
     }
 
     try {
-      send(connection, &answ);
+      send(connection, &answ, req, keep);
     } catch (const std::runtime_error& err) {
       LOG(WARN) << err.what();
+      keep = false;
+    }
+
+    if (!keep) {
+      if (drain) {
+        drainClose(connection);
+      } else {
+        close(connection);
+      }
+      return;
+    }
+
+    // pipelined requests are answered right away
+    if (buf.empty()) {
+      arm(connection, false);
+      return;
     }
+  }
+}
 
+// _____________________________________________________________________________
+void HttpServer::drainClose(int connection) {
+  // closing a connection with unread input resets it, which may discard the
+  // answer before the client read it. Signal the end of the answer and
+  // discard the remaining input for a short time first
+  shutdown(connection, SHUT_WR);
+
+  struct timeval tv;
+  tv.tv_sec = 0;
+  tv.tv_usec = DRAIN_TIMEOUT * 1000;
+  setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  auto end = std::chrono::steady_clock::now() +
+             std::chrono::milliseconds(DRAIN_TIMEOUT);
+  char tmp[4096];
+  size_t drained = 0;
+
+  while (drained < DRAIN_MAX && std::chrono::steady_clock::now() < end) {
+    int64_t r = read(connection, tmp, sizeof(tmp));
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) break;
+    drained += r;
+  }
+
+  close(connection);
+}
+
+// _____________________________________________________________________________
+void HttpServer::arm(int connection, bool add) {
+  {
+    std::unique_lock<std::mutex> lock(_idleMut);
+    _idle[connection] = std::chrono::steady_clock::now();
+  }
+
+  // the connection is disabled again after the first event, until a worker
+  // re-arms it
+  epoll_event ev;
+  ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+  ev.data.fd = connection;
+
+  if (epoll_ctl(_epoll, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, connection, &ev) <
+      0) {
+    LOG(WARN) << "Could not watch connection (" << std::strerror(errno) << ")";
+    std::unique_lock<std::mutex> lock(_idleMut);
+    _idle.erase(connection);
     close(connection);
   }
 }
 
+// _____________________________________________________________________________
+void HttpServer::expire() {
+  auto now = std::chrono::steady_clock::now();
+  std::unique_lock<std::mutex> lock(_idleMut);
+  for (auto i = _idle.begin(); i != _idle.end();) {
+    if (now - i->second > std::chrono::seconds(KEEP_ALIVE_TIMEOUT)) {
+      epoll_ctl(_epoll, EPOLL_CTL_DEL, i->first, 0);
+      close(i->first);
+      i = _idle.erase(i);
+    } else {
+      i++;
+    }
+  }
+}
+
 // _____________________________________________________________________________
 bool HttpServer::gzipSupport(const Req& req) {
   bool accepts = false;
   // decide according to
   // http://www.w3.org/Protocols/rfc2616/rfc2616-sec14.html
-  for (const auto& kv : req.params) {
-    if (kv.first == "Accept-Encoding") {
-      for (const auto& encoding : split(kv.second, ',')) {
-        std::vector<std::string> parts = split(encoding, ';');
-        for (size_t i = 0; i < parts.size(); i++) {
-          parts[i] = trim(parts[i]);
-        }
-        if (parts[0] == "*" && ((parts.size() == 1) || parts[1] != "q=0"))
-          accepts = true;
-        if (parts[0] == "gzip") accepts = true;
-        if (parts.size() > 1 && parts[1] == "q=0") accepts = false;
-      }
+  const std::string* val = header(req, "Accept-Encoding");
+  if (!val) return false;
+
+  for (const auto& encoding : split(*val, ',')) {
+    std::vector<std::string> parts = split(encoding, ';');
+    for (size_t i = 0; i < parts.size(); i++) {
+      parts[i] = trim(parts[i]);
     }
+    if (parts[0] == "*" && ((parts.size() == 1) || parts[1] != "q=0"))
+      accepts = true;
+    if (parts[0] == "gzip") accepts = true;
+    if (parts.size() > 1 && parts[1] == "q=0") accepts = false;
   }
   return accepts;
 }
 
 // _____________________________________________________________________________
-Req HttpServer::getReq(int connection) {
-  char buf[BSIZE + 1];
-  size_t rcvd = 0;
-  int64_t curRcvd = 0;
-  HeaderState state = NONE;
-  Req ret;
-  char* tmp = 0;
-  char* tmp2 = 0;
-  char* brk = 0;
+bool HttpServer::keepAlive(const Req& req) {
+  const std::string* val = header(req, "Connection");
+  // HTTP/1.1 connections are persistent by default
+  if (req.ver == "HTTP/1.1") return !val || strcasecmp(val->c_str(), "close");
+  return val && !strcasecmp(val->c_str(), "keep-alive");
+}
+
+// _____________________________________________________________________________
+const std::string* HttpServer::header(const Req& req, const std::string& key) {
+  // header field names are case-insensitive
+  for (const auto& kv : req.params) {
+    if (!strcasecmp(kv.first.c_str(), key.c_str())) return &kv.second;
+  }
+  return 0;
+}
+
+// _____________________________________________________________________________
+size_t HttpServer::readMore(int connection, std::string* buf, size_t len) {
+  size_t old = buf->size();
+  buf->resize(old + len);
+
+  int64_t curRcvd;
+  do {
+    curRcvd = read(connection, &(*buf)[old], len);
+  } while (curRcvd < 0 && errno == EINTR);
+
+  if (curRcvd < 0) {
+    buf->resize(old);
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+      throw HttpErr("408 Request Timeout");
+    throw HttpErr("500 Internal Server Error");
+  }
 
-  while ((curRcvd = read(connection, buf + rcvd, BSIZE - rcvd))) {
-    if (curRcvd < 0) {
-      if (errno == EAGAIN || errno == EINTR) continue;
-      throw HttpErr("500 Internal Server Error");
+  buf->resize(old + curRcvd);
+  return curRcvd;
+}
+
+// _____________________________________________________________________________
+bool HttpServer::getReq(int connection, std::string* buf, Req* req) {
+  size_t end = 0;
+  size_t searched = 0;
+
+  while (true) {
+    // skip empty lines before the request line
+    size_t start = buf->find_first_not_of("\r\n");
+    if (start == std::string::npos) start = buf->size();
+    if (start) {
+      buf->erase(0, start);
+      searched = 0;
     }
 
-    // parse request
-    for (int i = 0; i < curRcvd; i++) {
-      if (brk) break;
-      char* c = buf + rcvd + i;
-      switch (state) {
-        case NONE:
-          state = I_COM;
-          tmp = c;
-          continue;
-        case I_VER:
-          if (*c == '\n') {
-            *c = 0;
-            ret.ver = trim(tmp);
-            state = A_KEY;
-          }
-          continue;
-        case I_URL:
-          if (*c == ' ') {
-            *c = 0, ret.url = trim(tmp);
-            tmp = c + 1;
-            state = I_VER;
-          } else if (*c == '\n') {
-            *c = 0, ret.url = trim(tmp);
-            state = A_KEY;
-          }
-          continue;
-        case I_COM:
-          if (*c == ' ') {
-            *c = 0, ret.cmd = trim(tmp);
-            tmp = c + 1;
-            state = I_URL;
-          } else if (*c == '\n') {
-            *c = 0, ret.cmd = trim(tmp);
-            state = A_KEY;
-          }
-          continue;
-        case A_KEY:
-          if (*c == '\r') *c = ' ';
-          if (*c == '\n')
-            brk = c + 1;
-          else if (*c != ' ') {
-            state = I_KEY;
-            tmp = c;
-          }
-          continue;
-        case I_KEY:
-          if (*c == ':') {
-            *c = 0;
-            state = A_VAL;
-          }
-          continue;
-        case A_VAL:
-          if (*c != ' ') {
-            state = I_VAL;
-            tmp2 = c;
-          }
-          continue;
-        case I_VAL:
-          if (*c == '\r') *c = ' ';
-          if (*c == '\n') {
-            *c = 0;
-            ret.params[tmp] = trim(tmp2);
-            state = A_KEY;
-          }
-          continue;
-      }
+    // the header ends with an empty line
+    for (size_t i = searched; i + 1 < buf->size() && !end; i++) {
+      if ((*buf)[i] != '\n') continue;
+      if ((*buf)[i + 1] == '\n') end = i + 2;
+      if ((*buf)[i + 1] == '\r' && i + 2 < buf->size() && (*buf)[i + 2] == '\n')
+        end = i + 3;
     }
+    if (end) break;
+    searched = buf->size() > 2 ? buf->size() - 2 : 0;
 
-    rcvd += curRcvd;
+    if (buf->size() >= BSIZE)
+      throw HttpErr("431 Request Header Fields Too Large");
 
-    // buffer is full
-    if (rcvd == BSIZE) throw HttpErr("431 Request Header Fields Too Large");
-    if (brk) break;
+    if (!readMore(connection, buf, BSIZE - buf->size())) {
+      if (buf->empty()) return false;
+      throw HttpErr("400 Bad Request");
+    }
   }
 
-  // POST payload
-  if (ret.cmd == "POST") {
-    size_t size = 0;
-    if (ret.params.count("Content-Length"))
-      size = atoi(ret.params["Content-Length"].c_str());
-    if (size) {
-      char* postBuf = new char[size + 1];
-      postBuf[size] = 0;
-      size_t rem = 0;
-
-      // copy existing to new buffer
-      if ((int)rcvd > brk - buf) {
-        rem = std::min(size, rcvd - (brk - buf));
-        memcpy(postBuf, brk, rem);
-      }
+  parseHeader(&(*buf)[0], end, req);
 
-      rcvd = 0;
-
-      if (rem < size) {
-        while ((curRcvd = read(connection, postBuf + rcvd + rem, size - rem))) {
-          if (curRcvd == -1 && (errno == EAGAIN || errno == EINTR)) continue;
-          if (curRcvd == -1) {
-            postBuf[rcvd + 1] = 0;
-            break;
-          }
-          rcvd += curRcvd;
-          if (rcvd == size - rem) break;
-        }
-      }
+  if (req->cmd.empty() || req->url.empty())
+    throw HttpErr("400 Bad Request");
+
+  size_t size = 0;
+
+  if (header(*req, "Transfer-Encoding"))
+    throw HttpErr("411 Length Required");
+
+  const std::string* len = header(*req, "Content-Length");
+  if (len) size = atol(len->c_str());
 
-      ret.payload = postBuf;
-      delete[] postBuf;
+  // POST payload
+  while (buf->size() < end + size) {
+    if (!readMore(connection, buf,
+                  std::max(BSIZE_R, end + size - buf->size()))) {
+      throw HttpErr("400 Bad Request");
     }
   }
 
-  return ret;
+  // binary payloads may contain 0 bytes
+  if (req->cmd == "POST") req->payload = buf->substr(end, size);
+  buf->erase(0, end + size);
+
+  return true;
+}
+
+// _____________________________________________________________________________
+void HttpServer::parseHeader(char* data, size_t len, Req* ret) {
+  HeaderState state = NONE;
+  char* tmp = 0;
+  char* tmp2 = 0;
+
+  for (size_t i = 0; i < len; i++) {
+    char* c = data + i;
+    switch (state) {
+      case NONE:
+        state = I_COM;
+        tmp = c;
+        continue;
+      case I_VER:
+        if (*c == '\n') {
+          *c = 0;
+          ret->ver = trim(tmp);
+          state = A_KEY;
+        }
+        continue;
+      case I_URL:
+        if (*c == ' ') {
+          *c = 0, ret->url = trim(tmp);
+          tmp = c + 1;
+          state = I_VER;
+        } else if (*c == '\n') {
+          *c = 0, ret->url = trim(tmp);
+          state = A_KEY;
+        }
+        continue;
+      case I_COM:
+        if (*c == ' ') {
+          *c = 0, ret->cmd = trim(tmp);
+          tmp = c + 1;
+          state = I_URL;
+        } else if (*c == '\n') {
+          *c = 0, ret->cmd = trim(tmp);
+          state = A_KEY;
+        }
+        continue;
+      case A_KEY:
+        if (*c == '\r') *c = ' ';
+        if (*c == '\n') return;
+        if (*c != ' ') {
+          state = I_KEY;
+          tmp = c;
+        }
+        continue;
+      case I_KEY:
+        if (*c == ':') {
+          *c = 0;
+          state = A_VAL;
+        }
+        continue;
+      case A_VAL:
+        if (*c != ' ') {
+          state = I_VAL;
+          tmp2 = c;
+        }
+        continue;
+      case I_VAL:
+        if (*c == '\r') *c = ' ';
+        if (*c == '\n') {
+          *c = 0;
+          ret->params[tmp] = trim(tmp2);
+          state = A_KEY;
+        }
+        continue;
+    }
+  }
 }
 
 // _____________________________________________________________________________
@@ -326,12 +579,80 @@ std::string HttpServer::compress(const std::string& str, std::string* enc) {
 
 // _____________________________________________________________________________
 void HttpServer::run() {
-  Socket socket(_port);
+  // ignore SIGPIPE
+  signal(SIGPIPE, SIG_IGN);
+
+  std::unique_ptr<Socket> socket;
+
+  try {
+    socket.reset(new Socket(_port));
+
+    _epoll = epoll_create1(0);
+    if (_epoll < 0)
+      throw std::runtime_error(
+          std::string("Could not create epoll instance (") +
+          std::strerror(errno) + ")");
+
+    epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = socket->fd();
+    if (epoll_ctl(_epoll, EPOLL_CTL_ADD, socket->fd(), &ev) < 0)
+      throw std::runtime_error(std::string("Could not watch socket (") +
+                               std::strerror(errno) + ")");
+  } catch (...) {
+    listening(-1);
+    throw;
+  }
 
   std::vector<std::thread> thrds(_threads);
   for (auto& thr : thrds) thr = std::thread(&HttpServer::handle, this);
 
-  while (1) _jobs.add(socket.wait());
+  listening(socket->port());
+
+  std::vector<epoll_event> evs(BLOG);
+
+  while (1) {
+    // wake up regularly to close expired idle connections
+    int n = epoll_wait(_epoll, &evs[0], evs.size(), 1000);
+    if (n < 0 && errno != EINTR)
+      throw std::runtime_error(std::string("Could not wait for events (") +
+                               std::strerror(errno) + ")");
+
+    for (int i = 0; i < n; i++) {
+      int fd = evs[i].data.fd;
+      if (fd == socket->fd()) {
+        int c;
+        while ((c = socket->accept()) >= 0) arm(c, true);
+        continue;
+      }
+
+      {
+        std::unique_lock<std::mutex> lock(_idleMut);
+        _idle.erase(fd);
+      }
+
+      // blocks while all workers are busy and the queue is full
+      _jobs.add(fd);
+    }
+
+    expire();
+  }
+}
+
+// _____________________________________________________________________________
+void HttpServer::listening(int port) {
+  {
+    std::unique_lock<std::mutex> lock(_listenMut);
+    _listening = port;
+  }
+  _listenCv.notify_all();
+}
+
+// _____________________________________________________________________________
+int HttpServer::port() {
+  std::unique_lock<std::mutex> lock(_listenMut);
+  while (!_listening) _listenCv.wait(lock);
+  return _listening;
 }
 
 // _____________________________________________________________________________
@@ -339,6 +660,7 @@ void Queue::add(int c) {
   if (c < 0) return;
   {
     std::unique_lock<std::mutex> lock(_mut);
+    while (_jobs.size() >= BLOG) _hasSpace.wait(lock);
     _jobs.push(c);
   }
   _hasNew.notify_one();
@@ -346,9 +668,13 @@ void Queue::add(int c) {
 
 // _____________________________________________________________________________
 int Queue::get() {
-  std::unique_lock<std::mutex> lock(_mut);
-  while (_jobs.empty()) _hasNew.wait(lock);
-  int next = _jobs.front();
-  _jobs.pop();
+  int next;
+  {
+    std::unique_lock<std::mutex> lock(_mut);
+    while (_jobs.empty()) _hasNew.wait(lock);
+    next = _jobs.front();
+    _jobs.pop();
+  }
+  _hasSpace.notify_one();
   return next;
 }
@@ -2,6 +2,7 @@
 // Chair of Algorithms and Data Structures.
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
+#include <chrono>
 #include <condition_variable>
 #include <fstream>
 #include <iostream>
@@ -26,12 +27,22 @@
 namespace util {
 namespace http {
 
-// socket backlog size
+// socket backlog size, also the maximum number of queued connections
 const static size_t BLOG = 128;
-// socket read buffer size
+// maximum size of a request header
 const static size_t BSIZE = 4 * 1024;
-// zlib compression buffer size
+// socket read buffer size for request bodies
+const static size_t BSIZE_R = 64 * 1024;
+// zlib compression buffer size, also the maximum size of a response chunk
 const size_t BSIZE_C = 128 * 1024;
+// seconds an idle keep-alive connection is kept open
+const static int KEEP_ALIVE_TIMEOUT = 15;
+// seconds a blocking read or write on a connection may take
+const static int IO_TIMEOUT = 30;
+// milliseconds unread input is discarded before a connection is closed after
+// an error, and the maximum number of bytes discarded
+const static int DRAIN_TIMEOUT = 500;
+const static size_t DRAIN_MAX = 1024 * 1024;
 
 // states for HTTP header parser
 enum HeaderState { NONE, I_COM, I_URL, I_VER, A_KEY, I_KEY, A_VAL, I_VAL };
@@ -81,7 +92,7 @@ class Handler {
 };
 
 /*
- * Queue of connections to handle
+ * Bounded queue of connections to handle, add() blocks while it is full
  */
 class Queue {
  public:
@@ -92,46 +103,91 @@ class Queue {
   std::mutex _mut;
   std::queue<int> _jobs;
   std::condition_variable _hasNew;
+  std::condition_variable _hasSpace;
 };
 
 /*
- * Socket wrapper
+ * Non-blocking listening socket wrapper
  */
 class Socket {
  public:
   Socket(int port);
   ~Socket();
-  int wait();
+
+  // the next pending connection, or -1 if there is none
+  int accept();
+  int fd() const { return _sock; }
+
+  // the port the socket is bound to
+  int port() const;
 
  private:
   int _sock;
 };
 
 /*
- * Simple HTTP server, must provide a pointer to a class instance implementing
- * virtual class Handler.
+ * Simple HTTP/1.1 server, must provide a pointer to a class instance
+ * implementing virtual class Handler.
+ *
+ * Connections are watched by a single epoll event loop. As soon as a request
+ * arrives on a connection, the connection is handed to a bounded pool of
+ * worker threads which read the request, call the handler and write the
+ * answer. Keep-alive connections are then given back to the event loop, so
+ * idle connections do not occupy a worker. Compressed answers are streamed
+ * with chunked transfer encoding while they are being compressed.
  */
 class HttpServer {
  public:
   HttpServer(int port, const Handler* h) : HttpServer(port, h, 0) {}
   HttpServer(int port, const Handler* h, size_t threads)
-      : _port(port), _handler(h), _threads(threads) {
+      : _port(port),
+        _handler(h),
+        _threads(threads),
+        _epoll(-1),
+        _listening(0) {
     if (!_threads) _threads = 8 * std::thread::hardware_concurrency();
   }
   void run();
 
+  // the port the server listens on, blocks until run() accepts connections.
+  // With port 0, this is the free port picked by the system. Returns -1 if
+  // run() failed to set up the listening socket.
+  int port();
+
  private:
   int _port;
   Queue _jobs;
   const Handler* _handler;
   size_t _threads;
 
-  void handle();
+  int _epoll;
 
-  static void send(int sock, Answer* aw);
-  static Req getReq(int connection);
+  // the bound port once run() accepts connections, -1 if it failed
+  int _listening;
+  std::mutex _listenMut;
+  std::condition_variable _listenCv;
+
+  // connections waiting in the event loop, with the time they became idle
+  std::unordered_map<int, std::chrono::steady_clock::time_point> _idle;
+  std::mutex _idleMut;
+
+  void handle();
+  void serve(int connection);
+  void arm(int connection, bool add);
+  void expire();
+  void listening(int port);
+
+  static void send(int sock, Answer* aw, const Req& req, bool keepAlive);
+  static void sendChunked(int sock, const std::string& pl);
+  static void writeAll(int sock, const char* data, size_t len);
+  static void drainClose(int connection);
+  static size_t readMore(int connection, std::string* buf, size_t len);
+  static bool getReq(int connection, std::string* buf, Req* req);
+  static void parseHeader(char* data, size_t len, Req* req);
+  static const std::string* header(const Req& req, const std::string& key);
   static std::string compress(const std::string& str, std::string* enc);
   static bool gzipSupport(const Req& req);
+  static bool keepAlive(const Req& req);
 };
 }  // http
 }  // util
@@ -0,0 +1,387 @@
+// Copyright 2018, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include "Reader.h"
+
+using namespace util;
+using namespace json;
+
+namespace {
+// _____________________________________________________________________________
+void appendUtf8(uint32_t cp, std::string* s) {
+  if (cp < 0x80) {
+    *s += static_cast<char>(cp);
+  } else if (cp < 0x800) {
+    *s += static_cast<char>(0xC0 | (cp >> 6));
+    *s += static_cast<char>(0x80 | (cp & 0x3F));
+  } else if (cp < 0x10000) {
+    *s += static_cast<char>(0xE0 | (cp >> 12));
+    *s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    *s += static_cast<char>(0x80 | (cp & 0x3F));
+  } else {
+    *s += static_cast<char>(0xF0 | (cp >> 18));
+    *s += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    *s += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    *s += static_cast<char>(0x80 | (cp & 0x3F));
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+Reader::Reader(std::istream* in)
+    : _in(in),
+      _buf(BUF_SIZE),
+      _data(&_buf[0]),
+      _pos(0),
+      _len(0),
+      _offset(0),
+      _depth(0),
+      _type(END),
+      _bool(false) {}
+
+// _____________________________________________________________________________
+Reader::Reader(const char* data, size_t len, size_t offset)
+    : _in(0),
+      _data(data),
+      _pos(0),
+      _len(len),
+      _offset(offset),
+      _depth(0),
+      _type(END),
+      _bool(false) {}
+
+// _____________________________________________________________________________
+bool Reader::fill() {
+  if (!_in) return false;
+  _offset += _len;
+  _pos = 0;
+  _len = 0;
+  if (!_in->good()) return false;
+  _in->read(&_buf[0], _buf.size());
+  _len = _in->gcount();
+  return _len > 0;
+}
+
+// _____________________________________________________________________________
+int Reader::peek() {
+  if (_pos == _len && !fill()) return -1;
+  return static_cast<unsigned char>(_data[_pos]);
+}
+
+// _____________________________________________________________________________
+int Reader::get() {
+  if (_pos == _len && !fill()) return -1;
+  return static_cast<unsigned char>(_data[_pos++]);
+}
+
+// _____________________________________________________________________________
+int Reader::nextNonWs() {
+  while (true) {
+    int c = get();
+    if (c != ' ' && c != '\n' && c != '\r' && c != '\t' && c != ',' &&
+        c != ':')
+      return c;
+  }
+}
+
+// _____________________________________________________________________________
+Reader::TOKEN_T Reader::next() {
+  int c = nextNonWs();
+
+  switch (c) {
+    case -1:
+      if (_depth) err("Unexpected end of input");
+      return _type = END;
+    case '{':
+      _depth++;
+      return _type = OBJ_START;
+    case '}':
+      if (!_depth) err("Unexpected '}'");
+      _depth--;
+      return _type = OBJ_END;
+    case '[':
+      _depth++;
+      return _type = ARR_START;
+    case ']':
+      if (!_depth) err("Unexpected ']'");
+      _depth--;
+      return _type = ARR_END;
+    case '"':
+      readStr();
+
+      // a string directly followed by a colon is an object key
+      while (true) {
+        int p = peek();
+        if (p == ' ' || p == '\n' || p == '\r' || p == '\t') {
+          _pos++;
+          continue;
+        }
+        if (p == ':') {
+          _pos++;
+          return _type = KEY;
+        }
+        return _type = STRING;
+      }
+    case 't':
+      readLiteral("rue");
+      _bool = true;
+      return _type = BOOL;
+    case 'f':
+      readLiteral("alse");
+      _bool = false;
+      return _type = BOOL;
+    case 'n':
+      readLiteral("ull");
+      return _type = JSNULL;
+    default:
+      if (c == '-' || (c >= '0' && c <= '9')) {
+        readNum(c);
+        return _type = NUMBER;
+      }
+      err(std::string("Unexpected character '") + static_cast<char>(c) + "'");
+  }
+
+  return _type = END;
+}
+
+// _____________________________________________________________________________
+Reader::TOKEN_T Reader::type() const { return _type; }
+
+// _____________________________________________________________________________
+const std::string& Reader::str() const { return _str; }
+
+// _____________________________________________________________________________
+double Reader::num() const { return atof(_str.c_str()); }
+
+// _____________________________________________________________________________
+bool Reader::boolean() const { return _bool; }
+
+// _____________________________________________________________________________
+void Reader::skip() {
+  if (_type != OBJ_START && _type != ARR_START) return;
+
+  size_t depth = 1;
+  while (depth) {
+    switch (next()) {
+      case OBJ_START:
+      case ARR_START:
+        depth++;
+        break;
+      case OBJ_END:
+      case ARR_END:
+        depth--;
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void Reader::skipVal() {
+  next();
+  skip();
+}
+
+// _____________________________________________________________________________
+std::string Reader::strVal() {
+  next();
+  if (_type == STRING || _type == NUMBER) return _str;
+  skip();
+  return "";
+}
+
+// _____________________________________________________________________________
+double Reader::numVal(double def) {
+  next();
+  if (_type == NUMBER) return num();
+  skip();
+  return def;
+}
+
+// _____________________________________________________________________________
+size_t Reader::pos() const { return _pos; }
+
+// _____________________________________________________________________________
+void Reader::seek(size_t pos) {
+  if (_in || pos > _len) err("Cannot seek");
+  _pos = pos;
+}
+
+// _____________________________________________________________________________
+uint32_t Reader::readHex4() {
+  uint32_t cp = 0;
+  for (size_t i = 0; i < 4; i++) {
+    int h = get();
+    cp <<= 4;
+    if (h >= '0' && h <= '9')
+      cp |= h - '0';
+    else if (h >= 'a' && h <= 'f')
+      cp |= h - 'a' + 10;
+    else if (h >= 'A' && h <= 'F')
+      cp |= h - 'A' + 10;
+    else
+      err("Invalid unicode escape");
+  }
+  return cp;
+}
+
+// _____________________________________________________________________________
+void Reader::readStr() {
+  _str.clear();
+
+  // a high surrogate waiting for its low surrogate, or 0. Surrogates without
+  // their partner are replaced by U+FFFD.
+  uint32_t hi = 0;
+
+  while (true) {
+    // copy unescaped runs directly from the buffer
+    size_t start = _pos;
+    while (_pos < _len && _data[_pos] != '"' && _data[_pos] != '\\') _pos++;
+    if (hi && _pos > start) {
+      appendUtf8(0xFFFD, &_str);
+      hi = 0;
+    }
+    _str.append(_data + start, _pos - start);
+
+    // end of buffer, continue with the next one
+    if (_pos == _len) {
+      if (!fill()) err("Unterminated string");
+      continue;
+    }
+
+    int c = get();
+    if (c == -1) err("Unterminated string");
+    if (c == '"') {
+      if (hi) appendUtf8(0xFFFD, &_str);
+      return;
+    }
+
+    // escape sequence
+    c = get();
+    if (hi && c != 'u') {
+      appendUtf8(0xFFFD, &_str);
+      hi = 0;
+    }
+
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        _str += static_cast<char>(c);
+        break;
+      case 'b':
+        _str += '\b';
+        break;
+      case 'f':
+        _str += '\f';
+        break;
+      case 'n':
+        _str += '\n';
+        break;
+      case 'r':
+        _str += '\r';
+        break;
+      case 't':
+        _str += '\t';
+        break;
+      case 'u': {
+        uint32_t cp = readHex4();
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+          if (hi) appendUtf8(0xFFFD, &_str);
+          hi = cp;
+        } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+          appendUtf8(hi ? 0x10000 + ((hi - 0xD800) << 10) + (cp - 0xDC00)
+                        : 0xFFFD,
+                     &_str);
+          hi = 0;
+        } else {
+          if (hi) appendUtf8(0xFFFD, &_str);
+          hi = 0;
+          appendUtf8(cp, &_str);
+        }
+        break;
+      }
+      default:
+        err("Invalid escape sequence");
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void Reader::readNum(char c) {
+  _str.clear();
+  _str += c;
+
+  while (true) {
+    int p = peek();
+    if ((p >= '0' && p <= '9') || p == '.' || p == 'e' || p == 'E' ||
+        p == '-' || p == '+') {
+      _str += static_cast<char>(p);
+      _pos++;
+    } else {
+      return;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void Reader::readLiteral(const char* rest) {
+  for (size_t i = 0; i < strlen(rest); i++) {
+    if (get() != rest[i]) err("Invalid literal");
+  }
+}
+
+// _____________________________________________________________________________
+void Reader::err(const std::string& msg) const {
+  std::stringstream ss;
+  ss << msg << " at byte " << (_offset + _pos);
+  throw ReaderException(ss.str());
+}
+
+// _____________________________________________________________________________
+std::vector<size_t> util::json::arrayChunks(const char* data, size_t len,
+                                            size_t pos, size_t minLen) {
+  std::vector<size_t> ret{pos};
+  size_t next = pos + minLen;
+  size_t depth = 0;
+
+  // set after a comma between two top-level elements
+  bool sep = false;
+
+  for (size_t p = pos; p < len; p++) {
+    char c = data[p];
+    if (c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+
+    if (sep) {
+      sep = false;
+      if (p >= next) {
+        ret.push_back(p);
+        next = p + minLen;
+      }
+    }
+
+    if (c == '"') {
+      for (p++; p < len && data[p] != '"'; p++) {
+        if (data[p] == '\\') p++;
+      }
+    } else if (c == '{' || c == '[') {
+      depth++;
+    } else if (c == '}' || c == ']') {
+      if (!depth) {
+        ret.push_back(p);
+        return ret;
+      }
+      depth--;
+    } else if (c == ',' && !depth) {
+      sep = true;
+    }
+  }
+
+  ret.push_back(len);
+  return ret;
+}
@@ -0,0 +1,133 @@
+// Copyright 2018, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#ifndef UTIL_JSON_READER_H_
+#define UTIL_JSON_READER_H_
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace util {
+namespace json {
+
+class ReaderException : public std::exception {
+ public:
+  ReaderException(std::string msg) : _msg(msg) {}
+  ~ReaderException() throw() {}
+
+  virtual const char* what() const throw() { return _msg.c_str(); };
+
+ private:
+  std::string _msg;
+};
+
+// simple streaming JSON reader which returns one token at a time and never
+// holds more than a single value in memory. Object keys are returned as
+// separate KEY tokens, separators are consumed silently.
+class Reader {
+ public:
+  enum TOKEN_T {
+    OBJ_START,
+    OBJ_END,
+    ARR_START,
+    ARR_END,
+    KEY,
+    STRING,
+    NUMBER,
+    BOOL,
+    JSNULL,
+    END
+  };
+
+  explicit Reader(std::istream* in);
+
+  // read from len bytes of memory, which have to outlive the reader. Byte
+  // positions in errors are reported relative to offset.
+  Reader(const char* data, size_t len, size_t offset);
+
+  // read the next token, throws if the input ends inside an object or array
+  TOKEN_T next();
+
+  // type of the current token
+  TOKEN_T type() const;
+
+  // content of the current KEY or STRING token, or the literal of the current
+  // NUMBER token
+  const std::string& str() const;
+
+  // value of the current NUMBER or BOOL token
+  double num() const;
+  bool boolean() const;
+
+  // skip the value starting with the current token, afterwards the current
+  // token is its last token
+  void skip();
+
+  // read and skip the next value
+  void skipVal();
+
+  // read the next value, if it is a string or a number return its content,
+  // otherwise skip it and return ""
+  std::string strVal();
+
+  // read the next value, if it is a number return it, otherwise skip it and
+  // return def
+  double numVal(double def);
+
+  // byte position after the current token, only in memory mode
+  size_t pos() const;
+
+  // continue reading at byte pos, only in memory mode. The skipped bytes must
+  // not change the nesting depth.
+  void seek(size_t pos);
+
+ private:
+  static const size_t BUF_SIZE = 1 << 16;
+
+  std::istream* _in;
+
+  std::vector<char> _buf;
+
+  // current buffer, either _buf or the memory read from
+  const char* _data;
+  size_t _pos, _len;
+
+  // number of bytes read from the stream before the current buffer
+  size_t _offset;
+
+  // nesting depth of objects and arrays
+  size_t _depth;
+
+  TOKEN_T _type;
+  std::string _str;
+  bool _bool;
+
+  int peek();
+  int get();
+  bool fill();
+  int nextNonWs();
+
+  void readStr();
+  uint32_t readHex4();
+  void readNum(char c);
+  void readLiteral(const char* rest);
+
+  void err(const std::string& msg) const;
+};
+
+// split the elements of the array whose content starts at byte pos of data
+// into chunks of at least minLen bytes, which can be decoded independently.
+// Returns the byte positions of the chunk starts, each the first byte of a
+// top-level element, found by tracking the nesting depth and strings. The
+// first position is pos, the last one that of the closing bracket, or len if
+// the array is not closed.
+std::vector<size_t> arrayChunks(const char* data, size_t len, size_t pos,
+                                size_t minLen);
+
+}  // namespace json
+}  // namespace util
+
+#endif  // UTIL_JSON_READER_H_
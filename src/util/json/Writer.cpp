@@ -2,9 +2,11 @@
 // Chair of Algorithms and Data Structures.
 // Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
 
+#include <cstring>
 #include <iomanip>
+#include <sstream>
 #include "Writer.h"
-#include "util/String.h"
+#include "util/3rdparty/dtoa_milo.h"
 using namespace util;
 using namespace json;
 
@@ -12,6 +14,78 @@ using std::ostream;
 using std::string;
 using std::map;
 
+namespace {
+
+// _____________________________________________________________________________
+size_t writeUInt(uint64_t v, char* buf) {
+  char tmp[20];
+  size_t n = 0;
+  do {
+    tmp[n++] = '0' + (v % 10);
+    v /= 10;
+  } while (v);
+  for (size_t i = 0; i < n; i++) buf[i] = tmp[n - 1 - i];
+  return n;
+}
+
+// _____________________________________________________________________________
+size_t fixedFloat(double v, size_t prec, char* buf) {
+  // write v with exactly prec decimals, rounded half to even from the exact
+  // binary value as printf's %.*f does. The value is decomposed into
+  // m * 2^e, m * 5^prec * 2^(e + prec) is then computed exactly in 128 bit.
+  // Returns 0 if v is out of the range of this fast path.
+  if (!std::isfinite(v) || prec > 17) return 0;
+
+  uint64_t bits;
+  memcpy(&bits, &v, sizeof(bits));
+  bool neg = bits >> 63;
+  int exp = (bits >> 52) & 0x7FF;
+  uint64_t m = bits & ((uint64_t(1) << 52) - 1);
+  int e = -1074;
+  if (exp) {
+    m |= uint64_t(1) << 52;
+    e = exp - 1075;
+  }
+
+  uint64_t pow5 = 1;
+  for (size_t i = 0; i < prec; i++) pow5 *= 5;
+
+  // m * 5^17 < 2^93
+  gcc_ints::uint128 x = static_cast<gcc_ints::uint128>(m) * pow5;
+  int s = e + static_cast<int>(prec);
+
+  gcc_ints::uint128 q;
+  if (s >= 0) {
+    if (s > 30) return 0;
+    q = x << s;
+  } else if (s <= -128) {
+    q = 0;
+  } else {
+    q = x >> -s;
+    gcc_ints::uint128 rem = x - (q << -s);
+    gcc_ints::uint128 half = static_cast<gcc_ints::uint128>(1) << (-s - 1);
+    if (rem > half || (rem == half && (q & 1))) q++;
+  }
+
+  if (q >> 64) return 0;
+
+  char digits[20];
+  size_t n = writeUInt(static_cast<uint64_t>(q), digits);
+
+  size_t pos = 0;
+  if (neg) buf[pos++] = '-';
+
+  // pad with leading zeros to get at least one integer digit
+  size_t total = std::max(n, prec + 1);
+  for (size_t i = 0; i < total; i++) {
+    if (prec && i == total - prec) buf[pos++] = '.';
+    buf[pos++] = i < total - n ? '0' : digits[i - (total - n)];
+  }
+
+  return pos;
+}
+}  // namespace
+
 // _____________________________________________________________________________
 Writer::Writer(std::ostream* out)
     : _out(out), _pretty(false), _indent(2), _floatPrec(10) {}
@@ -28,6 +102,72 @@ Writer::Writer(std::ostream* out, size_t prec, bool pret)
 Writer::Writer(std::ostream* out, size_t prec, bool pret, size_t indent)
     : _out(out), _pretty(pret), _indent(indent), _floatPrec(prec) {}
 
+// _____________________________________________________________________________
+Writer::~Writer() { flush(); }
+
+// _____________________________________________________________________________
+void Writer::write(const char* s, size_t n) {
+  _buf.append(s, n);
+  if (_buf.size() >= BUF_SIZE) flush();
+}
+
+// _____________________________________________________________________________
+void Writer::write(const std::string& s) { write(s.data(), s.size()); }
+
+// _____________________________________________________________________________
+void Writer::write(char c) { write(&c, 1); }
+
+// _____________________________________________________________________________
+void Writer::writeStr(const char* s, size_t n) {
+  static const char* HEX = "0123456789abcdef";
+  _buf += '"';
+
+  // copy unescaped runs directly
+  size_t start = 0;
+  for (size_t i = 0; i < n; i++) {
+    char c = s[i];
+    if (c != '"' && c != '\\' && (c < '\x00' || c > '\x1f')) continue;
+    _buf.append(s + start, i - start);
+    start = i + 1;
+    switch (c) {
+      case '"':
+        _buf += "\\\"";
+        break;
+      case '\\':
+        _buf += "\\\\";
+        break;
+      case '\b':
+        _buf += "\\b";
+        break;
+      case '\f':
+        _buf += "\\f";
+        break;
+      case '\n':
+        _buf += "\\n";
+        break;
+      case '\r':
+        _buf += "\\r";
+        break;
+      case '\t':
+        _buf += "\\t";
+        break;
+      default:
+        _buf += "\\u00";
+        _buf += HEX[c >> 4];
+        _buf += HEX[c & 0xF];
+    }
+  }
+  _buf.append(s + start, n - start);
+
+  write('"');
+}
+
+// _____________________________________________________________________________
+void Writer::flush() {
+  if (_buf.size()) _out->write(_buf.data(), _buf.size());
+  _buf.clear();
+}
+
 // _____________________________________________________________________________
 void Writer::obj() {
   if (!_stack.empty() && _stack.top().type == OBJ)
@@ -35,7 +175,7 @@ void Writer::obj() {
   if (!_stack.empty() && _stack.top().type == KEY) _stack.pop();
   if (!_stack.empty() && _stack.top().type == ARR) valCheck();
   if (_stack.size() && _stack.top().type == ARR) prettor();
-  *_out << "{";
+  write('{');
   _stack.push({OBJ, 1});
 }
 
@@ -43,11 +183,12 @@ void Writer::obj() {
 void Writer::key(const std::string& k) {
   if (_stack.empty() || _stack.top().type != OBJ)
     throw WriterException("Keys only allowed in objects.");
-  if (!_stack.top().empty) (*_out) << ",";
+  if (!_stack.top().empty) write(',');
   _stack.top().empty = 0;
   prettor();
-  *_out << "\"" << k << "\""
-        << ":" << (_pretty ? " " : "");
+  write('"');
+  write(k);
+  write(_pretty ? "\": " : "\":");
   _stack.push({KEY, 1});
 }
 
@@ -57,7 +198,7 @@ void Writer::valCheck() {
     throw WriterException("Value not allowed here.");
   if (!_stack.empty() && _stack.top().type == KEY) _stack.pop();
   if (!_stack.empty() && _stack.top().type == ARR) {
-    if (!_stack.top().empty) (*_out) << "," << (_pretty ? " " : "");
+    if (!_stack.top().empty) write(_pretty ? ", " : ",");
     _stack.top().empty = 0;
   }
 }
@@ -65,43 +206,64 @@ void Writer::valCheck() {
 // _____________________________________________________________________________
 void Writer::val(const std::string& v) {
   valCheck();
-  *_out << "\"" << util::jsonStringEscape(v) << "\"";
+  writeStr(v.data(), v.size());
 }
 
 // _____________________________________________________________________________
 void Writer::val(const char* v) {
   valCheck();
-  *_out << "\"" << util::jsonStringEscape(v) << "\"";
+  writeStr(v, strlen(v));
 }
 
 // _____________________________________________________________________________
 void Writer::val(bool v) {
   valCheck();
-  *_out << (v ? "true" : "false");
+  write(v ? "true" : "false");
 }
 
 // _____________________________________________________________________________
 void Writer::val(int v) {
   valCheck();
-  *_out << v;
+  char buf[21];
+  size_t n = 0;
+  if (v < 0) buf[n++] = '-';
+  n += writeUInt(v < 0 ? -static_cast<int64_t>(v) : v, buf + n);
+  write(buf, n);
 }
 
 // _____________________________________________________________________________
 void Writer::val(size_t v) {
   valCheck();
-  *_out << v;
+  char buf[20];
+  write(buf, writeUInt(v, buf));
 }
 
 // _____________________________________________________________________________
 void Writer::val(double v) {
   valCheck();
-  *_out << std::fixed << std::setprecision(_floatPrec) << v;
+  char buf[32];
+
+  if (_floatPrec == PREC_SHORTEST && std::isfinite(v)) {
+    util::dtoa_milo(v, buf);
+    write(buf, strlen(buf));
+    return;
+  }
+
+  size_t n = fixedFloat(v, _floatPrec, buf);
+  if (n) {
+    write(buf, n);
+    return;
+  }
+
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(_floatPrec) << v;
+  write(ss.str());
 }
 
 // _____________________________________________________________________________
 void Writer::val(Null) {
   valCheck();
-  *_out << "null";
+  write("null");
 }
 
 // _____________________________________________________________________________
@@ -146,21 +308,22 @@ void Writer::arr() {
     throw WriterException("Array not allowed as key");
   if (!_stack.empty() && _stack.top().type == KEY) _stack.pop();
   if (!_stack.empty() && _stack.top().type == ARR) valCheck();
-  *_out << "[";
+  write('[');
   _stack.push({ARR, 1});
 }
 
 // _____________________________________________________________________________
 void Writer::prettor() {
   if (_pretty) {
-    *_out << "\n";
-    for (size_t i = 0; i < _indent * _stack.size(); i++) (*_out) << " ";
+    write('\n');
+    _buf.append(_indent * _stack.size(), ' ');
   }
 }
 
 // _____________________________________________________________________________
 void Writer::closeAll() {
   while (!_stack.empty()) close();
+  flush();
 }
 
 // _____________________________________________________________________________
@@ -170,11 +333,11 @@ void Writer::close() {
     case OBJ:
       _stack.pop();
       prettor();
-      (*_out) << "}";
+      write('}');
       break;
     case ARR:
       _stack.pop();
-      (*_out) << "]";
+      write(']');
       break;
     case KEY:
       throw WriterException("Missing value.");
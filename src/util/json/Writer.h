@@ -57,14 +57,19 @@ typedef std::string String;
 typedef std::vector<Val> Array;
 typedef std::map<std::string, Val> Dict;
 
-// simple JSON writer class without much overhead
+// float precision for the shortest representation which reads back to the
+// same double
+const size_t PREC_SHORTEST = static_cast<size_t>(-1);
+
+// simple JSON writer class without much overhead. Output is buffered and
+// written to the stream on flush(), closeAll() and destruction.
 class Writer {
  public:
   explicit Writer(std::ostream* out);
   Writer(std::ostream* out, size_t prec);
   Writer(std::ostream* out, size_t prec, bool pretty);
   Writer(std::ostream* out, size_t prec, bool pretty, size_t indent);
-  ~Writer(){};
+  ~Writer();
 
   void obj();
   void arr();
@@ -85,9 +90,13 @@ class Writer {
 
   void close();
   void closeAll();
+  void flush();
 
  private:
+  static const size_t BUF_SIZE = 1 << 16;
+
   std::ostream* _out;
+  std::string _buf;
 
   enum NODE_T { OBJ, ARR, KEY };
 
@@ -104,6 +113,12 @@ class Writer {
 
   void valCheck();
   void prettor();
+  void write(const char* s, size_t n);
+  void write(const std::string& s);
+  void write(char c);
+
+  // write a quoted string, escaped as util::jsonStringEscape() does
+  void writeStr(const char* s, size_t n);
 };
 
 }  // namespace json
@@ -0,0 +1,232 @@
+// Copyright 2017, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+// Authors: Patrick Brosi <brosi@informatik.uni-freiburg.de>
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "util/log/Log.h"
+
+using util::AsyncLog;
+
+std::atomic<std::ostream*> AsyncLog::_os(0);
+
+namespace {
+
+// a single-producer, single-consumer ring buffer of log messages
+struct Ring {
+  static const size_t SIZE = 1024;
+
+  struct Msg {
+    uint64_t seq;
+    std::string str;
+  };
+
+  Msg msgs[SIZE];
+
+  // the next slot to write, only written by the producing thread
+  std::atomic<size_t> head{0};
+
+  // the next slot to read, only written by the flusher
+  std::atomic<size_t> tail{0};
+
+  // set when the producing thread has finished
+  std::atomic<bool> retired{false};
+};
+
+struct Backend {
+  // guards everything but the atomics
+  std::mutex mut;
+  std::condition_variable wake, written;
+  std::vector<std::unique_ptr<Ring>> rings;
+  std::thread flusher;
+  bool running = false;
+  bool atExit = false;
+
+  // set until the flusher has written its last messages
+  bool flushing = false;
+
+  // the stream written by the flusher, kept after it stopped
+  std::ostream* os = 0;
+
+  std::atomic<uint64_t> numPushed{0};
+  std::atomic<uint64_t> numWritten{0};
+};
+
+// _____________________________________________________________________________
+Backend& backend() {
+  // never destroyed, threads may still log during static destruction
+  static Backend* b = new Backend();
+  return *b;
+}
+
+// the ring of a thread, retired when the thread finishes
+struct LocalRing {
+  ~LocalRing() {
+    if (ring) ring->retired.store(true, std::memory_order_release);
+  }
+  Ring* ring = 0;
+};
+
+// _____________________________________________________________________________
+Ring* localRing() {
+  static thread_local LocalRing l;
+  if (!l.ring) {
+    Backend& b = backend();
+    std::lock_guard<std::mutex> lock(b.mut);
+    b.rings.emplace_back(new Ring());
+    l.ring = b.rings.back().get();
+  }
+  return l.ring;
+}
+
+// _____________________________________________________________________________
+void flushLoop(Backend* b, std::ostream* os) {
+  std::vector<Ring::Msg> msgs;
+  std::unique_lock<std::mutex> lock(b->mut);
+
+  while (true) {
+    bool stopping = !b->running;
+
+    msgs.clear();
+    for (auto it = b->rings.begin(); it != b->rings.end();) {
+      Ring* r = it->get();
+      // read before draining, a retired ring stays empty afterwards
+      bool retired = r->retired.load(std::memory_order_acquire);
+      size_t t = r->tail.load(std::memory_order_relaxed);
+      // sequentially consistent, see AsyncLog::push()
+      size_t h = r->head.load();
+      for (; t < h; t++) msgs.push_back(std::move(r->msgs[t % Ring::SIZE]));
+      r->tail.store(h, std::memory_order_release);
+
+      if (retired) {
+        it = b->rings.erase(it);
+      } else {
+        it++;
+      }
+    }
+
+    if (msgs.size()) {
+      lock.unlock();
+
+      // restore the global order of messages from different threads
+      std::sort(msgs.begin(), msgs.end(),
+                [](const Ring::Msg& a, const Ring::Msg& c) {
+                  return a.seq < c.seq;
+                });
+      for (const auto& m : msgs) (*os) << m.str;
+      os->flush();
+
+      lock.lock();
+      b->numWritten += msgs.size();
+      b->written.notify_all();
+      continue;
+    }
+
+    if (stopping) break;
+    b->wake.wait_for(lock, std::chrono::milliseconds(20));
+  }
+
+  b->flushing = false;
+  b->written.notify_all();
+}
+
+// _____________________________________________________________________________
+void writeDirect(Backend* b, Ring* r) {
+  // messages queued after the flusher's last pass, write them once it has
+  // finished, unless logging was started again
+  std::unique_lock<std::mutex> lock(b->mut);
+  b->written.wait(lock, [b]() { return !b->flushing || b->running; });
+  if (b->running) return;
+
+  size_t t = r->tail.load(std::memory_order_relaxed);
+  size_t h = r->head.load(std::memory_order_acquire);
+  for (size_t i = t; i < h; i++) (*b->os) << r->msgs[i % Ring::SIZE].str;
+  b->os->flush();
+  r->tail.store(h, std::memory_order_release);
+  b->numWritten += h - t;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+void AsyncLog::start(std::ostream* os) {
+  Backend& b = backend();
+  std::lock_guard<std::mutex> lock(b.mut);
+  if (b.running) return;
+
+  b.running = true;
+  b.flushing = true;
+  b.os = os;
+  b.flusher = std::thread(flushLoop, &b, os);
+  _os.store(os);
+
+  // write the pending messages on exit
+  if (!b.atExit) std::atexit(AsyncLog::stop);
+  b.atExit = true;
+}
+
+// _____________________________________________________________________________
+void AsyncLog::stop() {
+  Backend& b = backend();
+  std::thread t;
+  {
+    std::lock_guard<std::mutex> lock(b.mut);
+    if (!b.running) return;
+    _os.store(0);
+    b.running = false;
+    t = std::move(b.flusher);
+  }
+
+  b.wake.notify_all();
+  t.join();
+  b.written.notify_all();
+}
+
+// _____________________________________________________________________________
+void AsyncLog::flush() {
+  Backend& b = backend();
+  uint64_t target = b.numPushed.load();
+
+  std::unique_lock<std::mutex> lock(b.mut);
+  b.wake.notify_all();
+  b.written.wait(lock, [&b, target]() {
+    return !b.running || b.numWritten.load() >= target;
+  });
+}
+
+// _____________________________________________________________________________
+void AsyncLog::push(std::string&& msg, bool sync) {
+  Backend& b = backend();
+  Ring* r = localRing();
+
+  uint64_t seq = b.numPushed.fetch_add(1);
+
+  size_t h = r->head.load(std::memory_order_relaxed);
+  while (h - r->tail.load(std::memory_order_acquire) >= Ring::SIZE) {
+    if (!_os.load()) {
+      // stopped, the flusher will not make room anymore
+      writeDirect(&b, r);
+      continue;
+    }
+
+    // full, wait for the flusher
+    b.wake.notify_all();
+    std::this_thread::yield();
+  }
+
+  r->msgs[h % Ring::SIZE].seq = seq;
+  r->msgs[h % Ring::SIZE].str = std::move(msg);
+
+  // both sequentially consistent: if stop() has not cleared the stream yet,
+  // the flusher's last pass sees the message, otherwise it is written here
+  r->head.store(h + 1);
+  if (!_os.load()) {
+    writeDirect(&b, r);
+    return;
+  }
+
+  if (sync) flush();
+}
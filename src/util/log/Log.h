@@ -5,10 +5,16 @@
 #ifndef UTIL_LOG_LOG_H_
 #define UTIL_LOG_LOG_H_
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <string>
 
 #define VDEBUG 4
 #define DEBUG 3
@@ -21,8 +27,20 @@
 #endif
 
 // compiler will optimize statement away if x > LOGLEVEL
-#define LOG(x) if (x <= LOGLEVEL) util::Log<x>().log()
-#define LOGTO(x, os) if (x <= LOGLEVEL) util::Log<x>(&os).log()
+#define LOG(x) \
+  if (x <= LOGLEVEL && util::logEnabled(x)) util::Log<x>().log()
+#define LOGTO(x, os) \
+  if (x <= LOGLEVEL && util::logEnabled(x)) util::Log<x>(&os).log()
+
+// like LOGTO, but logs at most once every ms milliseconds per call site, for
+// progress messages in loops
+#define LOGTO_EVERY(x, os, ms)                                     \
+  if (x <= LOGLEVEL && util::logEnabled(x) &&                      \
+      []() -> util::LogRate& {                                     \
+        static util::LogRate r;                                    \
+        return r;                                                  \
+      }().pass(ms))                                                \
+  util::Log<x>(&os).log()
 
 using std::setfill;
 using std::setw;
@@ -32,24 +50,105 @@ namespace util {
 
 static const char* LOGS[] = {"ERROR", "WARN ", "INFO ", "DEBUG", "DEBUG"};
 
+// writes the messages logged to a stream from a background thread, which
+// collects them from per-thread ring buffers. Messages of one thread are
+// written in order, messages of different threads only within one pass of
+// the background thread over the buffers.
+class AsyncLog {
+ public:
+  // write messages logged to os asynchronously. Should be called before any
+  // threads are spawned.
+  static void start(std::ostream* os);
+
+  // stop the background thread after writing all pending messages, messages
+  // are written synchronously again afterwards
+  static void stop();
+
+  // wait until all messages logged so far have been written
+  static void flush();
+
+  // the stream written asynchronously, or 0
+  static std::ostream* stream() {
+    return _os.load(std::memory_order_acquire);
+  }
+
+  // queue a message for the background thread, if sync is set, wait until
+  // it has been written. If the background thread has been stopped
+  // meanwhile, the message is written directly.
+  static void push(std::string&& msg, bool sync);
+
+ private:
+  static std::atomic<std::ostream*> _os;
+};
+
+// the runtime log level, initialized from the environment variable LOGLEVEL.
+// Levels above the compile-time LOGLEVEL are never logged.
+inline std::atomic<int>& logLevel() {
+  static std::atomic<int> lvl(getenv("LOGLEVEL") ? atoi(getenv("LOGLEVEL"))
+                                                  : LOGLEVEL);
+  return lvl;
+}
+
+// _____________________________________________________________________________
+inline void setLogLevel(int lvl) { logLevel().store(lvl); }
+
+// _____________________________________________________________________________
+inline bool logEnabled(int lvl) {
+  return lvl <= logLevel().load(std::memory_order_relaxed);
+}
+
+// lets a message pass at most once in a given interval
+class LogRate {
+ public:
+  LogRate() : _last(std::numeric_limits<int64_t>::min()) {}
+
+  bool pass(int64_t ms) {
+    int64_t now = duration_cast<milliseconds>(
+                      steady_clock::now().time_since_epoch()).count();
+    int64_t last = _last.load(std::memory_order_relaxed);
+    if (last != std::numeric_limits<int64_t>::min() && now - last < ms) {
+      return false;
+    }
+    return _last.compare_exchange_strong(last, now);
+  }
+
+ private:
+  std::atomic<int64_t> _last;
+};
+
 template <char LVL>
 class Log {
  public:
   Log() { if (LVL < INFO) os = &std::cerr; else os = &std::cout; }
   Log(std::ostream* s) { os = s; }
-  ~Log() { buf << std::endl; (*os) << buf.str(); }
+  ~Log() {
+    if (os == AsyncLog::stream()) {
+      buf << '\n';
+      // make sure errors are out before we may crash
+      AsyncLog::push(buf.str(), LVL == ERROR);
+    } else {
+      buf << std::endl;
+      (*os) << buf.str();
+    }
+  }
   std::ostream& log() { return ts() << LOGS[(size_t)LVL] << ": "; }
 
  private:
   std::ostream* os;
   std::ostringstream buf;
   std::ostream& ts() {
-    char tl[20];
+    // formatting the date is expensive, only do it once per second
+    static thread_local time_t lastT = -1;
+    static thread_local char tl[20];
     auto n = system_clock::now();
     time_t tt = system_clock::to_time_t(n);
     int m = duration_cast<milliseconds>(n-time_point_cast<seconds>(n)).count();
-    struct tm t = *localtime(&tt);
-    strftime(tl, 20, "%Y-%m-%d %H:%M:%S", &t);
+    if (tt != lastT) {
+      struct tm t;
+      localtime_r(&tt, &t);
+      strftime(tl, 20, "%Y-%m-%d %H:%M:%S", &t);
+      lastT = tt;
+    }
     return buf << "[" << tl << "." << setfill('0') << setw(3) << m << "] ";
   }
 };
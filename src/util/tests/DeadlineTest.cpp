@@ -0,0 +1,65 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <chrono>
+#include <thread>
+#include "util/Deadline.h"
+#include "util/Misc.h"
+#include "util/tests/DeadlineTest.h"
+
+using util::Deadline;
+
+// _____________________________________________________________________________
+void DeadlineTest::run() {
+  {
+    // no time limit
+    Deadline d;
+    TEST(d.limited(), ==, false);
+    TEST(d.expired(), ==, false);
+    TEST(d.remaining(), >, 1e300);
+    TEST(d.clampTimeLim(-1), ==, -1);
+    TEST(d.clampTimeLim(60), ==, 60);
+
+    Deadline neg(-1);
+    TEST(neg.limited(), ==, false);
+    TEST(neg.expired(), ==, false);
+  }
+
+  {
+    Deadline d(3600);
+    TEST(d.limited(), ==, true);
+    TEST(d.expired(), ==, false);
+    TEST(d.remaining(), >, 3500);
+    TEST(d.remaining(), <=, 3600);
+    TEST(d.clampTimeLim(60), ==, 60);
+    TEST(d.clampTimeLim(-1), >=, 3599);
+    TEST(d.clampTimeLim(7200), <=, 3600);
+  }
+
+  {
+    Deadline d(0.01);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    TEST(d.expired(), ==, true);
+    TEST(d.remaining(), ==, 0);
+
+    // solvers treat a limit of 0 as none
+    TEST(d.clampTimeLim(-1), ==, 1);
+    TEST(d.clampTimeLim(60), ==, 1);
+  }
+
+  {
+    // copies share the cancellation state
+    Deadline d;
+    Deadline cp = d;
+    std::thread t([&cp]() { cp.cancel(); });
+    t.join();
+    TEST(d.expired(), ==, true);
+    TEST(d.remaining(), ==, 0);
+    TEST(d.clampTimeLim(-1), ==, 1);
+
+    // ... but a new deadline does not
+    d = Deadline(3600);
+    TEST(d.expired(), ==, false);
+    TEST(cp.expired(), ==, true);
+  }
+}
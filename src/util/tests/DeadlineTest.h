@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef UTIL_TEST_DEADLINETEST_H_
+#define UTIL_TEST_DEADLINETEST_H_
+
+class DeadlineTest {
+  public:
+    void run();
+};
+
+#endif
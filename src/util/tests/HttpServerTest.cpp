@@ -0,0 +1,239 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#ifdef ZLIB_FOUND
+#include <zlib.h>
+#endif
+#include "util/Misc.h"
+#include "util/http/Server.h"
+#include "util/tests/HttpServerTest.h"
+
+using util::http::Answer;
+using util::http::HttpServer;
+using util::http::Req;
+
+namespace {
+
+// answers with the URL, the payload size, or a large text for /big
+class TestHandler : public util::http::Handler {
+ public:
+  Answer handle(const Req& req, int connection) const {
+    UNUSED(connection);
+    if (req.url == "/big") return Answer("200 OK", big());
+    if (req.cmd == "POST") {
+      return Answer("200 OK", std::to_string(req.payload.size()));
+    }
+    return Answer("200 OK", req.url);
+  }
+
+  static std::string big() {
+    std::string ret;
+    for (size_t i = 0; i < 100000; i++) ret += std::to_string(i) + ",";
+    return ret;
+  }
+};
+
+struct Res {
+  std::string head, body;
+};
+
+// _____________________________________________________________________________
+int connect(int port) {
+  int sock = socket(PF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr;
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+  if (connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr))) {
+    close(sock);
+    return -1;
+  }
+  return sock;
+}
+
+// _____________________________________________________________________________
+void sendAll(int sock, const std::string& s) {
+  size_t w = 0;
+  while (w < s.size()) w += write(sock, s.data() + w, s.size() - w);
+}
+
+// _____________________________________________________________________________
+bool fill(int sock, std::string* buf, size_t n) {
+  char tmp[4096];
+  while (buf->size() < n) {
+    ssize_t r = read(sock, tmp, sizeof(tmp));
+    if (r <= 0) return false;
+    buf->append(tmp, r);
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+bool line(int sock, std::string* buf, std::string* ret) {
+  size_t p;
+  while ((p = buf->find("\r\n")) == std::string::npos) {
+    if (!fill(sock, buf, buf->size() + 1)) return false;
+  }
+  *ret = buf->substr(0, p);
+  buf->erase(0, p + 2);
+  return true;
+}
+
+// _____________________________________________________________________________
+Res answer(int sock, std::string* buf) {
+  Res r;
+  std::string l;
+  while (line(sock, buf, &l) && !l.empty()) r.head += l + "\n";
+
+  size_t p = r.head.find("Content-Length: ");
+  if (p != std::string::npos) {
+    size_t len = atol(r.head.c_str() + p + 16);
+    fill(sock, buf, len);
+    r.body = buf->substr(0, len);
+    buf->erase(0, len);
+    return r;
+  }
+
+  // chunked
+  while (line(sock, buf, &l)) {
+    size_t len = strtol(l.c_str(), 0, 16);
+    fill(sock, buf, len + 2);
+    r.body += buf->substr(0, len);
+    buf->erase(0, len + 2);
+    if (!len) break;
+  }
+  return r;
+}
+
+// _____________________________________________________________________________
+std::string gunzip(const std::string& s) {
+#ifdef ZLIB_FOUND
+  z_stream str;
+  str.zalloc = Z_NULL;
+  str.zfree = Z_NULL;
+  str.opaque = Z_NULL;
+  str.avail_in = s.size();
+  str.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(s.data()));
+  inflateInit2(&str, 15 + 16);
+
+  std::string ret;
+  char out[4096];
+  int st;
+  do {
+    str.avail_out = sizeof(out);
+    str.next_out = reinterpret_cast<Bytef*>(out);
+    st = inflate(&str, Z_NO_FLUSH);
+    ret.append(out, sizeof(out) - str.avail_out);
+  } while (st == Z_OK);
+  inflateEnd(&str);
+  return ret;
+#else
+  return s;
+#endif
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+void HttpServerTest::run() {
+  // never destroyed, the workers still wait on its queue at exit
+  HttpServer* srv = new HttpServer(0, new TestHandler(), 2);
+  std::thread(&HttpServer::run, srv).detach();
+
+  // blocks until the server accepts connections
+  int port = srv->port();
+  TEST(port, >, 0);
+
+  {
+    // keep-alive, several requests on one connection
+    int sock = connect(port);
+    TEST(sock, >=, 0);
+    std::string buf;
+
+    sendAll(sock, "GET /a HTTP/1.1\r\nHost: x\r\n\r\n");
+    Res r = answer(sock, &buf);
+    TEST(r.head.find("200 OK") != std::string::npos);
+    TEST(r.head.find("Connection: keep-alive") != std::string::npos);
+    TEST(r.body, ==, "/a");
+
+    sendAll(sock, "GET /b HTTP/1.1\r\n\r\n");
+    r = answer(sock, &buf);
+    TEST(r.body, ==, "/b");
+
+    // pipelined requests, with a binary payload in between
+    std::string pl("a\0b\0c", 5);
+    sendAll(sock,
+            "GET /c HTTP/1.1\r\n\r\nPOST /d HTTP/1.1\r\nContent-Length: 5\r\n"
+            "\r\n" + pl + "GET /e HTTP/1.1\r\nconnection: close\r\n\r\n");
+    TEST(answer(sock, &buf).body, ==, "/c");
+    TEST(answer(sock, &buf).body, ==, "5");
+    r = answer(sock, &buf);
+    TEST(r.body, ==, "/e");
+    TEST(r.head.find("Connection: close") != std::string::npos);
+
+    // the server closed the connection
+    TEST(!fill(sock, &buf, 1));
+    close(sock);
+  }
+
+  {
+    // HTTP/1.0 connections are closed after the answer
+    int sock = connect(port);
+    std::string buf;
+    sendAll(sock, "GET /f HTTP/1.0\r\n\r\n");
+    Res r = answer(sock, &buf);
+    TEST(r.body, ==, "/f");
+    TEST(!fill(sock, &buf, 1));
+    close(sock);
+  }
+
+#ifdef ZLIB_FOUND
+  {
+    // large answers are compressed and streamed in chunks
+    int sock = connect(port);
+    std::string buf;
+    sendAll(sock, "GET /big HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n");
+    Res r = answer(sock, &buf);
+    TEST(r.head.find("Transfer-Encoding: chunked") != std::string::npos);
+    TEST(r.head.find("Content-Encoding: gzip") != std::string::npos);
+    TEST(r.body.size(), <, TestHandler::big().size());
+    TEST(gunzip(r.body) == TestHandler::big());
+
+    // the connection is still usable
+    sendAll(sock, "GET /g HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n");
+    TEST(answer(sock, &buf).body, ==, "/g");
+
+    // HTTP/1.0 clients get the compressed answer in one piece
+    sendAll(sock, "GET /big HTTP/1.0\r\nAccept-Encoding: gzip\r\n\r\n");
+    r = answer(sock, &buf);
+    TEST(r.head.find("Content-Length") != std::string::npos);
+    TEST(gunzip(r.body) == TestHandler::big());
+    close(sock);
+  }
+#endif
+
+  {
+    // malformed requests
+    int sock = connect(port);
+    std::string buf;
+    sendAll(sock, "GET /h HTTP/1.1\r\n" + std::string(8000, 'x') + "\r\n\r\n");
+    Res r = answer(sock, &buf);
+    TEST(r.head.find("431") != std::string::npos);
+
+    // the unread rest of the request was drained, so the connection is
+    // closed without a reset
+    TEST(r.body, ==, "431 Request Header Fields Too Large");
+    TEST(buf.empty());
+    char c;
+    TEST(read(sock, &c, 1), ==, 0);
+    close(sock);
+  }
+}
@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef UTIL_TEST_HTTPSERVERTEST_H_
+#define UTIL_TEST_HTTPSERVERTEST_H_
+
+class HttpServerTest {
+  public:
+    void run();
+};
+
+#endif
@@ -0,0 +1,112 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "util/Misc.h"
+#include "util/String.h"
+#include "util/log/Log.h"
+#include "util/tests/LogTest.h"
+
+// _____________________________________________________________________________
+void LogTest::run() {
+  {
+    // synchronous logging
+    std::stringstream ss;
+    LOGTO(WARN, ss) << "a " << 1;
+    TEST(ss.str().find("WARN : a 1\n") != std::string::npos);
+  }
+
+  {
+    // runtime level filter
+    std::stringstream ss;
+    int lvl = util::logLevel();
+    util::setLogLevel(ERROR);
+    LOGTO(WARN, ss) << "a";
+    TEST(ss.str(), ==, "");
+    util::setLogLevel(lvl);
+    LOGTO(WARN, ss) << "a";
+    TEST(ss.str().size(), >, 0);
+  }
+
+  {
+    // rate limited messages
+    std::stringstream ss;
+    for (size_t i = 0; i < 1000; i++) {
+      LOGTO_EVERY(WARN, ss, 60000) << "progress " << i;
+    }
+    TEST(util::split(ss.str(), '\n').size(), ==, 1);
+    TEST(ss.str().find("progress 0\n") != std::string::npos);
+  }
+
+  {
+    // asynchronous logging from several threads, with more messages per
+    // thread than fit into a ring buffer
+    std::stringstream ss, other;
+    util::AsyncLog::start(&ss);
+    TEST(util::AsyncLog::stream() == &ss);
+
+    std::vector<std::thread> thrds;
+    for (size_t t = 0; t < 4; t++) {
+      thrds.push_back(std::thread([t]() {
+        for (size_t i = 0; i < 3000; i++) {
+          LOGTO(WARN, *util::AsyncLog::stream()) << "t" << t << " m" << i;
+        }
+      }));
+    }
+    for (auto& t : thrds) t.join();
+
+    // other streams are still written synchronously
+    LOGTO(WARN, other) << "sync";
+    TEST(other.str().find("sync") != std::string::npos);
+
+    util::AsyncLog::flush();
+
+    auto lines = util::split(ss.str(), '\n');
+    TEST(lines.size(), ==, 12000);
+
+    // every message is intact, and the messages of a thread are in order
+    std::vector<size_t> next(4, 0);
+    bool ok = true;
+    for (size_t i = 0; i < 12000; i++) {
+      size_t p = lines[i].find("WARN : t");
+      if (p == std::string::npos) {
+        ok = false;
+        break;
+      }
+      size_t t = atoi(lines[i].c_str() + p + 8);
+      size_t m = atoi(lines[i].c_str() + lines[i].find(" m", p) + 2);
+      if (t > 3 || m != next[t]) {
+        ok = false;
+        break;
+      }
+      next[t]++;
+    }
+    TEST(ok);
+
+    // errors are written before the log call returns
+    LOGTO(ERROR, ss) << "err";
+    TEST(ss.str().find("ERROR: err\n") != std::string::npos);
+
+    LOGTO(WARN, ss) << "last";
+    util::AsyncLog::stop();
+    TEST(util::AsyncLog::stream() == 0);
+    TEST(ss.str().find("WARN : last\n") != std::string::npos);
+
+    LOGTO(WARN, ss) << "after";
+    TEST(ss.str().find("WARN : after\n") != std::string::npos);
+
+    // messages queued by threads which saw the stream just before it was
+    // stopped are written directly, even more than fit into a ring buffer
+    ss.str("");
+    for (size_t i = 0; i < 3000; i++) {
+      util::AsyncLog::push("late " + std::to_string(i) + "\n", false);
+    }
+    lines = util::split(ss.str(), '\n');
+    TEST(lines.size(), ==, 3000);
+    TEST(lines.front(), ==, "late 0");
+    TEST(lines.back(), ==, "late 2999");
+  }
+}
@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef UTIL_TEST_LOGTEST_H_
+#define UTIL_TEST_LOGTEST_H_
+
+class LogTest {
+  public:
+    void run();
+};
+
+#endif
@@ -0,0 +1,176 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "util/Misc.h"
+#include "util/Stats.h"
+#include "util/graph/Dijkstra.h"
+#include "util/graph/DirGraph.h"
+#include "util/tests/StatsTest.h"
+
+using util::graph::Dijkstra;
+using util::graph::DirGraph;
+using util::graph::Edge;
+using util::graph::Node;
+using util::json::Dict;
+
+namespace {
+
+// _____________________________________________________________________________
+size_t counter(const Dict& stats, const std::string& name) {
+  return stats.at("counters").dict.at(name).ui;
+}
+
+struct CostFunc : public Dijkstra::CostFunc<int, int, int> {
+  int operator()(const Node<int, int>* from, const Edge<int, int>* e,
+                 const Node<int, int>* to) const {
+    UNUSED(from);
+    UNUSED(to);
+    return e->pl();
+  }
+  int inf() const { return 999; }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+void StatsTest::run() {
+  util::stats::reset();
+
+  {
+    // nothing is recorded before stats are enabled
+    STATS_COUNT(GRID_QUERIES, 5);
+    util::stats::Timer t("disabled", false);
+  }
+
+  auto s = util::stats::toJson();
+  TEST(counter(s, "grid_queries"), ==, 0);
+  TEST(s["timers"].dict.size(), ==, 0);
+
+  util::stats::enable();
+
+  {
+    // counters of finished threads are kept
+    util::stats::count(util::stats::SCORER_CALLS, 2);
+    std::vector<std::thread> thrds;
+    for (size_t i = 0; i < 3; i++) {
+      thrds.push_back(std::thread([]() {
+        for (size_t j = 0; j < 1000; j++) {
+          util::stats::count(util::stats::SCORER_CALLS, 1);
+        }
+      }));
+    }
+    for (auto& t : thrds) t.join();
+
+    s = util::stats::toJson();
+    TEST(counter(s, "scorer_calls"), ==, 3002);
+    TEST(s["threads"].arr.size(), >=, 4);
+  }
+
+  {
+    { util::stats::Timer t("a", false); }
+    { util::stats::Timer t("a", false); }
+    {
+      util::stats::Timer t("phase", true);
+      std::vector<char> buf(1 << 20, 1);
+      TEST(buf[100], ==, 1);
+    }
+
+    s = util::stats::toJson();
+    TEST(s["timers"].dict.size(), ==, 1);
+    TEST(s["timers"].dict["a"].dict["count"].ui, ==, 2);
+    TEST(s["phases"].arr.size(), ==, 1);
+    TEST(s["phases"].arr[0].dict["name"].str, ==, "phase");
+    TEST(s["phases"].arr[0].dict["rss_after"].ui, >, 0);
+    TEST(s["phases"].arr[0].dict["peak_rss"].ui, >=,
+         s["phases"].arr[0].dict["rss_after"].ui);
+
+    std::stringstream ss;
+    util::stats::writeTrace(&ss);
+    TEST(ss.str().find("\"traceEvents\":["), !=, std::string::npos);
+    TEST(ss.str().find("\"name\":\"phase\""), !=, std::string::npos);
+    TEST(ss.str().find("\"ph\":\"X\""), !=, std::string::npos);
+  }
+
+  // every phase gets its own peak, an enclosing one also those of its
+  // children
+  if (std::ofstream("/proc/self/clear_refs").good()) {
+    util::stats::reset();
+    {
+      util::stats::Timer outer("outer", true);
+      {
+        util::stats::Timer t("big", true);
+        std::vector<char> buf(64 << 20, 1);
+        TEST(buf[100], ==, 1);
+      }
+      { util::stats::Timer t("small", true); }
+    }
+
+    s = util::stats::toJson();
+    TEST(s["phases"].arr.size(), ==, 3);
+    size_t outer = s["phases"].arr[0].dict["peak_rss"].ui;
+    size_t big = s["phases"].arr[1].dict["peak_rss"].ui;
+    size_t small = s["phases"].arr[2].dict["peak_rss"].ui;
+    TEST(s["phases"].arr[1].dict["name"].str, ==, "big");
+    TEST(big, >, small + (32 << 20));
+    TEST(outer, >=, big);
+  }
+
+  {
+    util::stats::reset();
+    {
+      util::stats::MemTrack a(util::stats::MEM_GRID);
+      util::stats::MemTrack b(util::stats::MEM_GRID);
+      a.set(100);
+      b.set(50);
+      a.set(20);
+      TEST(util::stats::memUsage(util::stats::MEM_GRID), ==, 70);
+      TEST(util::stats::memPeak(util::stats::MEM_GRID), ==, 150);
+
+      s = util::stats::toJson();
+      TEST(s["memory"].dict["grid"].dict["bytes"].ui, ==, 70);
+      TEST(s["memory"].dict["grid"].dict["peak_bytes"].ui, ==, 150);
+      TEST(s["memory"].dict["peak_rss"].ui, >, 0);
+    }
+
+    // released on destruction, the peak is kept until the next reset
+    TEST(util::stats::memUsage(util::stats::MEM_GRID), ==, 0);
+    TEST(util::stats::memPeak(util::stats::MEM_GRID), ==, 150);
+    util::stats::reset();
+    TEST(util::stats::memPeak(util::stats::MEM_GRID), ==, 0);
+
+    DirGraph<int, int> g;
+    size_t empty = g.memUsage();
+    g.addEdg(g.addNd(1), g.addNd(2), 1);
+    TEST(g.memUsage(), >, empty);
+  }
+
+#if UTIL_STATS
+  {
+    util::stats::reset();
+
+    // a -> b -> c, and a -> c
+    DirGraph<int, int> g;
+    auto a = g.addNd(1);
+    auto b = g.addNd(2);
+    auto c = g.addNd(3);
+    g.addEdg(a, b, 1);
+    g.addEdg(b, c, 1);
+    g.addEdg(a, c, 5);
+
+    TEST(Dijkstra::shortestPath(a, c, CostFunc()), ==, 2);
+
+    s = util::stats::toJson();
+    TEST(counter(s, "settled_nodes"), ==, 3);
+    TEST(counter(s, "relaxations"), ==, 3);
+    TEST(counter(s, "pq_pushes"), ==, 4);
+  }
+#endif
+
+  util::stats::reset();
+  util::stats::ENABLED = false;
+}
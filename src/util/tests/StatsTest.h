@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef UTIL_TEST_STATSTEST_H_
+#define UTIL_TEST_STATSTEST_H_
+
+class StatsTest {
+  public:
+    void run();
+};
+
+#endif
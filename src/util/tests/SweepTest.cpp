@@ -0,0 +1,65 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "util/Misc.h"
+#include "util/Sweep.h"
+#include "util/tests/SweepTest.h"
+
+using util::sweep::ParamSet;
+
+// _____________________________________________________________________________
+void SweepTest::run() {
+  {
+    std::stringstream ss;
+    ss << "# comment\n"
+       << "\n"
+       << "  -d 30 --no-infer-restrs  \n"
+       << "--diag-pen {1,2} -g {50%,100%,150%}\n";
+
+    auto sets = util::sweep::read(&ss);
+    TEST(sets.size(), ==, 7);
+
+    TEST(util::sweep::toString(sets[0]), ==, "-d 30 --no-infer-restrs");
+
+    // the cartesian product, the last value varies fastest
+    TEST(util::sweep::toString(sets[1]), ==, "--diag-pen 1 -g 50%");
+    TEST(util::sweep::toString(sets[2]), ==, "--diag-pen 1 -g 100%");
+    TEST(util::sweep::toString(sets[3]), ==, "--diag-pen 1 -g 150%");
+    TEST(util::sweep::toString(sets[4]), ==, "--diag-pen 2 -g 50%");
+    TEST(util::sweep::toString(sets[6]), ==, "--diag-pen 2 -g 150%");
+  }
+
+  {
+    std::stringstream ss;
+    ss << "--diag-pen {1,2\n";
+
+    bool thrown = false;
+    try {
+      util::sweep::read(&ss);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    TEST(thrown);
+  }
+
+  {
+    std::stringstream ss;
+    auto sets = util::sweep::read(&ss);
+    TEST(sets.size(), ==, 0);
+  }
+
+  {
+    // a single record per line
+    std::vector<ParamSet> sets{{"--diag-pen", "2"}};
+    std::vector<util::json::Dict> stats{{{"statistics", size_t(3)}}};
+
+    std::stringstream out;
+    util::sweep::writeStats(sets, stats, &out);
+    TEST(out.str(), ==,
+         "{\"params\":\"--diag-pen 2\",\"set\":0,\"statistics\":3}\n");
+  }
+}
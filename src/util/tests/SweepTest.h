@@ -0,0 +1,12 @@
+// Copyright 2016
+// Author: Patrick Brosi
+
+#ifndef UTIL_TEST_SWEEPTEST_H_
+#define UTIL_TEST_SWEEPTEST_H_
+
+class SweepTest {
+  public:
+    void run();
+};
+
+#endif
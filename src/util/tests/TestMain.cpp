@@ -2,11 +2,22 @@
 // Author: Patrick Brosi
 //
 
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
 #include <string>
+#include <vector>
 #include "util/Misc.h"
 #include "util/Nullable.h"
+#include "util/Sha256.h"
 #include "util/String.h"
+#include "util/tests/DeadlineTest.h"
+#include "util/tests/HttpServerTest.h"
+#include "util/tests/LogTest.h"
 #include "util/tests/QuadTreeTest.h"
+#include "util/tests/StatsTest.h"
+#include "util/tests/SweepTest.h"
 #include "util/geo/Geo.h"
 #include "util/geo/Grid.h"
 #include "util/graph/Algorithm.h"
@@ -15,6 +26,7 @@
 #include "util/graph/DirGraph.h"
 #include "util/graph/EDijkstra.h"
 #include "util/graph/UndirGraph.h"
+#include "util/json/Reader.h"
 #include "util/json/Writer.h"
 
 using namespace util;
@@ -23,6 +35,38 @@ using namespace util::graph;
 
 using util::approx;
 
+namespace {
+// _____________________________________________________________________________
+double frechetDistRec(size_t i, size_t j, const Line<double>& p,
+                      const Line<double>& q, std::vector<float>& ca) {
+  // the memoized recursion frechetDist() replaced, as a reference
+  float& c = ca[i * q.size() + j];
+  if (c > -1) return c;
+
+  if (i == 0 && j == 0)
+    c = dist(p[0], q[0]);
+  else if (j == 0)
+    c = std::max(frechetDistRec(i - 1, 0, p, q, ca), dist(p[i], q[0]));
+  else if (i == 0)
+    c = std::max(frechetDistRec(0, j - 1, p, q, ca), dist(p[0], q[j]));
+  else
+    c = std::max(std::min(std::min(frechetDistRec(i - 1, j, p, q, ca),
+                                   frechetDistRec(i - 1, j - 1, p, q, ca)),
+                          frechetDistRec(i, j - 1, p, q, ca)),
+                 dist(p[i], q[j]));
+
+  return c;
+}
+
+// _____________________________________________________________________________
+double frechetDistRef(const Line<double>& a, const Line<double>& b, double d) {
+  const auto& p = densify(a, d);
+  const auto& q = densify(b, d);
+  std::vector<float> ca(p.size() * q.size(), -1);
+  return frechetDistRec(p.size() - 1, q.size() - 1, p, q, ca);
+}
+}  // namespace
+
 // _____________________________________________________________________________
 int main(int argc, char** argv) {
 	UNUSED(argc);
@@ -33,6 +77,42 @@ int main(int argc, char** argv) {
   QuadTreeTest quadTreeTest;
   quadTreeTest.run();
 
+  HttpServerTest httpServerTest;
+  httpServerTest.run();
+
+  StatsTest statsTest;
+  statsTest.run();
+
+  DeadlineTest deadlineTest;
+  deadlineTest.run();
+
+  LogTest logTest;
+  logTest.run();
+
+  SweepTest sweepTest;
+  sweepTest.run();
+
+  // ___________________________________________________________________________
+  {
+    TEST(util::sha256(""), ==,
+         "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    TEST(util::sha256("abc"), ==,
+         "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    TEST(util::sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+         ==,
+         "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    // incremental updates across block boundaries
+    std::string a(1000, 'a');
+    util::Sha256 h;
+    for (size_t i = 0; i < 1000; i++) h.update(a.data(), 1 + i % 117);
+    std::string b;
+    for (size_t i = 0; i < 1000; i++) b += a.substr(0, 1 + i % 117);
+    TEST(h.hex(), ==, util::sha256(b));
+    TEST(util::sha256(std::string(1000000, 'a')), ==,
+         "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+  }
+
   // ___________________________________________________________________________
   {
     TEST(geo::frechetDist(Line<double>{{0, 0}, {10, 10}}, Line<double>{{0, 0},
@@ -53,6 +133,31 @@ int main(int argc, char** argv) {
 
     TEST(geo::frechetDist(Line<double>{{0, 10}, {0, 10}}, Line<double>{{0, 5},
                                   {0, 5}}, 0.1) == approx(5));
+
+    // the two-row table gives the same as the full recursion
+    std::vector<Line<double>> lines = {
+        {{0, 0}, {10, 10}, {20, 0}},
+        {{0, 1}, {10, 12}, {21, 0}},
+        {{0, 0}, {5, 5}, {10, 0}, {15, 5}, {20, 0}},
+        {{20, 0}, {10, 10}, {0, 0}},
+        {{0, 0}, {0, 0}, {10, 0}, {10, 0}},
+        {{0, 1}, {30, 1}},
+        {{5, 5}},
+        {{-3, 7}},
+        {{2, 2}, {2, 2}}};
+
+    for (const auto& a : lines) {
+      for (const auto& b : lines) {
+        for (double d : {0.5, 3.0, 100.0}) {
+          TEST(geo::frechetDist(a, b, d) == approx(frechetDistRef(a, b, d)));
+        }
+      }
+    }
+
+    TEST(geo::frechetDist(Line<double>{{5, 5}}, Line<double>{{5, 5}}, 1) ==
+         approx(0));
+    TEST(geo::frechetDist(Line<double>{{0, 0}}, Line<double>{{0, 3}, {4, 0}},
+                          1) == approx(4));
   }
 
   // ___________________________________________________________________________
@@ -152,6 +257,181 @@ int main(int argc, char** argv) {
             ss.str() == "[1,[2.13,{\"B\":2.12,\"a\":1},4],0]"));
   }
 
+  // ___________________________________________________________________________
+  {
+    // fixed precision output is the same as that of the standard streams
+    std::vector<double> vals{0,       -0.0,     0.25,    0.35,     -0.001,
+                             1e-300,  5e-11,    1.5e-10, 2.5e-10,  1e17,
+                             1e300,   -1e22,    873838.4254750526,
+                             6099451.017543876, 1.0 / 3, 10.0 / 7};
+    for (size_t i = 0; i < 2000; i++) {
+      vals.push_back((rand() - RAND_MAX / 2) * 1.0 / (rand() + 1) *
+                     std::pow(10, rand() % 16));
+    }
+
+    for (size_t prec : {0, 1, 2, 5, 10, 17, 20}) {
+      for (double v : vals) {
+        std::stringstream ss, exp;
+        util::json::Writer wr(&ss, prec, false);
+        wr.arr();
+        wr.val(v);
+        wr.closeAll();
+        exp << "[" << std::fixed << std::setprecision(prec) << v << "]";
+        TEST(ss.str(), ==, exp.str());
+      }
+    }
+
+    // shortest output reads back to the same value
+    for (double v : vals) {
+      std::stringstream ss;
+      util::json::Writer wr(&ss, util::json::PREC_SHORTEST, false);
+      wr.arr();
+      wr.val(v);
+      wr.closeAll();
+      TEST(ss.str().size(), <=, 27);
+      TEST(strtod(ss.str().c_str() + 1, 0) == v);
+    }
+
+    std::stringstream ss;
+    util::json::Writer wr(&ss, util::json::PREC_SHORTEST, false);
+    wr.val(util::json::Array{0.1, 100.0, 1e30, "a\"\\\n\x01\xC3\xA4"});
+    wr.closeAll();
+    TEST(ss.str(), ==, "[0.1,100.0,1e30,\"a\\\"\\\\\\n\\u0001\xC3\xA4\"]");
+  }
+
+  // ___________________________________________________________________________
+  {
+    std::stringstream ss(
+        "{\"a\" : [1, -2.5e2, \"x\\\"y\\u00e4\\n\"], \"b\":{\"c\":null},"
+        "\"d\": true, \"e\": [[]], \"f\": 7}");
+    util::json::Reader r(&ss);
+
+    TEST(r.next(), ==, util::json::Reader::OBJ_START);
+    TEST(r.next(), ==, util::json::Reader::KEY);
+    TEST(r.str(), ==, "a");
+    TEST(r.next(), ==, util::json::Reader::ARR_START);
+    TEST(r.next(), ==, util::json::Reader::NUMBER);
+    TEST(r.num(), ==, approx(1));
+    TEST(r.next(), ==, util::json::Reader::NUMBER);
+    TEST(r.num(), ==, approx(-250));
+    TEST(r.str(), ==, "-2.5e2");
+    TEST(r.next(), ==, util::json::Reader::STRING);
+    TEST(r.str(), ==, "x\"y\xC3\xA4\n");
+    TEST(r.next(), ==, util::json::Reader::ARR_END);
+
+    TEST(r.next(), ==, util::json::Reader::KEY);
+    TEST(r.str(), ==, "b");
+    r.skipVal();
+    TEST(r.type(), ==, util::json::Reader::OBJ_END);
+
+    TEST(r.next(), ==, util::json::Reader::KEY);
+    TEST(r.next(), ==, util::json::Reader::BOOL);
+    TEST(r.boolean());
+
+    TEST(r.next(), ==, util::json::Reader::KEY);
+    TEST(r.strVal(), ==, "");
+    TEST(r.next(), ==, util::json::Reader::KEY);
+    TEST(r.strVal(), ==, "7");
+
+    TEST(r.next(), ==, util::json::Reader::OBJ_END);
+    TEST(r.next(), ==, util::json::Reader::END);
+
+    // strings spanning several buffers
+    std::string longStr(200000, 'a');
+    longStr[100000] = 'b';
+    ss.str("[\"" + longStr + "\"]");
+    ss.clear();
+    util::json::Reader r2(&ss);
+    TEST(r2.next(), ==, util::json::Reader::ARR_START);
+    TEST(r2.next(), ==, util::json::Reader::STRING);
+    TEST(r2.str(), ==, longStr);
+
+    // truncated input
+    ss.str("{\"a\": [1, 2");
+    ss.clear();
+    util::json::Reader r3(&ss);
+    bool thrown = false;
+    try {
+      r3.skipVal();
+    } catch (const util::json::ReaderException& e) {
+      thrown = true;
+    }
+    TEST(thrown);
+
+    // surrogate pairs, unpaired surrogates become U+FFFD
+    ss.str(
+        "[\"\\ud83d\\ude00\", \"a\\ud83d\", \"\\ud83d\\n\", \"\\ude00b\","
+        " \"\\ud83d\\u00e4\", \"\\ud83dx\", 1]");
+    ss.clear();
+    util::json::Reader r4(&ss);
+    TEST(r4.next(), ==, util::json::Reader::ARR_START);
+    TEST(r4.next(), ==, util::json::Reader::STRING);
+    TEST(r4.str(), ==, "\xF0\x9F\x98\x80");
+    TEST(r4.next(), ==, util::json::Reader::STRING);
+    TEST(r4.str(), ==, "a\xEF\xBF\xBD");
+    TEST(r4.next(), ==, util::json::Reader::STRING);
+    TEST(r4.str(), ==, "\xEF\xBF\xBD\n");
+    TEST(r4.next(), ==, util::json::Reader::STRING);
+    TEST(r4.str(), ==, "\xEF\xBF\xBD" "b");
+    TEST(r4.next(), ==, util::json::Reader::STRING);
+    TEST(r4.str(), ==, "\xEF\xBF\xBD\xC3\xA4");
+    TEST(r4.next(), ==, util::json::Reader::STRING);
+    TEST(r4.str(), ==, "\xEF\xBF\xBDx");
+    TEST(r4.next(), ==, util::json::Reader::NUMBER);
+    TEST(r4.next(), ==, util::json::Reader::ARR_END);
+  }
+
+  // ___________________________________________________________________________
+  {
+    // chunks of a feature array only start at top-level features, not at
+    // the objects of the "lines" arrays or in strings
+    std::string doc = "{\"features\": [";
+    std::vector<size_t> feats;
+    for (size_t i = 0; i < 200; i++) {
+      if (i) doc += ", ";
+      feats.push_back(doc.size());
+      doc += "{\"type\": \"Feature\", \"properties\": {\"label\": "
+             "\"a\\\"}, {\", \"lines\": [{\"id\": \"A\"}, {\"id\": "
+             "\"B\"}, {\"id\": \"C]\"}], \"excluded_line_conns\": "
+             "[{\"route\": \"A\"}, {\"route\": \"B\"}]}}";
+    }
+    size_t end = doc.size();
+    doc += "], \"a\": 1}";
+    size_t pos = doc.find('[') + 1;
+
+    auto chunks = util::json::arrayChunks(doc.data(), doc.size(), pos, 1);
+    TEST(chunks.size(), ==, feats.size() + 1);
+    TEST(chunks.front(), ==, pos);
+    TEST(chunks.back(), ==, end);
+    bool ok = true;
+    for (size_t i = 1; i < feats.size(); i++) ok = ok && chunks[i] == feats[i];
+    TEST(ok);
+
+    // every chunk decodes to exactly the features up to the next start, so
+    // no chunk has to be decoded again
+    chunks = util::json::arrayChunks(doc.data(), doc.size(), pos, 1000);
+    TEST(chunks.size(), >, 2);
+    TEST(chunks.size(), <, feats.size());
+    for (size_t i = 1; i + 1 < chunks.size(); i++) {
+      TEST(std::find(feats.begin(), feats.end(), chunks[i]) != feats.end());
+      TEST(chunks[i] - chunks[i - 1], >=, 1000);
+    }
+    TEST(chunks.back(), ==, end);
+
+    util::json::Reader r(doc.data() + chunks[1], doc.size() - chunks[1],
+                         chunks[1]);
+    r.skipVal();
+    TEST(doc[chunks[1] + r.pos() - 1], ==, '}');
+    TEST(doc.substr(chunks[1] + r.pos(), 2), ==, ", ");
+
+    // unclosed arrays end at the input
+    std::string open = "[{\"a\": [1, 2]}, {\"b\": \"]\"}";
+    chunks = util::json::arrayChunks(open.data(), open.size(), 1, 1);
+    TEST(chunks.size(), ==, 3);
+    TEST(chunks[1], ==, open.find("{\"b"));
+    TEST(chunks[2], ==, open.size());
+  }
+
   // ___________________________________________________________________________
   {
     DirGraph<int, int> g;
@@ -236,6 +516,101 @@ int main(int argc, char** argv) {
     // TODO: more test cases
   }
 
+  // ___________________________________________________________________________
+  {
+    OrderedSet<int*> s;
+    int v[5];
+
+    for (int i = 4; i >= 0; i--) s.insert(&v[i]);
+    TEST(s.size(), ==, (size_t)5);
+    TEST(s.insert(&v[2]).second, ==, false);
+    TEST(s.size(), ==, (size_t)5);
+
+    auto it = s.begin();
+    for (int i = 4; i >= 0; i--, it++) TEST(*it == &v[i]);
+    TEST(it == s.end());
+
+    // erasing returns the next element, other iterators stay valid
+    auto last = s.find(&v[0]);
+    it = s.erase(s.find(&v[3]));
+    TEST(*it == &v[2]);
+    TEST(*last == &v[0]);
+    TEST(s.count(&v[3]), ==, (size_t)0);
+
+    // freed slots are reused, but the order is still the insertion order
+    s.insert(&v[3]);
+    std::vector<int*> order(s.begin(), s.end());
+    TEST(order.size(), ==, (size_t)5);
+    TEST(order[0] == &v[4]);
+    TEST(order[1] == &v[2]);
+    TEST(order[4] == &v[3]);
+
+    TEST(s.erase(&v[1]), ==, (size_t)1);
+    TEST(s.erase(&v[1]), ==, (size_t)0);
+
+    s.clear();
+    TEST(s.empty());
+    TEST(s.begin() == s.end());
+  }
+
+  // ___________________________________________________________________________
+  {
+    UndirGraph<int, int, PoolAlloc> g;
+
+    std::vector<Node<int, int>*> nds;
+    for (int i = 0; i < 3000; i++) nds.push_back(g.addNd(i));
+    for (int i = 1; i < 3000; i++) g.addEdg(nds[i - 1], nds[i], i);
+    g.addEdg(nds[0], nds[0]);
+
+    TEST(g.getNds().size(), ==, (size_t)3000);
+
+    int i = 0;
+    for (auto n : g.getNds()) TEST(n->pl(), ==, i++);
+
+    TEST(nds[0]->getDeg(), ==, (size_t)2);
+    g.delNd(nds[1]);
+    TEST(nds[0]->getDeg(), ==, (size_t)1);
+    TEST(nds[2]->getDeg(), ==, (size_t)1);
+
+    // the freed slot is reused
+    auto n = g.addNd(5000);
+    TEST(n == nds[1]);
+    TEST(n->getDeg(), ==, (size_t)0);
+    TEST((*g.getNds().begin())->pl(), ==, 0);
+
+    g.delEdg(nds[0], nds[0]);
+    TEST(nds[0]->getDeg(), ==, (size_t)0);
+
+    UndirGraph<int, int, PoolAlloc> g2(std::move(g));
+    TEST(g.getNds().size(), ==, (size_t)0);
+    TEST(g2.getNds().size(), ==, (size_t)3000);
+    TEST(nds[2]->getAdjList().front()->getOtherNd(nds[2]) == nds[3]);
+  }
+
+  // ___________________________________________________________________________
+  {
+    DirGraph<int, int, PoolAlloc> g;
+
+    auto a = g.addNd(1);
+    auto b = g.addNd(2);
+    auto c = g.addNd(3);
+
+    g.addEdg(a, b);
+    g.addEdg(b, a);
+    g.addEdg(b, c);
+    g.addEdg(b, b);
+
+    TEST(b->getOutDeg(), ==, (size_t)3);
+    TEST(b->getInDeg(), ==, (size_t)2);
+
+    g.delNd(b);
+
+    TEST(a->getOutDeg(), ==, (size_t)0);
+    TEST(a->getInDeg(), ==, (size_t)0);
+    TEST(c->getInDeg(), ==, (size_t)0);
+    TEST(g.getNds().size(), ==, (size_t)2);
+  }
+
   // ___________________________________________________________________________
   {
     Grid<int, Line, double> g(
@@ -577,6 +952,17 @@ int main(int argc, char** argv) {
     g.addEdg(f, a, 1);
     comps = util::graph::Algorithm::connectedComponents(g);
     TEST(comps.size(), ==, static_cast<size_t>(1));
+
+    // components iterate in id order, which is the insertion order
+    TEST(a->getId(), ==, static_cast<size_t>(0));
+    TEST(gn->getId(), ==, static_cast<size_t>(6));
+    size_t last = 0;
+    for (auto n : comps[0]) {
+      TEST(n->getId(), >=, last);
+      last = n->getId();
+    }
+    TEST(*comps[0].begin() == a);
+    TEST(*comps[0].rbegin() == gn);
   }
 
   // ___________________________________________________________________________